@@ -0,0 +1,178 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "ControlDispatcher.h"
+#include "Languages.h"
+#include "Logger/Logger.h"
+#include "Utils/Utils.h"
+
+using std::chrono::steady_clock;
+using std::string;
+using std::to_string;
+
+ControlDispatcher::ControlDispatcher(ControlInterface* control, const ControlID controlID)
+:	control(control),
+	controlID(controlID),
+	logger(Logger::Logger::GetLogger(Languages::GetText(Languages::TextManager))),
+	run(true),
+	deliveringSequence(0),
+	maxDepth(0),
+	posted(0),
+	coalesced(0),
+	overflows(0),
+	overflowing(false),
+	deliveryThread(&ControlDispatcher::Worker, this)
+{
+}
+
+ControlDispatcher::~ControlDispatcher()
+{
+	Terminate();
+}
+
+void ControlDispatcher::Post(const unsigned long long object,
+	const unsigned int kind,
+	const std::function<void()>& call)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (!run)
+	{
+		return;
+	}
+	++posted;
+	if (!queue.Push(object, kind, call))
+	{
+		++coalesced;
+		return;
+	}
+	const size_t depth = queue.GetSize();
+	if (depth > maxDepth)
+	{
+		maxDepth = depth;
+	}
+	if (depth > Capacity)
+	{
+		// the update is kept anyway, a lost accessory or loco command would let the layout differ from the manager
+		++overflows;
+		if (!overflowing)
+		{
+			overflowing = true;
+			logger->Warning(Languages::TextControlQueueOverflow, depth, controlID);
+		}
+	}
+	cv.notify_one();
+}
+
+void ControlDispatcher::PostUrgent(const std::function<void()>& call)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (!run)
+	{
+		return;
+	}
+	++posted;
+	queue.PushUrgent(call);
+	cv.notify_one();
+}
+
+bool ControlDispatcher::IsDeliveredUnlocked(const unsigned long long sequence) const
+{
+	return queue.IsPoppedUpTo(sequence) && (deliveringSequence == 0 || deliveringSequence > sequence);
+}
+
+void ControlDispatcher::WaitUntilDelivered()
+{
+	if (std::this_thread::get_id() == deliveryThread.get_id())
+	{
+		return;
+	}
+	std::unique_lock<std::mutex> lock(mutex);
+	const unsigned long long waitFor = queue.GetSequence();
+	deliveredCv.wait(lock, [this, waitFor] { return IsDeliveredUnlocked(waitFor); });
+}
+
+void ControlDispatcher::Terminate()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		run = false;
+		cv.notify_one();
+		deliveredCv.notify_all();
+	}
+	if (!deliveryThread.joinable())
+	{
+		return;
+	}
+	if (std::this_thread::get_id() == deliveryThread.get_id())
+	{
+		deliveryThread.detach();
+		return;
+	}
+	deliveryThread.join();
+}
+
+string ControlDispatcher::GetStatistics() const
+{
+	const string name = "controlqueue;" + to_string(controlID);
+	string statistics;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		statistics = name + ";" + to_string(queue.GetSize())
+			+ ";" + to_string(maxDepth)
+			+ ";" + to_string(posted)
+			+ ";" + to_string(coalesced)
+			+ ";" + to_string(overflows)
+			+ "\n";
+	}
+	return statistics + latency.ToCsv("controllatency;" + to_string(controlID));
+}
+
+void ControlDispatcher::Worker()
+{
+	Utils::Utils::SetThreadName("Control " + to_string(controlID));
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true)
+	{
+		Utils::CoalescingQueue::Entry entry;
+		if (!queue.Pop(entry))
+		{
+			if (!run)
+			{
+				return;
+			}
+			cv.wait(lock);
+			continue;
+		}
+
+		deliveringSequence = entry.sequence;
+		lock.unlock();
+
+		entry.call();
+		latency.Add(entry.posted);
+
+		lock.lock();
+		deliveringSequence = 0;
+		if (overflowing && queue.GetSize() <= Capacity / 2)
+		{
+			overflowing = false;
+		}
+		deliveredCv.notify_all();
+	}
+}
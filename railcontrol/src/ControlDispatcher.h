@@ -0,0 +1,105 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "DataTypes.h"
+#include "Utils/CoalescingQueue.h"
+#include "Utils/LatencyHistogram.h"
+
+class ControlInterface;
+
+namespace Logger
+{
+	class Logger;
+}
+
+// Delivers state updates to one control on its own thread, so a slow control does not delay the others.
+// A queued update is replaced by a newer one of the same object and kind
+// as long as no other update of that object has been queued behind it.
+class ControlDispatcher
+{
+	public:
+		static const size_t Capacity = 1024;
+
+		ControlDispatcher(const ControlDispatcher&) = delete;
+		ControlDispatcher& operator=(const ControlDispatcher&) = delete;
+
+		ControlDispatcher(ControlInterface* control, const ControlID controlID);
+		~ControlDispatcher();
+
+		static inline unsigned long long ObjectKey(const ObjectType objectType, const ObjectID objectID)
+		{
+			return (static_cast<unsigned long long>(objectType) << 32) | objectID;
+		}
+
+		inline ControlInterface* GetControl() const
+		{
+			return control;
+		}
+
+		// never blocks and never drops an update, a control that has more than Capacity updates waiting
+		// is logged as not keeping up and counted as overflow
+		void Post(const unsigned long long object,
+			const unsigned int kind,
+			const std::function<void()>& call);
+
+		// urgent calls are delivered in order before all other waiting updates
+		void PostUrgent(const std::function<void()>& call);
+
+		// blocks until everything posted before has been delivered
+		void WaitUntilDelivered();
+
+		// delivers all waiting updates and stops the thread
+		void Terminate();
+
+		// returns one CSV line: controlqueue;controlID;depth;max depth;posted;coalesced;overflows
+		// followed by the delivery latency histogram
+		std::string GetStatistics() const;
+
+	private:
+		bool IsDeliveredUnlocked(const unsigned long long sequence) const;
+
+		void Worker();
+
+		ControlInterface* const control;
+		const ControlID controlID;
+		Logger::Logger* const logger;
+		Utils::CoalescingQueue queue;
+		mutable std::mutex mutex;
+		std::condition_variable cv;
+		std::condition_variable deliveredCv;
+		bool run;
+		unsigned long long deliveringSequence;
+		size_t maxDepth;
+		unsigned long long posted;
+		unsigned long long coalesced;
+		unsigned long long overflows;
+		// set while more than Capacity updates are waiting, until half of them have been delivered
+		bool overflowing;
+		Utils::LatencyHistogram latency;
+		std::thread deliveryThread;
+};
@@ -88,6 +88,12 @@ class ControlInterface
 			return GetName();
 		}
 
+		// returns CSV lines for cmd=stats
+		virtual std::string GetStatistics() const
+		{
+			return "";
+		}
+
 		virtual void Warning(__attribute__((unused)) Languages::TextSelector textSelector)
 		{
 		}
@@ -0,0 +1,291 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include "DataModel/AutoModeDispatcher.h"
+#include "DataModel/LocoBase.h"
+#include "Utils/Utils.h"
+
+using std::chrono::steady_clock;
+
+namespace DataModel
+{
+	const std::chrono::seconds AutoModeDispatcher::SafetyInterval(30);
+
+	AutoModeDispatcher::AutoModeDispatcher(const unsigned int numberOfWorkers)
+	:	run(true)
+	{
+		for (unsigned int i = 0; i < numberOfWorkers; ++i)
+		{
+			workers.push_back(std::thread(&AutoModeDispatcher::Worker, this));
+		}
+	}
+
+	AutoModeDispatcher::~AutoModeDispatcher()
+	{
+		Terminate();
+	}
+
+	void AutoModeDispatcher::Start(LocoBase* locoBase)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		Entry& entry = locoBases[locoBase];
+		entry.deadline = steady_clock::now();
+		entry.queued = true;
+		entry.running = false;
+		entry.woken = false;
+		readyQueue.push_back(locoBase);
+		cv.notify_all();
+	}
+
+	void AutoModeDispatcher::Wakeup(LocoBase* locoBase)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto entry = locoBases.find(locoBase);
+		if (entry == locoBases.end())
+		{
+			return;
+		}
+		WakeupUnlocked(locoBase, entry->second);
+	}
+
+	void AutoModeDispatcher::WakeupAll()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (auto& entry : locoBases)
+		{
+			WakeupUnlocked(entry.first, entry.second);
+		}
+	}
+
+	void AutoModeDispatcher::Wakeup(const ObjectIdentifier& object)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		WakeupUnlocked(object);
+	}
+
+	void AutoModeDispatcher::Wakeup(const std::vector<ObjectIdentifier>& objects)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (auto& object : objects)
+		{
+			WakeupUnlocked(object);
+		}
+	}
+
+	void AutoModeDispatcher::WakeupUnlocked(const ObjectIdentifier& object)
+	{
+		// a running step may have tried the object before the event and registers for it after the event
+		for (auto& entry : locoBases)
+		{
+			if (entry.second.running)
+			{
+				entry.second.woken = true;
+			}
+		}
+
+		auto waiters = waiting.find(object);
+		if (waiters == waiting.end())
+		{
+			return;
+		}
+		const std::vector<LocoBase*> locos = waiters->second;
+		for (LocoBase* locoBase : locos)
+		{
+			Entry& entry = locoBases.at(locoBase);
+			StopWaitingUnlocked(locoBase, entry);
+			WakeupUnlocked(locoBase, entry);
+		}
+	}
+
+	void AutoModeDispatcher::WaitFor(LocoBase* locoBase, const std::vector<ObjectIdentifier>& objects)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto entry = locoBases.find(locoBase);
+		if (entry == locoBases.end())
+		{
+			return;
+		}
+		StopWaitingUnlocked(locoBase, entry->second);
+		std::vector<ObjectIdentifier>& waitingFor = entry->second.waitingFor;
+		waitingFor = objects;
+		std::sort(waitingFor.begin(), waitingFor.end());
+		waitingFor.erase(std::unique(waitingFor.begin(), waitingFor.end()), waitingFor.end());
+		for (auto& object : waitingFor)
+		{
+			waiting[object].push_back(locoBase);
+		}
+	}
+
+	void AutoModeDispatcher::StopWaitingUnlocked(LocoBase* locoBase, Entry& entry)
+	{
+		for (auto& object : entry.waitingFor)
+		{
+			auto waiters = waiting.find(object);
+			if (waiters == waiting.end())
+			{
+				continue;
+			}
+			std::vector<LocoBase*>& locos = waiters->second;
+			locos.erase(std::remove(locos.begin(), locos.end(), locoBase), locos.end());
+			if (locos.empty())
+			{
+				waiting.erase(waiters);
+			}
+		}
+		entry.waitingFor.clear();
+	}
+
+	void AutoModeDispatcher::WakeupUnlocked(LocoBase* locoBase, Entry& entry)
+	{
+		if (entry.running)
+		{
+			// the event may have arrived after the running step has looked at it
+			entry.woken = true;
+			return;
+		}
+		if (entry.queued)
+		{
+			return;
+		}
+		entry.queued = true;
+		readyQueue.push_back(locoBase);
+		cv.notify_all();
+	}
+
+	void AutoModeDispatcher::WaitUntilTerminated(LocoBase* locoBase)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		while (locoBases.count(locoBase))
+		{
+			cv.wait(lock);
+		}
+	}
+
+	void AutoModeDispatcher::Terminate()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			run = false;
+			cv.notify_all();
+		}
+		for (auto& worker : workers)
+		{
+			if (worker.joinable())
+			{
+				worker.join();
+			}
+		}
+	}
+
+	void AutoModeDispatcher::Worker()
+	{
+		Utils::Utils::SetMinThreadPriority();
+		Utils::Utils::SetThreadName("AutoMode");
+		std::unique_lock<std::mutex> lock(mutex);
+		while (run)
+		{
+			if (readyQueue.empty())
+			{
+				const steady_clock::time_point now = steady_clock::now();
+				steady_clock::time_point next = steady_clock::time_point::max();
+				for (auto& entry : locoBases)
+				{
+					Entry& e = entry.second;
+					if (e.queued || e.running)
+					{
+						continue;
+					}
+					if (e.deadline <= now)
+					{
+						e.queued = true;
+						readyQueue.push_back(entry.first);
+						continue;
+					}
+					if (e.deadline < next)
+					{
+						next = e.deadline;
+					}
+				}
+
+				if (readyQueue.empty())
+				{
+					if (next == steady_clock::time_point::max())
+					{
+						cv.wait(lock);
+					}
+					else
+					{
+						cv.wait_until(lock, next);
+					}
+					continue;
+				}
+			}
+
+			LocoBase* locoBase = readyQueue.front();
+			readyQueue.pop_front();
+			Entry& entry = locoBases.at(locoBase);
+			// the step registers again for what it still waits for
+			StopWaitingUnlocked(locoBase, entry);
+			entry.queued = false;
+			entry.running = true;
+			entry.woken = false;
+			lock.unlock();
+
+			const StepResult result = locoBase->AutoModeStep();
+
+			lock.lock();
+			entry.running = false;
+			switch (result)
+			{
+				case StepResultTerminated:
+					StopWaitingUnlocked(locoBase, entry);
+					locoBases.erase(locoBase);
+					cv.notify_all();
+					break;
+
+				case StepResultAgain:
+					entry.queued = true;
+					readyQueue.push_back(locoBase);
+					break;
+
+				case StepResultWait:
+				default:
+					if (entry.woken)
+					{
+						entry.queued = true;
+						readyQueue.push_back(locoBase);
+						break;
+					}
+					{
+						const steady_clock::time_point now = steady_clock::now();
+						entry.deadline = now + SafetyInterval;
+						// a loco that waits after a route has been released has to run when the wait time is over
+						if (locoBase->waitUntil > now && locoBase->waitUntil < entry.deadline)
+						{
+							entry.deadline = locoBase->waitUntil;
+						}
+					}
+					break;
+			}
+		}
+	}
+} // namespace DataModel
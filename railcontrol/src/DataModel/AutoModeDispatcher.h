@@ -0,0 +1,104 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "DataModel/ObjectIdentifier.h"
+
+namespace DataModel
+{
+	class LocoBase;
+
+	// Runs the automode state machines of all locos on a fixed number of worker threads.
+	// A loco is run as soon as it is woken up by an event. A loco that found no free route waits for the
+	// objects it depends on and is only woken up by events of these objects.
+	// One loco is never run by two workers at the same time.
+	class AutoModeDispatcher
+	{
+		public:
+			enum StepResult : unsigned char
+			{
+				StepResultAgain = 0,
+				StepResultWait,
+				StepResultTerminated
+			};
+
+			AutoModeDispatcher(const AutoModeDispatcher&) = delete;
+			AutoModeDispatcher& operator=(const AutoModeDispatcher&) = delete;
+
+			AutoModeDispatcher(const unsigned int numberOfWorkers);
+			~AutoModeDispatcher();
+
+			void Start(LocoBase* locoBase);
+
+			void Wakeup(LocoBase* locoBase);
+
+			void WakeupAll();
+
+			// wakes up the locos waiting for object and the locos that are running right now
+			void Wakeup(const ObjectIdentifier& object);
+
+			void Wakeup(const std::vector<ObjectIdentifier>& objects);
+
+			// called by the running step of locoBase, it is woken up again as soon as one of objects is woken up
+			void WaitFor(LocoBase* locoBase, const std::vector<ObjectIdentifier>& objects);
+
+			// blocks until the state machine of locoBase has terminated
+			void WaitUntilTerminated(LocoBase* locoBase);
+
+			void Terminate();
+
+		private:
+			struct Entry
+			{
+				std::chrono::steady_clock::time_point deadline;
+				bool queued;
+				bool running;
+				bool woken;
+				std::vector<ObjectIdentifier> waitingFor;
+			};
+
+			// a waiting loco is run after this interval even if it has not been woken up,
+			// this catches changes that are not reported as events, e.g. a changed number of tracks to reserve
+			static const std::chrono::seconds SafetyInterval;
+
+			void WakeupUnlocked(LocoBase* locoBase, Entry& entry);
+			void WakeupUnlocked(const ObjectIdentifier& object);
+			void StopWaitingUnlocked(LocoBase* locoBase, Entry& entry);
+
+			void Worker();
+
+			std::map<LocoBase*,Entry> locoBases;
+			std::map<ObjectIdentifier,std::vector<LocoBase*>> waiting;
+			std::deque<LocoBase*> readyQueue;
+			std::mutex mutex;
+			std::condition_variable cv;
+			bool run;
+			std::vector<std::thread> workers;
+	};
+} // namespace DataModel
@@ -42,7 +42,9 @@ namespace DataModel
 		str += ";feedbacktype=" + to_string(feedbackType);
 		str += ";route=" + to_string(routeId);
 		str += ";inverted=" + to_string(inverted);
-		str += ";state=" + to_string(stateCounter > 0);
+		str += ";ondelay=" + to_string(onDelay);
+		str += ";offdelay=" + to_string(offDelay);
+		str += ";state=" + to_string(state);
 		str += ";matchkey=" + matchKey;
 		return str;
 	}
@@ -66,7 +68,9 @@ namespace DataModel
 		feedbackType = static_cast<FeedbackType>(Utils::Utils::GetIntegerMapEntry(arguments, "feedbacktype", FeedbackTypeDefault));
 		routeId = Utils::Utils::GetIntegerMapEntry(arguments, "route", RouteNone);
 		inverted = Utils::Utils::GetBoolMapEntry(arguments, "inverted", false);
-		stateCounter = Utils::Utils::GetBoolMapEntry(arguments, "state", FeedbackStateFree) ? MaxStateCounter : 0;
+		onDelay = Utils::Utils::GetIntegerMapEntry(arguments, "ondelay", DefaultOnDelay);
+		offDelay = Utils::Utils::GetIntegerMapEntry(arguments, "offdelay", DefaultOffDelay);
+		state = static_cast<FeedbackState>(Utils::Utils::GetBoolMapEntry(arguments, "state", FeedbackStateFree));
 		matchKey = Utils::Utils::GetStringMapEntry(arguments, "matchkey");
 
 		// FIXME: 2025-11-03 convert CS2 feedback pin to pin/bus/device / can be removed later
@@ -84,66 +88,82 @@ namespace DataModel
 	}
 
 	void Feedback::SetState(Logger::Logger* logger,
-		const FeedbackState newState)
+		const FeedbackState newState,
+		const std::chrono::steady_clock::time_point timestamp)
 	{
-		const FeedbackState state = static_cast<FeedbackState>(newState != inverted);
+		const FeedbackState newStateInverted = static_cast<FeedbackState>(newState != inverted);
 		{
 			std::lock_guard<std::mutex> Guard(updateMutex);
-			if (state == FeedbackStateFree)
+			if (newStateInverted == state)
 			{
-				if (stateCounter < MaxStateCounter)
+				// the pending change was only a short interruption
+				if (pending)
 				{
-					return;
+					pending = false;
+					manager->FeedbackDebounceCancel(debounceTimer);
 				}
-				stateCounter = MaxStateCounter - 1;
 				return;
 			}
 
-			const unsigned char oldStateCounter = stateCounter;
-			stateCounter = MaxStateCounter;
+			if (pending)
+			{
+				// the delay runs from the first report of the new state
+				return;
+			}
 
-			if (oldStateCounter > 0)
+			const Delay delay = (newStateInverted == FeedbackStateOccupied ? onDelay : offDelay);
+			if (delay > 0)
 			{
+				pending = true;
+				pendingSince = timestamp;
+				++debounceGeneration;
+				debounceTimer = manager->FeedbackDebounceAt(this, timestamp + std::chrono::milliseconds(delay), debounceGeneration);
 				return;
 			}
+			state = newStateInverted;
 		}
 
-		manager->FeedbackPublishState(this);
-		UpdateTrackState(FeedbackStateOccupied);
+		PublishState(logger, newStateInverted, timestamp);
+	}
 
-		Route* route = manager->GetRoute(routeId);
-		if (route)
+	void Feedback::Debounce(Logger::Logger* logger, const unsigned int generation)
+	{
+		FeedbackState newState;
+		std::chrono::steady_clock::time_point timestamp;
 		{
-			route->Execute(logger, (track ? track->GetLocoBase() : ObjectIdentifier()));
+			std::lock_guard<std::mutex> Guard(updateMutex);
+			if (!pending || generation != debounceGeneration)
+			{
+				return;
+			}
+			pending = false;
+			state = static_cast<FeedbackState>(!state);
+			newState = state;
+			timestamp = pendingSince;
 		}
+		PublishState(logger, newState, timestamp);
 	}
 
-	void Feedback::UpdateTrackState(const FeedbackState state)
+	void Feedback::PublishState(Logger::Logger* logger,
+		const FeedbackState newState,
+		const std::chrono::steady_clock::time_point timestamp)
 	{
-		if (!track)
+		manager->FeedbackPublishState(this);
+		if (track)
 		{
-			return;
+			track->SetFeedbackState(GetID(), newState, timestamp);
 		}
-		track->SetFeedbackState(GetID(), state);
-	}
 
-	void Feedback::Debounce()
-	{
+		if (newState == FeedbackStateFree)
 		{
-			std::lock_guard<std::mutex> Guard(updateMutex);
-			if (stateCounter == MaxStateCounter || stateCounter == 0)
-			{
-				return;
-			}
+			return;
+		}
 
-			--stateCounter;
-			if (stateCounter != 0)
-			{
-				return;
-			}
+		Route* route = manager->GetRoute(routeId);
+		if (route)
+		{
+			route->Execute(logger, (track ? track->GetLocoBase() : ObjectIdentifier()));
 		}
-		manager->FeedbackPublishState(this);
-		UpdateTrackState(FeedbackStateFree);
 	}
 
 	Feedback& Feedback::operator=(const Hardware::FeedbackCacheEntry& feedback)
@@ -20,6 +20,7 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <chrono>
 #include <mutex>
 #include <string>
 
@@ -29,6 +30,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "Hardware/FeedbackCache.h"
 #include "Languages.h"
 #include "Logger/Logger.h"
+#include "Utils/TimerScheduler.h"
 
 class Manager;
 
@@ -46,6 +48,9 @@ namespace DataModel
 	class Feedback : public LayoutItem
 	{
 		public:
+			static const Delay DefaultOnDelay = 0;
+			static const Delay DefaultOffDelay = 2000;
+
 			enum FeedbackState : bool
 			{
 				FeedbackStateFree = false,
@@ -63,14 +68,22 @@ namespace DataModel
 				feedbackType(FeedbackTypeDefault),
 				routeId(RouteNone),
 				inverted(false),
+				onDelay(DefaultOnDelay),
+				offDelay(DefaultOffDelay),
 				track(nullptr),
-				stateCounter(0)
+				state(FeedbackStateFree),
+				pending(false),
+				debounceGeneration(0),
+				debounceTimer(Utils::TimerScheduler::TimerNone)
 			{
 			}
 
 			inline Feedback(Manager* manager, const std::string& serialized)
 			:	manager(manager),
-				track(nullptr)
+				track(nullptr),
+				pending(false),
+				debounceGeneration(0),
+				debounceTimer(Utils::TimerScheduler::TimerNone)
 			{
 				Deserialize(serialized);
 			}
@@ -124,12 +137,35 @@ namespace DataModel
 				return inverted;
 			}
 
+			// delays in ms a new state has to last before it is published
+			inline void SetOnDelay(const Delay onDelay)
+			{
+				this->onDelay = onDelay;
+			}
+
+			inline Delay GetOnDelay() const
+			{
+				return onDelay;
+			}
+
+			inline void SetOffDelay(const Delay offDelay)
+			{
+				this->offDelay = offDelay;
+			}
+
+			inline Delay GetOffDelay() const
+			{
+				return offDelay;
+			}
+
+			// timestamp is the time the hardware has reported the state
 			void SetState(Logger::Logger* logger,
-				const FeedbackState state);
+				const FeedbackState state,
+				const std::chrono::steady_clock::time_point timestamp);
 
 			inline FeedbackState GetState() const
 			{
-				return static_cast<FeedbackState>(stateCounter > 0);
+				return state;
 			}
 
 			inline bool CheckState(const FeedbackState state) const
@@ -137,7 +173,8 @@ namespace DataModel
 				return (GetState() == state);
 			}
 
-			void Debounce();
+			// called by the debouncer of the manager when the delay of a state change has passed
+			void Debounce(Logger::Logger* logger, const unsigned int generation);
 
 			inline void SetControlID(const ControlID controlID)
 			{
@@ -220,7 +257,9 @@ namespace DataModel
 			Feedback& operator=(const Hardware::FeedbackCacheEntry& feedback);
 
 		private:
-			void UpdateTrackState(const FeedbackState state);
+			void PublishState(Logger::Logger* logger,
+				const FeedbackState state,
+				const std::chrono::steady_clock::time_point timestamp);
 
 			ControlID controlID;
 			FeedbackPin pin;
@@ -231,9 +270,15 @@ namespace DataModel
 			FeedbackType feedbackType;
 			RouteID routeId;
 			bool inverted;
+			Delay onDelay;
+			Delay offDelay;
 			Track* track;
-			unsigned char stateCounter;
-			static const unsigned char MaxStateCounter = 10;
+			FeedbackState state;
+			// a state change waiting for its delay, it is dropped if the previous state comes back in time
+			bool pending;
+			std::chrono::steady_clock::time_point pendingSince;
+			unsigned int debounceGeneration;
+			Utils::TimerScheduler::TimerID debounceTimer;
 			mutable std::mutex updateMutex;
 			std::string matchKey;
 	};
@@ -19,6 +19,7 @@ along with RailControl; see the file LICENCE. If not see
 */
 
 #include <algorithm>
+#include <chrono>
 #include <map>
 #include <string>
 #include <thread>
@@ -38,6 +39,7 @@ namespace DataModel
 {
 	LocoBase::~LocoBase()
 	{
+		manager->CancelTimers(this);
 		while (true)
 		{
 			{
@@ -119,6 +121,8 @@ namespace DataModel
 	bool LocoBase::Release()
 	{
 		ForceManualMode();
+		// may be called with the loco mutex held that a running delay callback is waiting for
+		manager->CancelTimers(this, false);
 		{
 			std::lock_guard<std::mutex> Guard(stateMutex);
 
@@ -166,16 +170,30 @@ namespace DataModel
 	void LocoBase::ReleaseRouteAndTrack()
 	{
 		const ObjectIdentifier identifier = GetObjectIdentifier();
+		std::vector<ObjectIdentifier> released;
 		while(!releaseTrackQueue.IsEmpty())
 		{
 			Track* track = releaseTrackQueue.Dequeue();
 			track->Release(logger, identifier);
+			released.push_back(track->GetObjectIdentifier());
 		}
 		while(!releaseRouteQueue.IsEmpty())
 		{
 			Route* route = releaseRouteQueue.Dequeue();
 			route->Release(logger, identifier);
+			route->GetReservationObjects(released);
 		}
+		if (!released.empty())
+		{
+			// other locos may be waiting for the released tracks and routes
+			manager->AutoModeWakeup(released);
+		}
+	}
+
+	void LocoBase::FeedbackIdReached(const FeedbackID feedbackID)
+	{
+		feedbackIdsReached.Enqueue(feedbackID);
+		manager->AutoModeWakeup(this);
 	}
 
 	bool LocoBase::CheckFreeingTrack(const TrackID trackID) const
@@ -211,7 +229,7 @@ namespace DataModel
 		}
 		if (state == LocoStateTerminated)
 		{
-			locoThread.join();
+			manager->AutoModeWaitUntilTerminated(this);
 			state = LocoStateManual;
 		}
 		if (state != LocoStateManual)
@@ -222,7 +240,8 @@ namespace DataModel
 
 		followUpRoute = RouteAuto;
 		state = LocoStateAutomodeGetFirst;
-		locoThread = std::thread(&DataModel::LocoBase::AutoMode, this);
+		logger->Info(Languages::TextIsNowInAutoMode);
+		manager->AutoModeStart(this);
 
 		return true;
 	}
@@ -234,6 +253,7 @@ namespace DataModel
 			return;
 		}
 		requestManualMode = true;
+		manager->AutoModeWakeup(this);
 	}
 
 	bool LocoBase::GoToManualMode()
@@ -246,7 +266,7 @@ namespace DataModel
 		{
 			return false;
 		}
-		locoThread.join();
+		manager->AutoModeWaitUntilTerminated(this);
 		state = LocoStateManual;
 		return true;
 	}
@@ -268,26 +288,22 @@ namespace DataModel
 					break;
 			}
 		}
-		locoThread.join();
+		manager->AutoModeWakeup(this);
+		manager->AutoModeWaitUntilTerminated(this);
 		state = LocoStateManual;
 	}
 
-	void LocoBase::AutoMode()
+	AutoModeDispatcher::StepResult LocoBase::AutoModeStep()
 	{
-		Utils::Utils::SetMinThreadPriority();
-		const string& name = GetName();
-		Utils::Utils::SetThreadName(name);
-		logger->Info(Languages::TextIsNowInAutoMode);
-
-		while (true)
+		AutoModeDispatcher::StepResult result = AutoModeDispatcher::StepResultWait;
 		{
-			unsigned char pause = 0;
-			{ // sleep must be outside of locked block
-				std::lock_guard<std::mutex> Guard(stateMutex);
+			std::lock_guard<std::mutex> Guard(stateMutex);
 
-				if (!feedbackIdsReached.IsEmpty())
+			std::vector<FeedbackID> feedbackIds;
+			if (feedbackIdsReached.DequeueAll(feedbackIds))
+			{
+				for (const FeedbackID feedbackId : feedbackIds)
 				{
-					FeedbackID feedbackId = feedbackIdsReached.Dequeue();
 					if (feedbackId == feedbackIdFirst)
 					{
 						FeedbackIdFirstReached();
@@ -297,115 +313,142 @@ namespace DataModel
 						FeedbackIdStopReached();
 					}
 				}
-				else
+				result = AutoModeDispatcher::StepResultAgain;
+			}
+			else
+			{
+				const LocoState oldState = state;
+				switch (state)
 				{
-					switch (state)
-					{
-						case LocoStateOff:
-							// automode is turned off, terminate thread
-							logger->Info(Languages::TextIsNowInManualMode);
-							state = LocoStateTerminated;
-							requestManualMode = false;
+					case LocoStateOff:
+						// automode is turned off, terminate state machine
+						logger->Info(Languages::TextIsNowInManualMode);
+						state = LocoStateTerminated;
+						requestManualMode = false;
+						wait = 0;
+						waitUntil = std::chrono::steady_clock::time_point();
+						return AutoModeDispatcher::StepResultTerminated;
+
+					case LocoStateAutomodeGetFirst:
+						if (requestManualMode || (followUpRoute == RouteStop))
+						{
+							state = LocoStateOff;
+							break;
+						}
+						if (wait > 0)
+						{
+							waitUntil = std::chrono::steady_clock::now() + std::chrono::seconds(wait);
 							wait = 0;
-							return;
-
-						case LocoStateAutomodeGetFirst:
-							if (requestManualMode || (followUpRoute == RouteStop))
-							{
-								state = LocoStateOff;
-								break;
-							}
-							if (wait > 0)
-							{
-								--wait;
-								break;
-							}
-							GetTimetableDestinationFirst();
+						}
+						if (std::chrono::steady_clock::now() < waitUntil)
+						{
 							break;
-
-						case LocoStateAutomodeGetSecond:
-							if (requestManualMode)
-							{
-								logger->Info(Languages::TextIsRunningWaitingUntilDestination);
-								state = LocoStateStopping;
-								break;
-							}
-							if (manager->GetNrOfTracksToReserve() <= 1)
-							{
-								break;
-							}
-							if (wait > 0)
-							{
-								break;
-							}
-							GetTimetableDestinationSecond();
+						}
+						GetTimetableDestinationFirst();
+						break;
+
+					case LocoStateAutomodeGetSecond:
+						if (requestManualMode)
+						{
+							logger->Info(Languages::TextIsRunningWaitingUntilDestination);
+							state = LocoStateStopping;
 							break;
-
-						case LocoStateAutomodeRunning:
-							// loco is already running, waiting until destination reached
-							if (requestManualMode)
-							{
-								logger->Info(Languages::TextIsRunningWaitingUntilDestination);
-								state = LocoStateStopping;
-							}
+						}
+						if (manager->GetNrOfTracksToReserve() <= 1)
+						{
 							break;
-
-						case LocoStateStopping:
-							if (requestManualMode)
-							{
-								logger->Info(Languages::TextHasNotReachedDestination);
-								break;
-							}
-
-							if (trackSecond)
-							{
-								state = LocoStateAutomodeRunning;
-							}
-							else if (trackFirst)
-							{
-								state = LocoStateAutomodeGetSecond;
-							}
-							else
-							{
-								state = LocoStateAutomodeGetFirst;
-							}
+						}
+						if (wait > 0)
+						{
 							break;
-
-						case LocoStateTerminated:
-							logger->Error(Languages::TextIsInTerminatedState);
-							state = LocoStateError;
+						}
+						GetTimetableDestinationSecond();
+						break;
+
+					case LocoStateAutomodeRunning:
+						// loco is already running, waiting until destination reached
+						if (requestManualMode)
+						{
+							logger->Info(Languages::TextIsRunningWaitingUntilDestination);
+							state = LocoStateStopping;
+						}
+						break;
+
+					case LocoStateStopping:
+						if (requestManualMode)
+						{
+							logger->Info(Languages::TextHasNotReachedDestination);
 							break;
-
-						case LocoStateManual:
-							logger->Error(Languages::TextIsInManualState);
-							state = LocoStateError;
-							#include "Fallthrough.h"
-
-						case LocoStateError:
-							logger->Error(Languages::TextIsInErrorState);
-							if (requestManualMode)
-							{
-								state = LocoStateOff;
-							}
-							break;
-					}
-					pause = 1;
+						}
+
+						if (trackSecond)
+						{
+							state = LocoStateAutomodeRunning;
+						}
+						else if (trackFirst)
+						{
+							state = LocoStateAutomodeGetSecond;
+						}
+						else
+						{
+							state = LocoStateAutomodeGetFirst;
+						}
+						break;
+
+					case LocoStateTerminated:
+						logger->Error(Languages::TextIsInTerminatedState);
+						state = LocoStateError;
+						break;
+
+					case LocoStateManual:
+						logger->Error(Languages::TextIsInManualState);
+						state = LocoStateError;
+						#include "Fallthrough.h"
+
+					case LocoStateError:
+						logger->Error(Languages::TextIsInErrorState);
+						if (requestManualMode)
+						{
+							state = LocoStateOff;
+						}
+						break;
+				}
+				if (state != oldState)
+				{
+					result = AutoModeDispatcher::StepResultAgain;
 				}
 			}
+		}
 
-			if (state == LocoStateError)
-			{
-				manager->LocoBaseSpeed(ControlTypeInternal, GetObjectIdentifier(), MinSpeed);
-			}
+		if (state == LocoStateError)
+		{
+			manager->LocoBaseSpeed(ControlTypeInternal, GetObjectIdentifier(), MinSpeed);
+		}
 
-			ReleaseRouteAndTrack();
+		ReleaseRouteAndTrack();
+		return result;
+	}
 
-			// FIXME: make configurable
-			Utils::Utils::SleepForSeconds(pause);
+	Route* LocoBase::GetNextDestination(const Track* const track, const bool allowLocoTurn)
+	{
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		Route* const route = GetNextDestinationInternal(track, allowLocoTurn);
+		manager->RouteSelected(start);
+		if (!route && track)
+		{
+			// run again as soon as something changes that one of the routes from this track depends on
+			std::vector<ObjectIdentifier> objects;
+			objects.push_back(track->GetObjectIdentifier());
+			for (const Route* trackRoute : track->GetRoutes())
+			{
+				trackRoute->GetReservationObjects(objects);
+			}
+			manager->AutoModeWaitFor(this, objects);
 		}
+		return route;
 	}
 
-	Route* LocoBase::GetNextDestination(const Track* const track, const bool allowLocoTurn)
+	Route* LocoBase::GetNextDestinationInternal(const Track* const track, const bool allowLocoTurn)
 	{
 		if (timeTableQueue.IsEmpty())
 		{
@@ -536,24 +579,37 @@ namespace DataModel
 
 	Route* LocoBase::GetDestinationFromTimeTable(const Track* const track, const bool allowLocoTurn)
 	{
-		if (timeTableQueue.IsEmpty())
+		// the entry stays in the queue if the route can not be executed yet
+		TimeTableEntry entry;
+		if (!timeTableQueue.Front(entry))
 		{
 			return nullptr;
 		}
-
-		const TimeTableEntry entry = timeTableQueue.Dequeue();
 		Route* const route = manager->GetRoute(entry.first);
 		if (route->GetFromTrack() != track->GetID())
 		{
-			return nullptr;
+			// drive towards the start of the timetable route, the entry stays in the queue
+			bool reachable;
+			Route* const routeTowards = SearchRouteTowards(track, allowLocoTurn, route->GetFromTrack(), reachable);
+			if (!reachable)
+			{
+				timeTableQueue.PopFront();
+				return nullptr;
+			}
+			if (!routeTowards)
+			{
+				return nullptr;
+			}
+			logger->Debug(Languages::TextUsingRouteTowardsTimetable, routeTowards->GetName(), route->GetName());
+			return ExecuteRoute(track, allowLocoTurn, routeTowards) ? routeTowards : nullptr;
 		}
 		logger->Debug(Languages::TextUsingRouteFromTimetable, route->GetName());
 		bool ret = ExecuteRoute(track, allowLocoTurn, route);
 		if (!ret)
 		{
-			timeTableQueue.EnqueueFront(entry);
 			return nullptr;
 		}
+		timeTableQueue.PopFront();
 		followUpRoute = entry.second;
 		return route;
 	}
@@ -564,6 +620,7 @@ namespace DataModel
 		requestManualMode = false;
 		const TimeTableEntry entry(route->GetID(), followUpRoute);
 		timeTableQueue.EnqueueBack(entry);
+		manager->AutoModeWakeup(this);
 	}
 
 	void LocoBase::PrepareDestinationSecond(Route* const route)
@@ -636,6 +693,8 @@ namespace DataModel
 
 		vector<Route*> validRoutes;
 		track->GetValidRoutes(logger, this, allowLocoTurn, validRoutes);
+		// routes that can not be reserved because of another loco are not tried at all
+		manager->RouteGraphRemoveConflicting(GetObjectIdentifier(), validRoutes);
 		for (auto route : validRoutes)
 		{
 			bool ret = ReserveRoute(track, allowLocoTurn, route);
@@ -648,6 +707,27 @@ namespace DataModel
 		return nullptr;
 	}
 
+	Route* LocoBase::SearchRouteTowards(const Track* const track,
+		const bool allowLocoTurn,
+		const TrackID destination,
+		bool& reachable)
+	{
+		// planned again on every call, so released tracks and routes are taken into account at once
+		vector<Route*> validRoutes;
+		track->GetValidRoutes(logger, this, allowLocoTurn, validRoutes);
+		manager->RouteGraphOrder(GetObjectIdentifier(), destination, validRoutes);
+		reachable = !validRoutes.empty();
+		manager->RouteGraphRemoveConflicting(GetObjectIdentifier(), validRoutes);
+		for (auto route : validRoutes)
+		{
+			if (ReserveRoute(track, allowLocoTurn, route))
+			{
+				return route;
+			}
+		}
+		return nullptr;
+	}
+
 	bool LocoBase::ReserveRoute(const Track* const track, const bool allowLocoTurn, Route* const route)
 	{
 		const string& routeName = route->GetName();
@@ -655,6 +735,7 @@ namespace DataModel
 		const ObjectIdentifier locoBaseIdentifier = GetObjectIdentifier();
 		if (!route->Reserve(logger, locoBaseIdentifier))
 		{
+			manager->RouteReservationConflict();
 			logger->Debug(Languages::TextUnableToReserveRoute, routeName);
 			return false;
 		}
@@ -743,93 +824,57 @@ namespace DataModel
 		}
 	}
 
-	Speed LocoBase::LocationStopReached(const FeedbackID feedbackID,
-		const Delay stopDelay)
+	void LocoBase::LocationStopReachedDelayed(const FeedbackID feedbackID)
 	{
-		Utils::Utils::SleepForMilliseconds(stopDelay * 100);
 		if (feedbackID != feedbackIdStop)
 		{
-			return speed;
+			return;
 		}
-		return LocationStopReached();
+		manager->LocoBaseSpeed(ControlTypeInternal, GetObjectIdentifier(), LocationStopReached());
 	}
 
 	Speed LocoBase::LocationStopReached()
 	{
-		feedbackIdsReached.EnqueueBack(feedbackIdStop);
+		FeedbackIdReached(feedbackIdStop);
 		return MinSpeed;
 	}
 
-	void LocoBase::LocationStopReachedStatic(Manager* manager,
-		LocoBase* locoBase,
-		const FeedbackID feedbackID,
-		const Delay stopDelay)
-	{
-		Utils::Utils::SetThreadName("LocationStopReachedStatic");
-		const Speed newSpeed = locoBase->LocationStopReached(feedbackID, stopDelay);
-		manager->LocoBaseSpeed(ControlTypeInternal, locoBase->GetObjectIdentifier(), newSpeed);
-	}
-
-	Speed LocoBase::LocationCreepReached(const FeedbackID feedbackID,
-		const Delay creepDelay)
+	void LocoBase::LocationCreepReachedDelayed(const FeedbackID feedbackID)
 	{
-		Utils::Utils::SleepForMilliseconds(creepDelay * 100);
 		if (feedbackID != feedbackIdCreep)
 		{
-			return speed;
+			return;
 		}
-		return LocationCreepReached();
+		manager->LocoBaseSpeed(ControlTypeInternal, GetObjectIdentifier(), LocationCreepReached());
 	}
 
 	Speed LocoBase::LocationCreepReached()
 	{
 		if (feedbackIdFirst != FeedbackNone)
 		{
-			feedbackIdsReached.EnqueueBack(feedbackIdFirst);
+			FeedbackIdReached(feedbackIdFirst);
 		}
 		return std::min(speed, creepingSpeed);
 	}
 
-	void LocoBase::LocationCreepReachedStatic(Manager* manager,
-		LocoBase* locoBase,
-		const FeedbackID feedbackID,
-		const Delay creepDelay)
-	{
-		Utils::Utils::SetThreadName("LocationCreepReachedStatic");
-		const Speed newSpeed = locoBase->LocationCreepReached(feedbackID, creepDelay);
-		manager->LocoBaseSpeed(ControlTypeInternal, locoBase->GetObjectIdentifier(), newSpeed);
-	}
-
-	Speed LocoBase::LocationReducedReached(const FeedbackID feedbackID,
-		const Delay reducedDelay)
+	void LocoBase::LocationReducedReachedDelayed(const FeedbackID feedbackID)
 	{
-		Utils::Utils::SleepForMilliseconds(reducedDelay * 100);
 		if (feedbackID != feedbackIdReduced)
 		{
-			return speed;
+			return;
 		}
-		return LocationReducedReached();
+		manager->LocoBaseSpeed(ControlTypeInternal, GetObjectIdentifier(), LocationReducedReached());
 	}
 
 	Speed LocoBase::LocationReducedReached()
 	{
 		if (feedbackIdFirst != 0)
 		{
-			feedbackIdsReached.EnqueueBack(feedbackIdFirst);
+			FeedbackIdReached(feedbackIdFirst);
 		}
 		return std::min(speed, reducedSpeed);
 	}
 
-	void LocoBase::LocationReducedReachedStatic(Manager* manager,
-		LocoBase* locoBase,
-		const FeedbackID feedbackID,
-		const Delay reducedDelay)
-	{
-		Utils::Utils::SetThreadName("LocationReducedReachedStatic");
-		const Speed newSpeed = locoBase->LocationReducedReached(feedbackID, reducedDelay);
-		manager->LocoBaseSpeed(ControlTypeInternal, locoBase->GetObjectIdentifier(), newSpeed);
-	}
-
 	Speed LocoBase::LocationReached(const FeedbackID feedbackID)
 	{
 		Speed newSpeed = speed;
@@ -866,15 +911,16 @@ namespace DataModel
 		{
 			const Speed nextSpeed = GetRouteSpeed(routeSecond->GetSpeed());
 			newSpeed = std::min(speed, nextSpeed);
-			feedbackIdsReached.EnqueueBack(feedbackIdFirst);
+			FeedbackIdReached(feedbackIdFirst);
 		}
 
 		if (feedbackID == feedbackIdReduced)
 		{
 			if (reducedDelay)
 			{
-				std::thread t(LocationReducedReachedStatic, manager, this, feedbackID, reducedDelay);
-				t.detach();
+				manager->ScheduleTimer(std::chrono::milliseconds(reducedDelay * 100),
+					[this, feedbackID]() { LocationReducedReachedDelayed(feedbackID); },
+					this);
 			}
 			else
 			{
@@ -886,8 +932,9 @@ namespace DataModel
 		{
 			if (creepDelay)
 			{
-				std::thread t(LocationCreepReachedStatic, manager, this, feedbackID, creepDelay);
-				t.detach();
+				manager->ScheduleTimer(std::chrono::milliseconds(creepDelay * 100),
+					[this, feedbackID]() { LocationCreepReachedDelayed(feedbackID); },
+					this);
 			}
 			else
 			{
@@ -899,8 +946,9 @@ namespace DataModel
 		{
 			if (stopDelay)
 			{
-				std::thread t(LocationStopReachedStatic, manager, this, feedbackID, stopDelay);
-				t.detach();
+				manager->ScheduleTimer(std::chrono::milliseconds(stopDelay * 100),
+					[this, feedbackID]() { LocationStopReachedDelayed(feedbackID); },
+					this);
 			}
 			else
 			{
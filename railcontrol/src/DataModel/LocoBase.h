@@ -20,17 +20,20 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <chrono>
 #include <mutex>
 #include <string>
 #include <vector>
 
 #include "DataTypes.h"
 #include "Logger/Logger.h"
+#include "DataModel/AutoModeDispatcher.h"
 #include "DataModel/HardwareHandle.h"
 #include "DataModel/LocoFunctions.h"
 #include "DataModel/Object.h"
 #include "DataModel/Relation.h"
 #include "DataModel/Route.h"
+#include "Utils/RingQueue.h"
 #include "Utils/ThreadSafeQueue.h"
 
 class Manager;
@@ -95,6 +98,7 @@ namespace DataModel
 				feedbackIdOver(FeedbackNone),
 				feedbackIdsReached(),
 				wait(0),
+				waitUntil(),
 				followUpRoute(RouteAuto),
 				matchKey("")
 			{
@@ -310,6 +314,8 @@ namespace DataModel
 			Manager* manager;
 
 		private:
+			friend class AutoModeDispatcher;
+
 			typedef std::pair<RouteID,RouteID> TimeTableEntry;
 
 			enum LocoState : unsigned char
@@ -326,9 +332,13 @@ namespace DataModel
 
 			void SetMinThreadPriorityAndThreadName();
 
-			void AutoMode();
+			// one step of the automode state machine, run by the AutoModeDispatcher
+			AutoModeDispatcher::StepResult AutoModeStep();
+
+			void FeedbackIdReached(const FeedbackID feedbackID);
 
 			Route* GetNextDestination(const Track* const track, const bool allowLocoTurn);
+			Route* GetNextDestinationInternal(const Track* const track, const bool allowLocoTurn);
 
 			void GetTimetableDestinationFirst();
 
@@ -342,6 +352,13 @@ namespace DataModel
 
 			DataModel::Route* SearchDestination(const DataModel::Track* const oldToTrack, const bool allowLocoTurn);
 
+			// reserves the first route of the cheapest path to destination,
+			// reachable is false if there is no path at all
+			DataModel::Route* SearchRouteTowards(const DataModel::Track* const track,
+				const bool allowLocoTurn,
+				const TrackID destination,
+				bool& reachable);
+
 			bool ReserveRoute(const Track* const track, const bool allowLocoTurn, Route* const route);
 
 			bool ExecuteRoute(const Track* const track, const bool allowLocoTurn, Route* const route);
@@ -358,36 +375,18 @@ namespace DataModel
 
 			Speed GetRouteSpeed(const Route::Speed routeSpeed) const;
 
-			Speed LocationStopReached(const FeedbackID feedbackID,
-				const Delay stopDelay);
+			void LocationStopReachedDelayed(const FeedbackID feedbackID);
 
 			Speed LocationStopReached();
 
-			static void LocationStopReachedStatic(Manager* manager,
-				LocoBase* locoBase,
-				const FeedbackID feedbackID,
-				const Delay stopDelay);
-
-			Speed LocationCreepReached(const FeedbackID feedbackID,
-				const Delay creepDelay);
+			void LocationCreepReachedDelayed(const FeedbackID feedbackID);
 
 			Speed LocationCreepReached();
 
-			static void LocationCreepReachedStatic(Manager* manager,
-				LocoBase* locoBase,
-				const FeedbackID feedbackID,
-				const Delay creepDelay);
-
-			Speed LocationReducedReached(const FeedbackID feedbackID,
-				const Delay reducedDelay);
+			void LocationReducedReachedDelayed(const FeedbackID feedbackID);
 
 			Speed LocationReducedReached();
 
-			static void LocationReducedReachedStatic(Manager* manager,
-				LocoBase* locoBase,
-				const FeedbackID feedbackID,
-				const Delay reducedDelay);
-
 			void ReleaseRouteAndTrack();
 
 			static inline void ReleaseRouteAndTrackStatic(LocoBase* locoBase)
@@ -397,7 +396,6 @@ namespace DataModel
 			}
 
 			mutable std::mutex stateMutex;
-			std::thread locoThread;
 
 			Length length;
 			bool pushpull;
@@ -431,8 +429,10 @@ namespace DataModel
 			volatile FeedbackID feedbackIdStop;
 			volatile Delay stopDelay;
 			volatile FeedbackID feedbackIdOver;
-			Utils::ThreadSafeQueue<FeedbackID> feedbackIdsReached;
+			Utils::MpscQueue<FeedbackID,64> feedbackIdsReached;
 			Pause wait;
+			std::chrono::steady_clock::time_point waitUntil;
+			// unbounded, entries may be added while the loco is in manual mode and nothing takes them out
 			Utils::ThreadSafeQueue<TimeTableEntry> timeTableQueue;
 			RouteID followUpRoute;
 			std::string matchKey;
@@ -26,81 +26,41 @@ namespace DataModel
 {
 	void ObjectIdentifier::Deserialize(const std::map<std::string, std::string>& arguments)
 	{
-		objectID = static_cast<ObjectID>(Utils::Utils::GetIntegerMapEntry(arguments, "track", ObjectNone));
-		if (objectID != ObjectNone)
-		{
-			objectType = ObjectTypeTrack;
-			return;
-		}
-
-		objectID = static_cast<ObjectID>(Utils::Utils::GetIntegerMapEntry(arguments, "signal", ObjectNone));
-		if (objectID != ObjectNone)
-		{
-			objectType = ObjectTypeSignal;
-			return;
-		}
-
-		objectID = static_cast<ObjectID>(Utils::Utils::GetIntegerMapEntry(arguments, "switch", ObjectNone));
-		if (objectID != ObjectNone)
-		{
-			objectType = ObjectTypeSwitch;
-			return;
-		}
-
-		objectID = static_cast<ObjectID>(Utils::Utils::GetIntegerMapEntry(arguments, "accessory", ObjectNone));
-		if (objectID != ObjectNone)
-		{
-			objectType = ObjectTypeAccessory;
-			return;
-		}
-
-		objectID = static_cast<ObjectID>(Utils::Utils::GetIntegerMapEntry(arguments, "feedback", ObjectNone));
-		if (objectID != ObjectNone)
-		{
-			objectType = ObjectTypeFeedback;
-			return;
-		}
-
-		objectID = static_cast<ObjectID>(Utils::Utils::GetIntegerMapEntry(arguments, "route", ObjectNone));
-		if (objectID != ObjectNone)
-		{
-			objectType = ObjectTypeRoute;
-			return;
-		}
-
-		objectID = static_cast<ObjectID>(Utils::Utils::GetIntegerMapEntry(arguments, "text", ObjectNone));
-		if (objectID != ObjectNone)
-		{
-			objectType = ObjectTypeText;
-			return;
-		}
-
-		objectID = static_cast<ObjectID>(Utils::Utils::GetIntegerMapEntry(arguments, "pause", ObjectNone));
-		if (objectID != ObjectNone)
-		{
-			objectType = ObjectTypePause;
-			return;
-		}
-
-		objectID = static_cast<ObjectID>(Utils::Utils::GetIntegerMapEntry(arguments, "multipleunit", ObjectNone));
-		if (objectID != ObjectNone)
-		{
-			objectType = ObjectTypeMultipleUnit;
-			return;
-		}
-
-		objectID = static_cast<ObjectID>(Utils::Utils::GetIntegerMapEntry(arguments, "booster", ObjectNone));
-		if (objectID != ObjectNone)
-		{
-			objectType = ObjectTypeBooster;
-			return;
-		}
+		Deserialize([&arguments](const char* name)
+			{
+				return Utils::Utils::GetIntegerMapEntry(arguments, name, ObjectNone);
+			});
+	}
 
-		objectID = static_cast<ObjectID>(Utils::Utils::GetIntegerMapEntry(arguments, "counter", ObjectNone));
-		if (objectID != ObjectNone)
-		{
-			objectType = ObjectTypeCounter;
-			return;
+	void ObjectIdentifier::Deserialize(const std::function<int(const char* name)>& getArgument)
+	{
+		static const struct
+		{
+			const char* name;
+			ObjectType objectType;
+		} argumentTypes[] =
+		{
+			{ "track", ObjectTypeTrack },
+			{ "signal", ObjectTypeSignal },
+			{ "switch", ObjectTypeSwitch },
+			{ "accessory", ObjectTypeAccessory },
+			{ "feedback", ObjectTypeFeedback },
+			{ "route", ObjectTypeRoute },
+			{ "text", ObjectTypeText },
+			{ "pause", ObjectTypePause },
+			{ "multipleunit", ObjectTypeMultipleUnit },
+			{ "booster", ObjectTypeBooster },
+			{ "counter", ObjectTypeCounter }
+		};
+
+		for (auto& argumentType : argumentTypes)
+		{
+			objectID = static_cast<ObjectID>(getArgument(argumentType.name));
+			if (objectID != ObjectNone)
+			{
+				objectType = argumentType.objectType;
+				return;
+			}
 		}
 
 		objectType = ObjectTypeNone;
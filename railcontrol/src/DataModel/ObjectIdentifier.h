@@ -20,6 +20,7 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <functional>
 #include <map>
 #include <string>
 
@@ -61,6 +62,9 @@ namespace DataModel
 
 			void Deserialize(const std::map<std::string,std::string>& arguments);
 
+			// getArgument returns the object id of the argument name or ObjectNone if it is not set
+			void Deserialize(const std::function<int(const char* name)>& getArgument);
+
 			inline ObjectIdentifier& operator=(const ObjectIdentifier& other) = default;
 
 			inline void SetObjectType(const ObjectType objectType)
@@ -85,6 +89,11 @@ namespace DataModel
 				return !(*this == other);
 			}
 
+			inline bool operator<(const ObjectIdentifier& other) const
+			{
+				return this->objectType < other.objectType || (this->objectType == other.objectType && this->objectID < other.objectID);
+			}
+
 			inline operator std::string() const
 			{
 				return GetObjectTypeAsString() + GetObjectIdAsString();
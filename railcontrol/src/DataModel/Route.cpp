@@ -323,6 +323,7 @@ namespace DataModel
 			}
 		}
 
+		manager->RouteGraphSetLocoBase(GetID(), locoBaseIdentifier);
 		return true;
 	}
 
@@ -401,7 +402,9 @@ namespace DataModel
 			relation->Release(logger, locoBaseIdentifier);
 		}
 
-		return LockableItem::Release(logger, locoBaseIdentifier);
+		const bool ret = LockableItem::Release(logger, locoBaseIdentifier);
+		manager->RouteGraphSetLocoBase(GetID(), GetLocoBase());
+		return ret;
 	}
 
 	void Route::ReleaseInternalWithToTrack(Logger::Logger* logger, const ObjectIdentifier& locoBaseIdentifier)
@@ -414,6 +417,20 @@ namespace DataModel
 		ReleaseInternal(logger, locoBaseIdentifier);
 	}
 
+	void Route::GetReservationObjects(std::vector<ObjectIdentifier>& objects) const
+	{
+		objects.push_back(GetObjectIdentifier());
+		objects.push_back(ObjectIdentifier(ObjectTypeTrack, toTrack));
+		for (auto relation : relationsAtLock)
+		{
+			objects.push_back(ObjectIdentifier(relation->ObjectType2(), relation->ObjectID2()));
+		}
+		for (auto condition : relationsConditions)
+		{
+			objects.push_back(ObjectIdentifier(condition->ObjectType2(), condition->ObjectID2()));
+		}
+	}
+
 	bool Route::ObjectIsPartOfRoute(const ObjectIdentifier& identifier) const
 	{
 		for (auto relation : relationsAtLock)
@@ -152,6 +152,10 @@ namespace DataModel
 				return relationsConditions;
 			}
 
+			// adds the route, its destination track and the objects of its relations and conditions,
+			// these decide if the route can be reserved
+			void GetReservationObjects(std::vector<ObjectIdentifier>& objects) const;
+
 			bool FromTrackOrientation(Logger::Logger* logger,
 				const TrackID trackID,
 				const Orientation trackOrientation,
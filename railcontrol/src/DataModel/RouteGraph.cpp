@@ -0,0 +1,495 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <queue>
+
+#include "DataModel/Relation.h"
+#include "DataModel/Route.h"
+#include "DataModel/RouteGraph.h"
+
+using std::string;
+using std::to_string;
+using std::vector;
+
+namespace DataModel
+{
+	RouteGraph::RouteGraph()
+	:	words(0),
+		filtered(0),
+		plans(0)
+	{
+	}
+
+	void RouteGraph::Update(const Route* const route)
+	{
+		vector<unsigned long long> elements;
+		Elements(route, elements);
+
+		std::lock_guard<std::mutex> guard(mutex);
+		const RouteID routeID = route->GetID();
+		auto found = indices.find(routeID);
+		const size_t index = (found == indices.end() ? AddIndexUnlocked(routeID) : found->second);
+		RemoveConflictsUnlocked(index);
+
+		Node& node = nodes[index];
+		RemoveFromTrackList(routesFromTrack, node.fromTrack, index);
+		RemoveFromTrackList(routesToTrack, node.toTrack, index);
+		node.route = route;
+		node.fromTrack = TrackNone;
+		node.toTrack = TrackNone;
+		if (route->GetAutomode() == AutomodeYes && route->GetFromTrack() != TrackNone && route->GetToTrack() != TrackNone)
+		{
+			node.fromTrack = route->GetFromTrack();
+			node.toTrack = route->GetToTrack();
+			routesFromTrack[node.fromTrack].push_back(index);
+			routesToTrack[node.toTrack].push_back(index);
+		}
+
+		node.elements.swap(elements);
+		for (auto element : node.elements)
+		{
+			Bitset& routesOfElement = users[element];
+			routesOfElement.resize(words, 0);
+			for (size_t word = 0; word < words; ++word)
+			{
+				node.conflicts[word] |= routesOfElement[word];
+			}
+			SetBit(routesOfElement, index);
+		}
+
+		for (size_t word = 0; word < words; ++word)
+		{
+			uint64_t bits = node.conflicts[word];
+			while (bits)
+			{
+				SetBit(nodes[word * BitsPerWord + __builtin_ctzll(bits)].conflicts, index);
+				bits &= bits - 1;
+			}
+		}
+	}
+
+	void RouteGraph::Remove(const RouteID routeID)
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		auto found = indices.find(routeID);
+		if (found == indices.end())
+		{
+			return;
+		}
+		const size_t index = found->second;
+		RemoveConflictsUnlocked(index);
+		ClearBit(held, index);
+		Node& node = nodes[index];
+		RemoveFromTrackList(routesFromTrack, node.fromTrack, index);
+		RemoveFromTrackList(routesToTrack, node.toTrack, index);
+		node.fromTrack = TrackNone;
+		node.toTrack = TrackNone;
+		node.route = nullptr;
+		node.routeID = RouteNone;
+		node.locoBase.Clear();
+		indices.erase(found);
+		freeIndices.push_back(index);
+	}
+
+	void RouteGraph::SetLocoBase(const RouteID routeID, const ObjectIdentifier& locoBaseIdentifier)
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		auto found = indices.find(routeID);
+		if (found == indices.end())
+		{
+			return;
+		}
+		const size_t index = found->second;
+		nodes[index].locoBase = locoBaseIdentifier;
+		if (locoBaseIdentifier.IsSet())
+		{
+			SetBit(held, index);
+		}
+		else
+		{
+			ClearBit(held, index);
+		}
+	}
+
+	void RouteGraph::RemoveConflicting(const ObjectIdentifier& locoBaseIdentifier, vector<Route*>& routes) const
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		auto remaining = std::remove_if(routes.begin(), routes.end(),
+			[this, &locoBaseIdentifier](const Route* route)
+			{
+				auto found = indices.find(route->GetID());
+				return found != indices.end() && ConflictsWithOtherLocoBaseUnlocked(found->second, locoBaseIdentifier);
+			});
+		filtered += routes.end() - remaining;
+		routes.erase(remaining, routes.end());
+	}
+
+	void RouteGraph::Order(const ObjectIdentifier& locoBaseIdentifier,
+		const TrackID destination,
+		const TrackCost& trackCost,
+		vector<Route*>& routes) const
+	{
+		// every track is rated only once per plan
+		std::map<TrackID,Cost> trackCosts;
+		auto cachedTrackCost = [&trackCost, &trackCosts](const TrackID trackID) -> Cost
+			{
+				auto found = trackCosts.find(trackID);
+				if (found != trackCosts.end())
+				{
+					return found->second;
+				}
+				const Cost cost = trackCost(trackID);
+				trackCosts[trackID] = cost;
+				return cost;
+			};
+
+		std::lock_guard<std::mutex> guard(mutex);
+		++plans;
+		const time_t now = std::time(nullptr);
+		std::map<TrackID,Cost> costsToDestination;
+		if (destination != TrackNone)
+		{
+			CostsToDestinationUnlocked(locoBaseIdentifier, destination, cachedTrackCost, costsToDestination);
+		}
+		std::map<std::pair<TrackID,unsigned int>,Cost> lookAheadCosts;
+
+		vector<std::pair<Cost,Route*>> rated;
+		for (auto route : routes)
+		{
+			auto found = indices.find(route->GetID());
+			if (found == indices.end())
+			{
+				continue;
+			}
+			const size_t index = found->second;
+			const TrackID toTrack = nodes[index].toTrack;
+			if (toTrack == TrackNone)
+			{
+				continue;
+			}
+			Cost cost = Add(RouteCostUnlocked(index, locoBaseIdentifier, now), cachedTrackCost(toTrack));
+			if (destination != TrackNone)
+			{
+				auto costToDestination = costsToDestination.find(toTrack);
+				if (costToDestination == costsToDestination.end())
+				{
+					continue;
+				}
+				cost = Add(cost, costToDestination->second);
+			}
+			else
+			{
+				cost = Add(cost, LookAheadCostUnlocked(locoBaseIdentifier, toTrack, LookAheadRoutes, cachedTrackCost, lookAheadCosts));
+			}
+			if (cost == CostUnreachable)
+			{
+				continue;
+			}
+			rated.push_back(std::make_pair(cost, route));
+		}
+
+		std::stable_sort(rated.begin(), rated.end(),
+			[](const std::pair<Cost,Route*>& rated1, const std::pair<Cost,Route*>& rated2)
+			{
+				return rated1.first < rated2.first;
+			});
+		routes.clear();
+		for (auto& ratedRoute : rated)
+		{
+			routes.push_back(ratedRoute.second);
+		}
+	}
+
+	string RouteGraph::GetStatistics() const
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		size_t conflicts = 0;
+		for (auto& index : indices)
+		{
+			for (auto word : nodes[index.second].conflicts)
+			{
+				conflicts += __builtin_popcountll(word);
+			}
+		}
+		size_t numberOfHeld = 0;
+		for (auto word : held)
+		{
+			numberOfHeld += __builtin_popcountll(word);
+		}
+		return "routegraph;" + to_string(indices.size())
+			+ ";" + to_string(conflicts / 2)
+			+ ";" + to_string(numberOfHeld)
+			+ ";" + to_string(filtered)
+			+ ";" + to_string(plans)
+			+ "\n";
+	}
+
+	void RouteGraph::Elements(const Route* const route, vector<unsigned long long>& elements)
+	{
+		// a route conflicts with all routes that contain it
+		elements.push_back(ElementKey(ObjectTypeRoute, route->GetID()));
+		if (route->GetAutomode() == AutomodeYes && route->GetToTrack() != TrackNone)
+		{
+			elements.push_back(ElementKey(ObjectTypeTrack, route->GetToTrack()));
+		}
+		for (auto relation : route->GetRelationsAtLock())
+		{
+			const ObjectType objectType = relation->ObjectType2();
+			switch (objectType)
+			{
+				case ObjectTypeTrack:
+				case ObjectTypeSignal:
+				case ObjectTypeSwitch:
+				case ObjectTypeAccessory:
+				case ObjectTypeRoute:
+					elements.push_back(ElementKey(objectType, relation->ObjectID2()));
+					break;
+
+				default:
+					// locos, pauses, boosters and counters are not reserved
+					break;
+			}
+		}
+		std::sort(elements.begin(), elements.end());
+		elements.erase(std::unique(elements.begin(), elements.end()), elements.end());
+	}
+
+	bool RouteGraph::IsEmpty(const Bitset& bitset)
+	{
+		for (auto word : bitset)
+		{
+			if (word)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	size_t RouteGraph::AddIndexUnlocked(const RouteID routeID)
+	{
+		size_t index;
+		if (freeIndices.size())
+		{
+			index = freeIndices.back();
+			freeIndices.pop_back();
+		}
+		else
+		{
+			index = nodes.size();
+			nodes.push_back(Node());
+			nodes[index].route = nullptr;
+			nodes[index].fromTrack = TrackNone;
+			nodes[index].toTrack = TrackNone;
+			if (nodes.size() > words * BitsPerWord)
+			{
+				++words;
+				for (auto& node : nodes)
+				{
+					node.conflicts.resize(words, 0);
+				}
+				for (auto& routesOfElement : users)
+				{
+					routesOfElement.second.resize(words, 0);
+				}
+				held.resize(words, 0);
+			}
+			nodes[index].conflicts.resize(words, 0);
+		}
+		nodes[index].routeID = routeID;
+		indices[routeID] = index;
+		return index;
+	}
+
+	void RouteGraph::RemoveConflictsUnlocked(const size_t index)
+	{
+		Node& node = nodes[index];
+		for (auto element : node.elements)
+		{
+			auto routesOfElement = users.find(element);
+			if (routesOfElement == users.end())
+			{
+				continue;
+			}
+			ClearBit(routesOfElement->second, index);
+			if (IsEmpty(routesOfElement->second))
+			{
+				users.erase(routesOfElement);
+			}
+		}
+		node.elements.clear();
+
+		for (size_t word = 0; word < words; ++word)
+		{
+			uint64_t bits = node.conflicts[word];
+			while (bits)
+			{
+				ClearBit(nodes[word * BitsPerWord + __builtin_ctzll(bits)].conflicts, index);
+				bits &= bits - 1;
+			}
+			node.conflicts[word] = 0;
+		}
+	}
+
+	bool RouteGraph::ConflictsWithOtherLocoBaseUnlocked(const size_t index, const ObjectIdentifier& locoBaseIdentifier) const
+	{
+		const Node& node = nodes[index];
+		if (node.locoBase.IsSet() && node.locoBase != locoBaseIdentifier)
+		{
+			return true;
+		}
+		for (size_t word = 0; word < words; ++word)
+		{
+			uint64_t bits = node.conflicts[word] & held[word];
+			while (bits)
+			{
+				if (nodes[word * BitsPerWord + __builtin_ctzll(bits)].locoBase != locoBaseIdentifier)
+				{
+					return true;
+				}
+				bits &= bits - 1;
+			}
+		}
+		return false;
+	}
+
+	void RouteGraph::RemoveFromTrackList(std::map<TrackID,vector<size_t>>& tracks, const TrackID trackID, const size_t index)
+	{
+		auto track = tracks.find(trackID);
+		if (track == tracks.end())
+		{
+			return;
+		}
+		vector<size_t>& indicesOfTrack = track->second;
+		indicesOfTrack.erase(std::remove(indicesOfTrack.begin(), indicesOfTrack.end(), index), indicesOfTrack.end());
+		if (indicesOfTrack.empty())
+		{
+			tracks.erase(track);
+		}
+	}
+
+	RouteGraph::Cost RouteGraph::RouteCostUnlocked(const size_t index, const ObjectIdentifier& locoBaseIdentifier, const time_t now) const
+	{
+		Cost cost = CostRoute;
+		const Route* route = nodes[index].route;
+		if (route && route->GetLastUsed() + RecentlyUsed > now)
+		{
+			cost += CostRecentlyUsed;
+		}
+		if (ConflictsWithOtherLocoBaseUnlocked(index, locoBaseIdentifier))
+		{
+			cost += CostOccupied;
+		}
+		return cost;
+	}
+
+	void RouteGraph::CostsToDestinationUnlocked(const ObjectIdentifier& locoBaseIdentifier,
+		const TrackID destination,
+		const std::function<Cost(const TrackID)>& cachedTrackCost,
+		std::map<TrackID,Cost>& costs) const
+	{
+		// Dijkstra backwards from the destination over the routes ending at each track
+		typedef std::pair<Cost,TrackID> QueueEntry;
+		std::priority_queue<QueueEntry,vector<QueueEntry>,std::greater<QueueEntry>> queue;
+		const time_t now = std::time(nullptr);
+		costs[destination] = 0;
+		queue.push(QueueEntry(0, destination));
+		while (!queue.empty())
+		{
+			const QueueEntry entry = queue.top();
+			queue.pop();
+			const Cost costOfTrack = entry.first;
+			const TrackID trackID = entry.second;
+			if (costs[trackID] < costOfTrack)
+			{
+				continue;
+			}
+			auto routesTo = routesToTrack.find(trackID);
+			if (routesTo == routesToTrack.end())
+			{
+				continue;
+			}
+			const Cost enterCost = Add(costOfTrack, cachedTrackCost(trackID));
+			for (auto index : routesTo->second)
+			{
+				const Cost cost = Add(enterCost, RouteCostUnlocked(index, locoBaseIdentifier, now));
+				if (cost == CostUnreachable)
+				{
+					continue;
+				}
+				const TrackID fromTrack = nodes[index].fromTrack;
+				auto known = costs.find(fromTrack);
+				if (known != costs.end() && known->second <= cost)
+				{
+					continue;
+				}
+				costs[fromTrack] = cost;
+				queue.push(QueueEntry(cost, fromTrack));
+			}
+		}
+	}
+
+	RouteGraph::Cost RouteGraph::LookAheadCostUnlocked(const ObjectIdentifier& locoBaseIdentifier,
+		const TrackID trackID,
+		const unsigned int routesLeft,
+		const std::function<Cost(const TrackID)>& cachedTrackCost,
+		std::map<std::pair<TrackID,unsigned int>,Cost>& costs) const
+	{
+		if (routesLeft == 0)
+		{
+			return 0;
+		}
+		auto routesFrom = routesFromTrack.find(trackID);
+		if (routesFrom == routesFromTrack.end())
+		{
+			// the end of the line is not a dead lock
+			return 0;
+		}
+		const std::pair<TrackID,unsigned int> key(trackID, routesLeft);
+		auto known = costs.find(key);
+		if (known != costs.end())
+		{
+			return known->second;
+		}
+		const time_t now = std::time(nullptr);
+		Cost cheapest = CostUnreachable;
+		for (auto index : routesFrom->second)
+		{
+			const TrackID toTrack = nodes[index].toTrack;
+			Cost cost = Add(RouteCostUnlocked(index, locoBaseIdentifier, now), cachedTrackCost(toTrack));
+			if (cost >= cheapest)
+			{
+				continue;
+			}
+			cost = Add(cost, LookAheadCostUnlocked(locoBaseIdentifier, toTrack, routesLeft - 1, cachedTrackCost, costs));
+			if (cost < cheapest)
+			{
+				cheapest = cost;
+			}
+		}
+		if (cheapest == CostUnreachable)
+		{
+			cheapest = CostOccupied;
+		}
+		costs[key] = cheapest;
+		return cheapest;
+	}
+} // namespace DataModel
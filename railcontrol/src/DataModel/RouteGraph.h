@@ -0,0 +1,167 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <climits>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "DataModel/ObjectIdentifier.h"
+#include "DataTypes.h"
+
+namespace DataModel
+{
+	class Route;
+
+	// Keeps a conflict matrix of all routes: two routes conflict if they lock
+	// the same track, switch, signal, accessory or route.
+	// Every route has a dense index and one bitset row with all routes it conflicts with,
+	// so the candidates that can not be reserved are found with a few word operations.
+	// The automode routes also form a graph of tracks that is used to plan paths over several routes.
+	class RouteGraph
+	{
+		public:
+			typedef unsigned int Cost;
+
+			static const Cost CostUnreachable = UINT_MAX;
+			static const Cost CostRoute = 10;
+			static const Cost CostRecentlyUsed = 20;
+			static const Cost CostOccupied = 1000;
+			static const unsigned int LookAheadRoutes = 3;
+
+			// returns the cost of entering a track or CostUnreachable
+			typedef std::function<Cost(const TrackID trackID)> TrackCost;
+
+			RouteGraph(const RouteGraph&) = delete;
+			RouteGraph& operator=(const RouteGraph&) = delete;
+
+			RouteGraph();
+
+			// adds the route or replaces the elements it locks, only its own row and column are recalculated
+			void Update(const Route* const route);
+
+			void Remove(const RouteID routeID);
+
+			// the route has been reserved by locoBaseIdentifier, or released if locoBaseIdentifier is not set
+			void SetLocoBase(const RouteID routeID, const ObjectIdentifier& locoBaseIdentifier);
+
+			// removes the routes that are held by another loco or conflict with a route held by another loco,
+			// the order of the remaining routes is kept
+			void RemoveConflicting(const ObjectIdentifier& locoBaseIdentifier, std::vector<Route*>& routes) const;
+
+			// sorts the routes by the cost of the cheapest path to destination with Dijkstra and removes
+			// the routes that can not reach it. Without destination the next LookAheadRoutes routes
+			// after each route are rated, so routes into tracks whose exits are all blocked come last.
+			// A route costs CostRoute, the cost of its destination track, CostRecentlyUsed if it has
+			// been used within the last RecentlyUsed, and CostOccupied if it conflicts with another loco.
+			void Order(const ObjectIdentifier& locoBaseIdentifier,
+				const TrackID destination,
+				const TrackCost& trackCost,
+				std::vector<Route*>& routes) const;
+
+			// returns one CSV line: routegraph;routes;conflicting pairs;held;filtered;plans
+			std::string GetStatistics() const;
+
+		private:
+			typedef std::vector<uint64_t> Bitset;
+
+			struct Node
+			{
+				RouteID routeID;
+				const Route* route;
+				TrackID fromTrack;
+				TrackID toTrack;
+				std::vector<unsigned long long> elements;
+				Bitset conflicts;
+				ObjectIdentifier locoBase;
+			};
+
+			static const size_t BitsPerWord = 64;
+			static const time_t RecentlyUsed = 60;
+
+			static inline unsigned long long ElementKey(const ObjectType objectType, const ObjectID objectID)
+			{
+				return (static_cast<unsigned long long>(objectType) << 32) | objectID;
+			}
+
+			static void Elements(const Route* const route, std::vector<unsigned long long>& elements);
+
+			static inline void SetBit(Bitset& bitset, const size_t index)
+			{
+				bitset[index / BitsPerWord] |= static_cast<uint64_t>(1) << (index % BitsPerWord);
+			}
+
+			static inline void ClearBit(Bitset& bitset, const size_t index)
+			{
+				bitset[index / BitsPerWord] &= ~(static_cast<uint64_t>(1) << (index % BitsPerWord));
+			}
+
+			static bool IsEmpty(const Bitset& bitset);
+
+			size_t AddIndexUnlocked(const RouteID routeID);
+
+			void RemoveConflictsUnlocked(const size_t index);
+
+			bool ConflictsWithOtherLocoBaseUnlocked(const size_t index, const ObjectIdentifier& locoBaseIdentifier) const;
+
+			static void RemoveFromTrackList(std::map<TrackID,std::vector<size_t>>& tracks, const TrackID trackID, const size_t index);
+
+			static inline Cost Add(const Cost cost1, const Cost cost2)
+			{
+				return (cost1 >= CostUnreachable - cost2) ? CostUnreachable : cost1 + cost2;
+			}
+
+			// cost of using the route without the cost of its destination track
+			Cost RouteCostUnlocked(const size_t index, const ObjectIdentifier& locoBaseIdentifier, const time_t now) const;
+
+			// cheapest costs of all tracks to reach destination
+			void CostsToDestinationUnlocked(const ObjectIdentifier& locoBaseIdentifier,
+				const TrackID destination,
+				const std::function<Cost(const TrackID)>& cachedTrackCost,
+				std::map<TrackID,Cost>& costs) const;
+
+			// cheapest cost of the next routes from trackID
+			Cost LookAheadCostUnlocked(const ObjectIdentifier& locoBaseIdentifier,
+				const TrackID trackID,
+				const unsigned int routesLeft,
+				const std::function<Cost(const TrackID)>& cachedTrackCost,
+				std::map<std::pair<TrackID,unsigned int>,Cost>& costs) const;
+
+			mutable std::mutex mutex;
+			std::map<RouteID,size_t> indices;
+			std::vector<Node> nodes;
+			std::vector<size_t> freeIndices;
+			// for every locked element the routes that lock it
+			std::map<unsigned long long,Bitset> users;
+			// the automode routes starting and ending at each track
+			std::map<TrackID,std::vector<size_t>> routesFromTrack;
+			std::map<TrackID,std::vector<size_t>> routesToTrack;
+			Bitset held;
+			size_t words;
+			mutable unsigned long long filtered;
+			mutable unsigned long long plans;
+	};
+} // namespace DataModel
@@ -18,35 +18,245 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
-#include <deque>
+#include <cstdint>
+#include <cstring>
 
 #include "DataModel/Serializable.h"
-#include "Utils/Utils.h"
 
-using std::deque;
-using std::string;
 using std::map;
+using std::string;
 
 namespace DataModel
 {
+	namespace
+	{
+		// keys of binary version 1, never change the order, only append
+		const char* const Keys[] =
+		{
+			"address", "allowlocoturn", "automode", "blocked", "bus", "controlID", "counter", "creepdelay",
+			"creepingspeed", "data", "delay", "device", "displayname", "duration", "feedbackIdCreep", "feedbackIdOver",
+			"feedbackIdReduced", "feedbackIdStop", "feedbacktype", "followuproute", "fromTrack", "fromorientation", "functions", "height",
+			"inverted", "lastused", "length", "lockstate", "locobaseid", "locobasetype", "locodelayed", "locoorientation",
+			"locotypedelayed", "main", "matchkey", "max", "maxspeed", "maxtrainlength", "min", "mintrainlength",
+			"name", "objectID", "objectID1", "objectID2", "objectType", "objectType1", "objectType2", "orientation",
+			"pin", "port", "posX", "posY", "posZ", "priority", "propulsion", "protocol",
+			"pushpull", "reduceddelay", "reducedspeed", "releasewhenfree", "rotation", "route", "selectrouteapproach", "serveraddress",
+			"showname", "speed", "state", "stopdelay", "toTrack", "toorientation", "track", "trackstate",
+			"trackstatedelayed", "tracktype", "traintype", "travelspeed", "type", "visible", "waitafterrelease", "width"
+		};
+		const size_t NumberOfKeys = sizeof(Keys) / sizeof(Keys[0]);
+
+		void AppendVarint(string& output, uint64_t value)
+		{
+			while (value >= 0x80)
+			{
+				output.push_back(static_cast<char>((value & 0x7F) | 0x80));
+				value >>= 7;
+			}
+			output.push_back(static_cast<char>(value));
+		}
+
+		bool ReadVarint(const string& input, size_t& position, uint64_t& value)
+		{
+			value = 0;
+			for (unsigned char shift = 0; shift < 64 && position < input.size(); shift += 7)
+			{
+				const unsigned char byte = static_cast<unsigned char>(input[position++]);
+				value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void AppendString(string& output, const char* data, const size_t length)
+		{
+			AppendVarint(output, length);
+			output.append(data, length);
+		}
+
+		bool ReadString(const string& input, size_t& position, string& output)
+		{
+			uint64_t length;
+			if (!ReadVarint(input, position, length) || length > input.size() - position)
+			{
+				return false;
+			}
+			output.assign(input, position, length);
+			position += length;
+			return true;
+		}
+
+		// only values that are converted back to exactly the same text are stored as integer
+		bool IsCanonicalInteger(const char* data, const size_t length, int64_t& value)
+		{
+			size_t position = (length > 0 && data[0] == '-') ? 1 : 0;
+			const size_t digits = length - position;
+			if (digits == 0 || digits > 18 || (digits > 1 && data[position] == '0') || (position == 1 && data[1] == '0'))
+			{
+				return false;
+			}
+			value = 0;
+			for (; position < length; ++position)
+			{
+				if (data[position] < '0' || data[position] > '9')
+				{
+					return false;
+				}
+				value = value * 10 + (data[position] - '0');
+			}
+			if (data[0] == '-')
+			{
+				value = -value;
+			}
+			return true;
+		}
+
+		// returns the position in Keys plus one or zero if the key is not known
+		size_t KeyIndex(const char* data, const size_t length)
+		{
+			static const map<string,size_t> keyIndexes = []()
+			{
+				map<string,size_t> indexes;
+				for (size_t index = 0; index < NumberOfKeys; ++index)
+				{
+					indexes[Keys[index]] = index + 1;
+				}
+				return indexes;
+			}();
+			auto keyIndex = keyIndexes.find(string(data, length));
+			return keyIndex == keyIndexes.end() ? 0 : keyIndex->second;
+		}
+
+		// calls function(key, keyLength, value, valueLength) for every argument of a text record
+		template<typename Function>
+		void ForEachTextArgument(const string& serialized, Function function)
+		{
+			const char* data = serialized.data();
+			const size_t size = serialized.size();
+			size_t start = 0;
+			while (start < size)
+			{
+				const char* partEnd = static_cast<const char*>(memchr(data + start, ';', size - start));
+				const size_t end = partEnd ? partEnd - data : size;
+				const char* equal = static_cast<const char*>(memchr(data + start, '=', end - start));
+				if (equal)
+				{
+					const size_t keyEnd = equal - data;
+					// like splitting at every '=', the value ends at a second '='
+					const char* valueEnd = static_cast<const char*>(memchr(equal + 1, '=', end - keyEnd - 1));
+					const size_t valueLength = (valueEnd ? valueEnd - data : end) - keyEnd - 1;
+					function(data + start, keyEnd - start, equal + 1, valueLength);
+				}
+				start = end + 1;
+			}
+		}
+	}
+
+	string Serializable::ToBinary(const string& serialized)
+	{
+		if (IsBinary(serialized))
+		{
+			return serialized;
+		}
+		string output;
+		output.reserve(serialized.size() / 2);
+		output.push_back(BinaryMarker);
+		output.push_back(static_cast<char>(BinaryVersion));
+		ForEachTextArgument(serialized,
+			[&output](const char* key, const size_t keyLength, const char* value, const size_t valueLength)
+			{
+				const size_t keyIndex = KeyIndex(key, keyLength);
+				int64_t integer;
+				const bool isInteger = IsCanonicalInteger(value, valueLength, integer);
+				AppendVarint(output, (keyIndex << 1) | (isInteger ? 1 : 0));
+				if (keyIndex == 0)
+				{
+					AppendString(output, key, keyLength);
+				}
+				if (isInteger)
+				{
+					// zigzag encoding keeps small negative numbers short
+					AppendVarint(output, (static_cast<uint64_t>(integer) << 1) ^ static_cast<uint64_t>(integer >> 63));
+					return;
+				}
+				AppendString(output, value, valueLength);
+			});
+		return output;
+	}
+
 	void Serializable::ParseArguments(const string& serialized, map<string, string>& arguments)
 	{
-		deque<string> parts;
-		Utils::Utils::SplitString(serialized, ";", parts);
-		for (auto& part : parts)
+		if (IsBinary(serialized))
+		{
+			ParseBinary(serialized, arguments);
+			return;
+		}
+		ParseText(serialized, arguments);
+	}
+
+	void Serializable::ParseText(const string& serialized, map<string, string>& arguments)
+	{
+		ForEachTextArgument(serialized,
+			[&arguments](const char* key, const size_t keyLength, const char* value, const size_t valueLength)
+			{
+				if (keyLength == 0 && valueLength == 0)
+				{
+					return;
+				}
+				arguments[string(key, keyLength)].assign(value, valueLength);
+			});
+	}
+
+	void Serializable::ParseBinary(const string& serialized, map<string, string>& arguments)
+	{
+		if (static_cast<unsigned char>(serialized[1]) > BinaryVersion)
 		{
-			if (part.length() == 0)
+			return;
+		}
+		size_t position = 2;
+		string key;
+		while (position < serialized.size())
+		{
+			uint64_t header;
+			if (!ReadVarint(serialized, position, header))
 			{
-				continue;
+				return;
 			}
-			deque<string> keyValue;
-			Utils::Utils::SplitString(part, "=", keyValue);
-			if (keyValue.size() < 2)
+			const uint64_t keyIndex = header >> 1;
+			if (keyIndex > NumberOfKeys)
 			{
+				return;
+			}
+			if (keyIndex == 0)
+			{
+				if (!ReadString(serialized, position, key))
+				{
+					return;
+				}
+			}
+			else
+			{
+				key = Keys[keyIndex - 1];
+			}
+
+			string& value = arguments[std::move(key)];
+			if ((header & 1) == 0)
+			{
+				if (!ReadString(serialized, position, value))
+				{
+					return;
+				}
 				continue;
 			}
-			string value = keyValue[1];
-			arguments[keyValue[0]] = value;
+			uint64_t zigzag;
+			if (!ReadVarint(serialized, position, zigzag))
+			{
+				return;
+			}
+			value = std::to_string(static_cast<int64_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1)));
 		}
 	}
 }
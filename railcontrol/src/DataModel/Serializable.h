@@ -25,6 +25,8 @@ along with RailControl; see the file LICENCE. If not see
 
 namespace DataModel
 {
+	// Objects are serialized as text "key1=value1;key2=value2".
+	// For storage the text can be converted to a compact binary record, ParseArguments reads both.
 	class Serializable
 	{
 		public:
@@ -32,7 +34,23 @@ namespace DataModel
 			virtual std::string Serialize() const = 0;
 			virtual void Deserialize(const std::string& serialized) = 0;
 
+			static const unsigned char BinaryVersion = 1;
+
+			static std::string ToBinary(const std::string& serialized);
+
+			static inline bool IsBinary(const std::string& serialized)
+			{
+				return serialized.size() >= 2 && serialized[0] == BinaryMarker;
+			}
+
 		protected:
 			static void ParseArguments(const std::string& serialized, std::map<std::string,std::string>& arguments);
+
+		private:
+			// text records always start with a key, so a control character can not be mistaken
+			static const char BinaryMarker = 0x01;
+
+			static void ParseText(const std::string& serialized, std::map<std::string,std::string>& arguments);
+			static void ParseBinary(const std::string& serialized, std::map<std::string,std::string>& arguments);
 	};
 } // namespace DataModel
@@ -338,8 +338,11 @@ namespace DataModel
 		return ret;
 	}
 
-	bool Track::SetFeedbackState(const FeedbackID feedbackID, const DataModel::Feedback::FeedbackState newTrackState)
+	bool Track::SetFeedbackState(const FeedbackID feedbackID,
+		const DataModel::Feedback::FeedbackState newTrackState,
+		const std::chrono::steady_clock::time_point timestamp)
 	{
+		manager->FeedbackReachedTrack(timestamp);
 		{
 			std::lock_guard<std::mutex> Guard(updateMutex);
 			const DataModel::Feedback::FeedbackState oldTrackState = this->trackState;
@@ -354,6 +357,10 @@ namespace DataModel
 				return true;
 			}
 		}
+		if (newTrackState == DataModel::Feedback::FeedbackStateFree)
+		{
+			manager->AutoModeWakeup(GetObjectIdentifier());
+		}
 		PublishState();
 		return true;
 	}
@@ -495,11 +502,11 @@ namespace DataModel
 				}
 			}
 		}
-		OrderValidRoutes(validRoutes);
+		OrderValidRoutes(loco, validRoutes);
 		return true;
 	}
 
-	void Track::OrderValidRoutes(vector<Route*>& validRoutes) const
+	void Track::OrderValidRoutes(const LocoBase* loco, vector<Route*>& validRoutes) const
 	{
 		switch (GetSelectRouteApproachCalculated())
 		{
@@ -520,6 +527,10 @@ namespace DataModel
 				std::sort(validRoutes.begin(), validRoutes.end(), Route::CompareLastUsed);
 				return;
 
+			case SelectRoutePlannedPath:
+				manager->RouteGraphOrder(loco->GetObjectIdentifier(), TrackNone, validRoutes);
+				return;
+
 			case SelectRouteDoNotCare:
 			default:
 				// do nothing
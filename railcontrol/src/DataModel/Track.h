@@ -20,6 +20,7 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <chrono>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -59,7 +60,8 @@ namespace DataModel
 		SelectRouteDoNotCare = 1,
 		SelectRouteRandom = 2,
 		SelectRouteMinTrackLength = 3,
-		SelectRouteLongestUnused = 4
+		SelectRouteLongestUnused = 4,
+		SelectRoutePlannedPath = 5
 	};
 
 	class Track : public LayoutItem, public LockableItem
@@ -125,7 +127,10 @@ namespace DataModel
 				this->trackType = type;
 			}
 
-			bool SetFeedbackState(const FeedbackID feedbackID, const DataModel::Feedback::FeedbackState state);
+			// timestamp is the time the hardware has reported the state, before the delays of the feedback
+			bool SetFeedbackState(const FeedbackID feedbackID,
+				const DataModel::Feedback::FeedbackState state,
+				const std::chrono::steady_clock::time_point timestamp);
 
 			inline DataModel::Feedback::FeedbackState GetStateDelayed() const
 			{
@@ -344,7 +349,7 @@ namespace DataModel
 			void StopAllSignals(const ObjectIdentifier& locoBaseIdentifier);
 
 			bool FeedbackStateInternal(const FeedbackID feedbackID, const DataModel::Feedback::FeedbackState state);
-			void OrderValidRoutes(std::vector<DataModel::Route*>& validRoutes) const;
+			void OrderValidRoutes(const LocoBase* loco, std::vector<DataModel::Route*>& validRoutes) const;
 			SelectRouteApproach GetSelectRouteApproachCalculated() const;
 			bool ReleaseForceUnlocked(Logger::Logger* logger, const ObjectIdentifier& locoBaseIdentifier);
 
@@ -196,7 +196,8 @@ enum ArgumentType : uint8_t
 	ArgumentTypeIpAddress = 1,
 	ArgumentTypeSerialPort = 2,
 	ArgumentTypeS88Modules = 3,
-	ArgumentTypeMainSecundary = 4
+	ArgumentTypeMainSecundary = 4,
+	ArgumentTypeSimulationSpeed = 5
 };
 
 enum HardwareType : uint8_t
@@ -225,7 +226,8 @@ enum HardwareType : uint8_t
 	HardwareTypeIntellibox2 = 21,
 	HardwareTypeLocoNetAdapter63120 = 22,
 	HardwareTypeLocoNetAdapter63820 = 23,
-	HardwareTypeSystemControl7 = 24
+	HardwareTypeSystemControl7 = 24,
+	HardwareTypeSimulator = 25
 };
 
 enum Automode : bool
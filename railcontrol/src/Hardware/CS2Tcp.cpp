@@ -27,7 +27,7 @@ namespace Hardware
 	:	MaerklinCAN(params,
 			"Maerklin Central Station 2 (CS2) TCP / " + params->GetName() + " at IP " + params->GetArg1(),
 			params->GetName()),
-		connection(Network::TcpClient::GetTcpClientConnection(HardwareInterface::logger, params->GetArg1(), CS2Port))
+		connection(Network::TcpClient::GetTcpClientConnection(HardwareInterface::logger, params->GetArg1(), CS2Port, &capture))
 	{
 		HardwareInterface::logger->Info(Languages::TextStarting, GetFullName());
 
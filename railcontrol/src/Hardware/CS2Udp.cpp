@@ -27,8 +27,8 @@ namespace Hardware
 	:	MaerklinCAN(params,
 			"Maerklin Central Station 2 (CS2) UDP / " + params->GetName() + " at IP " + params->GetArg1(),
 			params->GetName()),
-		senderConnection(HardwareInterface::logger, params->GetArg1(), CS2SenderPort),
-		receiverConnection(HardwareInterface::logger, "0.0.0.0", CS2ReceiverPort)
+		senderConnection(HardwareInterface::logger, params->GetArg1(), CS2SenderPort, &capture),
+		receiverConnection(HardwareInterface::logger, "0.0.0.0", CS2ReceiverPort, &capture)
 	{
 		HardwareInterface::logger->Info(Languages::TextStarting, GetFullName());
 
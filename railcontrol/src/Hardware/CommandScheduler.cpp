@@ -0,0 +1,188 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "Hardware/CommandScheduler.h"
+#include "Utils/Utils.h"
+
+using std::string;
+using std::to_string;
+
+namespace Hardware
+{
+	const std::chrono::milliseconds CommandScheduler::PaceInterval(5);
+
+	CommandScheduler::CommandScheduler(const ControlID controlID, const std::function<size_t()>& pendingCommands)
+	:	controlID(controlID),
+		pendingCommands(pendingCommands),
+		run(true),
+		sending(false),
+		maxDepth(0),
+		posted(0),
+		dropped(0),
+		paced(0),
+		senderThread(&CommandScheduler::Worker, this)
+	{
+	}
+
+	CommandScheduler::~CommandScheduler()
+	{
+		Terminate();
+	}
+
+	void CommandScheduler::Post(const unsigned long long address,
+		const unsigned int kind,
+		const std::function<void()>& command)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!run)
+		{
+			return;
+		}
+		++posted;
+		if (!queue.Push(address, kind, command))
+		{
+			// the replaced command has become stale before it reached the bus
+			++dropped;
+			return;
+		}
+		const size_t depth = queue.GetSize();
+		if (depth > maxDepth)
+		{
+			maxDepth = depth;
+		}
+		cv.notify_one();
+	}
+
+	void CommandScheduler::PostUrgent(const std::function<void()>& command)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!run)
+		{
+			return;
+		}
+		++posted;
+		queue.PushUrgent(command);
+		cv.notify_one();
+	}
+
+	void CommandScheduler::PostUrgent(const unsigned long long address,
+		const unsigned int kind,
+		const std::function<void()>& command)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!run)
+		{
+			return;
+		}
+		++posted;
+		queue.PushUrgent(address, kind, command);
+		cv.notify_one();
+	}
+
+	void CommandScheduler::Flush()
+	{
+		if (std::this_thread::get_id() == senderThread.get_id())
+		{
+			return;
+		}
+		std::unique_lock<std::mutex> lock(mutex);
+		const unsigned long long waitFor = queue.GetSequence();
+		sentCv.wait(lock, [this, waitFor] { return queue.IsPoppedUpTo(waitFor) && !sending; });
+	}
+
+	void CommandScheduler::Terminate()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			run = false;
+			cv.notify_one();
+		}
+		if (!senderThread.joinable())
+		{
+			return;
+		}
+		if (std::this_thread::get_id() == senderThread.get_id())
+		{
+			senderThread.detach();
+			return;
+		}
+		senderThread.join();
+	}
+
+	string CommandScheduler::GetStatistics() const
+	{
+		string statistics;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			statistics = "hardwarequeue;" + to_string(controlID)
+				+ ";" + to_string(queue.GetSize())
+				+ ";" + to_string(maxDepth)
+				+ ";" + to_string(posted)
+				+ ";" + to_string(dropped)
+				+ ";" + to_string(paced)
+				+ "\n";
+		}
+		return statistics + latency.ToCsv("hardwarelatency;" + to_string(controlID));
+	}
+
+	void CommandScheduler::Worker()
+	{
+		Utils::Utils::SetThreadName("Commands " + to_string(controlID));
+		std::unique_lock<std::mutex> lock(mutex);
+		bool waitedForBus = false;
+		while (true)
+		{
+			if (queue.IsEmpty())
+			{
+				if (!run)
+				{
+					return;
+				}
+				cv.wait(lock);
+				continue;
+			}
+
+			// the bus is still busy with earlier commands, newer values may still replace the waiting ones
+			if (run && !queue.HasUrgent() && pendingCommands() > 0)
+			{
+				waitedForBus = true;
+				cv.wait_for(lock, PaceInterval);
+				continue;
+			}
+			if (waitedForBus)
+			{
+				++paced;
+				waitedForBus = false;
+			}
+
+			Utils::CoalescingQueue::Entry entry;
+			queue.Pop(entry);
+			sending = true;
+			lock.unlock();
+
+			entry.call();
+			latency.Add(entry.posted);
+
+			lock.lock();
+			sending = false;
+			sentCv.notify_all();
+		}
+	}
+} // namespace Hardware
@@ -0,0 +1,105 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "DataTypes.h"
+#include "Utils/CoalescingQueue.h"
+#include "Utils/LatencyHistogram.h"
+
+namespace Hardware
+{
+	// Sends the loco commands of one hardware on its own thread.
+	// Only the latest speed, orientation and function state of an address is kept while waiting,
+	// and a new command is only sent when the hardware has no more commands waiting for the bus.
+	// Booster commands and loco stops are sent before all waiting loco commands.
+	// Only hardware that reports its waiting commands (so far LocoNet) is paced, all others get every command immediately.
+	class CommandScheduler
+	{
+		public:
+			enum CommandKind : unsigned int
+			{
+				CommandKindSpeed = 0,
+				CommandKindOrientation,
+				CommandKindAll,
+				CommandKindFunction // + function number
+			};
+
+			CommandScheduler(const CommandScheduler&) = delete;
+			CommandScheduler& operator=(const CommandScheduler&) = delete;
+
+			// pendingCommands returns how many commands are still waiting inside the hardware
+			CommandScheduler(const ControlID controlID, const std::function<size_t()>& pendingCommands);
+			~CommandScheduler();
+
+			static inline unsigned long long AddressKey(const Protocol protocol, const Address address)
+			{
+				return (static_cast<unsigned long long>(protocol) << 32) | address;
+			}
+
+			void Post(const unsigned long long address,
+				const unsigned int kind,
+				const std::function<void()>& command);
+
+			void PostUrgent(const std::function<void()>& command);
+
+			// sent before all waiting commands, waiting commands of the same address and kind are replaced by it
+			void PostUrgent(const unsigned long long address,
+				const unsigned int kind,
+				const std::function<void()>& command);
+
+			// blocks until all waiting commands have been sent
+			void Flush();
+
+			// sends all waiting commands and stops the thread
+			void Terminate();
+
+			// returns one CSV line: hardwarequeue;controlID;depth;max depth;posted;dropped;paced
+			// followed by the latency histogram from posting to sending
+			std::string GetStatistics() const;
+
+		private:
+			static const std::chrono::milliseconds PaceInterval;
+
+			void Worker();
+
+			const ControlID controlID;
+			const std::function<size_t()> pendingCommands;
+			Utils::CoalescingQueue queue;
+			mutable std::mutex mutex;
+			std::condition_variable cv;
+			std::condition_variable sentCv;
+			bool run;
+			bool sending;
+			size_t maxDepth;
+			unsigned long long posted;
+			unsigned long long dropped;
+			unsigned long long paced;
+			Utils::LatencyHistogram latency;
+			std::thread senderThread;
+	};
+} // namespace Hardware
@@ -33,7 +33,7 @@ namespace Hardware
 #else
 			true
 #endif
-			)
+			, &capture)
 	{
 		logger->Info(Languages::TextStarting, GetFullName());
 		Init();
@@ -43,6 +43,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "Hardware/OpenDcc.h"
 #include "Hardware/RedBox.h"
 #include "Hardware/Rektor.h"
+#include "Hardware/Simulator.h"
 #include "Hardware/SystemControl7.h"
 #include "Hardware/TwinCenter.h"
 #include "Hardware/Virtual.h"
@@ -62,108 +63,103 @@ namespace Hardware
 			return;
 		}
 
+		HardwareInterface* newInstance = CreateInstance(params);
+		std::lock_guard<std::mutex> lock(instanceMutex);
+		instance = newInstance;
+	}
+
+	HardwareInterface* HardwareHandler::CreateInstance(const HardwareParams* params)
+	{
 		const HardwareType type = params->GetHardwareType();
 		switch(type)
 		{
 			case HardwareTypeVirtual:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new Virtual(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new Virtual(params));
 
 			case HardwareTypeCS2Udp:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new CS2Udp(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new CS2Udp(params));
 
 			case HardwareTypeM6051:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new M6051(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new M6051(params));
 
 			case HardwareTypeOpenDcc:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new OpenDcc(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new OpenDcc(params));
 
 			case HardwareTypeHsi88:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new Hsi88(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new Hsi88(params));
 
 			case HardwareTypeZ21:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new Z21(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new Z21(params));
 
 			case HardwareTypeCcSchnitte:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new CcSchnitte(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new CcSchnitte(params));
 
 			case HardwareTypeEcos:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new Ecos(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new Ecos(params));
 
 			case HardwareTypeCS2Tcp:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new CS2Tcp(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new CS2Tcp(params));
 
 			case HardwareTypeIntellibox:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new Intellibox(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new Intellibox(params));
 
 			case HardwareTypeMasterControl:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new MasterControl(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new MasterControl(params));
 
 			case HardwareTypeTwinCenter:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new TwinCenter(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new TwinCenter(params));
 
 			case HardwareTypeMasterControl2:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new MasterControl2(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new MasterControl2(params));
 
 			case HardwareTypeRedBox:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new RedBox(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new RedBox(params));
 
 			case HardwareTypeRektor:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new Rektor(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new Rektor(params));
 
 			case HardwareTypeDR5000:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new DR5000(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new DR5000(params));
 
 			case HardwareTypeCS1:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new CS1(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new CS1(params));
 
 			case HardwareTypeDccPpExTcp:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new DccPpExTcp(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new DccPpExTcp(params));
 
 			case HardwareTypeDccPpExSerial:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new DccPpExSerial(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new DccPpExSerial(params));
 
 			case HardwareTypeIntellibox2:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new Intellibox2(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new Intellibox2(params));
 
 			case HardwareTypeLocoNetAdapter63120:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new LocoNetAdapter63120(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new LocoNetAdapter63120(params));
 
 			case HardwareTypeLocoNetAdapter63820:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new LocoNetAdapter63820(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new LocoNetAdapter63820(params));
 
 			case HardwareTypeSystemControl7:
-				instance = reinterpret_cast<Hardware::HardwareInterface*>(new SystemControl7(params));
-				return;
+				return reinterpret_cast<Hardware::HardwareInterface*>(new SystemControl7(params));
+
+			case HardwareTypeSimulator:
+				return reinterpret_cast<Hardware::HardwareInterface*>(new Simulator(params));
 
 			case HardwareTypeNone:
 			default:
-				instance = nullptr;
-				return;
+				return nullptr;
 		}
 	}
 
+	HardwareInterface* HardwareHandler::ReleaseInstance()
+	{
+		// a command of the scheduler or a timer still using the instance holds the lock until it is done
+		std::lock_guard<std::mutex> lock(instanceMutex);
+		HardwareInterface* oldInstance = instance;
+		instance = nullptr;
+		return oldInstance;
+	}
+
 	void HardwareHandler::Close()
 	{
 		if (!instance)
@@ -171,8 +167,8 @@ namespace Hardware
 			return;
 		}
 
-		delete(instance);
-		instance = nullptr;
+		params->GetManager()->CancelTimers(this);
+		delete(ReleaseInstance());
 		params = nullptr;
 	}
 
@@ -184,10 +180,7 @@ namespace Hardware
 			{
 				return;
 			}
-			HardwareInterface* oldInstance = instance;
-			instance = nullptr;
-			Utils::Utils::SleepForMilliseconds(1);
-			delete(oldInstance);
+			delete(ReleaseInstance());
 		}
 		Init();
 		Start();
@@ -267,7 +260,15 @@ namespace Hardware
 		{
 			return;
 		}
-		instance->Booster(status);
+		scheduler.PostUrgent(
+			[this, status]()
+			{
+				std::lock_guard<std::mutex> lock(instanceMutex);
+				if (instance)
+				{
+					instance->Booster(status);
+				}
+			});
 	}
 
 	void HardwareHandler::LocoBaseSpeed(const ControlType controlType,
@@ -284,7 +285,27 @@ namespace Hardware
 		{
 			return;
 		}
-		instance->LocoSpeed(protocol, address, speed);
+		const std::function<void()> command =
+			[this, protocol, address, speed]()
+			{
+				std::lock_guard<std::mutex> lock(instanceMutex);
+				if (instance)
+				{
+					instance->LocoSpeed(protocol, address, speed);
+				}
+			};
+		const unsigned long long addressKey = CommandScheduler::AddressKey(protocol, address);
+		// a stop must not wait behind the commands of other locos
+		if (speed == MinSpeed)
+		{
+			{
+				std::lock_guard<std::mutex> lock(stopsMutex);
+				++stops[addressKey];
+			}
+			scheduler.PostUrgent(addressKey, CommandScheduler::CommandKindSpeed, command);
+			return;
+		}
+		scheduler.Post(addressKey, CommandScheduler::CommandKindSpeed, command);
 	}
 
 	void HardwareHandler::LocoBaseOrientation(const ControlType controlType,
@@ -301,7 +322,15 @@ namespace Hardware
 		{
 			return;
 		}
-		instance->LocoOrientation(protocol, address, orientation);
+		scheduler.Post(CommandScheduler::AddressKey(protocol, address), CommandScheduler::CommandKindOrientation,
+			[this, protocol, address, orientation]()
+			{
+				std::lock_guard<std::mutex> lock(instanceMutex);
+				if (instance)
+				{
+					instance->LocoOrientation(protocol, address, orientation);
+				}
+			});
 	}
 
 	void HardwareHandler::LocoBaseFunctionState(const ControlType controlType,
@@ -319,7 +348,15 @@ namespace Hardware
 		{
 			return;
 		}
-		instance->LocoFunctionState(protocol, address, function, state);
+		scheduler.Post(CommandScheduler::AddressKey(protocol, address), CommandScheduler::CommandKindFunction + function,
+			[this, protocol, address, function, state]()
+			{
+				std::lock_guard<std::mutex> lock(instanceMutex);
+				if (instance)
+				{
+					instance->LocoFunctionState(protocol, address, function, state);
+				}
+			});
 	}
 
 	void HardwareHandler::LocoBaseSpeedOrientationFunctionStates(const ControlID controlID,
@@ -337,7 +374,19 @@ namespace Hardware
 		{
 			return;
 		}
-		instance->LocoSpeedOrientationFunctionStates(protocol, address, speed, orientation, functions);
+		const unsigned long long addressKey = CommandScheduler::AddressKey(protocol, address);
+		const unsigned int stopsBefore = GetStops(addressKey);
+		scheduler.Post(addressKey, CommandScheduler::CommandKindAll,
+			[this, protocol, address, addressKey, stopsBefore, speed, orientation, functions]()
+			{
+				// an urgent stop posted after this command has already been sent and must not be undone
+				const Speed sendSpeed = (GetStops(addressKey) == stopsBefore ? speed : MinSpeed);
+				std::lock_guard<std::mutex> lock(instanceMutex);
+				if (instance)
+				{
+					instance->LocoSpeedOrientationFunctionStates(protocol, address, sendSpeed, orientation, functions);
+				}
+			});
 	}
 
 	void HardwareHandler::LocoSettings(const LocoID locoId,
@@ -433,8 +482,16 @@ namespace Hardware
 		const DataModel::AccessoryPulseDuration duration)
 	{
 		instance->Accessory(protocol, address, state, true, duration);
-		std::thread t(AccessoryBaseStateStatic, instance, protocol, address, state, duration);
-		t.detach();
+		params->GetManager()->ScheduleTimer(std::chrono::milliseconds(duration),
+			[this, protocol, address, state]()
+			{
+				std::lock_guard<std::mutex> lock(instanceMutex);
+				if (instance)
+				{
+					instance->Accessory(protocol, address, state, false, 0);
+				}
+			},
+			this);
 	}
 
 	void HardwareHandler::SwitchSettings(const SwitchID switchId,
@@ -934,6 +991,10 @@ namespace Hardware
 			case HardwareTypeSystemControl7:
 				Hardware::SystemControl7::GetArgumentTypesAndHint(arguments, hint);
 				return;
+
+			case HardwareTypeSimulator:
+				Hardware::Simulator::GetArgumentTypesAndHint(arguments, hint);
+				return;
 		}
 	}
 } // namespace Hardware
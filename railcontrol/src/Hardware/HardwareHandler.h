@@ -20,11 +20,14 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <map>
+#include <mutex>
 #include <string>
 
 #include "ControlInterface.h"
 #include "DataModel/LocoFunctions.h"
 #include "DataTypes.h"
+#include "Hardware/CommandScheduler.h"
 #include "Hardware/HardwareInterface.h"
 #include "Hardware/HardwareParams.h"
 #include "Hardware/LocoCache.h"
@@ -42,13 +45,15 @@ namespace Hardware
 			inline HardwareHandler(const HardwareParams* params)
 			:	ControlInterface(ControlTypeHardware),
 				instance(nullptr),
-				params(nullptr)
+				params(nullptr),
+				scheduler(params->GetControlID(), [this]() { return PendingCommands(); })
 			{
 				Init(params);
 			}
 
 			inline ~HardwareHandler()
 			{
+				scheduler.Terminate();
 				Close();
 			}
 
@@ -63,6 +68,7 @@ namespace Hardware
 
 			inline void ReInit(const HardwareParams* params) override
 			{
+				scheduler.Flush();
 				Close();
 				Init(params);
 				Start();
@@ -79,6 +85,13 @@ namespace Hardware
 
 			const std::string& GetShortName() const override;
 
+			inline std::string GetStatistics() const override
+			{
+				const std::string statistics = scheduler.GetStatistics();
+				std::lock_guard<std::mutex> lock(instanceMutex);
+				return statistics + (instance ? instance->GetStatistics() : "");
+			}
+
 			void AccessoryProtocols(std::vector<Protocol>& protocols) const override;
 			bool AccessoryProtocolSupported(Protocol protocol) const override;
 			void AccessoryState(const ControlType controlType, const DataModel::Accessory* accessory) override;
@@ -200,8 +213,14 @@ namespace Hardware
 			static void ArgumentTypesOfHardwareTypeAndHint(const HardwareType hardwareType, std::map<unsigned char,ArgumentType>& arguments, std::string& hint);
 
 		private:
+			// only replaced by the thread of the manager, all other threads have to hold instanceMutex while using it
 			Hardware::HardwareInterface* instance;
+			mutable std::mutex instanceMutex;
 			const HardwareParams* params;
+			// number of urgent stops posted per address
+			std::map<unsigned long long,unsigned int> stops;
+			mutable std::mutex stopsMutex;
+			CommandScheduler scheduler;
 
 			static const std::string Unknown;
 
@@ -213,25 +232,32 @@ namespace Hardware
 
 			void Init();
 
+			static HardwareInterface* CreateInstance(const HardwareParams* params);
+
+			// the caller deletes the returned instance
+			HardwareInterface* ReleaseInstance();
+
 			void Close();
 
+			inline size_t PendingCommands() const
+			{
+				std::lock_guard<std::mutex> lock(instanceMutex);
+				return instance ? instance->GetPendingCommands() : 0;
+			}
+
+			inline unsigned int GetStops(const unsigned long long addressKey) const
+			{
+				std::lock_guard<std::mutex> lock(stopsMutex);
+				auto entry = stops.find(addressKey);
+				return entry == stops.end() ? 0 : entry->second;
+			}
+
 			bool ProgramCheckValues(const ProgramMode mode, const CvNumber cv, const CvValue value = 1);
 
 			void AccessoryBaseState(const Protocol protocol,
 				const Address address,
 				const DataModel::AccessoryState state,
 				const DataModel::AccessoryPulseDuration duration);
-
-			static inline void AccessoryBaseStateStatic(HardwareInterface* instance,
-				const Protocol protocol,
-				const Address address,
-				const DataModel::AccessoryState state,
-				const DataModel::AccessoryPulseDuration duration)
-			{
-				Utils::Utils::SetThreadName("AccessoryBaseStateStatic");
-				Utils::Utils::SleepForMilliseconds(duration);
-				instance->Accessory(protocol, address, state, false, 0);
-			}
 	};
 } // namespace Hardware
 
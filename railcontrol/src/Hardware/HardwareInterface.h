@@ -31,6 +31,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "Hardware/Capabilities.h"
 #include "Hardware/LocoCache.h"
 #include "Manager.h"
+#include "Network/Capture.h"
 #include "Utils/Utils.h"
 
 namespace Hardware
@@ -50,6 +51,10 @@ namespace Hardware
 			:	manager(manager),
 				controlID(controlID),
 				logger(Logger::Logger::GetLogger(shortName)),
+				capture(logger,
+					manager->GetCaptureFileName(controlID),
+					manager->GetReplayFileName(controlID),
+					manager->GetReplaySpeed()),
 				fullName(fullName),
 				shortName(shortName),
 				communicationError(false)
@@ -114,6 +119,19 @@ namespace Hardware
 				return false;
 			}
 
+			// number of commands waiting inside the hardware to be sent,
+			// loco commands are held back and merged as long as this is not 0
+			virtual size_t GetPendingCommands() const
+			{
+				return 0;
+			}
+
+			// CSV lines appended to the statistics of the control
+			virtual std::string GetStatistics() const
+			{
+				return "";
+			}
+
 			// turn booster on or off
 			virtual void Booster(__attribute__((unused)) const BoosterState status)
 			{
@@ -255,6 +273,8 @@ namespace Hardware
 			Manager* const manager;
 			const ControlID controlID;
 			Logger::Logger* const logger;
+			// to be passed to the connections of the hardware
+			Network::Capture capture;
 
 		private:
 			const std::string fullName;
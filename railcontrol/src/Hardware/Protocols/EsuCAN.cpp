@@ -47,7 +47,7 @@ namespace Hardware
 				controlName + " / " + params->GetName() + " at IP " + params->GetArg1(),
 				params->GetName()),
 			run(false),
-			tcp(Network::TcpClient::GetTcpClientConnection(logger, params->GetArg1(), EsuCANPort)),
+			tcp(Network::TcpClient::GetTcpClientConnection(logger, params->GetArg1(), EsuCANPort, &capture)),
 			readBufferLength(0),
 			readBufferPosition(0),
 			locoCache(params->GetControlID(), params->GetManager()),
@@ -36,7 +36,7 @@ namespace Hardware
 				controlName + " / " + params->GetName() + " at serial port " + params->GetArg1(),
 			   params->GetName()),
 			run(true),
-			serialLine(logger, params->GetArg1(), dataSpeed, 8, 'N', 1),
+			serialLine(logger, params->GetArg1(), dataSpeed, 8, 'N', 1, false, &capture),
 			lastCv(0),
 			isProgramming(false)
 		{
@@ -47,7 +47,7 @@ namespace Hardware
 		LocoNet::~LocoNet()
 		{
 			run = false;
-			sendingQueue.EnqueueBack(SendingQueueEntry());
+			sendingQueue.Terminate();
 			senderThread.join();
 			receiverThread.join();
 			logger->Info(Languages::TextTerminatingSenderSocket);
@@ -467,7 +467,11 @@ namespace Hardware
 					}
 				}
 
-				SendingQueueEntry temp = sendingQueue.Dequeue();
+				SendingQueueEntry temp;
+				if (!sendingQueue.Dequeue(temp))
+				{
+					continue;
+				}
 				{
 					std::unique_lock<std::mutex> lock(entryToVerifyMutex);
 					entryToVerify = temp;
@@ -1052,7 +1056,7 @@ namespace Hardware
 			unsigned char buffer[2];
 			buffer[0] = data;
 			CalcCheckSum(buffer, 1, buffer + 1);
-			sendingQueue.EnqueueBack(SendingQueueEntry(sizeof(buffer), buffer));
+			sendingQueue.Enqueue(SendingQueueEntry(sizeof(buffer), buffer));
 		}
 
 		void LocoNet::Send4ByteCommand(const unsigned char data0,
@@ -1064,7 +1068,7 @@ namespace Hardware
 			buffer[1] = data1;
 			buffer[2] = data2;
 			CalcCheckSum(buffer, 3, buffer + 3);
-			sendingQueue.EnqueueBack(SendingQueueEntry(sizeof(buffer), buffer));
+			sendingQueue.Enqueue(SendingQueueEntry(sizeof(buffer), buffer));
 		}
 
 		void LocoNet::Send6ByteCommand(const unsigned char data0,
@@ -1080,14 +1084,14 @@ namespace Hardware
 			buffer[3] = data3;
 			buffer[4] = data4;
 			CalcCheckSum(buffer, 5, buffer + 5);
-			sendingQueue.EnqueueBack(SendingQueueEntry(sizeof(buffer), buffer));
+			sendingQueue.Enqueue(SendingQueueEntry(sizeof(buffer), buffer));
 		}
 
 		void LocoNet::SendXByteCommand(unsigned char* data, unsigned char dataLength)
 		{
 			data[1] = dataLength;
 			CalcCheckSum(data, dataLength - 1, data + dataLength - 1);
-			sendingQueue.EnqueueBack(SendingQueueEntry(dataLength, data));
+			sendingQueue.Enqueue(SendingQueueEntry(dataLength, data));
 		}
 
 		uint8_t LocoNet::SetOrientationF0F4Bit(const unsigned char slot, const bool on, const unsigned char shift)
@@ -28,6 +28,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "Hardware/Protocols/LocoNetLocoCache.h"
 #include "Logger/Logger.h"
 #include "Network/Serial.h"
+#include "Utils/RingQueue.h"
 
 // Protocol specification at https://www.digitrax.com/static/apps/cms/media/documents/loconet/loconetpersonaledition.pdf
 // Programming specification does not fit for Uhlenbrock Intellibox II
@@ -92,6 +93,11 @@ namespace Hardware
 					return (protocol == ProtocolServer);
 				}
 
+				inline size_t GetPendingCommands() const override
+				{
+					return sendingQueue.GetSize();
+				}
+
 				void Booster(const BoosterState status) override;
 
 				void LocoSpeed(const Protocol protocol,
@@ -321,7 +327,7 @@ namespace Hardware
 
 				LocoNetLocoCache locoCache;
 
-				Utils::ThreadSafeQueue<SendingQueueEntry> sendingQueue;
+				Utils::MpscQueue<SendingQueueEntry,256> sendingQueue;
 				SendingQueueEntry entryToVerify;
 				mutable std::mutex entryToVerifyMutex;
 				std::condition_variable entryToVerifyCV;
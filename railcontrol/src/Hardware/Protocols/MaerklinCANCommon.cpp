@@ -35,13 +35,19 @@ namespace Hardware { namespace Protocols
 		run = true;
 		receiverThread = std::thread(&MaerklinCANCommon::ReceiverInternal, this);
 		pingThread = std::thread(&MaerklinCANCommon::PingSender, this);
+		configDataThread = std::thread(&MaerklinCANCommon::ConfigDataSender, this);
 	}
 
 	MaerklinCANCommon::~MaerklinCANCommon()
 	{
 		run = false;
+		{
+			std::lock_guard<std::mutex> guard(configDataMutex);
+		}
+		configDataCondition.notify_all();
 		receiverThread.join();
 		pingThread.join();
+		configDataThread.join();
 		while (canFiles.size())
 		{
 			vector<struct CanFile>::iterator firstCanFile = canFiles.begin();
@@ -428,6 +434,10 @@ namespace Hardware { namespace Protocols
 		CanLength length = ParseLength(buffer);
 		logger->HexIn(buffer, 5 + length);
 		const CanHash receivedHash = ParseHash(buffer);
+		if (configDataActive && ConfigDataFeedback(receivedHash, command, response))
+		{
+			return;
+		}
 		if (receivedHash == hash)
 		{
 			uint16_t deviceType = Utils::Integer::DataBigEndianToShort(buffer + 11);
@@ -620,8 +630,7 @@ namespace Hardware { namespace Protocols
 			&& (buffer[11] == 0x00)
 			&& (buffer[12] == 0x00))
 		{
-			const string dataPlain = manager->GetCs2Lokomotive();
-			SendCompressedFile(dataPlain, buffer + 5);
+			QueueConfigData(buffer, ConfigDataLoks);
 		}
 		else if ((buffer[5] == 'm')
 			&& (buffer[6] == 'a')
@@ -632,8 +641,7 @@ namespace Hardware { namespace Protocols
 			&& (buffer[11] == 0x00)
 			&& (buffer[12] == 0x00))
 		{
-			const string dataPlain = manager->GetCs2Magnetartikel();
-			SendCompressedFile(dataPlain, buffer + 5);
+			QueueConfigData(buffer, ConfigDataMags);
 		}
 		else if ((buffer[5] == 'g')
 			&& (buffer[6] == 'b')
@@ -645,15 +653,13 @@ namespace Hardware { namespace Protocols
 				&& (buffer[10] == 0x00)
 				&& (buffer[11] == 0x00))
 			{
-				const string dataPlain = manager->GetCs2GBS();
-				SendCompressedFile(dataPlain, buffer + 5);
+				QueueConfigData(buffer, ConfigDataGbs);
 			}
 			else if (buffer[8] == '-')
 			{
 				const string gbsAsString(reinterpret_cast<const char*>(buffer + 9));
 				const unsigned int gbs = Utils::Integer::StringToInteger(gbsAsString);
-				const string dataPlain = manager->GetCs2GBS(gbs);
-				SendCompressedFile(dataPlain, buffer + 5);
+				QueueConfigData(buffer, ConfigDataGbsPage, gbs);
 			}
 		}
 		else if ((buffer[5] == 'f')
@@ -665,62 +671,244 @@ namespace Hardware { namespace Protocols
 			&& (buffer[11] == 0x00)
 			&& (buffer[12] == 0x00))
 		{
-			// we send an empty configuration
-			const string dataPlain = "[fahrstrassen]\nversion\n .minor=4\n";
-			SendCompressedFile(dataPlain, buffer + 5);
+			QueueConfigData(buffer, ConfigDataFs);
 		}
 	}
 
-	void MaerklinCANCommon::SendCompressedFile(const string& dataPlain, const unsigned char* fileName)
+	void MaerklinCANCommon::QueueConfigData(const unsigned char* const buffer,
+		const ConfigDataFile file,
+		const signed char gbsPage)
 	{
-		logger->Debug(dataPlain);
-		const uint32_t dataPlainSize = dataPlain.size();
+		ConfigDataRequest request;
+		request.file = file;
+		request.gbsPage = gbsPage;
+		request.fileName.assign(reinterpret_cast<const char*>(buffer + 5), 8);
+		request.requester = ParseHash(buffer);
 
-		unsigned char sendBuffer[CANCommandBufferLength];
-		if (fileName)
+		std::lock_guard<std::mutex> guard(configDataMutex);
+		if (configDataActive && configDataRequester == request.requester)
 		{
-			// send filename as response
-			CreateCommandHeader(sendBuffer, CanCommandRequestConfigData, CanResponseResponse, 8);
-			Utils::Utils::Copy8Bytes(fileName, sendBuffer + 5);
-			SendInternal(sendBuffer);
+			// the requester has given up the running transfer and starts over
+			configDataCancel = true;
+		}
+		for (auto it = configDataRequests.begin(); it != configDataRequests.end(); ++it)
+		{
+			if (it->requester == request.requester && it->fileName == request.fileName)
+			{
+				configDataRequests.erase(it);
+				break;
+			}
 		}
+		configDataRequests.push_back(request);
+		configDataCondition.notify_all();
+	}
+
+	string MaerklinCANCommon::GetConfigDataPlain(const ConfigDataRequest& request) const
+	{
+		switch (request.file)
+		{
+			case ConfigDataLoks:
+				return manager->GetCs2Lokomotive();
 
+			case ConfigDataMags:
+				return manager->GetCs2Magnetartikel();
+
+			case ConfigDataGbs:
+				return manager->GetCs2GBS();
+
+			case ConfigDataGbsPage:
+				return manager->GetCs2GBS(request.gbsPage);
+
+			case ConfigDataFs:
+			default:
+				// we send an empty configuration
+				return "[fahrstrassen]\nversion\n .minor=4\n";
+		}
+	}
+
+	const MaerklinCANCommon::ConfigData& MaerklinCANCommon::GetConfigData(const ConfigDataRequest& request)
+	{
+		// read the revision first, a change while building the file leads to a rebuild on the next request
+		const unsigned int revision = manager->GetCs2Revision();
+		auto cached = configDataCache.find(request.fileName);
+		if (cached != configDataCache.end() && cached->second.revision == revision)
+		{
+			return cached->second;
+		}
+
+		const string dataPlain = GetConfigDataPlain(request);
+		logger->Debug(dataPlain);
 		const string dataCompressed = ZLib::Compress(dataPlain);
-		const unsigned char* const dataCompressedPtr = reinterpret_cast<const unsigned char*>(dataCompressed.c_str());
-		const uint32_t dataCompressedSize = dataCompressed.size();
 
-		// prepare data
-		const uint32_t dataToSendSize = (4 + dataCompressedSize + 8) & 0xFFFFFFF8;
-		unsigned char* const dataToSend = reinterpret_cast<unsigned char*>(malloc(dataToSendSize));
+		ConfigData& configData = configDataCache[request.fileName];
+		configData.revision = revision;
+		configData.size = dataCompressed.size() + 4;
+
+		// first 4 bytes are the uncompressed size, the last data packet is filled up with 0
+		const uint32_t dataToSendSize = (configData.size + 8) & 0xFFFFFFF8;
+		configData.data.assign(dataToSendSize, 0);
+		unsigned char* const dataToSend = reinterpret_cast<unsigned char*>(&configData.data[0]);
+		Utils::Integer::IntToDataBigEndian(dataPlain.size(), dataToSend);
+		std::memcpy(dataToSend + 4, dataCompressed.c_str(), dataCompressed.size());
+		configData.crc = CalcCrc(dataToSend, dataToSendSize);
+		return configData;
+	}
 
-		// set last 8 bytes to 0 (fill up last data packet)
-		const uint64_t eightBytes = 0;
-		Utils::Utils::Copy8Bytes(&eightBytes, dataToSend + dataToSendSize - 8);
+	void MaerklinCANCommon::ConfigDataSender()
+	{
+		Utils::Utils::SetThreadName("Maerklin CAN Config");
+		logger->Info(Languages::TextSenderThreadStarted);
+		while (true)
+		{
+			ConfigDataRequest request;
+			{
+				std::unique_lock<std::mutex> lock(configDataMutex);
+				configDataCondition.wait(lock, [this] { return !run || !configDataRequests.empty(); });
+				if (!run)
+				{
+					break;
+				}
+				request = configDataRequests.front();
+				configDataRequests.pop_front();
+				configDataActive = true;
+				configDataCancel = false;
+				configDataInFlight = 0;
+				configDataRequester = request.requester;
+				configDataRequesterAnswered = false;
+				configDataRequesterSeen = std::chrono::steady_clock::now();
+			}
+
+			SendConfigData(request);
+
+			// the last echoes must not be parsed as a config file of another device
+			std::unique_lock<std::mutex> lock(configDataMutex);
+			configDataCondition.wait_for(lock,
+				std::chrono::milliseconds(ConfigDataEchoTimeout),
+				[this] { return !configDataEcho || configDataInFlight == 0; });
+			configDataActive = false;
+		}
+		logger->Info(Languages::TextTerminatingSenderThread);
+	}
 
-		// set first 4 bytes to length of uncompressed data size
-		Utils::Integer::IntToDataBigEndian(dataPlainSize, dataToSend);
+	void MaerklinCANCommon::SendConfigData(const ConfigDataRequest& request)
+	{
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		const ConfigData& configData = GetConfigData(request);
+		const string fileName(request.fileName.c_str());
+
+		unsigned char sendBuffer[CANCommandBufferLength];
 
-		// copy compressed data to out buffer
-		std::memcpy(dataToSend + 4, dataCompressedPtr, dataCompressedSize);
+		// send filename as response
+		CreateCommandHeader(sendBuffer, CanCommandRequestConfigData, CanResponseResponse, 8);
+		Utils::Utils::Copy8Bytes(request.fileName.data(), sendBuffer + 5);
+		SendInternal(sendBuffer);
 
-		const CanFileCrc crc = CalcCrc(dataToSend, dataToSendSize);
+		std::chrono::steady_clock::time_point nextFrame = start;
+		std::chrono::steady_clock::time_point nextPing = start + std::chrono::milliseconds(ConfigDataPingInterval);
 
 		// send first data packet
+		if (!WaitForConfigDataFrame(nextFrame))
+		{
+			logger->Info(Languages::TextConfigFileTransferCancelled, fileName);
+			return;
+		}
 		CreateCommandHeader(sendBuffer, CanCommandConfigData, CanResponseCommand, 6);
-		Utils::Integer::IntToDataBigEndian(dataCompressedSize + 4, sendBuffer + 5);
-		Utils::Integer::ShortToDataBigEndian(crc, sendBuffer + 9);
+		Utils::Integer::IntToDataBigEndian(configData.size, sendBuffer + 5);
+		Utils::Integer::ShortToDataBigEndian(configData.crc, sendBuffer + 9);
 		SendInternal(sendBuffer);
 
 		// send following data packets
 		CreateCommandHeader(sendBuffer, CanCommandConfigData, CanResponseCommand, 8);
-		for(size_t sent = 0; sent < dataToSendSize; sent += 8)
+		const unsigned char* const dataToSend = reinterpret_cast<const unsigned char*>(configData.data.data());
+		for (size_t sent = 0; sent < configData.data.size(); sent += 8)
 		{
+			if (std::chrono::steady_clock::now() >= nextPing)
+			{
+				// the answer shows us that the requester is still there
+				Ping();
+				nextPing += std::chrono::milliseconds(ConfigDataPingInterval);
+			}
+			if (!WaitForConfigDataFrame(nextFrame))
+			{
+				logger->Info(Languages::TextConfigFileTransferCancelled, fileName);
+				return;
+			}
 			Utils::Utils::Copy8Bytes(dataToSend + sent, sendBuffer + 5);
-			Utils::Utils::SleepForMilliseconds(2); // do not overload CS2 with too much data
 			SendInternal(sendBuffer);
 		}
 
-		free(dataToSend);
+		const long long duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+		logger->Info(Languages::TextConfigFileSent, fileName, configData.data.size(), duration);
+	}
+
+	bool MaerklinCANCommon::WaitForConfigDataFrame(std::chrono::steady_clock::time_point& nextFrame)
+	{
+		std::unique_lock<std::mutex> lock(configDataMutex);
+		while (true)
+		{
+			if (!run || configDataCancel)
+			{
+				return false;
+			}
+
+			const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			if (configDataRequesterAnswered && now - configDataRequesterSeen > std::chrono::milliseconds(ConfigDataRequesterTimeout))
+			{
+				// the requester has answered our pings before and is gone now
+				return false;
+			}
+
+			if (configDataEcho)
+			{
+				// the bus echoes our frames, so we send as fast as the echoes come back
+				if (configDataInFlight < ConfigDataWindow)
+				{
+					++configDataInFlight;
+					return true;
+				}
+				if (configDataCondition.wait_for(lock, std::chrono::milliseconds(ConfigDataEchoTimeout)) == std::cv_status::timeout
+					&& configDataInFlight >= ConfigDataWindow)
+				{
+					configDataEcho = false;
+					configDataInFlight = 0;
+					nextFrame = now;
+				}
+				continue;
+			}
+
+			if (now >= nextFrame)
+			{
+				// do not overload CS2 with too much data
+				nextFrame = now + std::chrono::milliseconds(ConfigDataFrameInterval);
+				return true;
+			}
+			configDataCondition.wait_until(lock, nextFrame);
+		}
+	}
+
+	bool MaerklinCANCommon::ConfigDataFeedback(const CanHash receivedHash, const CanCommand command, const CanResponse response)
+	{
+		std::lock_guard<std::mutex> guard(configDataMutex);
+		if (receivedHash == configDataRequester)
+		{
+			configDataRequesterAnswered = true;
+			configDataRequesterSeen = std::chrono::steady_clock::now();
+			return false;
+		}
+
+		if (receivedHash != hash || command != CanCommandConfigData || response)
+		{
+			return false;
+		}
+
+		// echo of a frame of our own config data stream
+		if (configDataInFlight)
+		{
+			--configDataInFlight;
+		}
+		configDataEcho = true;
+		configDataCondition.notify_all();
+		return true;
 	}
 
 	void MaerklinCANCommon::DeleteCanFile(MaerklinCANCommon::CanFile* canFile)
@@ -20,6 +20,14 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
 #include "DataModel/AccessoryBase.h"
 #include "DataModel/LocoFunctions.h"
 #include "Hardware/Capabilities.h"
@@ -87,7 +95,13 @@ namespace Hardware { namespace Protocols
 				hash(CalcHash(this->uid)),
 				hasCs2Main(false),
 				isCs2Main(isCs2Main),
-				controlID(controlID)
+				controlID(controlID),
+				configDataActive(false),
+				configDataCancel(false),
+				configDataEcho(true),
+				configDataInFlight(0),
+				configDataRequester(0),
+				configDataRequesterAnswered(false)
 			{
 				logger->Debug(Languages::TextMyUidHash, uid, Utils::Integer::IntegerToHex(hash));
 			}
@@ -291,6 +305,32 @@ namespace Hardware { namespace Protocols
 				size_t crcSize;
 			};
 
+			enum ConfigDataFile : unsigned char
+			{
+				ConfigDataLoks,
+				ConfigDataMags,
+				ConfigDataGbs,
+				ConfigDataGbsPage,
+				ConfigDataFs
+			};
+
+			struct ConfigDataRequest
+			{
+				ConfigDataFile file;
+				signed char gbsPage;
+				std::string fileName; // the 8 bytes of the request, also the key of the cache
+				CanHash requester;
+			};
+
+			// compressed once per revision of the content and sent as often as requested
+			struct ConfigData
+			{
+				unsigned int revision;
+				uint32_t size; // size of compressed data including the 4 bytes of the uncompressed size
+				CanFileCrc crc;
+				std::string data; // uncompressed size, compressed data and padding to 8 bytes
+			};
+
 			void CreateCommandHeader(unsigned char* const buffer,
 				const CanCommand command,
 				const CanResponse response,
@@ -373,7 +413,17 @@ namespace Hardware { namespace Protocols
 			void ParseResponseAccessory(const unsigned char* const buffer);
 			void ParseCommandPing(const unsigned char* const buffer);
 			void ParseCommandRequestConfigData(const unsigned char* const buffer);
-			void SendCompressedFile(const std::string& dataPlain, const unsigned char* fileName = nullptr);
+
+			void QueueConfigData(const unsigned char* const buffer,
+				const ConfigDataFile file,
+				const signed char gbsPage = 0);
+
+			std::string GetConfigDataPlain(const ConfigDataRequest& request) const;
+			const ConfigData& GetConfigData(const ConfigDataRequest& request);
+			void ConfigDataSender();
+			void SendConfigData(const ConfigDataRequest& request);
+			bool WaitForConfigDataFrame(std::chrono::steady_clock::time_point& nextFrame);
+			bool ConfigDataFeedback(const CanHash receivedHash, const CanCommand command, const CanResponse response);
 
 			void DeleteCanFile(CanFile* canFile);
 
@@ -425,11 +475,33 @@ namespace Hardware { namespace Protocols
 			const bool isCs2Main;
 			std::thread receiverThread;
 			std::thread pingThread;
+			std::thread configDataThread;
 
 			std::vector<struct CanFile> canFiles;
 
 			ControlID controlID;
 
+			// frames of a config data stream that may be on the way while the bus echoes them
+			static const unsigned int ConfigDataWindow = 16;
+			static const unsigned int ConfigDataEchoTimeout = 50; // ms
+			// pacing if the bus does not echo our frames
+			static const unsigned int ConfigDataFrameInterval = 2; // ms
+			static const unsigned int ConfigDataPingInterval = 1000; // ms
+			static const unsigned int ConfigDataRequesterTimeout = 3000; // ms
+
+			std::mutex configDataMutex;
+			std::condition_variable configDataCondition;
+			std::deque<ConfigDataRequest> configDataRequests;
+			volatile bool configDataActive;
+			bool configDataCancel;
+			bool configDataEcho;
+			unsigned int configDataInFlight;
+			CanHash configDataRequester;
+			bool configDataRequesterAnswered;
+			std::chrono::steady_clock::time_point configDataRequesterSeen;
+			// only used by configDataThread
+			std::map<std::string,ConfigData> configDataCache;
+
 			static const uint8_t MaxNrOfCs2FunctionIcons = 128;
 			static const DataModel::LocoFunctionIcon LocoFunctionMapCs2ToRailControl[MaxNrOfCs2FunctionIcons];
 			static const MaerklinCANCommon::LocoFunctionCs2Icon LocoFunctionMapRailControlToCs2[DataModel::MaxLocoFunctionIcons];
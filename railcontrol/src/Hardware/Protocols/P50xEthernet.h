@@ -45,7 +45,7 @@ namespace Hardware
 				:	P50x(params,
 						controlName + " / " + params->GetName() + " at serial port " + params->GetArg1(),
 						type),
-					connection(Network::TcpClient::GetTcpClientConnection(logger, params->GetArg1(), P50xPort))
+					connection(Network::TcpClient::GetTcpClientConnection(logger, params->GetArg1(), P50xPort, &capture))
 				{
 				}
 
@@ -40,7 +40,7 @@ namespace Hardware
 			   controlName + " / " + params->GetName() + " at IP " + params->GetArg1(),
 			   params->GetName()),
 			run(true),
-			connection(logger, params->GetArg1(), Z21Port),
+			connection(logger, params->GetArg1(), Z21Port, &capture),
 			lastProgramMode(ProgramModeMm),
 			connected(false)
 		{
@@ -277,7 +277,7 @@ namespace Hardware
 			const DataModel::AccessoryPulseDuration duration)
 		{
 			AccessoryQueueEntry entry(protocol, address, state, duration);
-			accessoryQueue.EnqueueBack(entry);
+			accessoryQueue.Enqueue(entry);
 		}
 
 		void Z21::AccessoryOnOrOff(const Address address,
@@ -298,10 +298,10 @@ namespace Hardware
 			logger->Info(Languages::TextAccessorySenderThreadStarted);
 			while (run)
 			{
-				AccessoryQueueEntry entry = accessoryQueue.Dequeue();
-				if (entry.protocol == ProtocolNone)
+				AccessoryQueueEntry entry;
+				if (!accessoryQueue.Dequeue(entry))
 				{
-					// ProtocolNone is in queue when we should quit
+					// queue has been terminated because we should quit
 					continue;
 				}
 				SendSetTurnoutMode(entry.address, entry.protocol);
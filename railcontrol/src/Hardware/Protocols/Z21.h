@@ -33,6 +33,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "Hardware/Protocols/Z21TurnoutCache.h"
 #include "Logger/Logger.h"
 #include "Network/UdpConnection.h"
+#include "Utils/RingQueue.h"
 
 namespace Z21Enums = Hardware::Protocols::Z21Enums;
 
@@ -186,7 +187,7 @@ namespace Hardware
 				ProgramMode lastProgramMode;
 				volatile bool connected;
 
-				Utils::ThreadSafeQueue<AccessoryQueueEntry> accessoryQueue;
+				Utils::MpscQueue<AccessoryQueueEntry,64> accessoryQueue;
 
 				void ProgramMm(const CvNumber cv, const CvValue value);
 				void ProgramDccRead(const CvNumber cv);
@@ -0,0 +1,280 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+
+#include <chrono>
+#include <string>
+
+#include "DataModel/Route.h"
+#include "DataModel/Track.h"
+#include "Hardware/Simulator.h"
+#include "Manager.h"
+#include "Utils/Integer.h"
+#include "Utils/Utils.h"
+
+using std::string;
+using std::to_string;
+using std::vector;
+
+namespace Hardware
+{
+	Simulator::Simulator(const HardwareParams* params)
+	:	HardwareInterface(params->GetManager(),
+			params->GetControlID(),
+			"Virtual Layout Simulator / " + params->GetName(),
+			params->GetName()),
+		speedFactor(Utils::Integer::StringToInteger(params->GetArg1(), 1, 1000)),
+		run(true),
+		commands(0),
+		feedbacks(0),
+		overruns(0),
+		simulatedTime(0)
+	{
+		logger->Info(Languages::TextSimulatingTimesRealTime, speedFactor);
+		simulatorThread = std::thread(&Simulator::Simulate, this);
+	}
+
+	Simulator::~Simulator()
+	{
+		{
+			std::lock_guard<std::mutex> guard(trainMutex);
+			run = false;
+		}
+		stopCondition.notify_all();
+		simulatorThread.join();
+	}
+
+	string Simulator::GetStatistics() const
+	{
+		std::lock_guard<std::mutex> guard(trainMutex);
+		unsigned int moving = 0;
+		for (auto& train : trains)
+		{
+			if (train.second.speed)
+			{
+				++moving;
+			}
+		}
+		return "simulator;" + to_string(controlID)
+			+ ";" + to_string(moving)
+			+ ";" + to_string(commands)
+			+ ";" + to_string(feedbacks)
+			+ ";" + to_string(overruns)
+			+ ";" + to_string(simulatedTime) + "\n";
+	}
+
+	// turn booster on or off
+	void Simulator::Booster(const BoosterState status)
+	{
+		logger->Info(status ? Languages::TextTurningBoosterOn : Languages::TextTurningBoosterOff);
+	}
+
+	// set loco speed
+	void Simulator::LocoSpeed(const Protocol protocol, const Address address, const Speed speed)
+	{
+		logger->Debug(Languages::TextSettingSpeedWithProtocol, Utils::Utils::ProtocolToString(protocol), address, speed);
+		std::lock_guard<std::mutex> guard(trainMutex);
+		++commands;
+		speedCommands.push_back({ address, speed });
+		Train& train = trains[address];
+		if (train.length)
+		{
+			return;
+		}
+		const DataModel::LocoConfig loco = manager->GetLoco(controlID, protocol, address);
+		if (loco.GetType() == LocoTypeNone)
+		{
+			return;
+		}
+		train.locoBase = loco.GetObjectIdentifier();
+		train.length = (loco.GetLength() ? loco.GetLength() * 10 : DefaultTrainLength) * 1000ULL;
+	}
+
+	// set the direction of a loco
+	void Simulator::LocoOrientation(const Protocol protocol, const Address address, const Orientation orientation)
+	{
+		logger->Debug(Languages::TextSettingDirectionOfTravelWithProtocol, Utils::Utils::ProtocolToString(protocol), address, Languages::GetLeftRight(orientation));
+		std::lock_guard<std::mutex> guard(trainMutex);
+		++commands;
+	}
+
+	// set loco function
+	void Simulator::LocoFunctionState(const Protocol protocol,
+		const Address address,
+		const DataModel::LocoFunctionNr function,
+		const DataModel::LocoFunctionState on)
+	{
+		logger->Debug(Languages::TextSettingFunctionWithProtocol, static_cast<int>(function), Utils::Utils::ProtocolToString(protocol), address, Languages::GetOnOff(on));
+		std::lock_guard<std::mutex> guard(trainMutex);
+		++commands;
+	}
+
+	// accessory command
+	void Simulator::Accessory(const Protocol protocol,
+		const Address address,
+		const DataModel::AccessoryState state,
+		const bool on,
+		__attribute__((unused)) const DataModel::AccessoryPulseDuration duration)
+	{
+		logger->Debug(Languages::TextSettingAccessoryWithProtocol, Utils::Utils::ProtocolToString(protocol), address, Languages::GetGreenRed(state), Languages::GetOnOff(on));
+		std::lock_guard<std::mutex> guard(trainMutex);
+		++commands;
+	}
+
+	void Simulator::Simulate()
+	{
+		Utils::Utils::SetThreadName("Simulator");
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		vector<FeedbackEvent> events;
+		std::unique_lock<std::mutex> lock(trainMutex);
+		while (run)
+		{
+			// a tick that is late starts immediately, but still on its own
+			const std::chrono::steady_clock::time_point tickEnd = start
+				+ std::chrono::microseconds(1000ULL * (simulatedTime + StepDuration) / speedFactor);
+			stopCondition.wait_until(lock, tickEnd, [this]() { return !run; });
+			if (!run)
+			{
+				break;
+			}
+
+			ApplyCommands();
+			Step(events);
+			simulatedTime += StepDuration;
+			if (events.empty())
+			{
+				continue;
+			}
+
+			// reporting a feedback may command locos, so trainMutex must not be held
+			lock.unlock();
+			for (const FeedbackEvent& event : events)
+			{
+				manager->FeedbackState(event.feedbackID, event.state);
+			}
+			lock.lock();
+			events.clear();
+		}
+	}
+
+	void Simulator::ApplyCommands()
+	{
+		for (const SpeedCommand& command : speedCommands)
+		{
+			trains[command.address].speed = command.speed;
+		}
+		speedCommands.clear();
+	}
+
+	void Simulator::Step(vector<FeedbackEvent>& events)
+	{
+		for (auto& train : trains)
+		{
+			if (train.second.speed == 0 || train.second.length == 0)
+			{
+				continue;
+			}
+			StepTrain(train.second, events);
+		}
+	}
+
+	void Simulator::StepTrain(Train& train, vector<FeedbackEvent>& events)
+	{
+		if (!train.onRoute && !EnterRoute(train, TrackNone))
+		{
+			return;
+		}
+
+		// continue on the next route as soon as the stop point of the current route is passed
+		if (train.nextEvent > RouteEventStop)
+		{
+			const unsigned long long position = train.position - train.eventPositions[RouteEventStop];
+			if (EnterRoute(train, train.toTrack))
+			{
+				train.position = position;
+			}
+			else if (train.nextEvent == RouteEventDone)
+			{
+				// nothing reserved ahead, the train stands at the end of the track
+				return;
+			}
+		}
+
+		train.position += 1000ULL * train.speed * MaxVelocity * StepDuration / (MaxSpeed * 1000);
+
+		// the end of the train has left the previous track
+		if (!train.leaving.empty() && train.position >= train.length)
+		{
+			for (FeedbackID feedbackID : train.leaving)
+			{
+				events.push_back({ feedbackID, DataModel::Feedback::FeedbackStateFree });
+				++feedbacks;
+			}
+			train.leaving.clear();
+		}
+
+		while (train.nextEvent < RouteEventDone && train.position >= train.eventPositions[train.nextEvent])
+		{
+			const FeedbackID feedbackID = train.feedbacks[train.nextEvent];
+			if (feedbackID != FeedbackNone)
+			{
+				events.push_back({ feedbackID, DataModel::Feedback::FeedbackStateOccupied });
+				train.entering.push_back(feedbackID);
+				++feedbacks;
+			}
+			if (train.nextEvent == RouteEventOver)
+			{
+				++overruns;
+				train.position = train.eventPositions[RouteEventOver];
+			}
+			train.nextEvent = static_cast<RouteEvent>(train.nextEvent + 1);
+		}
+	}
+
+	bool Simulator::EnterRoute(Train& train, const TrackID fromTrack)
+	{
+		const DataModel::Route* route = manager->GetReservedRouteOfLocoBase(train.locoBase, fromTrack);
+		if (!route)
+		{
+			return false;
+		}
+		const TrackID toTrack = route->GetToTrack();
+		const DataModel::Track* track = manager->GetTrack(toTrack);
+		const unsigned long long trackLength = (track ? track->GetHeight() : 1) * TrackUnitLength * 1000ULL;
+		const unsigned long long approachLength = ApproachLength * 1000ULL;
+
+		train.feedbacks[RouteEventReduced] = route->GetFeedbackIdReduced();
+		train.feedbacks[RouteEventCreep] = route->GetFeedbackIdCreep();
+		train.feedbacks[RouteEventStop] = route->GetFeedbackIdStop();
+		train.feedbacks[RouteEventOver] = route->GetFeedbackIdOver();
+		train.eventPositions[RouteEventReduced] = approachLength;
+		train.eventPositions[RouteEventCreep] = approachLength + trackLength / 2;
+		train.eventPositions[RouteEventStop] = approachLength + trackLength * 3 / 4;
+		train.eventPositions[RouteEventOver] = approachLength + trackLength;
+
+		train.leaving.insert(train.leaving.end(), train.entering.begin(), train.entering.end());
+		train.entering.clear();
+		train.onRoute = true;
+		train.toTrack = toTrack;
+		train.position = 0;
+		train.nextEvent = RouteEventReduced;
+		return true;
+	}
+} // namespace
@@ -0,0 +1,164 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DataModel/ObjectIdentifier.h"
+#include "Hardware/HardwareInterface.h"
+#include "Hardware/HardwareParams.h"
+#include "Logger/Logger.h"
+
+namespace Hardware
+{
+	// Moves the locos along the routes they have reserved and reports the feedbacks of the routes.
+	// The simulation runs in ticks of fixed simulated time, arg1 speeds up the simulated time against real time.
+	// Loco commands received during a tick are applied at its end and the feedbacks of every tick are reported
+	// before the next one starts, so the same commands always lead to the same positions, however late a tick runs.
+	class Simulator : HardwareInterface
+	{
+		public:
+			Simulator() = delete;
+			Simulator(const Simulator&) = delete;
+			Simulator& operator=(const Simulator&) = delete;
+
+			Simulator(const HardwareParams* params);
+			~Simulator();
+
+			inline Hardware::Capabilities GetCapabilities() const override
+			{
+				return Hardware::CapabilityLoco
+					| Hardware::CapabilityAccessory
+					| Hardware::CapabilityFeedback;
+			}
+
+			static void GetArgumentTypesAndHint(std::map<unsigned char,ArgumentType>& argumentTypes, std::string& hint)
+			{
+				argumentTypes[1] = ArgumentTypeSimulationSpeed;
+				hint = Languages::GetText(Languages::TextHintSimulator);
+			}
+
+			void GetLocoProtocols(std::vector<Protocol>& protocols) const override { protocols.push_back(ProtocolNone); }
+			bool LocoProtocolSupported(const Protocol protocol) const override { return protocol == ProtocolNone; }
+			void GetAccessoryProtocols(std::vector<Protocol>& protocols) const override { protocols.push_back(ProtocolNone); }
+			bool AccessoryProtocolSupported(const Protocol protocol) const override { return protocol == ProtocolNone; }
+
+			// returns one CSV line: simulator;controlID;moving;commands;feedbacks;overruns;simulated ms
+			std::string GetStatistics() const override;
+
+			void Booster(const BoosterState status) override;
+			void LocoSpeed(const Protocol protocol, const Address address, const Speed speed) override;
+			void LocoOrientation(const Protocol protocol, const Address address, const Orientation orientation) override;
+
+			void LocoFunctionState(const Protocol protocol,
+				const Address address,
+				const DataModel::LocoFunctionNr function,
+				const DataModel::LocoFunctionState on) override;
+
+			void Accessory(const Protocol protocol,
+				const Address address,
+				const DataModel::AccessoryState state,
+				const bool on,
+				const DataModel::AccessoryPulseDuration duration) override;
+
+		private:
+			// all lengths are in mm, positions in µm
+			static const unsigned int StepDuration = 10; // ms of simulated time
+			static const unsigned int MaxVelocity = 500; // mm/s at MaxSpeed
+			static const unsigned int ApproachLength = 100; // from leaving the start track to the destination track
+			static const unsigned int TrackUnitLength = 250; // per unit of the height of a track
+			static const unsigned int DefaultTrainLength = 200;
+
+			enum RouteEvent : unsigned char
+			{
+				RouteEventReduced = 0,
+				RouteEventCreep,
+				RouteEventStop,
+				RouteEventOver,
+				RouteEventDone
+			};
+
+			struct Train
+			{
+				Train()
+				:	speed(0),
+					length(0),
+					onRoute(false),
+					toTrack(TrackNone),
+					position(0),
+					nextEvent(RouteEventReduced)
+				{
+				}
+
+				Speed speed;
+				DataModel::ObjectIdentifier locoBase;
+				unsigned long long length;
+				bool onRoute;
+				TrackID toTrack;
+				// indexed by RouteEvent
+				FeedbackID feedbacks[RouteEventDone];
+				unsigned long long eventPositions[RouteEventDone];
+				unsigned long long position;
+				RouteEvent nextEvent;
+				// occupied by the train on the track it is leaving
+				std::vector<FeedbackID> leaving;
+				// occupied by the train on the track it is entering
+				std::vector<FeedbackID> entering;
+			};
+
+			struct FeedbackEvent
+			{
+				FeedbackID feedbackID;
+				DataModel::Feedback::FeedbackState state;
+			};
+
+			struct SpeedCommand
+			{
+				Address address;
+				Speed speed;
+			};
+
+			void Simulate();
+			void ApplyCommands();
+			void Step(std::vector<FeedbackEvent>& events);
+			void StepTrain(Train& train, std::vector<FeedbackEvent>& events);
+			bool EnterRoute(Train& train, const TrackID fromTrack);
+
+			const unsigned int speedFactor;
+			mutable std::mutex trainMutex;
+			std::condition_variable stopCondition;
+			volatile bool run;
+			std::map<Address,Train> trains;
+			// in the order received, applied at the next tick
+			std::vector<SpeedCommand> speedCommands;
+			unsigned long long commands;
+			unsigned long long feedbacks;
+			unsigned long long overruns;
+			unsigned long long simulatedTime; // ms
+			std::thread simulatorThread;
+	};
+} // namespace
@@ -75,3 +75,36 @@ string ZLib::UnCompress(const char* input, const size_t inputSize, const size_t
 	free(outputBuffer);
 	return output;
 }
+
+string ZLib::GZip(const string& input)
+{
+	z_stream strm;
+	strm.zalloc = Z_NULL;
+	strm.zfree = Z_NULL;
+	strm.opaque = Z_NULL;
+	// window bits 15 + 16 writes a gzip header instead of a zlib header
+	int ret = deflateInit2(&strm, 9, Z_DEFLATED, 15 + 16, 9, Z_DEFAULT_STRATEGY);
+	if (ret != Z_OK)
+	{
+		return "";
+	}
+	string output(deflateBound(&strm, input.size()), '\0');
+	strm.avail_in = input.size();
+	strm.next_in = reinterpret_cast<unsigned char*>(const_cast<char*>(input.data()));
+	strm.avail_out = output.size();
+	strm.next_out = reinterpret_cast<unsigned char*>(&output[0]);
+	ret = deflate(&strm, Z_FINISH);
+	const size_t outputSize = strm.total_out;
+	deflateEnd(&strm);
+	if (ret != Z_STREAM_END)
+	{
+		return "";
+	}
+	output.resize(outputSize);
+	return output;
+}
+
+unsigned long ZLib::Crc32(const string& input)
+{
+	return crc32(crc32(0L, Z_NULL, 0), reinterpret_cast<const unsigned char*>(input.data()), input.size());
+}
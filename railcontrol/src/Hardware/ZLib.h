@@ -27,4 +27,9 @@ class ZLib
 	public:
 		static std::string Compress(const std::string& input);
 		static std::string UnCompress(const char* input, const size_t inputSize, const size_t outputSize);
+
+		// returns the input with gzip header and trailer as used by HTTP Content-Encoding, or an empty string on error
+		static std::string GZip(const std::string& input);
+
+		static unsigned long Crc32(const std::string& input);
 };
@@ -83,6 +83,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextAutomaticallyAddUnknownFeedbacks */ { "Automatically add unknown feedbacks", "Füge unbekannte Rückmelder automatisch hinzu", "Añadir retroseñales desconocidos automaticamente" },
 /* TextAutomode */ { "Automode", "Automode", "Autómodo" },
 /* TextBacktraceLine */ { "{0}: {1}", "{0}: {1}", "{0}: {1}" },
+/* TextBackupBeforeBinaryFormat */ { "Writing a backup of the database in text format to {0}, the conversion to binary format can not be undone", "Schreibe eine Sicherung der Datenbank im Textformat nach {0}, die Konvertierung ins Binärformat kann nicht rückgängig gemacht werden", "Escribiendo una copia de seguridad de la base de datos en formato de texto en {0}, la conversión al formato binario no se puede deshacer" },
 /* TextBaseAddress */ { "Baseaddress", "Basisadresse", "Dirección basica" },
 /* TextBasic */ { "Basic data", "Basisdaten", "Datos básicos" },
 /* TextBlockTrack */ { "Block track", "Blockiere Gleis", "Bloquear vía" },
@@ -120,6 +121,8 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextConditionsNotFulfilled */ { "Conditions for route not fulfilled", "Bedingungen der Fahrstrasse nicht erfüllt", "Condiciones del itinerario no cumplidas" },
 /* TextConfigFileNotFound */ { "Config file {0} not found. Using default config file {1}.", "Konfigurationsdatei {0} nicht gefunden. Verwende Vorlage {1}.", "Archivo de configuración {0} no encontrado. Se utilizará el archivo de configuración predeterminado {1}." },
 /* TextConfigFileReceivedWithSize */ { "Configuration file with {0} bytes received", "Konfigurationsdatei mit {0} Bytes empfangen", "Archivo de configuración recibido con {0} bytes" },
+/* TextConfigFileSent */ { "Configuration file {0} with {1} bytes sent in {2} ms", "Konfigurationsdatei {0} mit {1} Bytes in {2} ms gesendet", "Archivo de configuración {0} con {1} bytes enviado en {2} ms" },
+/* TextConfigFileTransferCancelled */ { "Transfer of configuration file {0} cancelled", "Übertragung der Konfigurationsdatei {0} abgebrochen", "Transferencia del archivo de configuración {0} cancelada" },
 /* TextConfigMenu */ { "Configuration menu", "Konfigurationsmenu", "Navegación de configuración" },
 /* TextConfigureControlFirst */ { "Please configure a control first", "Bitte zuerst eine Zentrale konfigurieren", "Por favor configura un control antes" },
 /* TextConnectedTo */ {"Connected to {0}", "Verbunden mit {0}", "Conectado con {0}" },
@@ -135,6 +138,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextControlDeleted */ { "Control {0} deleted", "Zentrale {0} gelöscht", "Control {0} eliminado" },
 /* TextControlDoesNotAnswer */ { "Control does not answer", "Zentrale antwortet nicht", "Control no respuesta" },
 /* TextControlDoesNotExist */ { "Control does not exist", "Zentrale existiert nicht", "Control no existe" },
+/* TextControlQueueOverflow */ { "{0} updates are waiting for control {1}, the control does not keep up", "{0} Meldungen warten auf Zentrale {1}, die Zentrale kommt nicht nach", "{0} actualizaciones esperan al control {1}, el control no da abasto" },
 /* TextControlReturnedBadParameter */ { "Control returned bad parameter", "Zentrale sendete falscher Parameter", "Control respondió malo parametro" },
 /* TextControlReturnedError */ { "Control returned error: {0}", "Zentrale meldete Fehler: {0}", "Control contesta error: {0}" },
 /* TextControlReturnedOnHalt */ { "Control returned on HALT", "Zentrale sendete auf HALT", "Control respondió en HALT" },
@@ -144,6 +148,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextControlReturnedUnknownErrorCode */ { "Control returned unknown error code: {0}", "Zentrale sendete unbekannten Fehlercode: {0}", "Control respondió codico error disconocido: {0}" },
 /* TextControlSaved */ { "Control {0} saved", "Zentrale {0} gespeichert", "Control {0} guardado" },
 /* TextControls */ { "Controls", "Zentralen", "Controls" },
+/* TextConvertingToBinary */ { "Converting {0} to binary format", "Konvertiere {0} ins Binärformat", "Convirtiendo {0} al formato binario" },
 /* TextCopyingFromTo */ { "Copying from {0} to {1}", "Kopiere von {0} nach {1}", "Copiando de {0} a {1}" },
 /* TextCounter */ { "Counter", "Zähler", "Contador" },
 /* TextCounterDecrement */ { "Decrement counter", "Zähler reduzieren", "Reducir contador" },
@@ -292,6 +297,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextHintPositionMove */ { "Elements can be moved by drag and drop while shift-, control or alt key is pressed (key depends on the used browser).", "Elemente können mit Drag und Drop verschoben werden, während die Shift-, Ctrl- oder Alt-Taste gedrückt wird (Die Taste ist abhängig vom verwendeten Browser).", "Se puede mover elementos con Drag and Drop, cuando la tecla de mayúsculas, control o alt esté pulsada (La tecla depende del navegador usado)." },
 /* TextHintPositionRotate */ { "Elements can be moved by clicking on it while shift-, control or alt key is pressed (key depends on the used browser).", "Elemente können mit einem Klick gedreht werden, während die Shift-, Ctrl- oder Alt-Taste gedrückt wird (Die Taste ist abhängig vom verwendeten Browser).", "Se puede rotar elementos con un click, cuando la tecla de mayúsculas, control o alt esté pulsada (La tecla depende del navegador usado)." },
 /* TextHintRedBox */ { "Under Linux the virtual serial port is usually /dev/ttyUSB0.<br>The RedBox does not forward very short feedbacks. It is not recommended to use the feedbacks of the RedBox for automatic train control.", "Unter Linux ist der erstellte virtuelle COM-Port üblicherweise /dev/ttyUSB0.<br>Die RedBox verschluckt sehr kurzzeitige Rückmelder. Ein Automatikbetrieb mit den Rückmeldern von RedBox ist deshalb nicht zu empfehlen.", "Sobre Linux el puerto virtual normalmente es /dev/ttyUSB0.<br>El RedBox no puede procesar las retroseñales muy cortas. No es recomendada de utilisar las retroseñales de RedBox para modo automatico." },
+/* TextHintSimulator */ { "The simulator moves the locos along their reserved routes and reports the feedbacks of the routes. It is for testing and benchmarks only.", "Der Simulator bewegt die Loks entlang ihrer reservierten Fahrstrassen und meldet die Rückmelder der Fahrstrassen. Er ist ausschliesslich für Tests und Benchmarks.", "El simulador mueve las locomotoras a lo largo de sus itinerarios reservados y reporta los contactos de los itinerarios. Es solamente para tests y benchmarks." },
 /* TextHintSystemControl7 */ { "Under Linux the virtual serial port is usually /dev/ttyUSB0.<br>Please set the System Control 7 to a communication speed of 115200 (default).", "Unter Linux ist der erstellte virtuelle COM-Port üblicherweise /dev/ttyUSB0.<br>Die Kommunikationsgeschwindigkeit ist in der System Control 7 auf 115200 zu setzen (standard).", "Sobre Linux el puerto virtual normalmente es /dev/ttyUSB0.<br>Se tiene que usar una velocidad de comunicación de 115200 en System Control 7 (defecto)." },
 /* TextHintTwinCenter */ { "Under Linux the virtual serial port is usually /dev/ttyUSB0.<br>The TwinCenter does not forward very short feedbacks. It is not recommended to use the feedbacks of the TwinCenter for automatic train control.", "Unter Linux ist der erstellte virtuelle COM-Port üblicherweise /dev/ttyUSB0.<br>Das TwinCenter verschluckt sehr kurzzeitige Rückmelder. Ein Automatikbetrieb mit den Rückmeldern vom TwinCenter ist deshalb nicht zu empfehlen.", "Sobre Linux el puerto virtual normalmente es /dev/ttyUSB0.<br>El TwinCenter no puede procesar las retroseñales muy cortas. No es recomendada de utilisar las retroseñales de TwinCenter para modo automatico." },
 /* TextHintVirtual */ { "The virtual control does not have a physical representation. It is for testing only.", "Die virtuelle Zentrale hat keine physische Repräsentation. Sie ist ausschliesslich für Tests.", "El control virtual no tiene representation physica. Es solamente para tests." },
@@ -306,6 +312,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextIndependentOfControl */ { "Independent of control", "Unabhängig der Zentrale", "Independiente del control" },
 /* TextIndex */ { "Index", "Index", "Index" },
 /* TextInfo */ { "info", "Informationen", "informaciones" },
+/* TextInvalidCaptureFile */ { "{0} is not a valid capture file", "{0} ist keine gültige Aufzeichnungsdatei", "{0} no es un archivo de captura válido" },
 /* TextInvalidControlID */ { "Invalid control ID {0}", "Ungültige Control ID {0}", "Control ID {0} no valido" },
 /* TextInvalidDataReceived */ { "Invalid data received", "Ungültige Daten empfangen", "Datos recibidos no validos" },
 /* TextInverted */ { "Inverted", "Invertiert", "Invertido" },
@@ -344,6 +351,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextLength */ { "Length", "Länge", "Longitud" },
 /* TextLink */ { "Link", "Link", "Enlace" },
 /* TextLoadedAccessory */ { "Loaded accessory {0}: {1}", "Zubehörartikel {0} geladen: {1}", "Cargado accesorio {0}: {1}" },
+/* TextLoadedAllObjects */ { "Loaded all objects in {0} ms", "Alle Objekte in {0} ms geladen", "Todos los objetos cargados en {0} ms" },
 /* TextLoadedCluster */ { "Loaded track cluster {0}: {1}", "Gleisgruppe {0} geladen: {1}", "Cargado grupo de vías {0}: {1}" },
 /* TextLoadedControl */ { "Loaded control {0}: {1}", "Zentrale {0} geladen: {1}", "Cargado control {0}: {1}" },
 /* TextLoadedCounter */ { "Loaded counter {0}: {1}", "Zähler {0} geladen: {1}", "Cargado contador {0}: {1}" },
@@ -351,6 +359,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextLoadedLayer */ { "Loaded layer {0}: {1}", "Schicht {0} geladen: {1}", "Cargado capa {0}: {1}" },
 /* TextLoadedLoco */ { "Loaded locomotive {0}: {1}", "Lokomotive {0} geladen: {1}", "Cargado locomotora {0}: {1}" },
 /* TextLoadedMultipleUnit */ { "Loaded multiple unit {0}: {1}", "Mehrfachtraktion {0} geladen: {1}", "Cargado unidad múltiple {0}: {1}" },
+/* TextLoadedPhase */ { "Startup phase {0}: loaded {1} object types on {2} threads in {3} ms", "Startphase {0}: {1} Objekttypen mit {2} Threads in {3} ms geladen", "Fase de inicio {0}: {1} tipos de objetos cargados con {2} hilos en {3} ms" },
 /* TextLoadedRoute */ { "Loaded route {0}: {1}", "Fahrstrasse {0} geladen: {1}", "Cargado itinerario {0}: {1}" },
 /* TextLoadedSignal */ { "Loaded signal {0}: {1}", "Signal {0} geladen: {1}", "Cargado señal {0}: {1}" },
 /* TextLoadedSwitch */ { "Loaded switch {0}: {1}", "Weiche {0} geladen: {1}", "Cargado desvío {0}: {1}" },
@@ -481,6 +490,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextLocoUpdated */ { "Locomotive {0} updated", "Lokomotive {0} aktualisiert", "Locomotora {0} actualizado" },
 /* TextLocos */ { "Locomotives", "Lokomotiven", "Locomotoras" },
 /* TextLogLevel */ { "Log level", "Log Level", "Nivel de registro" },
+/* TextLogMessagesDropped */ { "{0} log messages dropped because the log buffer was full", "{0} Log-Meldungen verworfen, weil der Log-Puffer voll war", "{0} mensajes de registro descartados porque el búfer de registro estaba lleno" },
 /* TextLongestUnused */ { "Longest unused", "Am längsten ungenutzt", "El más largo sin usar" },
 /* TextLookingForDestination */ {"Looking for new destination starting from {0}", "Suche von {0} aus neues Ziel", "Buscando nuevo destino deste {0}" },
 /* TextMaerklinLeft */ { "Märklin DSS left", "Märklin DKW links", "Märklin DCD izquierda" },
@@ -526,7 +536,9 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextObjectIsUsedByRoute */ { "Object {0} is used by route {1}", "Objekt {0} wird von Fahrstrasse {1} benutzt", "Objeto {0} está utilizado por itinerario {1}" },
 /* TextOccupied */ { "occupied", "besetzt", "ocupado" },
 /* TextOff */ { "off", "aus", "apagado" },
+/* TextOffDelay */ { "Delay until free (ms)", "Verzögerung bis frei (ms)", "Retardo hasta libre (ms)" },
 /* TextOn */ { "on", "ein", "encendido" },
+/* TextOnDelay */ { "Delay until occupied (ms)", "Verzögerung bis besetzt (ms)", "Retardo hasta ocupado (ms)" },
 /* TextOnPush */ { "on push", "beim Drücken", "al presionar" },
 /* TextOpeningSQLite */ { "Opening SQLite database with filename {0}", "Öffne SQLite Datenbank mit Dateiname {0}", "Abriendo base de datos SQLite con nombre {0}" },
 /* TextOrientation */ { "Orientation", "Ausrichtung", "Orientación" },
@@ -536,12 +548,14 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextPause */ { "Pause", "Pause", "Pausa" },
 /* TextPin */ { "Pin", "Kontakt", "Contacto" },
 /* TextPingSenderStarted */ { "Ping sender started", "Ping sender gestartet", "Ping enviador creado" },
+/* TextPlannedPath */ { "Planned path over several routes", "Geplanter Weg über mehrere Fahrstrassen", "Camino planificado sobre varios itinerarios" },
 /* TextPleaseSelectLoco */ { "Please select a locomotive", "Bitte eine Lokomotive wählen", "Por favor selecciona una locomotora" },
 /* TextPosX */ { "Position X", "Position X", "Posición X" },
 /* TextPosY */ { "Position Y", "Position Y", "Posición Y" },
 /* TextPosZ */ { "Layer", "Schicht", "Capa" },
 /* TextPosition */ { "Position", "Position", "Posición" },
 /* TextPositionAlreadyInUse */ { "Position {0}/{1}/{2} is already used by {3} \"{4}\".", "Position {0}/{1}/{2} wird bereits verwendet von {3} \"{4}\".", "Positión {0}/{1}/{2} es usado por {3} \"{4}\"." },
+/* TextPreloadedObjects */ { "Read {0} objects and {1} relations from the database in {2} ms", "{0} Objekte und {1} Beziehungen in {2} ms aus der Datenbank gelesen", "Leídos {0} objetos y {1} relaciones de la base de datos en {2} ms" },
 /* TextProgramDccDirectRead */ { "Reading DCC CV {0} on programming track in direct mode", "Lese DCC CV {0} auf dem Programmiergleis im Direct Mode", "Leyendo DCC CV {0} en la vía de programación en modo directo" },
 /* TextProgramDccDirectWrite */ { "Programming DCC CV {0} to value {1} on programming track in direct mode", "Programmiere DCC CV {0} auf Wert {1} auf dem Programmiergleis im Direct Mode", "Programando DCC CV {0} al valor {1} en modo directo" },
 /* TextProgramDccPageRead */ { "Reading DCC CV {0} on programming track in page mode", "Lese DCC CV {0} auf dem Programmiergleis im Page Mode", "Leyendo DCC CV {0} en la vía de programación en modo pagina" },
@@ -596,6 +610,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextReceivedSignalKill */ { "Received a signal kill {0} times. Exiting without saving.", "Signal Kill {0} mal erhalten. Beende RailControl ohne zu speichern.", "Señal Kill recibido {0} veces. Apagando RailControl sin guardar." },
 /* TextReceivedSpeedCommand */ { "Received speed command for locomotive {0}/{1}: {2}", "Geschwindigkeitskommando empfangen für Lokomotive {0}/{1}: {2}", "Recibido comando de velocidad para locomotora {0}/{1}: {2}" },
 /* TextReceiverThreadStarted */ { "Receiver thread started", "Empfangs-Thread gestartet", "Thread recibiendo creado" },
+/* TextRecordingTraffic */ { "Recording the traffic of the hardware to {0}", "Zeichne den Verkehr der Hardware in {0} auf", "Grabando el tráfico del hardware en {0}" },
 /* TextRed */ { "red", "rot", "rojo" },
 /* TextReducedSpeed */ { "Reduced speed", "Reduzierte Geschwindigkeit", "Velocidad reducido" },
 /* TextReducedSpeedAt */ { "Reduce speed at", "Reduziere Geschwindigkeit bei", "Reducir velocidad a" },
@@ -614,6 +629,8 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextReleasingMultipleUnit */ { "Releasing multiple unit", "Mehrfachtraktion wird freigeben", "Liberando unidad múltiple" },
 /* TextRemoveBackupFile */ { "Removing backup file {0}", "Lösche Sicherungskopie {0}", "Eliminando copia de respaldo {0}" },
 /* TextRenamingFromTo */ { "Renaming from {0} to {1}", "Benenne von {0} nach {1} um", "Renombrando de {0} a {1}" },
+/* TextReplayFinished */ { "Replay of {0} finished", "Wiedergabe von {0} beendet", "Reproducción de {0} terminada" },
+/* TextReplayingTraffic */ { "Replaying the traffic of the hardware from {0}", "Gebe den Verkehr der Hardware aus {0} wieder", "Reproduciendo el tráfico del hardware desde {0}" },
 /* TextRestarting */ { "Restarting", "Neustart", "Reiniciando" },
 /* TextRight */ { "right", "rechts", "derecha" },
 /* TextRotation */ { "Rotation", "Drehung", "Rotación", },
@@ -734,6 +751,8 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextSignals */ { "Signals", "Signale", "Señales" },
 /* TextSimpleLeft */ { "simple left", "einfach links", "simple izquierda" },
 /* TextSimpleRight */ { "simple right", "einfach rechts", "simple derecha" },
+/* TextSimulatingTimesRealTime */ { "Simulating {0} times faster than real time", "Simuliere {0} mal schneller als Echtzeit", "Simulando {0} veces más rápido que el tiempo real" },
+/* TextSimulationSpeed */ { "Simulation speed (times real time)", "Simulationsgeschwindigkeit (mal Echtzeit)", "Velocidad de simulación (veces tiempo real)" },
 /* TextSlotHasAddress */ { "Slot {0} has address {1}", "Slot {0} hat Adresse {1}", "Slot {0} tiene dirección {1}" },
 /* TextSpanish */ { "Spanish", "Spanisch", "Español" },
 /* TextSpeed */ { "Speed", "Geschwindigkeit", "Velocidad" },
@@ -891,6 +910,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextUnknownObjectType */ { "Unknown object type", "Unbekannter Objekttyp", "Tipo de objeto desconocido" },
 /* TextUnloadingControl */ { "Unloading control {0}: {1}", "Entlade Zentrale {0}: {1}", "Descargando control {0}: {1}" },
 /* TextUsingRouteFromTimetable */ { "Using route {0} from timetable", "Verwende Fahrstrasse {0} aus dem Fahrplan", "Usando itinerario {0} del horario" },
+/* TextUsingRouteTowardsTimetable */ { "Using route {0} towards route {1} from timetable", "Verwende Fahrstrasse {0} in Richtung Fahrstrasse {1} aus dem Fahrplan", "Usando itinerario {0} hacia itinerario {1} del horario" },
 /* TextValue */ { "Value", "Wert", "Valor" },
 /* TextVersion */ { "Version: {0}", "Version: {0}", "Versión: {0}" },
 /* TextVisible */ { "Visible", "Sichtbar", "Visible" },
@@ -942,3 +962,75 @@ const std::string Languages::GetText(const TextSelector label, const TextSelecto
 	out += "</div></div>";
 	return out;
 }
+
+void Languages::Tokenize(const char* text, std::vector<TextSegment>& segments)
+{
+	segments.clear();
+	if (text == nullptr)
+	{
+		return;
+	}
+	bool used[NoArgument] = { false };
+	size_t literalStart = 0;
+	size_t position = 0;
+	while (text[position] != '\0')
+	{
+		if (text[position] != '{')
+		{
+			++position;
+			continue;
+		}
+
+		size_t end = position + 1;
+		unsigned int argument = 0;
+		while (text[end] >= '0' && text[end] <= '9' && argument < NoArgument)
+		{
+			argument = argument * 10 + (text[end] - '0');
+			++end;
+		}
+		const bool leadingZero = (end > position + 2) && (text[position + 1] == '0');
+		if (end == position + 1 || leadingZero || text[end] != '}' || argument >= NoArgument || used[argument])
+		{
+			++position;
+			continue;
+		}
+		used[argument] = true;
+		++end;
+
+		if (position > literalStart)
+		{
+			segments.push_back({ literalStart, position - literalStart, NoArgument });
+		}
+		segments.push_back({ position, end - position, static_cast<unsigned char>(argument) });
+		literalStart = end;
+		position = end;
+	}
+	if (position > literalStart)
+	{
+		segments.push_back({ literalStart, position - literalStart, NoArgument });
+	}
+}
+
+std::vector<std::vector<Languages::TextSegment>> Languages::TokenizeAll()
+{
+	std::vector<std::vector<TextSegment>> allSegments(MaxTexts * MaxLanguages);
+	for (unsigned int selector = 0; selector < MaxTexts; ++selector)
+	{
+		for (unsigned char language = 0; language < MaxLanguages; ++language)
+		{
+			Tokenize(languages[selector][language], allSegments[selector * MaxLanguages + language]);
+		}
+	}
+	return allSegments;
+}
+
+const std::vector<Languages::TextSegment>& Languages::GetTextSegments(const Language language, const TextSelector selector)
+{
+	static const std::vector<std::vector<TextSegment>> allSegments = TokenizeAll();
+	if (language >= MaxLanguages || selector >= MaxTexts)
+	{
+		static const std::vector<TextSegment> unknownSegments;
+		return unknownSegments;
+	}
+	return allSegments[selector * MaxLanguages + language];
+}
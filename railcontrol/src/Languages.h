@@ -22,6 +22,7 @@ along with RailControl; see the file LICENCE. If not see
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "DataModel/AccessoryBase.h"
 #include "DataTypes.h"
@@ -83,6 +84,7 @@ class Languages
 			TextAutomaticallyAddUnknownFeedbacks,
 			TextAutomode,
 			TextBacktraceLine,
+			TextBackupBeforeBinaryFormat,
 			TextBaseAddress,
 			TextBasic,
 			TextBlockTrack,
@@ -120,6 +122,8 @@ class Languages
 			TextConditionsNotFulfilled,
 			TextConfigFileNotFound,
 			TextConfigFileReceivedWithSize,
+			TextConfigFileSent,
+			TextConfigFileTransferCancelled,
 			TextConfigMenu,
 			TextConfigureControlFirst,
 			TextConnectedTo,
@@ -135,6 +139,7 @@ class Languages
 			TextControlDeleted,
 			TextControlDoesNotAnswer,
 			TextControlDoesNotExist,
+			TextControlQueueOverflow,
 			TextControlReturnedBadParameter,
 			TextControlReturnedError,
 			TextControlReturnedOnHalt,
@@ -144,6 +149,7 @@ class Languages
 			TextControlReturnedUnknownErrorCode,
 			TextControlSaved,
 			TextControls,
+			TextConvertingToBinary,
 			TextCopyingFromTo,
 			TextCounter,
 			TextCounterDecrement,
@@ -292,6 +298,7 @@ class Languages
 			TextHintPositionMove,
 			TextHintPositionRotate,
 			TextHintRedBox,
+			TextHintSimulator,
 			TextHintSystemControl7,
 			TextHintTwinCenter,
 			TextHintVirtual,
@@ -306,6 +313,7 @@ class Languages
 			TextIndependentOfControl,
 			TextIndex,
 			TextInfo,
+			TextInvalidCaptureFile,
 			TextInvalidControlID,
 			TextInvalidDataReceived,
 			TextInverted,
@@ -344,6 +352,7 @@ class Languages
 			TextLength,
 			TextLink,
 			TextLoadedAccessory,
+			TextLoadedAllObjects,
 			TextLoadedCluster,
 			TextLoadedControl,
 			TextLoadedCounter,
@@ -351,6 +360,7 @@ class Languages
 			TextLoadedLayer,
 			TextLoadedLoco,
 			TextLoadedMultipleUnit,
+			TextLoadedPhase,
 			TextLoadedRoute,
 			TextLoadedSignal,
 			TextLoadedSwitch,
@@ -481,6 +491,7 @@ class Languages
 			TextLocoUpdated,
 			TextLocos,
 			TextLogLevel,
+			TextLogMessagesDropped,
 			TextLongestUnused,
 			TextLookingForDestination,
 			TextMaerklinLeft,
@@ -526,7 +537,9 @@ class Languages
 			TextObjectIsUsedByRoute,
 			TextOccupied,
 			TextOff,
+			TextOffDelay,
 			TextOn,
+			TextOnDelay,
 			TextOnPush,
 			TextOpeningSQLite,
 			TextOrientation,
@@ -536,12 +549,14 @@ class Languages
 			TextPause,
 			TextPin,
 			TextPingSenderStarted,
+			TextPlannedPath,
 			TextPleaseSelectLoco,
 			TextPosX,
 			TextPosY,
 			TextPosZ,
 			TextPosition,
 			TextPositionAlreadyInUse,
+			TextPreloadedObjects,
 			TextProgramDccDirectRead,
 			TextProgramDccDirectWrite,
 			TextProgramDccPageRead,
@@ -596,6 +611,7 @@ class Languages
 			TextReceivedSignalKill,
 			TextReceivedSpeedCommand,
 			TextReceiverThreadStarted,
+			TextRecordingTraffic,
 			TextRed,
 			TextReducedSpeed,
 			TextReducedSpeedAt,
@@ -614,6 +630,8 @@ class Languages
 			TextReleasingMultipleUnit,
 			TextRemoveBackupFile,
 			TextRenamingFromTo,
+			TextReplayFinished,
+			TextReplayingTraffic,
 			TextRestarting,
 			TextRight,
 			TextRotation,
@@ -734,6 +752,8 @@ class Languages
 			TextSignals,
 			TextSimpleLeft,
 			TextSimpleRight,
+			TextSimulatingTimesRealTime,
+			TextSimulationSpeed,
 			TextSlotHasAddress,
 			TextSpanish,
 			TextSpeed,
@@ -891,6 +911,7 @@ class Languages
 			TextUnknownObjectType,
 			TextUnloadingControl,
 			TextUsingRouteFromTimetable,
+			TextUsingRouteTowardsTimetable,
 			TextValue,
 			TextVersion,
 			TextVisible,
@@ -963,6 +984,31 @@ class Languages
 			return GetText(state == DataModel::AccessoryStateOn ? TextGreen : TextRed);
 		}
 
+		// A part of a text, either literal text or a placeholder {n} for argument n.
+		// The placeholder text is kept in start and length for the case that the argument is missing.
+		struct TextSegment
+		{
+			size_t start;
+			size_t length;
+			unsigned char argument;
+		};
+
+		static const unsigned char NoArgument = 0xFF;
+
+		// splits text into literal and placeholder segments, only the first occurrence of a placeholder is replaced
+		static void Tokenize(const char* text, std::vector<TextSegment>& segments);
+
+		static inline const std::vector<TextSegment>& GetTextSegments(const TextSelector selector)
+		{
+			return GetTextSegments(defaultLanguage, selector);
+		}
+
+		// the texts of all languages are tokenized once on first use
+		static const std::vector<TextSegment>& GetTextSegments(const Language language, const TextSelector selector);
+
+	private:
+		static std::vector<std::vector<TextSegment>> TokenizeAll();
+
 		static const char* languages[MaxTexts][MaxLanguages];
 		static Language defaultLanguage;
 };
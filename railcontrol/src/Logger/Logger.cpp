@@ -30,7 +30,9 @@ namespace Logger
 {
 	Logger::Level Logger::logLevel = Logger::LevelInfo;
 
-	string Logger::DateTime()
+	thread_local string Logger::lineBuffer;
+
+	void Logger::AppendDateTime(string& output)
 	{
 		char buffer[27];
 		struct timeval timestamp;
@@ -39,20 +41,25 @@ namespace Logger
 		localtime_r(&timestamp.tv_sec, &tm);
 		strftime(buffer, sizeof(buffer), "%F %T.", &tm);
 		snprintf(buffer + 20, sizeof(buffer) - 20, "%06li", static_cast<long>(timestamp.tv_usec));
-		return string(buffer);
+		output.append(buffer, 26);
 	}
 
-	void Logger::Replace(string& workString,
-		const unsigned char argument,
-		const std::string& value)
+	string& Logger::BeginLine(const char* type)
 	{
-		std::string needle = "{" + std::to_string(argument) + "}";
-		size_t pos = workString.find(needle);
-		if (pos == std::string::npos)
-		{
-			return;
-		}
-		workString.replace(pos, needle.size(), value);
+		lineBuffer.clear();
+		AppendDateTime(lineBuffer);
+		lineBuffer.append(": ");
+		lineBuffer.append(type);
+		lineBuffer.append(": ");
+		lineBuffer.append(component);
+		lineBuffer.append(": ");
+		return lineBuffer;
+	}
+
+	void Logger::EndLine(string& line)
+	{
+		line.push_back('\n');
+		server.Send(line);
 	}
 
 	void Logger::AsciiPart(std::stringstream& output, const unsigned char* input, const size_t size)
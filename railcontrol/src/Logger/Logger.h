@@ -21,6 +21,7 @@ along with RailControl; see the file LICENCE. If not see
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "Languages.h"
 #include "Logger/LoggerServer.h"
@@ -81,11 +82,49 @@ namespace Logger
 			template<typename... Args>
 			static std::string Format(const std::string& input, Args... args)
 			{
-				std::string output = input;
-				FormatInternal(output, 0, args...);
+				std::string output;
+				Append(output, input.c_str(), args...);
 				return output;
 			}
 
+			template<typename... Args>
+			static std::string Format(const Languages::TextSelector text, Args... args)
+			{
+				std::string output;
+				Append(output, text, args...);
+				return output;
+			}
+
+			// appends the text in the default language with the arguments in place of their placeholders
+			template<typename... Args>
+			static void Append(std::string& output, const Languages::TextSelector text, Args... args)
+			{
+				const Languages::Language language = Languages::GetDefaultLanguage();
+				AppendSegments(output, Languages::GetText(language, text), Languages::GetTextSegments(language, text), args...);
+			}
+
+			// texts that are not in the language table are tokenized on every call
+			template<typename T, typename... Args>
+			static void Append(std::string& output, const char* text, T value, Args... args)
+			{
+				if (text == nullptr)
+				{
+					return;
+				}
+				std::vector<Languages::TextSegment> segments;
+				Languages::Tokenize(text, segments);
+				AppendSegments(output, text, segments, value, args...);
+			}
+
+			static void Append(std::string& output, const char* text)
+			{
+				if (text == nullptr)
+				{
+					return;
+				}
+				output.append(text);
+			}
+
 			template<typename... Args>
 			static std::string Format(char* input, Args... args)
 			{
@@ -109,7 +148,7 @@ namespace Logger
 				{
 					return;
 				}
-				Log("Error", Languages::GetText(text), args...);
+				Log("Error", text, args...);
 			}
 
 			template<typename... Args> void Warning(const Languages::TextSelector text, Args... args)
@@ -118,7 +157,7 @@ namespace Logger
 				{
 					return;
 				}
-				Log("Warning", Languages::GetText(text), args...);
+				Log("Warning", text, args...);
 			}
 
 			template<typename... Args> void Info(const Languages::TextSelector text, Args... args)
@@ -127,12 +166,16 @@ namespace Logger
 				{
 					return;
 				}
-				Log("Info", Languages::GetText(text), args...);
+				Log("Info", text, args...);
 			}
 
 			template<typename... Args> void Debug(const Languages::TextSelector text, Args... args)
 			{
-				Debug(Languages::GetText(text), args...);
+				if (logLevel < LevelDebug)
+				{
+					return;
+				}
+				Log("Debug", text, args...);
 			}
 
 			template<typename... Args> void Debug(const std::string& text, Args... args)
@@ -172,45 +215,60 @@ namespace Logger
 			const std::string component;
 
 			static void AsciiPart(std::stringstream& output, const unsigned char* input, const size_t size);
-			static std::string DateTime();
+			static void AppendDateTime(std::string& output);
 
-			static void Replace(std::string& workString, const unsigned char argument, const std::string& value);
-			static void Replace(std::string& workString, const unsigned char argument, char* value)
-			{
-				const char* constValue = value;
-				Replace(workString, argument, std::string(constValue));
-			}
-			static void Replace(std::string& workString, const unsigned char argument, const char* value)
-			{
-				Replace(workString, argument, std::string(value == nullptr ? "" : value));
-			}
+			static inline std::string ToString(const std::string& value) { return value; }
+			static inline std::string ToString(char* value) { const char* constValue = value; return ToString(constValue); }
+			static inline std::string ToString(const char* value) { return std::string(value == nullptr ? "" : value); }
 			template<typename T>
-			static void Replace(std::string& workString, const unsigned char argument, T value)
-			{
-				Replace(workString, argument, std::to_string(value));
-			}
+			static inline std::string ToString(T value) { return std::to_string(value); }
 
-			template<typename T>
-			static void FormatInternal(std::string& workString,
-				const unsigned char argument,
-				T value)
+			static void AppendSegments(std::string& output,
+				const char* text,
+				__attribute__((unused)) const std::vector<Languages::TextSegment>& segments)
 			{
-				Replace(workString, argument, value);
+				output.append(text);
 			}
 
+			// one pass over the segments, each argument is converted to a string once
 			template<typename T, typename... Args>
-			static void FormatInternal(std::string& workString,
-				const unsigned char argument,
+			static void AppendSegments(std::string& output,
+				const char* text,
+				const std::vector<Languages::TextSegment>& segments,
 				T value,
 				Args... args)
 			{
-				Replace(workString, argument, value);
-				FormatInternal(workString, argument + 1, args...);
+				const std::string values[] = { ToString(value), ToString(args)... };
+				const size_t numberOfValues = sizeof(values) / sizeof(values[0]);
+				for (auto& segment : segments)
+				{
+					if (segment.argument < numberOfValues)
+					{
+						output.append(values[segment.argument]);
+						continue;
+					}
+					output.append(text + segment.start, segment.length);
+				}
+			}
+
+			// the line is formatted into a buffer of the calling thread that is reused for every message
+			std::string& BeginLine(const char* type);
+			void EndLine(std::string& line);
+
+			template<typename... Args> void Log(const char* type, const Languages::TextSelector text, Args... args)
+			{
+				std::string& line = BeginLine(type);
+				Append(line, text, args...);
+				EndLine(line);
 			}
 
-			template<typename... Args> void Log(const std::string& type, const std::string& text, Args... args)
+			template<typename... Args> void Log(const char* type, const std::string& text, Args... args)
 			{
-				server.Send(DateTime() + ": " + type + ": " + component + ": " + Format(text, args...) + "\n");
+				std::string& line = BeginLine(type);
+				Append(line, text.c_str(), args...);
+				EndLine(line);
 			}
+
+			static thread_local std::string lineBuffer;
 	};
 }
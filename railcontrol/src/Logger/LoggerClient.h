@@ -30,5 +30,8 @@ namespace Logger
 			virtual ~LoggerClient() {}
 
 			virtual void Send(const std::string& s) = 0;
+
+			// called by the logger writer thread after each batch of messages
+			virtual void Flush() {}
 	};
 }
@@ -32,7 +32,12 @@ namespace Logger
 		public:
 			void Send(const std::string& s) override
 			{
-				std::cout << s << std::flush;
+				std::cout << s;
+			}
+
+			void Flush() override
+			{
+				std::cout << std::flush;
 			}
 	};
 }
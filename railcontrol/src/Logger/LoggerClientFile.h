@@ -20,8 +20,11 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
-#include <fstream>
+#include <cerrno>
+#include <chrono>
+#include <fcntl.h>
 #include <string>
+#include <unistd.h>
 
 #include "Logger/LoggerClient.h"
 #include "Utils/Utils.h"
@@ -32,32 +35,66 @@ namespace Logger
 	{
 		public:
 			LoggerClientFile(const std::string& logFileName)
-			:	logFileName(logFileName)
+			:	logFileName(logFileName),
+				lastSync(std::chrono::steady_clock::now())
 			{
-				logFile.open(logFileName, std::fstream::out | std::fstream::app);
+				logFile = open(logFileName.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
 			}
 
 			~LoggerClientFile()
 			{
 				Utils::Utils::RenameFile(nullptr, logFileName, logFileName + "." + std::to_string(time(0)));
-				if (!logFile.is_open())
+				if (logFile < 0)
 				{
 					return;
 				}
-				logFile.close();
+				fsync(logFile);
+				close(logFile);
 			}
 
 			void Send(const std::string& s) override
 			{
-				if (!logFile.is_open())
+				if (logFile < 0)
 				{
 					return;
 				}
-				logFile << s << std::flush;
+				const char* data = s.data();
+				size_t size = s.size();
+				while (size > 0)
+				{
+					const ssize_t written = write(logFile, data, size);
+					if (written < 0)
+					{
+						if (errno == EINTR)
+						{
+							continue;
+						}
+						return;
+					}
+					data += written;
+					size -= written;
+				}
+			}
+
+			// the data is in the kernel after each batch, it is forced to the disk at most once per second
+			void Flush() override
+			{
+				if (logFile < 0)
+				{
+					return;
+				}
+				const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+				if (now - lastSync < std::chrono::seconds(1))
+				{
+					return;
+				}
+				fsync(logFile);
+				lastSync = now;
 			}
 
 		private:
 			const std::string logFileName;
-			std::ofstream logFile;
+			int logFile;
+			std::chrono::steady_clock::time_point lastSync;
 	};
 }
@@ -0,0 +1,120 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <string>
+
+namespace Logger
+{
+	// Lock free single producer single consumer byte ring for log messages.
+	// Each thread that logs owns one ring. The producer copies a complete message or nothing,
+	// so the consumer always sees whole lines.
+	class LoggerRingBuffer
+	{
+		public:
+			static const size_t Size = 64 * 1024; // must be a power of two
+
+			LoggerRingBuffer(const LoggerRingBuffer&) = delete;
+			LoggerRingBuffer& operator=(const LoggerRingBuffer&) = delete;
+
+			inline LoggerRingBuffer()
+			:	head(0),
+				tail(0),
+				dropped(0),
+				orphaned(false)
+			{
+			}
+
+			// producer only, returns false if the message does not fit
+			inline bool Push(const std::string& text)
+			{
+				const size_t size = text.size();
+				const size_t localTail = tail.load(std::memory_order_relaxed);
+				const size_t localHead = head.load(std::memory_order_acquire);
+				if (Size - (localTail - localHead) < size)
+				{
+					return false;
+				}
+				const size_t position = localTail & (Size - 1);
+				const size_t first = std::min(size, Size - position);
+				memcpy(buffer + position, text.data(), first);
+				memcpy(buffer, text.data() + first, size - first);
+				tail.store(localTail + size, std::memory_order_release);
+				return true;
+			}
+
+			// consumer only, appends all pending messages to output
+			inline bool Pop(std::string& output)
+			{
+				const size_t localTail = tail.load(std::memory_order_acquire);
+				const size_t localHead = head.load(std::memory_order_relaxed);
+				const size_t size = localTail - localHead;
+				if (size == 0)
+				{
+					return false;
+				}
+				const size_t position = localHead & (Size - 1);
+				const size_t first = std::min(size, Size - position);
+				output.append(buffer + position, first);
+				output.append(buffer, size - first);
+				head.store(localTail, std::memory_order_release);
+				return true;
+			}
+
+			inline bool IsEmpty() const
+			{
+				return tail.load(std::memory_order_acquire) == head.load(std::memory_order_relaxed);
+			}
+
+			// producer only
+			inline void AddDropped()
+			{
+				dropped.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			// consumer only, returns the number of dropped messages since the last call
+			inline unsigned long long TakeDropped()
+			{
+				return dropped.exchange(0, std::memory_order_relaxed);
+			}
+
+			// called by the owning thread when it exits, the consumer deletes the ring once it is empty
+			inline void SetOrphaned()
+			{
+				orphaned.store(true, std::memory_order_release);
+			}
+
+			inline bool IsOrphaned() const
+			{
+				return orphaned.load(std::memory_order_acquire);
+			}
+
+		private:
+			std::atomic<size_t> head;
+			std::atomic<size_t> tail;
+			std::atomic<unsigned long long> dropped;
+			std::atomic<bool> orphaned;
+			char buffer[Size];
+	};
+}
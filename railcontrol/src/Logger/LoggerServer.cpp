@@ -25,11 +25,54 @@ along with RailControl; see the file LICENCE. If not see
 #include "Utils/Utils.h"
 
 using std::string;
+using std::to_string;
+
+namespace
+{
+	// the ring buffer is handed over to the writer thread when its thread exits
+	class ThreadRingBuffer
+	{
+		public:
+			~ThreadRingBuffer()
+			{
+				if (ringBuffer)
+				{
+					ringBuffer->SetOrphaned();
+				}
+			}
+
+			Logger::LoggerRingBuffer* ringBuffer = nullptr;
+	};
+
+	thread_local ThreadRingBuffer threadRingBuffer;
+}
 
 namespace Logger
 {
+	const std::chrono::milliseconds LoggerServer::IdleInterval(100);
+
 	LoggerServer::~LoggerServer()
 	{
+		{
+			std::lock_guard<std::mutex> guard(writerMutex);
+			run = false;
+		}
+		writerCondition.notify_one();
+		if (writer.joinable())
+		{
+			if (writer.get_id() == std::this_thread::get_id())
+			{
+				writer.detach();
+			}
+			else
+			{
+				writer.join();
+			}
+		}
+
+		// write what is left, ring buffers of threads that are still running are not deleted
+		Drain();
+
 		// delete all client memory
 		{
 			std::lock_guard<std::mutex> guard(clientMutex);
@@ -52,6 +95,7 @@ namespace Logger
 
 	Logger* LoggerServer::GetLogger(const std::string& component)
 	{
+		std::lock_guard<std::mutex> guard(loggerMutex);
 		for (auto logger : loggers)
 		{
 			if (logger->IsComponent(component))
@@ -66,10 +110,152 @@ namespace Logger
 
 	void LoggerServer::Send(const std::string& text)
 	{
-		std::lock_guard<std::mutex> guard(clientMutex);
-		for (auto client : clients)
+		// messages sent before the writer is started wait in the ring buffer and are written with its first batch
+		LoggerRingBuffer* ringBuffer = threadRingBuffer.ringBuffer;
+		if (ringBuffer == nullptr)
+		{
+			ringBuffer = AddRingBuffer();
+		}
+		// a full ring buffer gives the writer a few chances to catch up, on a single core it would never run otherwise
+		for (unsigned char retry = 0; !ringBuffer->Push(text); ++retry)
 		{
-			client->Send(text);
+			if (!run || retry >= MaxPushRetries)
+			{
+				ringBuffer->AddDropped();
+				return;
+			}
+			WakeupWriter();
+			std::this_thread::yield();
+		}
+
+		// pairs with the fence in Writer: either the writer sees the message or we see it waiting
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (writerWaiting)
+		{
+			WakeupWriter();
+		}
+	}
+
+	void LoggerServer::WakeupWriter()
+	{
+		std::lock_guard<std::mutex> guard(writerMutex);
+		writerCondition.notify_one();
+	}
+
+	void LoggerServer::Flush()
+	{
+		Drain();
+	}
+
+	string LoggerServer::GetStatistics() const
+	{
+		return "logger;written;" + to_string(writtenBytes) + ";" + to_string(writtenBatches) + "\n"
+			+ "logger;dropped;" + to_string(droppedMessages) + "\n";
+	}
+
+	void LoggerServer::StartWriter()
+	{
+		if (run)
+		{
+			return;
+		}
+		logger = GetLogger("Logger");
+		run = true;
+		writer = std::thread(&LoggerServer::Writer, this);
+	}
+
+	LoggerRingBuffer* LoggerServer::AddRingBuffer()
+	{
+		LoggerRingBuffer* ringBuffer = new LoggerRingBuffer();
+		{
+			std::lock_guard<std::mutex> guard(ringBufferMutex);
+			ringBuffers.push_back(ringBuffer);
+		}
+		threadRingBuffer.ringBuffer = ringBuffer;
+		return ringBuffer;
+	}
+
+	bool LoggerServer::Drain()
+	{
+		std::lock_guard<std::mutex> drainGuard(drainMutex);
+		string batch;
+		unsigned long long dropped = 0;
+		{
+			std::lock_guard<std::mutex> guard(ringBufferMutex);
+			for (auto iterator = ringBuffers.begin(); iterator != ringBuffers.end();)
+			{
+				LoggerRingBuffer* ringBuffer = *iterator;
+				// check before reading so that the last messages of an exited thread are not lost
+				const bool orphaned = ringBuffer->IsOrphaned();
+				ringBuffer->Pop(batch);
+				dropped += ringBuffer->TakeDropped();
+				if (orphaned)
+				{
+					delete ringBuffer;
+					iterator = ringBuffers.erase(iterator);
+					continue;
+				}
+				++iterator;
+			}
+		}
+
+		if (dropped > 0 && logger)
+		{
+			droppedMessages += dropped;
+			// ends up in the ring buffer of the writer and is written with the next batch
+			logger->Warning(Languages::TextLogMessagesDropped, dropped);
+		}
+
+		if (batch.size() == 0)
+		{
+			return false;
+		}
+
+		{
+			std::lock_guard<std::mutex> guard(clientMutex);
+			for (auto client : clients)
+			{
+				client->Send(batch);
+				client->Flush();
+			}
+		}
+		writtenBytes += batch.size();
+		++writtenBatches;
+		return true;
+	}
+
+	bool LoggerServer::HasPendingMessages()
+	{
+		std::lock_guard<std::mutex> guard(ringBufferMutex);
+		for (auto ringBuffer : ringBuffers)
+		{
+			if (!ringBuffer->IsEmpty())
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void LoggerServer::Writer()
+	{
+		Utils::Utils::SetThreadName("Logger");
+		while (run)
+		{
+			if (Drain())
+			{
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(writerMutex);
+			writerWaiting = true;
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (run && !HasPendingMessages())
+			{
+				writerCondition.wait_for(lock, IdleInterval);
+			}
+			writerWaiting = false;
 		}
+		Drain();
 	}
 }
@@ -20,20 +20,27 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <fstream>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "Logger/LoggerClient.h"
 #include "Logger/LoggerClientConsole.h"
 #include "Logger/LoggerClientFile.h"
 #include "Logger/LoggerClientTcp.h"
+#include "Logger/LoggerRingBuffer.h"
 
 namespace Logger
 {
 	class Logger;
 
+	// Send only copies the message into the ring buffer of the calling thread.
+	// A writer thread collects the messages of all threads and hands them to the clients in batches.
 	class LoggerServer
 	{
 		public:
@@ -44,6 +51,11 @@ namespace Logger
 
 			void Send(const std::string& text);
 
+			// writes all pending messages before returning
+			void Flush();
+
+			std::string GetStatistics() const;
+
 			static inline LoggerServer& Instance()
 			{
 				static LoggerServer server;
@@ -59,6 +71,7 @@ namespace Logger
 				std::lock_guard<std::mutex> guard(clientMutex);
 				clients.push_back(new LoggerClientFile(fileName));
 				fileLoggerStarted = true;
+				StartWriter();
 			}
 
 			inline void AddConsoleLogger()
@@ -70,22 +83,63 @@ namespace Logger
 				std::lock_guard<std::mutex> guard(clientMutex);
 				clients.push_back(new LoggerClientConsole());
 				consoleLoggerStarted = true;
+				StartWriter();
 			}
 
 		private:
 			inline LoggerServer()
 			:	fileLoggerStarted(false),
-				consoleLoggerStarted(false)
+				consoleLoggerStarted(false),
+				logger(nullptr),
+				run(false),
+				writerWaiting(false),
+				writtenBytes(0),
+				writtenBatches(0),
+				droppedMessages(0)
 			{
 			}
 
 			~LoggerServer();
 
+			// must be called with locked clientMutex
+			void StartWriter();
+
+			LoggerRingBuffer* AddRingBuffer();
+
+			// returns true if messages have been written
+			bool Drain();
+
+			void WakeupWriter();
+
+			bool HasPendingMessages();
+
+			void Writer();
+
+			static const std::chrono::milliseconds IdleInterval;
+			static const unsigned char MaxPushRetries = 8;
+
 			bool fileLoggerStarted;
 			bool consoleLoggerStarted;
 			std::vector<LoggerClient*> clients;
 			std::vector<Logger*> loggers;
+			// objects are deserialized in parallel at startup and get their loggers from several threads
+			std::mutex loggerMutex;
+			Logger* logger;
 
 			std::mutex clientMutex;
+
+			std::vector<LoggerRingBuffer*> ringBuffers;
+			std::mutex ringBufferMutex;
+			std::mutex drainMutex;
+
+			std::atomic<bool> run;
+			std::atomic<bool> writerWaiting;
+			std::mutex writerMutex;
+			std::condition_variable writerCondition;
+			std::thread writer;
+
+			std::atomic<unsigned long long> writtenBytes;
+			std::atomic<unsigned long long> writtenBatches;
+			std::atomic<unsigned long long> droppedMessages;
 	};
 }
@@ -66,10 +66,17 @@ Manager::Manager(Config& config)
 	selectRouteApproach(DataModel::SelectRouteRandom),
 	nrOfTracksToReserve(DataModel::Loco::ReserveOne),
 	run(false),
-	debounceRun(false),
 	controlCheckerRun(false),
+	timerScheduler("Timer"),
+	debounceScheduler(Languages::GetText(Languages::TextDebouncer)),
+	routeReservationConflicts(0),
+	autoModeDispatcher(NumberOfAutoModeWorkers),
 	initLocosDone(false),
 	serverEnabled(false),
+	cs2Revision(0),
+	captureDirectory(config.getStringValue("capturedirectory", "")),
+	replayDirectory(config.getStringValue("replaydirectory", "")),
+	replaySpeed(config.getIntValue("replayspeed", 1)),
 	unknownControl(Languages::GetText(Languages::TextControlDoesNotExist)),
 	unknownLoco(Languages::GetText(Languages::TextLocoDoesNotExist)),
 	unknownMultipleUnit(Languages::GetText(Languages::TextMultipleUnitDoesNotExist)),
@@ -123,7 +130,33 @@ Manager::Manager(Config& config)
 		logger->Info(Languages::TextLoadedControl, hardwareParam.first, hardwareParam.second->GetName());
 	}
 
-	storage->AllLayers(layers);
+	{
+		std::lock_guard<std::mutex> guard(controlMutex);
+		for (auto& control : controls)
+		{
+			ControlDispatcherAddUnlocked(control.first, control.second);
+		}
+	}
+
+	const std::chrono::steady_clock::time_point loadStart = std::chrono::steady_clock::now();
+	size_t nrOfObjects;
+	size_t nrOfRelations;
+	storage->Preload(nrOfObjects, nrOfRelations);
+	logger->Info(Languages::TextPreloadedObjects, nrOfObjects, nrOfRelations,
+		std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - loadStart).count());
+
+	// objects that do not refer to other objects
+	LoadParallel(1,
+		{
+			[this]() { storage->AllLayers(layers); },
+			[this]() { storage->AllTexts(texts); },
+			[this]() { storage->AllAccessories(accessories); },
+			[this]() { storage->AllFeedbacks(feedbacks); },
+			[this]() { storage->AllSignals(signals); },
+			[this]() { storage->AllSwitches(switches); },
+			[this]() { storage->AllCounters(counters); }
+		});
+
 	for (auto& layer : layers)
 	{
 		logger->Info(Languages::TextLoadedLayer, layer.second->GetID(), layer.second->GetName());
@@ -138,31 +171,43 @@ Manager::Manager(Config& config)
 		}
 	}
 
-	storage->AllTexts(texts);
 	for (auto& text : texts)
 	{
 		logger->Info(Languages::TextLoadedText, text.second->GetID(), text.second->GetName());
 	}
 
-	storage->AllAccessories(accessories);
 	for (auto& accessory : accessories)
 	{
 		logger->Info(Languages::TextLoadedAccessory, accessory.second->GetID(), accessory.second->GetName());
 	}
 
-	storage->AllFeedbacks(feedbacks);
 	for (auto& feedback : feedbacks)
 	{
 		logger->Info(Languages::TextLoadedFeedback, feedback.second->GetID(), feedback.second->GetName());
+		FeedbackHardwareIndexAddUnlocked(feedback.second);
 	}
 
-	storage->AllSignals(signals);
 	for (auto& signal : signals)
 	{
 		logger->Info(Languages::TextLoadedSignal, signal.second->GetID(), signal.second->GetName());
 	}
 
-	storage->AllTracks(tracks);
+	for (auto& mySwitch : switches)
+	{
+		logger->Info(Languages::TextLoadedSwitch, mySwitch.second->GetID(), mySwitch.second->GetName());
+	}
+
+	for (auto& counter : counters)
+	{
+		logger->Info(Languages::TextLoadedCounter, counter.second->GetID(), counter.second->GetName());
+	}
+
+	// tracks refer to feedbacks and signals
+	LoadParallel(2,
+		{
+			[this]() { storage->AllTracks(tracks); }
+		});
+
 	for (auto& t : tracks)
 	{
 		Track* track = t.second;
@@ -175,44 +220,45 @@ Manager::Manager(Config& config)
 		logger->Info(Languages::TextLoadedTrack, track->GetID(), track->GetName());
 	}
 
-	storage->AllSwitches(switches);
-	for (auto& mySwitch : switches)
-	{
-		logger->Info(Languages::TextLoadedSwitch, mySwitch.second->GetID(), mySwitch.second->GetName());
-	}
+	// clusters, routes and locos refer to tracks
+	LoadParallel(3,
+		{
+			[this]() { storage->AllClusters(clusters); },
+			[this]() { storage->AllRoutes(routes); },
+			[this]() { storage->AllLocos(locos); }
+		});
 
-	storage->AllClusters(clusters);
 	for (auto& cluster : clusters)
 	{
 		logger->Info(Languages::TextLoadedCluster, cluster.second->GetID(), cluster.second->GetName());
 	}
 
-	storage->AllRoutes(routes);
 	for (auto& route : routes)
 	{
 		logger->Info(Languages::TextLoadedRoute, route.second->GetID(), route.second->GetName());
+		routeGraph.Update(route.second);
+		routeGraph.SetLocoBase(route.first, route.second->GetLocoBase());
 	}
 
-	storage->AllCounters(counters);
-	for (auto& counter : counters)
-	{
-		logger->Info(Languages::TextLoadedCounter, counter.second->GetID(), counter.second->GetName());
-	}
-
-	storage->AllLocos(locos);
 	for (auto& loco : locos)
 	{
 		logger->Info(Languages::TextLoadedLoco, loco.second->GetID(), loco.second->GetName());
 	}
 
-	storage->AllMultipleUnits(multipleUnits);
+	// multiple units refer to locos
+	LoadParallel(4,
+		{
+			[this]() { storage->AllMultipleUnits(multipleUnits); }
+		});
+
 	for (auto& multipleUnit : multipleUnits)
 	{
 		logger->Info(Languages::TextLoadedMultipleUnit, multipleUnit.second->GetID(), multipleUnit.second->GetName());
 	}
 
-	debounceRun = true;
-	debounceThread = std::thread(&Manager::DebounceWorker, this);
+	storage->ReleasePreload();
+	logger->Info(Languages::TextLoadedAllObjects,
+		std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - loadStart).count());
 
 	{
 		std::lock_guard<std::mutex> guard(controlMutex);
@@ -229,6 +275,40 @@ Manager::Manager(Config& config)
 	InitLocos();
 }
 
+void Manager::LoadParallel(const unsigned char phase, const std::vector<std::function<void()>>& loaders)
+{
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	const size_t nrOfThreads = std::max(static_cast<size_t>(1), std::min(loaders.size(), static_cast<size_t>(std::thread::hardware_concurrency())));
+	std::atomic<size_t> next(0);
+	auto worker = [&loaders, &next]()
+	{
+		for (size_t loader = next++; loader < loaders.size(); loader = next++)
+		{
+			loaders[loader]();
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t thread = 1; thread < nrOfThreads; ++thread)
+	{
+		threads.push_back(std::thread(
+			[&worker]()
+			{
+				Utils::Utils::SetThreadName("Loader");
+				worker();
+			}));
+	}
+	// the calling thread is part of the pool and keeps its name
+	worker();
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	logger->Info(Languages::TextLoadedPhase, phase, loaders.size(), nrOfThreads,
+		std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
 Manager::~Manager()
 {
 	while (!LocoBaseStopAll())
@@ -239,12 +319,25 @@ Manager::~Manager()
 	controlCheckerRun = false;
 	controlCheckerThread.join();
 
-	debounceRun = false;
-	debounceThread.join();
+	// a pending debounce would publish a feedback state while everything is shut down
+	debounceScheduler.Terminate(false);
+	logger->Info(Languages::TextDebounceThreadTerminated);
+
+	autoModeDispatcher.Terminate();
+	timerScheduler.Terminate();
 
 	Booster(ControlTypeInternal, BoosterStateStop);
 
 	run = false;
+	{
+		std::map<ControlID,std::shared_ptr<ControlDispatcher>> dispatchers;
+		{
+			std::lock_guard<std::mutex> guard(controlMutex);
+			dispatchers.swap(controlDispatchers);
+		}
+		// delivers all waiting updates including the booster stop
+		dispatchers.clear();
+	}
 	{
 		std::lock_guard<std::mutex> guard(controlMutex);
 		for (auto& control : controls)
@@ -296,6 +389,7 @@ Manager::~Manager()
 		DeleteAllMapEntries(tracks, trackMutex);
 		DeleteAllMapEntries(signals, signalMutex);
 		DeleteAllMapEntries(feedbacks, feedbackMutex);
+		feedbacksByHardware.clear();
 		DeleteAllMapEntries(accessories, accessoryMutex);
 		DeleteAllMapEntries(texts, textMutex);
 		DeleteAllMapEntries(layers, layerMutex);
@@ -333,12 +427,18 @@ void Manager::Booster(const ControlType controlType, const BoosterState state)
 	boosterState = state;
 	{
 		std::lock_guard<std::mutex> guard(controlMutex);
-		for (auto& control : controls)
+		for (auto& dispatcher : controlDispatchers)
 		{
-			control.second->Booster(controlType, state);
+			ControlInterface* control = dispatcher.second->GetControl();
+			dispatcher.second->PostUrgent([control, controlType, state]() { control->Booster(controlType, state); });
 		}
 	}
 
+	if (boosterState == BoosterStateGo)
+	{
+		autoModeDispatcher.WakeupAll();
+	}
+
 	if (boosterState != BoosterStateGo || initLocosDone)
 	{
 		return;
@@ -481,6 +581,7 @@ bool Manager::ControlSave(ControlID controlID,
 			return false;
 		}
 		controls[controlID] = control;
+		ControlDispatcherAddUnlocked(controlID, control);
 		return true;
 	}
 
@@ -511,20 +612,32 @@ bool Manager::ControlDelete(ControlID controlID)
 		hardwareParams.erase(controlID);
 		delete params;
 	}
+	ControlInterface* control = nullptr;
+	std::shared_ptr<ControlDispatcher> dispatcher;
 	{
 		std::lock_guard<std::mutex> guard(controlMutex);
 		if (controls.count(controlID) != 1)
 		{
 			return false;
 		}
-		ControlInterface* control = controls.at(controlID);
+		control = controls.at(controlID);
 		if (!control)
 		{
 			return false;
 		}
 		controls.erase(controlID);
-		delete control;
+		auto dispatcherEntry = controlDispatchers.find(controlID);
+		if (dispatcherEntry != controlDispatchers.end())
+		{
+			dispatcher = dispatcherEntry->second;
+			controlDispatchers.erase(dispatcherEntry);
+		}
+	}
+	if (dispatcher)
+	{
+		dispatcher->Terminate();
 	}
+	delete control;
 
 	if (storage)
 	{
@@ -691,6 +804,17 @@ const LocoConfig Manager::GetLoco(const LocoID locoID) const
 	return LocoConfig(*loco);
 }
 
+const LocoConfig Manager::GetLoco(const ControlID controlID, const Protocol protocol, const Address address) const
+{
+	std::lock_guard<std::mutex> guard(locoMutex);
+	const Loco* loco = GetLocoInternal(controlID, protocol, address);
+	if (!loco)
+	{
+		return LocoConfig(LocoTypeNone);
+	}
+	return LocoConfig(*loco);
+}
+
 const string& Manager::GetLocoName(const LocoID locoID) const
 {
 	std::lock_guard<std::mutex> guard(locoMutex);
@@ -923,6 +1047,7 @@ bool Manager::LocoSave(LocoID locoID,
 	{
 		control.second->LocoSettings(locoID, name, matchKey);
 	}
+	Cs2Changed();
 	return true;
 }
 
@@ -966,6 +1091,7 @@ bool Manager::LocoDelete(const LocoID locoID, string& result)
 		control.second->LocoDelete(locoID, name, matchKey);
 	}
 	delete loco;
+	Cs2Changed();
 	return true;
 }
 
@@ -1378,6 +1504,7 @@ bool Manager::LocoBaseSpeedInternal(LocoBase* locoBase,
 	}
 	logger->Info(Languages::TextLocoSpeedIs, locoName, newSpeed);
 	locoBase->SetSpeed(newSpeed);
+	Cs2Changed();
 	return true;
 }
 
@@ -1391,10 +1518,12 @@ void Manager::LocoBasePublishSpeed(const ControlType controlType,
 	const string& name,
 	const Speed speed)
 {
+	const unsigned long long object = ControlDispatcher::ObjectKey(locoType == LocoTypeMultipleUnit ? ObjectTypeMultipleUnit : ObjectTypeLoco, locoID);
 	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto& control : controls)
+	for (auto& dispatcher : controlDispatchers)
 	{
-		control.second->LocoBaseSpeed(controlType, controlID, locoID, locoType, protocol, address, serverAddress, name, speed);
+		ControlInterface* control = dispatcher.second->GetControl();
+		dispatcher.second->Post(object, LocoDispatchSpeed, [=]() { control->LocoBaseSpeed(controlType, controlID, locoID, locoType, protocol, address, serverAddress, name, speed); });
 	}
 }
 
@@ -1465,6 +1594,7 @@ bool Manager::LocoBaseOrientation(LocoBase* locoBase,
 	}
 	logger->Info(newOrientation ? Languages::TextLocoDirectionOfTravelIsRight : Languages::TextLocoDirectionOfTravelIsLeft, locoBase->GetName());
 	locoBase->SetOrientation(newOrientation);
+	Cs2Changed();
 	return true;
 }
 
@@ -1478,10 +1608,12 @@ void Manager::LocoBasePublishOrientation(const ControlType controlType,
 	const string& name,
 	const Orientation orientation)
 {
+	const unsigned long long object = ControlDispatcher::ObjectKey(locoType == LocoTypeMultipleUnit ? ObjectTypeMultipleUnit : ObjectTypeLoco, locoID);
 	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto& control : controls)
+	for (auto& dispatcher : controlDispatchers)
 	{
-		control.second->LocoBaseOrientation(controlType, controlID, locoID, locoType, protocol, address, serverAddress, name, orientation);
+		ControlInterface* control = dispatcher.second->GetControl();
+		dispatcher.second->Post(object, LocoDispatchOrientation, [=]() { control->LocoBaseOrientation(controlType, controlID, locoID, locoType, protocol, address, serverAddress, name, orientation); });
 	}
 }
 
@@ -1548,6 +1680,7 @@ bool Manager::LocoBaseFunctionState(LocoBase* locoBase,
 	}
 	logger->Info(newState ? Languages::TextLocoFunctionIsOn : Languages::TextLocoFunctionIsOff, locoBase->GetName(), function);
 	locoBase->SetFunctionState(function, newState);
+	Cs2Changed();
 	return true;
 }
 
@@ -1562,10 +1695,12 @@ void Manager::LocoBasePublishFunctionState(const ControlType controlType,
 	const DataModel::LocoFunctionNr function,
 	const DataModel::LocoFunctionState state)
 {
+	const unsigned long long object = ControlDispatcher::ObjectKey(locoType == LocoTypeMultipleUnit ? ObjectTypeMultipleUnit : ObjectTypeLoco, locoID);
 	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto& control : controls)
+	for (auto& dispatcher : controlDispatchers)
 	{
-		control.second->LocoBaseFunctionState(controlType, controlID, locoID, locoType, protocol, address, serverAddress, name, function, state);
+		ControlInterface* control = dispatcher.second->GetControl();
+		dispatcher.second->Post(object, LocoDispatchFunction + function, [=]() { control->LocoBaseFunctionState(controlType, controlID, locoID, locoType, protocol, address, serverAddress, name, function, state); });
 	}
 }
 
@@ -1780,11 +1915,15 @@ void Manager::AccessoryState(const ControlType controlType, Accessory* accessory
 		}
 	}
 	accessory->SetAccessoryState(state);
+	// routes may have the state as condition
+	autoModeDispatcher.Wakeup(accessory->GetObjectIdentifier());
 
+	const unsigned long long object = ControlDispatcher::ObjectKey(ObjectTypeAccessory, accessory->GetID());
 	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto& control : controls)
+	for (auto& dispatcher : controlDispatchers)
 	{
-		control.second->AccessoryState(controlType, accessory);
+		ControlInterface* control = dispatcher.second->GetControl();
+		dispatcher.second->Post(object, 0, [control, controlType, accessory]() { control->AccessoryState(controlType, accessory); });
 	}
 }
 
@@ -1967,6 +2106,8 @@ bool Manager::AccessoryRotate(const AccessoryID accessoryID,
 
 void Manager::AccessorySaveAndPublishSettings(const Accessory* const accessory)
 {
+	Cs2Changed();
+
 	// save in db
 	if (storage)
 	{
@@ -2035,12 +2176,14 @@ bool Manager::AccessoryDelete(const AccessoryID accessoryID,
 	}
 	const string& name = accessory->GetName();
 	const string& matchKey = accessory->GetMatchKey();
+	ControlsWaitUntilDelivered();
 	std::lock_guard<std::mutex> guard(controlMutex);
 	for (auto& control : controls)
 	{
 		control.second->AccessoryDelete(accessoryID, name, matchKey);
 	}
 	delete accessory;
+	Cs2Changed();
 	return true;
 }
 
@@ -2051,7 +2194,9 @@ bool Manager::AccessoryRelease(const AccessoryID accessoryID)
 	{
 		return false;
 	}
-	return accessory->Release(logger, accessory->GetLocoBase());
+	const bool ret = accessory->Release(logger, accessory->GetLocoBase());
+	autoModeDispatcher.Wakeup(accessory->GetObjectIdentifier());
+	return ret;
 }
 
 AccessoryConfig Manager::GetAccessoryOfConfigByMatchKey(const ControlID controlId, const string& matchKey) const
@@ -2096,12 +2241,13 @@ void Manager::FeedbackState(const ControlID controlID,
 	const FeedbackPin pin,
 	const FeedbackDevice device,
 	const FeedbackBus bus,
-	const DataModel::Feedback::FeedbackState state)
+	const DataModel::Feedback::FeedbackState state,
+	const std::chrono::steady_clock::time_point timestamp)
 {
 	Feedback* feedback = GetFeedback(controlID, pin, device, bus);
 	if (feedback)
 	{
-		feedback->SetState(logger, state);
+		feedback->SetState(logger, state, timestamp);
 		return;
 	}
 
@@ -2116,7 +2262,7 @@ void Manager::FeedbackState(const ControlID controlID,
 	logger->Info(Languages::TextAddingFeedback, name);
 	string result;
 
-	FeedbackSave(FeedbackNone, name, DataModel::LayoutItem::VisibleNo, 0, 0, 0, DataModel::LayoutItem::Rotation0, controlID, "", pin, device, bus, false, FeedbackTypeDefault, RouteNone, result);
+	FeedbackSave(FeedbackNone, name, DataModel::LayoutItem::VisibleNo, 0, 0, 0, DataModel::LayoutItem::Rotation0, controlID, "", pin, device, bus, false, FeedbackTypeDefault, RouteNone, Feedback::DefaultOnDelay, Feedback::DefaultOffDelay, result);
 }
 
 void Manager::FeedbackState(const FeedbackID feedbackID, const DataModel::Feedback::FeedbackState state)
@@ -2126,7 +2272,7 @@ void Manager::FeedbackState(const FeedbackID feedbackID, const DataModel::Feedba
 	{
 		return;
 	}
-	feedback->SetState(logger, state);
+	feedback->SetState(logger, state, std::chrono::steady_clock::now());
 }
 
 void Manager::FeedbackPublishState(const Feedback* feedback)
@@ -2139,15 +2285,28 @@ void Manager::FeedbackPublishState(const Feedback* feedback)
 	const string& feedbackName = feedback->GetName();
 	logger->Info(state ? Languages::TextFeedbackStateIsOn : Languages::TextFeedbackStateIsOff, feedbackName);
 	const FeedbackID feedbackID = feedback->GetID();
+	// routes may have the state of the feedback as condition
+	autoModeDispatcher.Wakeup(feedback->GetObjectIdentifier());
+	const unsigned long long object = ControlDispatcher::ObjectKey(ObjectTypeFeedback, feedbackID);
 	{
 		std::lock_guard<std::mutex> guard(controlMutex);
-		for (auto& control : controls)
+		for (auto& dispatcher : controlDispatchers)
 		{
-			control.second->FeedbackState(feedbackName, feedbackID, state);
+			ControlInterface* control = dispatcher.second->GetControl();
+			dispatcher.second->Post(object, 0, [control, feedbackName, feedbackID, state]() { control->FeedbackState(feedbackName, feedbackID, state); });
 		}
 	}
 }
 
+Utils::TimerScheduler::TimerID Manager::FeedbackDebounceAt(Feedback* feedback,
+	const std::chrono::steady_clock::time_point deadline,
+	const unsigned int generation)
+{
+	return debounceScheduler.ScheduleAt(deadline,
+		[this, feedback, generation]() { feedback->Debounce(logger, generation); },
+		feedback);
+}
+
 Feedback* Manager::GetFeedback(const FeedbackID feedbackID) const
 {
 	std::lock_guard<std::mutex> guard(feedbackMutex);
@@ -2169,15 +2328,43 @@ Feedback* Manager::GetFeedback(const ControlID controlID,
 	const FeedbackBus bus) const
 {
 	std::lock_guard<std::mutex> guard(feedbackMutex);
+	auto feedback = feedbacksByHardware.find(FeedbackHardwareKey(controlID, pin, device, bus));
+	if (feedback == feedbacksByHardware.end())
+	{
+		return nullptr;
+	}
+	return feedback->second;
+}
+
+void Manager::FeedbackHardwareIndexAddUnlocked(Feedback* feedback)
+{
+	// if more feedbacks use the same contact the one with the lowest ID wins
+	Feedback*& entry = feedbacksByHardware[GetFeedbackHardwareKey(feedback)];
+	if (!entry || entry->GetID() > feedback->GetID())
+	{
+		entry = feedback;
+	}
+}
+
+void Manager::FeedbackHardwareIndexRemoveUnlocked(const Feedback* feedback)
+{
+	const FeedbackHardwareKey key = GetFeedbackHardwareKey(feedback);
+	auto entry = feedbacksByHardware.find(key);
+	if (entry == feedbacksByHardware.end() || entry->second != feedback)
+	{
+		return;
+	}
+	feedbacksByHardware.erase(entry);
+
+	// another feedback may use the same contact
 	for (auto& f : feedbacks)
 	{
-		Feedback* feedback = f.second;
-		if (feedback->CheckControl(controlID, device, bus) && (feedback->GetPin() == pin))
+		if (f.second != feedback && GetFeedbackHardwareKey(f.second) == key)
 		{
-			return feedback;
+			feedbacksByHardware[key] = f.second;
+			return;
 		}
 	}
-	return nullptr;
 }
 
 const std::string& Manager::GetFeedbackName(const FeedbackID feedbackID) const
@@ -2224,6 +2411,8 @@ bool Manager::FeedbackSave(FeedbackID feedbackID,
 	const bool inverted,
 	const FeedbackType feedbackType,
 	const RouteID routeId,
+	const Delay onDelay,
+	const Delay offDelay,
 	string& result)
 {
 	Feedback* feedback = GetFeedback(feedbackID);
@@ -2252,14 +2441,21 @@ bool Manager::FeedbackSave(FeedbackID feedbackID,
 	feedback->SetPosY(posY);
 	feedback->SetPosZ(posZ);
 	feedback->SetRotation(rotation);
-	feedback->SetControlID(controlID);
-	feedback->SetMatchKey(matchKey);
-	feedback->SetPin(pin);
-	feedback->SetDevice(device);
-	feedback->SetBus(bus);
+	{
+		std::lock_guard<std::mutex> guard(feedbackMutex);
+		FeedbackHardwareIndexRemoveUnlocked(feedback);
+		feedback->SetControlID(controlID);
+		feedback->SetMatchKey(matchKey);
+		feedback->SetPin(pin);
+		feedback->SetDevice(device);
+		feedback->SetBus(bus);
+		FeedbackHardwareIndexAddUnlocked(feedback);
+	}
 	feedback->SetInverted(inverted);
 	feedback->SetFeedbackType(feedbackType);
 	feedback->SetRouteId(routeId);
+	feedback->SetOnDelay(onDelay);
+	feedback->SetOffDelay(offDelay);
 
 	FeedbackSaveAndPublishSettings(feedback);
 	return true;
@@ -2401,8 +2597,10 @@ bool Manager::FeedbackDelete(const FeedbackID feedbackID,
 			return false;
 		}
 
+		FeedbackHardwareIndexRemoveUnlocked(feedback);
 		feedbacks.erase(feedbackID);
 	}
+	debounceScheduler.CancelAll(feedback);
 
 	if (storage)
 	{
@@ -2678,6 +2876,8 @@ bool Manager::TrackRotate(const TrackID trackID,
 
 void Manager::TrackSaveAndPublishSettings(const Track* const track)
 {
+	Cs2Changed();
+
 	TrackSave(track);
 
 	std::lock_guard<std::mutex> guard(controlMutex);
@@ -2734,6 +2934,7 @@ bool Manager::TrackDelete(const TrackID trackID,
 		storage->DeleteTrack(trackID);
 	}
 	const string& name = track->GetName();
+	ControlsWaitUntilDelivered();
 	std::lock_guard<std::mutex> guard(controlMutex);
 	for (auto& control : controls)
 	{
@@ -2747,6 +2948,7 @@ bool Manager::TrackDelete(const TrackID trackID,
 	}
 
 	delete track;
+	Cs2Changed();
 	return true;
 }
 
@@ -2789,11 +2991,15 @@ void Manager::SwitchState(const ControlType controlType, Switch* mySwitch, const
 		}
 	}
 	mySwitch->SetAccessoryState(state);
+	// routes may have the state as condition
+	autoModeDispatcher.Wakeup(mySwitch->GetObjectIdentifier());
 
+	const unsigned long long object = ControlDispatcher::ObjectKey(ObjectTypeSwitch, mySwitch->GetID());
 	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto& control : controls)
+	for (auto& dispatcher : controlDispatchers)
 	{
-		control.second->SwitchState(controlType, mySwitch);
+		ControlInterface* control = dispatcher.second->GetControl();
+		dispatcher.second->Post(object, 0, [control, controlType, mySwitch]() { control->SwitchState(controlType, mySwitch); });
 	}
 }
 
@@ -2941,6 +3147,8 @@ bool Manager::SwitchRotate(const SwitchID switchID,
 
 void Manager::SwitchSaveAndPublishSettings(const Switch* const mySwitch)
 {
+	Cs2Changed();
+
 	if (storage)
 	{
 		TransactionGuard guard(storage);
@@ -2989,12 +3197,14 @@ bool Manager::SwitchDelete(const SwitchID switchID,
 
 	const string& name = mySwitch->GetName();
 	const string& matchKey = mySwitch->GetMatchKey();
+	ControlsWaitUntilDelivered();
 	std::lock_guard<std::mutex> guard(controlMutex);
 	for (auto& control : controls)
 	{
 		control.second->SwitchDelete(switchID, name, matchKey);
 	}
 	delete mySwitch;
+	Cs2Changed();
 	return true;
 }
 
@@ -3024,7 +3234,9 @@ bool Manager::SwitchRelease(const RouteID switchID)
 	{
 		return false;
 	}
-	return mySwitch->Release(logger, mySwitch->GetLocoBase());
+	const bool ret = mySwitch->Release(logger, mySwitch->GetLocoBase());
+	autoModeDispatcher.Wakeup(mySwitch->GetObjectIdentifier());
+	return ret;
 }
 
 Switch* Manager::GetSwitchByMatchKey(const ControlID controlId, const string& matchKey) const
@@ -3103,6 +3315,31 @@ Route* Manager::GetRoute(const RouteID routeID) const
 	return routes.at(routeID);
 }
 
+const Route* Manager::GetReservedRouteOfLocoBase(const ObjectIdentifier& locoBaseIdentifier,
+	TrackID fromTrackID) const
+{
+	if (fromTrackID == TrackNone)
+	{
+		std::lock_guard<std::mutex> guard(locoMutex);
+		const LocoBase* locoBase = GetLocoBaseInternal(locoBaseIdentifier);
+		if (!locoBase)
+		{
+			return nullptr;
+		}
+		fromTrackID = locoBase->GetTrackId();
+	}
+
+	std::lock_guard<std::mutex> guard(routeMutex);
+	for (auto& route : routes)
+	{
+		if (route.second->GetLocoBase() == locoBaseIdentifier && route.second->GetFromTrack() == fromTrackID)
+		{
+			return route.second;
+		}
+	}
+	return nullptr;
+}
+
 const string& Manager::GetRouteName(const RouteID routeID) const
 {
 	std::lock_guard<std::mutex> guard(routeMutex);
@@ -3241,6 +3478,8 @@ bool Manager::RouteSave(RouteID routeID,
 		route->SetFollowUpRoute(RouteNone);
 	}
 
+	routeGraph.Update(route);
+
 	// Add new route
 	Track* newTrack = GetTrack(route->GetFromTrack());
 	if (newTrack)
@@ -3342,6 +3581,7 @@ bool Manager::RouteDelete(const RouteID routeID,
 			std::lock_guard<std::mutex> guard(routeMutex);
 			routes.erase(routeID);
 		}
+		routeGraph.Remove(routeID);
 	}
 
 	if (storage)
@@ -3468,6 +3708,7 @@ bool Manager::LayerSave(LayerID layerID, const std::string&name, std::string& re
 	{
 		control.second->LayerSettings(layerID, name);
 	}
+	Cs2Changed();
 	return true;
 }
 
@@ -3594,6 +3835,7 @@ bool Manager::LayerDelete(const LayerID layerID,
 		control.second->LayerDelete(layerID, layerName);
 	}
 	delete layer;
+	Cs2Changed();
 	return true;
 }
 
@@ -3635,6 +3877,8 @@ bool Manager::SignalState(const ControlType controlType, Signal* signal, const D
 		return true;
 	}
 	signal->SetAccessoryState(state);
+	// routes may have the state as condition
+	autoModeDispatcher.Wakeup(signal->GetObjectIdentifier());
 
 	SignalPublishState(controlType, signal);
 	return true;
@@ -3642,10 +3886,12 @@ bool Manager::SignalState(const ControlType controlType, Signal* signal, const D
 
 void Manager::SignalPublishState(const ControlType controlType, const DataModel::Signal* signal)
 {
+	const unsigned long long object = ControlDispatcher::ObjectKey(ObjectTypeSignal, signal->GetID());
 	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto& control : controls)
+	for (auto& dispatcher : controlDispatchers)
 	{
-		control.second->SignalState(controlType, signal);
+		ControlInterface* control = dispatcher.second->GetControl();
+		dispatcher.second->Post(object, 0, [control, controlType, signal]() { control->SignalState(controlType, signal); });
 	}
 }
 
@@ -3789,6 +4035,8 @@ bool Manager::SignalRotate(const SignalID signalID,
 
 void Manager::SignalSaveAndPublishSettings(const Signal* const signal)
 {
+	Cs2Changed();
+
 	// save in db
 	if (storage)
 	{
@@ -3852,6 +4100,7 @@ bool Manager::SignalDelete(const SignalID signalID,
 
 	const string& name = signal->GetName();
 	const string& matchKey = signal->GetMatchKey();
+	ControlsWaitUntilDelivered();
 	std::lock_guard<std::mutex> guard(controlMutex);
 	for (auto& control : controls)
 	{
@@ -3859,6 +4108,7 @@ bool Manager::SignalDelete(const SignalID signalID,
 	}
 
 	delete signal;
+	Cs2Changed();
 	return true;
 }
 
@@ -3923,7 +4173,9 @@ bool Manager::SignalRelease(const SignalID signalID)
 	{
 		return false;
 	}
-	return signal->Release(logger, ObjectIdentifier());
+	const bool ret = signal->Release(logger, ObjectIdentifier());
+	autoModeDispatcher.Wakeup(signal->GetObjectIdentifier());
+	return ret;
 }
 
 /***************************
@@ -4328,10 +4580,12 @@ void Manager::CounterSaveAndPublishSettings(const Counter* const counter)
 
 void Manager::CounterPublishState(const DataModel::Counter* const counter)
 {
+	const unsigned long long object = ControlDispatcher::ObjectKey(ObjectTypeCounter, counter->GetID());
 	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto& control : controls)
+	for (auto& dispatcher : controlDispatchers)
 	{
-		control.second->CounterState(counter);
+		ControlInterface* control = dispatcher.second->GetControl();
+		dispatcher.second->Post(object, 0, [control, counter]() { control->CounterState(counter); });
 	}
 }
 
@@ -4362,6 +4616,7 @@ bool Manager::CounterDelete(const CounterID counterID, string& result)
 	}
 
 	const string& counterName = counter->GetName();
+	ControlsWaitUntilDelivered();
 	std::lock_guard<std::mutex> guard(controlMutex);
 	for (auto& control : controls)
 	{
@@ -4499,7 +4754,9 @@ bool Manager::TrackRelease(const TrackID trackID)
 	{
 		return false;
 	}
-	return track->ReleaseForce(logger, ObjectIdentifier());
+	const bool ret = track->ReleaseForce(logger, ObjectIdentifier());
+	autoModeDispatcher.Wakeup(track->GetObjectIdentifier());
+	return ret;
 }
 
 bool Manager::LocoBaseReleaseOnTrack(const TrackID trackID)
@@ -4511,6 +4768,7 @@ bool Manager::LocoBaseReleaseOnTrack(const TrackID trackID)
 	}
 	const ObjectIdentifier locoBaseIdentifier = track->GetLocoBase();
 	track->ReleaseForce(logger, locoBaseIdentifier);
+	autoModeDispatcher.Wakeup(track->GetObjectIdentifier());
 
 	const ObjectType type = locoBaseIdentifier.GetObjectType();
 	const ObjectID id = locoBaseIdentifier.GetObjectID();
@@ -4556,6 +4814,10 @@ void Manager::TrackBlock(const TrackID trackID, const bool blocked)
 	}
 	track->SetBlocked(blocked);
 	TrackPublishState(track);
+	if (!blocked)
+	{
+		autoModeDispatcher.Wakeup(track->GetObjectIdentifier());
+	}
 }
 
 void Manager::TrackSetLocoOrientation(const TrackID trackID, const Orientation orientation)
@@ -4567,15 +4829,18 @@ void Manager::TrackSetLocoOrientation(const TrackID trackID, const Orientation o
 	}
 	track->SetLocoBaseOrientation(orientation);
 	TrackPublishState(track);
+	autoModeDispatcher.Wakeup(track->GetObjectIdentifier());
 }
 
 void Manager::TrackPublishState(const DataModel::Track* track)
 {
 	{
+		const unsigned long long object = ControlDispatcher::ObjectKey(ObjectTypeTrack, track->GetID());
 		std::lock_guard<std::mutex> guard(controlMutex);
-		for (auto& control : controls)
+		for (auto& dispatcher : controlDispatchers)
 		{
-			control.second->TrackState(track);
+			ControlInterface* control = dispatcher.second->GetControl();
+			dispatcher.second->Post(object, 0, [control, track]() { control->TrackState(track); });
 		}
 	}
 	vector<Track*> extensions = track->GetExtensions();
@@ -4592,7 +4857,11 @@ bool Manager::RouteRelease(const RouteID routeID)
 	{
 		return false;
 	}
-	return route->Release(logger, route->GetLocoBase());
+	const bool ret = route->Release(logger, route->GetLocoBase());
+	vector<ObjectIdentifier> released;
+	route->GetReservationObjects(released);
+	autoModeDispatcher.Wakeup(released);
+	return ret;
 }
 
 bool Manager::LocoDestinationReached(const ObjectIdentifier& locoIdentifier,
@@ -5536,22 +5805,97 @@ bool Manager::SettingsSave(const Languages::Language language,
 	return true;
 }
 
-void Manager::DebounceWorker()
+string Manager::GetCaptureFileName(const ControlID controlID) const
+{
+	if (captureDirectory.empty())
+	{
+		return "";
+	}
+	return captureDirectory + "/control" + to_string(controlID) + ".rccap";
+}
+
+string Manager::GetReplayFileName(const ControlID controlID) const
 {
-	Utils::Utils::SetThreadName(Languages::GetText(Languages::TextDebouncer));
-	logger->Info(Languages::TextDebounceThreadStarted);
-	while (debounceRun)
+	if (replayDirectory.empty())
 	{
+		return "";
+	}
+	const string fileName = replayDirectory + "/control" + to_string(controlID) + ".rccap";
+	return Utils::Utils::FileExists(fileName) ? fileName : "";
+}
+
+string Manager::GetStatistics() const
+{
+	string statistics = timerScheduler.GetLateness().ToCsv("timerlateness")
+		+ debounceScheduler.GetLateness().ToCsv("debouncelateness")
+		+ feedbackLatency.ToCsv("feedbacklatency")
+		+ routeSelectionLatency.ToCsv("routeselection")
+		+ "routeconflicts;" + to_string(routeReservationConflicts) + "\n"
+		+ routeGraph.GetStatistics();
+	{
+		std::lock_guard<std::mutex> guard(controlMutex);
+		for (auto& dispatcher : controlDispatchers)
+		{
+			statistics += dispatcher.second->GetStatistics();
+		}
+		for (auto& control : controls)
+		{
+			statistics += control.second->GetStatistics();
+		}
+	}
+	return statistics + Logger::LoggerServer::Instance().GetStatistics();
+}
+
+void Manager::RouteGraphOrder(const ObjectIdentifier& locoBaseIdentifier,
+	const TrackID destination,
+	std::vector<Route*>& candidates) const
+{
+	routeGraph.Order(locoBaseIdentifier, destination,
+		[this, &locoBaseIdentifier](const TrackID trackID) -> DataModel::RouteGraph::Cost
 		{
-			std::lock_guard<std::mutex> guard(feedbackMutex);
-			for (auto& feedback : feedbacks)
+			const Track* track = GetTrack(trackID);
+			if (!track)
 			{
-				feedback.second->Debounce();
+				return DataModel::RouteGraph::CostUnreachable;
 			}
+			DataModel::RouteGraph::Cost cost = track->GetHeight();
+			// a track that is part of a main track is occupied and blocked together with it
+			const ObjectIdentifier trackLocoBase = track->GetMainLocoBaseDelayed();
+			if (trackLocoBase == locoBaseIdentifier)
+			{
+				return cost;
+			}
+			if (track->GetMainBlocked()
+				|| trackLocoBase.IsSet()
+				|| track->GetMainStateDelayed() != DataModel::Feedback::FeedbackStateFree)
+			{
+				cost += DataModel::RouteGraph::CostOccupied;
+			}
+			return cost;
+		},
+		candidates);
+}
+
+void Manager::ControlDispatcherAddUnlocked(const ControlID controlID, ControlInterface* control)
+{
+	controlDispatchers[controlID] = std::make_shared<ControlDispatcher>(control, controlID);
+}
+
+void Manager::ControlsWaitUntilDelivered()
+{
+	std::vector<std::shared_ptr<ControlDispatcher>> dispatchers;
+	{
+		std::lock_guard<std::mutex> guard(controlMutex);
+		for (auto& dispatcher : controlDispatchers)
+		{
+			dispatchers.push_back(dispatcher.second);
 		}
-		Utils::Utils::SleepForMilliseconds(250);
 	}
-	logger->Info(Languages::TextDebounceThreadTerminated);
+	// a control may call back into the manager while we wait, so controlMutex must not be held here
+	for (auto& dispatcher : dispatchers)
+	{
+		dispatcher->WaitUntilDelivered();
+	}
 }
 
 void Manager::ControlCheckerWorker()
@@ -20,24 +20,34 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <sstream>
 #include <string>
 #include <iomanip>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include "Config.h"
+#include "ControlDispatcher.h"
 #include "ControlInterface.h"
 #include "DataModel/AccessoryConfig.h"
+#include "DataModel/AutoModeDispatcher.h"
 #include "DataModel/DataModel.h"
 #include "DataModel/FeedbackConfig.h"
 #include "DataModel/LocoConfig.h"
 #include "DataModel/ObjectIdentifier.h"
+#include "DataModel/RouteGraph.h"
 #include "Hardware/HardwareParams.h"
 #include "Hardware/LocoCache.h"
 #include "Logger/Logger.h"
 #include "Storage/StorageHandler.h"
+#include "Utils/TimerScheduler.h"
 
 class Manager
 {
@@ -51,6 +61,68 @@ class Manager
 
 		void Warning(Languages::TextSelector textSelector);
 
+		// timer
+		inline Utils::TimerScheduler::TimerID ScheduleTimer(const std::chrono::milliseconds delay,
+			const std::function<void()>& callback,
+			const void* owner)
+		{
+			return timerScheduler.Schedule(delay, callback, owner);
+		}
+
+		inline void CancelTimers(const void* owner, const bool waitForRunning = true)
+		{
+			timerScheduler.CancelAll(owner, waitForRunning);
+		}
+
+		// automode
+		inline void AutoModeStart(DataModel::LocoBase* locoBase)
+		{
+			autoModeDispatcher.Start(locoBase);
+		}
+
+		inline void AutoModeWakeup(DataModel::LocoBase* locoBase)
+		{
+			autoModeDispatcher.Wakeup(locoBase);
+		}
+
+		inline void AutoModeWakeup(const DataModel::ObjectIdentifier& object)
+		{
+			autoModeDispatcher.Wakeup(object);
+		}
+
+		inline void AutoModeWakeup(const std::vector<DataModel::ObjectIdentifier>& objects)
+		{
+			autoModeDispatcher.Wakeup(objects);
+		}
+
+		inline void AutoModeWaitFor(DataModel::LocoBase* locoBase, const std::vector<DataModel::ObjectIdentifier>& objects)
+		{
+			autoModeDispatcher.WaitFor(locoBase, objects);
+		}
+
+		inline void AutoModeWaitUntilTerminated(DataModel::LocoBase* locoBase)
+		{
+			autoModeDispatcher.WaitUntilTerminated(locoBase);
+		}
+
+		inline void RouteGraphSetLocoBase(const RouteID routeID, const DataModel::ObjectIdentifier& locoBaseIdentifier)
+		{
+			routeGraph.SetLocoBase(routeID, locoBaseIdentifier);
+		}
+
+		inline void RouteGraphRemoveConflicting(const DataModel::ObjectIdentifier& locoBaseIdentifier,
+			std::vector<DataModel::Route*>& candidates) const
+		{
+			routeGraph.RemoveConflicting(locoBaseIdentifier, candidates);
+		}
+
+		// orders the candidates by the cheapest path to destination, or by the next routes without destination
+		void RouteGraphOrder(const DataModel::ObjectIdentifier& locoBaseIdentifier,
+			const TrackID destination,
+			std::vector<DataModel::Route*>& candidates) const;
+
+		std::string GetStatistics() const;
+
 		// booster
 		inline BoosterState Booster() const
 		{
@@ -96,6 +168,8 @@ class Manager
 
 		const DataModel::LocoConfig GetLoco(const LocoID locoID) const;
 
+		const DataModel::LocoConfig GetLoco(const ControlID controlID, const Protocol protocol, const Address address) const;
+
 		const DataModel::LocoConfig GetLocoOfConfigByMatchKey(const ControlID controlId, const std::string& matchKey) const;
 
 		DataModel::Loco* GetLocoByMatchKey(const ControlID controlId, const std::string& matchKey) const;
@@ -327,14 +401,31 @@ class Manager
 			FeedbackState(controlID, pin, 0, 0, state);
 		}
 
+		// timestamp is the time the hardware has reported the state, a driver may pass the time it has received it
 		void FeedbackState(const ControlID controlID,
 			const FeedbackPin pin,
 			const FeedbackDevice device,
 			const FeedbackBus bus,
-			const DataModel::Feedback::FeedbackState state);
+			const DataModel::Feedback::FeedbackState state,
+			const std::chrono::steady_clock::time_point timestamp = std::chrono::steady_clock::now());
 
 		void FeedbackState(const FeedbackID feedbackID, const DataModel::Feedback::FeedbackState state);
 		void FeedbackPublishState(const DataModel::Feedback* feedback);
+
+		// the state change of feedback is published at deadline unless Debounce sees another generation
+		Utils::TimerScheduler::TimerID FeedbackDebounceAt(DataModel::Feedback* feedback,
+			const std::chrono::steady_clock::time_point deadline,
+			const unsigned int generation);
+
+		inline void FeedbackDebounceCancel(const Utils::TimerScheduler::TimerID timerID)
+		{
+			debounceScheduler.Cancel(timerID);
+		}
+
+		inline void FeedbackReachedTrack(const std::chrono::steady_clock::time_point timestamp)
+		{
+			feedbackLatency.Add(timestamp);
+		}
 		DataModel::Feedback* GetFeedback(const FeedbackID feedbackID) const;
 		DataModel::Feedback* GetFeedbackUnlocked(const FeedbackID feedbackID) const;
 		const std::string& GetFeedbackName(const FeedbackID feedbackID) const;
@@ -365,6 +456,8 @@ class Manager
 			const bool inverted,
 			const DataModel::FeedbackType feedbackType,
 			const RouteID routeId,
+			const Delay onDelay,
+			const Delay offDelay,
 			std::string& result);
 
 		bool FeedbackDelete(const FeedbackID feedbackID,
@@ -477,6 +570,21 @@ class Manager
 
 		DataModel::Route* GetRoute(const RouteID routeID) const;
 
+		// the route a loco base has reserved starting at fromTrackID,
+		// with TrackNone starting at the track the loco base is on
+		const DataModel::Route* GetReservedRouteOfLocoBase(const DataModel::ObjectIdentifier& locoBaseIdentifier,
+			TrackID fromTrackID) const;
+
+		inline void RouteSelected(const std::chrono::steady_clock::time_point start)
+		{
+			routeSelectionLatency.Add(start);
+		}
+
+		inline void RouteReservationConflict()
+		{
+			++routeReservationConflicts;
+		}
+
 		const std::string& GetRouteName(const RouteID routeID) const;
 
 		inline const std::map<RouteID,DataModel::Route*>& RouteList() const
@@ -688,6 +796,23 @@ class Manager
 		std::string GetCs2GBS() const;
 		std::string GetCs2GBS(const signed char gbs) const;
 
+		// changes whenever the content of the CS2 config files changes
+		inline unsigned int GetCs2Revision() const
+		{
+			return cs2Revision;
+		}
+
+		// the files to record the traffic of a control to and to replay it from,
+		// empty if capturedirectory or replaydirectory are not configured or there is nothing to replay
+		std::string GetCaptureFileName(const ControlID controlID) const;
+		std::string GetReplayFileName(const ControlID controlID) const;
+
+		// times real time, 0 replays as fast as possible
+		inline unsigned int GetReplaySpeed() const
+		{
+			return replaySpeed;
+		}
+
 		inline DataModel::ObjectIdentifier GetLocoBaseIdentifierOfTrack(const TrackID trackId)
 		{
 			const DataModel::Track* track = GetTrack(trackId);
@@ -797,6 +922,25 @@ class Manager
 	public:
 		// FIXME: make this private
 		DataModel::LocoBase* GetLocoBaseInternal(const DataModel::ObjectIdentifier& locoBaseIdentifier) const;
+
+		typedef std::tuple<ControlID,FeedbackPin,FeedbackDevice,FeedbackBus> FeedbackHardwareKey;
+
+		static inline FeedbackHardwareKey GetFeedbackHardwareKey(const DataModel::Feedback* feedback)
+		{
+			return FeedbackHardwareKey(feedback->GetControlID(), feedback->GetPin(), feedback->GetDevice(), feedback->GetBus());
+		}
+
+		// every contact report of a feedback module looks up this index, so it is hashed
+		struct FeedbackHardwareKeyHash
+		{
+			inline size_t operator()(const FeedbackHardwareKey& key) const
+			{
+				const uint64_t controlAndPin = (static_cast<uint64_t>(std::get<0>(key)) << 32) | std::get<1>(key);
+				const uint64_t deviceAndBus = (static_cast<uint64_t>(std::get<2>(key)) << 32) | std::get<3>(key);
+				return std::hash<uint64_t>()(controlAndPin * 0x9E3779B97F4A7C15ull ^ deviceAndBus);
+			}
+		};
+
 	private:
 
 		bool LocoBaseSpeedInternal(DataModel::LocoBase* locoBase,
@@ -855,6 +999,10 @@ class Manager
 			const FeedbackDevice device,
 			const FeedbackBus bus) const;
 
+		// feedbackMutex has to be locked when calling these
+		void FeedbackHardwareIndexAddUnlocked(DataModel::Feedback* feedback);
+		void FeedbackHardwareIndexRemoveUnlocked(const DataModel::Feedback* feedback);
+
 		DataModel::Signal* GetSignal(const ControlID controlID, const Protocol protocol, const Address address) const;
 
 		void AccessoryState(const ControlType controlType, DataModel::Accessory* accessory, const DataModel::AccessoryState state, const bool force);
@@ -922,6 +1070,11 @@ class Manager
 		bool CounterRotate(const CounterID counterID,
 			std::string& result);
 
+		inline void Cs2Changed()
+		{
+			++cs2Revision;
+		}
+
 		void AccessorySaveAndPublishSettings(const DataModel::Accessory* const accessory);
 		void FeedbackSaveAndPublishSettings(const DataModel::Feedback* const feedback);
 		void RouteSaveAndPublishSettings(const DataModel::Route* const route);
@@ -1017,10 +1170,12 @@ class Manager
 			}
 		}
 
-		void DebounceWorker();
 
 		void ControlCheckerWorker();
 
+		// runs the loaders of one startup phase on a pool of threads and logs the time it took
+		void LoadParallel(const unsigned char phase, const std::vector<std::function<void()>>& loaders);
+
 		// FIXME: if all methods are fixed this should not be needed anymore (mutex using)
 		template<class ID, class T>
 		T* CreateAndAddObject(std::map<ID,T*>& objects, std::mutex& mutex)
@@ -1110,6 +1265,20 @@ class Manager
 
 		void ProgramCheckBooster(const ProgramMode mode);
 
+		// kinds of loco updates that replace each other in a dispatcher, functions use LocoDispatchFunction + function number
+		enum LocoDispatchKind : unsigned int
+		{
+			LocoDispatchSpeed = 0,
+			LocoDispatchOrientation,
+			LocoDispatchFunction
+		};
+
+		// controlMutex has to be locked
+		void ControlDispatcherAddUnlocked(const ControlID controlID, ControlInterface* control);
+
+		// must be called before deleting an object whose pointer may still wait in a dispatcher
+		void ControlsWaitUntilDelivered();
+
 		bool ObjectIsPartOfRoute(const DataModel::ObjectIdentifier& identifier,
 			const DataModel::Object* object,
 			std::string& result);
@@ -1121,6 +1290,8 @@ class Manager
 
 		// controls (Webserver & hardwareHandler. So each hardware is also added here).
 		std::map<ControlID,ControlInterface*> controls;
+		// state updates are delivered asynchronously through one dispatcher per control
+		std::map<ControlID,std::shared_ptr<ControlDispatcher>> controlDispatchers;
 		mutable std::mutex controlMutex;
 
 		// hardware (virt, CS2, ...)
@@ -1141,6 +1312,7 @@ class Manager
 
 		// feedback
 		std::map<FeedbackID,DataModel::Feedback*> feedbacks;
+		std::unordered_map<FeedbackHardwareKey,DataModel::Feedback*,FeedbackHardwareKeyHash> feedbacksByHardware;
 		mutable std::mutex feedbackMutex;
 
 		// track
@@ -1153,6 +1325,7 @@ class Manager
 
 		// route
 		std::map<RouteID,DataModel::Route*> routes;
+		DataModel::RouteGraph routeGraph;
 		mutable std::mutex routeMutex;
 
 		// layer
@@ -1187,15 +1360,29 @@ class Manager
 		DataModel::Loco::NrOfTracksToReserve nrOfTracksToReserve;
 
 		volatile bool run;
-		volatile bool debounceRun;
-		std::thread debounceThread;
 		volatile bool controlCheckerRun;
 		std::thread controlCheckerThread;
+		Utils::TimerScheduler timerScheduler;
+		// publishes the feedback states when their on or off delay has passed
+		Utils::TimerScheduler debounceScheduler;
+		// from the report of the hardware to the track, including the delays of the feedbacks
+		Utils::LatencyHistogram feedbackLatency;
+		// searching the next destination of a loco in automode
+		Utils::LatencyHistogram routeSelectionLatency;
+		std::atomic<unsigned long long> routeReservationConflicts;
+		static const unsigned int NumberOfAutoModeWorkers = 4;
+		DataModel::AutoModeDispatcher autoModeDispatcher;
 
 		volatile bool initLocosDone;
 
 		bool serverEnabled;
 
+		std::atomic<unsigned int> cs2Revision;
+
+		const std::string captureDirectory;
+		const std::string replayDirectory;
+		const unsigned int replaySpeed;
+
 		const std::string unknownControl;
 		const std::string unknownLoco;
 		const std::string unknownMultipleUnit;
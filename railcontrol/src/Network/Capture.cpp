@@ -0,0 +1,237 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#include "Network/Capture.h"
+
+namespace Network
+{
+	const char Capture::Magic[6] = { 'R', 'C', 'C', 'A', 'P', 1 };
+
+	static void WriteVarint(std::ofstream& file, unsigned long long value)
+	{
+		while (value >= 0x80)
+		{
+			file.put(static_cast<char>((value & 0x7F) | 0x80));
+			value >>= 7;
+		}
+		file.put(static_cast<char>(value));
+	}
+
+	static bool ReadVarint(std::ifstream& file, unsigned long long& value)
+	{
+		value = 0;
+		for (unsigned char shift = 0; shift < 64; shift += 7)
+		{
+			const int byte = file.get();
+			if (byte == EOF)
+			{
+				return false;
+			}
+			value |= static_cast<unsigned long long>(byte & 0x7F) << shift;
+			if (!(byte & 0x80))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	Capture::Capture(Logger::Logger* logger,
+		const std::string& recordFileName,
+		const std::string& replayFileName,
+		const unsigned int replaySpeed)
+	:	logger(logger),
+		channels(0),
+		lastRecord(std::chrono::steady_clock::now()),
+		replaying(false),
+		replaySpeed(replaySpeed),
+		replayStart(lastRecord),
+		replayChunksLeft(0),
+		replayFileName(replayFileName)
+	{
+		if (replayFileName.size())
+		{
+			replaying = Load(replayFileName);
+			if (replaying)
+			{
+				logger->Info(Languages::TextReplayingTraffic, replayFileName);
+			}
+		}
+
+		if (recordFileName.size())
+		{
+			recordFile.open(recordFileName, std::ios::binary | std::ios::trunc);
+			if (!recordFile.is_open())
+			{
+				logger->Error(Languages::TextUnableToOpenFile, recordFileName);
+				return;
+			}
+			recordFile.write(Magic, sizeof(Magic));
+			logger->Info(Languages::TextRecordingTraffic, recordFileName);
+		}
+	}
+
+	Capture::~Capture()
+	{
+		if (recordFile.is_open())
+		{
+			recordFile.close();
+		}
+	}
+
+	bool Capture::Load(const std::string& fileName)
+	{
+		std::ifstream file(fileName, std::ios::binary);
+		if (!file.is_open())
+		{
+			logger->Error(Languages::TextUnableToOpenFile, fileName);
+			return false;
+		}
+
+		char magic[sizeof(Magic)];
+		if (!file.read(magic, sizeof(magic)) || std::string(magic, sizeof(magic)) != std::string(Magic, sizeof(Magic)))
+		{
+			logger->Error(Languages::TextInvalidCaptureFile, fileName);
+			return false;
+		}
+
+		std::chrono::microseconds time(0);
+		while (file.peek() != EOF)
+		{
+			unsigned long long delta;
+			unsigned long long length;
+			if (!ReadVarint(file, delta))
+			{
+				logger->Error(Languages::TextInvalidCaptureFile, fileName);
+				return false;
+			}
+			const int channelAndDirection = file.get();
+			if (channelAndDirection == EOF || !ReadVarint(file, length))
+			{
+				logger->Error(Languages::TextInvalidCaptureFile, fileName);
+				return false;
+			}
+			std::string data(length, 0);
+			if (!file.read(&data[0], length))
+			{
+				logger->Error(Languages::TextInvalidCaptureFile, fileName);
+				return false;
+			}
+			time += std::chrono::microseconds(delta);
+			if ((channelAndDirection & 0x01) != DirectionReceived)
+			{
+				continue;
+			}
+			replayChannels[channelAndDirection >> 1].chunks.push_back({ time, std::move(data) });
+			++replayChunksLeft;
+		}
+		return true;
+	}
+
+	unsigned char Capture::AddChannel()
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		return channels++;
+	}
+
+	void Capture::Record(const unsigned char channel,
+		const Direction direction,
+		const unsigned char* data,
+		const size_t size)
+	{
+		if (!recordFile.is_open())
+		{
+			return;
+		}
+		std::lock_guard<std::mutex> guard(mutex);
+		RecordInternal(channel, direction, data, size);
+	}
+
+	void Capture::RecordInternal(const unsigned char channel,
+		const Direction direction,
+		const unsigned char* data,
+		const size_t size)
+	{
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		WriteVarint(recordFile, std::chrono::duration_cast<std::chrono::microseconds>(now - lastRecord).count());
+		lastRecord = now;
+		recordFile.put(static_cast<char>((channel << 1) | direction));
+		WriteVarint(recordFile, size);
+		recordFile.write(reinterpret_cast<const char*>(data), size);
+	}
+
+	ssize_t Capture::Replay(const unsigned char channel,
+		unsigned char* data,
+		const size_t maxSize,
+		const std::chrono::microseconds timeout)
+	{
+		const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+		std::unique_lock<std::mutex> lock(mutex);
+		ReplayChannel& replayChannel = replayChannels[channel];
+		if (replayChannel.next >= replayChannel.chunks.size())
+		{
+			lock.unlock();
+			std::this_thread::sleep_until(deadline);
+			errno = ETIMEDOUT;
+			return -1;
+		}
+
+		const Chunk& chunk = replayChannel.chunks[replayChannel.next];
+		if (replaySpeed)
+		{
+			const std::chrono::steady_clock::time_point due = replayStart + chunk.time / replaySpeed;
+			if (due > std::chrono::steady_clock::now())
+			{
+				// only this thread consumes the chunks of the channel, so the chunk stays valid
+				lock.unlock();
+				std::this_thread::sleep_until(due < deadline ? due : deadline);
+				if (due > deadline)
+				{
+					errno = ETIMEDOUT;
+					return -1;
+				}
+				lock.lock();
+			}
+		}
+
+		const size_t size = std::min(maxSize, chunk.data.size() - replayChannel.offset);
+		memcpy(data, chunk.data.data() + replayChannel.offset, size);
+		replayChannel.offset += size;
+		if (replayChannel.offset >= chunk.data.size())
+		{
+			++replayChannel.next;
+			replayChannel.offset = 0;
+			if (--replayChunksLeft == 0)
+			{
+				logger->Info(Languages::TextReplayFinished, replayFileName);
+			}
+		}
+		if (recordFile.is_open())
+		{
+			RecordInternal(channel, DirectionReceived, data, size);
+		}
+		return size;
+	}
+}
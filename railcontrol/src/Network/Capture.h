@@ -0,0 +1,128 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+#include "Logger/Logger.h"
+
+namespace Network
+{
+	// Records the bytes sent and received on the connections of a control with their monotonic time,
+	// and replays the received bytes of such a recording instead of using the connections.
+	// Each connection of a control is a channel, numbered in the order the connections are created.
+	//
+	// File format: the magic "RCCAP" and the version byte 1, then one record per Send or Receive:
+	// time since the previous record in µs (varint), channel * 2 + direction (one byte),
+	// length (varint), data.
+	class Capture
+	{
+		public:
+			enum Direction : unsigned char
+			{
+				DirectionSent = 0,
+				DirectionReceived = 1
+			};
+
+			Capture() = delete;
+			Capture(const Capture&) = delete;
+			Capture& operator=(const Capture&) = delete;
+
+			// empty file names turn recording or replaying off, replaySpeed 0 replays as fast as possible
+			Capture(Logger::Logger* logger,
+				const std::string& recordFileName,
+				const std::string& replayFileName,
+				const unsigned int replaySpeed);
+
+			~Capture();
+
+			unsigned char AddChannel();
+
+			inline bool IsRecording() const
+			{
+				return recordFile.is_open();
+			}
+
+			inline bool IsReplaying() const
+			{
+				return replaying;
+			}
+
+			void Record(const unsigned char channel,
+				const Direction direction,
+				const unsigned char* data,
+				const size_t size);
+
+			// returns the received bytes of the channel that are due within timeout, -1 if there are none
+			ssize_t Replay(const unsigned char channel,
+				unsigned char* data,
+				const size_t maxSize,
+				const std::chrono::microseconds timeout);
+
+		private:
+			struct Chunk
+			{
+				std::chrono::microseconds time; // since the start of the recording
+				std::string data;
+			};
+
+			struct ReplayChannel
+			{
+				ReplayChannel()
+				:	next(0),
+					offset(0)
+				{
+				}
+
+				std::vector<Chunk> chunks;
+				size_t next;
+				size_t offset;
+			};
+
+			bool Load(const std::string& fileName);
+			void RecordInternal(const unsigned char channel,
+				const Direction direction,
+				const unsigned char* data,
+				const size_t size);
+
+			static const char Magic[6];
+
+			Logger::Logger* const logger;
+			std::mutex mutex;
+			unsigned char channels;
+
+			std::ofstream recordFile;
+			std::chrono::steady_clock::time_point lastRecord;
+
+			bool replaying;
+			const unsigned int replaySpeed;
+			const std::chrono::steady_clock::time_point replayStart;
+			std::map<unsigned char,ReplayChannel> replayChannels;
+			size_t replayChunksLeft;
+			std::string replayFileName;
+	};
+}
@@ -28,6 +28,11 @@ namespace Network
 {
 	void Serial::Init()
 	{
+		if (IsReplaying())
+		{
+			return;
+		}
+
 		fileHandle = open(tty.c_str(), O_RDWR | O_NOCTTY);
 		if (!IsConnected())
 		{
@@ -128,6 +133,10 @@ namespace Network
 		{
 			return -1;
 		}
+		if (IsReplaying())
+		{
+			return capture->Replay(captureChannel, data, maxData, std::chrono::seconds(timeoutS) + std::chrono::microseconds(timeoutUS));
+		}
 		fd_set set;
 		FD_ZERO(&set);
 		FD_SET(fileHandle, &set);
@@ -145,6 +154,10 @@ namespace Network
 		{
 			return -1;
 		}
+		if (capture)
+		{
+			capture->Record(captureChannel, Capture::DirectionReceived, data, ret);
+		}
 		return ret;
 	}
 
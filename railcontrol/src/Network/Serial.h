@@ -26,6 +26,7 @@ along with RailControl; see the file LICENCE. If not see
 #include <unistd.h>   //close & write;
 
 #include "Logger/Logger.h"
+#include "Network/Capture.h"
 
 namespace Network
 {
@@ -42,7 +43,8 @@ namespace Network
 				const unsigned char dataBits,
 				const char parity,
 				const unsigned char stopBits,
-				const bool hardwareFlowControl = false)
+				const bool hardwareFlowControl = false,
+				Capture* capture = nullptr)
 			:	logger(logger),
 				tty(tty),
 				dataSpeed(dataSpeed),
@@ -50,7 +52,9 @@ namespace Network
 				parity(parity),
 				stopBits(stopBits),
 				hardwareFlowControl(hardwareFlowControl),
-				fileHandle(-1)
+				fileHandle(-1),
+				capture(capture),
+				captureChannel(capture ? capture->AddChannel() : 0)
 			{
 				Init();
 			}
@@ -68,7 +72,7 @@ namespace Network
 
 			inline bool IsConnected() const
 			{
-				return fileHandle != -1;
+				return fileHandle != -1 || IsReplaying();
 			}
 
 			inline void ClearBuffers()
@@ -92,6 +96,14 @@ namespace Network
 				{
 					return 0;
 				}
+				if (capture)
+				{
+					capture->Record(captureChannel, Capture::DirectionSent, data, size);
+					if (capture->IsReplaying())
+					{
+						return size;
+					}
+				}
 				std::lock_guard<std::mutex> Guard(fileHandleMutex);
 				return write(fileHandle, data, size);
 			}
@@ -102,6 +114,11 @@ namespace Network
 			ssize_t ReceiveExact(unsigned char* data, const size_t length, const unsigned int timeoutS = 0, const unsigned int timeoutUS = 100000);
 
 		private:
+			inline bool IsReplaying() const
+			{
+				return capture && capture->IsReplaying();
+			}
+
 			void Init();
 			void Close();
 
@@ -114,5 +131,7 @@ namespace Network
 			const bool hardwareFlowControl;
 			int fileHandle;
 			mutable std::mutex fileHandleMutex;
+			Capture* const capture;
+			const unsigned char captureChannel;
 	};
 }
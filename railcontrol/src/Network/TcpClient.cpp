@@ -22,13 +22,22 @@ along with RailControl; see the file LICENCE. If not see
 #include <netinet/in.h>
 #include <string.h>
 
+#include "Network/Capture.h"
 #include "Network/Select.h"
 #include "Network/TcpClient.h"
 
 namespace Network
 {
-	TcpConnection TcpClient::GetTcpClientConnection(Logger::Logger* logger, const std::string& host, const unsigned short port)
+	TcpConnection TcpClient::GetTcpClientConnection(Logger::Logger* logger,
+		const std::string& host,
+		const unsigned short port,
+		Capture* capture)
 	{
+		if (capture && capture->IsReplaying())
+		{
+			return TcpConnection(0, nullptr, capture);
+		}
+
 		struct sockaddr_storage address;
 		struct sockaddr_in* addressPointer = reinterpret_cast<struct sockaddr_in*>(&address);
 		addressPointer->sin_family = AF_INET;
@@ -69,7 +78,7 @@ namespace Network
 			return TcpConnection(0);
 		}
 
-		return TcpConnection(sock, &address);
+		return TcpConnection(sock, &address, capture);
 	}
 
 	int TcpClient::ConnectWithTimeout(int sock, struct sockaddr *addr, socklen_t length)
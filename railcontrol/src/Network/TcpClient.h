@@ -37,7 +37,11 @@ namespace Network
 			TcpClient(const TcpClient&) = delete;
 			TcpClient& operator=(const TcpClient&) = delete;
 
-			static TcpConnection GetTcpClientConnection(Logger::Logger* logger, const std::string& host, const unsigned short port);
+			// with a replaying capture no connection is made
+			static TcpConnection GetTcpClientConnection(Logger::Logger* logger,
+				const std::string& host,
+				const unsigned short port,
+				Capture* capture = nullptr);
 
 		private:
 			static int ConnectWithTimeout(int sock, struct sockaddr *addr, socklen_t length);
@@ -21,6 +21,7 @@ along with RailControl; see the file LICENCE. If not see
 #include <arpa/inet.h>
 #include <unistd.h>   // close & TEMP_FAILURE_RETRY;
 
+#include "Network/Capture.h"
 #include "Network/Select.h"
 #include "Network/TcpConnection.h"
 #include "Utils/Utils.h"
@@ -31,17 +32,43 @@ along with RailControl; see the file LICENCE. If not see
 
 namespace Network
 {
+	TcpConnection::TcpConnection(int socket,
+		const struct sockaddr_storage* address,
+		Capture* capture)
+	:	connectionSocket(socket),
+		connected(socket != 0 || (capture && capture->IsReplaying())),
+		capture(capture),
+		captureChannel(capture ? capture->AddChannel() : 0)
+	{
+		if (address)
+		{
+			this->address = *address;
+		}
+		else
+		{
+			memset(&(this->address), 0, sizeof(struct sockaddr_storage));
+		}
+	}
+
 	void TcpConnection::Terminate() const
 	{
 		if (connected)
 		{
 			connected = false;
-			close(connectionSocket);
+			if (connectionSocket != 0)
+			{
+				close(connectionSocket);
+			}
 		}
 	}
 
 	int TcpConnection::Send(const unsigned char* buffer, const size_t bufferLength, const int flags) const
 	{
+		if (capture && capture->IsReplaying())
+		{
+			capture->Record(captureChannel, Capture::DirectionSent, buffer, bufferLength);
+			return connected ? bufferLength : -1;
+		}
 		if (connectionSocket == 0 || !connected)
 		{
 			errno = ENOTCONN;
@@ -72,11 +99,69 @@ namespace Network
 			Terminate();
 			return -1;
 		}
+		if (capture)
+		{
+			capture->Record(captureChannel, Capture::DirectionSent, buffer, ret);
+		}
+		return ret;
+	}
+
+	int TcpConnection::SendNonBlocking(const std::string& string) const
+	{
+		if (connectionSocket == 0 || !connected)
+		{
+			errno = ENOTCONN;
+			return -1;
+		}
+		errno = 0;
+		int ret = send(connectionSocket, string.c_str(), string.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+		if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+		{
+			errno = EAGAIN;
+			return -1;
+		}
+		if (ret <= 0)
+		{
+			errno = ECONNRESET;
+			Terminate();
+			return -1;
+		}
+		return ret;
+	}
+
+	int TcpConnection::ReceiveNonBlocking(char* buffer, const size_t bufferLength) const
+	{
+		if (connectionSocket == 0 || !connected)
+		{
+			errno = ENOTCONN;
+			return -1;
+		}
+		errno = 0;
+		int ret = recv(connectionSocket, buffer, bufferLength, MSG_DONTWAIT);
+		if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+		{
+			errno = EAGAIN;
+			return -1;
+		}
+		if (ret <= 0)
+		{
+			Terminate();
+			return 0;
+		}
 		return ret;
 	}
 
 	int TcpConnection::Receive(unsigned char* buffer, const size_t bufferLength, const int flags) const
 	{
+		if (capture && capture->IsReplaying())
+		{
+			if (!connected)
+			{
+				errno = ENOTCONN;
+				return -1;
+			}
+			return capture->Replay(captureChannel, buffer, bufferLength, std::chrono::seconds(1));
+		}
 		if (connectionSocket == 0 || connected == false)
 		{
 			errno = ENOTCONN;
@@ -107,6 +192,10 @@ namespace Network
 			Terminate();
 			return -1;
 		}
+		if (capture)
+		{
+			capture->Record(captureChannel, Capture::DirectionReceived, buffer, ret);
+		}
 		return ret;
 	}
 
@@ -27,31 +27,26 @@ along with RailControl; see the file LICENCE. If not see
 
 namespace Network
 {
+	// Logger includes TcpConnection, Capture includes Logger
+	class Capture;
+
 	class TcpConnection
 	{
 		public:
 			TcpConnection() = delete;
 			TcpConnection& operator=(const TcpConnection&) = delete;
 
-			inline TcpConnection(int socket,
-				const struct sockaddr_storage* address = nullptr)
-			:	connectionSocket(socket),
-				connected(socket != 0)
-			{
-				if (address)
-				{
-					this->address = *address;
-				}
-				else
-				{
-					memset(&(this->address), 0, sizeof(struct sockaddr_storage));
-				}
-			}
+			// with a replaying capture the connection is connected without a socket
+			TcpConnection(int socket,
+				const struct sockaddr_storage* address = nullptr,
+				Capture* capture = nullptr);
 
 			inline TcpConnection(const TcpConnection& other)
 			:	connectionSocket(other.connectionSocket),
 				connected(other.connected),
-				address(other.address)
+				address(other.address),
+				capture(other.capture),
+				captureChannel(other.captureChannel)
 			{
 			}
 
@@ -74,6 +69,14 @@ namespace Network
 				return Send(string.c_str(), string.size(), flags);
 			}
 
+			// sends as much as possible without blocking, returns the number of bytes sent
+			// or -1 with errno EAGAIN if the socket buffer is full
+			int SendNonBlocking(const std::string& string) const;
+
+			// receives what is available without blocking, returns 0 if the peer has closed the connection
+			// or -1 with errno EAGAIN if nothing is available
+			int ReceiveNonBlocking(char* buffer, const size_t bufferLength) const;
+
 			int Receive(unsigned char* buffer, const size_t bufferLength, const int flags = 0) const;
 
 			inline int Receive(char* buffer, const size_t bufferLength, const int flags = 0) const
@@ -90,6 +93,11 @@ namespace Network
 				return connected;
 			}
 
+			inline int GetSocket() const
+			{
+				return connectionSocket;
+			}
+
 			inline std::string AddressAsString()
 			{
 				return Utils::Network::AddressToString(&address);
@@ -99,5 +107,7 @@ namespace Network
 			mutable int connectionSocket;
 			mutable volatile bool connected;
 			struct sockaddr_storage address;
+			Capture* const capture;
+			const unsigned char captureChannel;
 	};
 }
@@ -30,8 +30,12 @@ namespace Network
 {
 	UdpConnection::UdpConnection(Logger::Logger* logger,
 		const std::string& server,
-		const unsigned short port)
+		const unsigned short port,
+		Capture* capture)
 	:	logger(logger),
+		capture(capture),
+		captureChannel(capture ? capture->AddChannel() : 0),
+		connectionSocket(-1),
 		connected(false),
 		server(server),
 		port(port)
@@ -53,6 +57,9 @@ namespace Network
 	UdpConnection::UdpConnection(Logger::Logger* logger,
 		struct sockaddr* sockaddr)
 	:	logger(logger),
+		capture(nullptr),
+		captureChannel(0),
+		connectionSocket(-1),
 		connected(false),
 		sockaddr(*sockaddr)
 	{
@@ -67,6 +74,12 @@ namespace Network
 
 	void UdpConnection::CreateUdpSocket()
 	{
+		if (IsReplaying())
+		{
+			connected = true;
+			return;
+		}
+
 		// create socket
 		connectionSocket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
 		if (connectionSocket == -1)
@@ -85,6 +98,11 @@ namespace Network
 
 	bool UdpConnection::Bind()
 	{
+		if (IsReplaying())
+		{
+			return true;
+		}
+
 		int ret = bind(connectionSocket, &sockaddr, sizeof(sockaddr));
 		if (ret == 0)
 		{
@@ -102,7 +120,10 @@ namespace Network
 		if (connected)
 		{
 			connected = false;
-			close(connectionSocket);
+			if (connectionSocket != -1)
+			{
+				close(connectionSocket);
+			}
 		}
 	}
 
@@ -114,7 +135,17 @@ namespace Network
 			errno = ECONNRESET;
 			return -1;
 		}
-		return sendto(connectionSocket, buffer, bufferLength, 0, &sockaddr, sizeof(sockaddr));
+		if (IsReplaying())
+		{
+			capture->Record(captureChannel, Capture::DirectionSent, reinterpret_cast<const unsigned char*>(buffer), bufferLength);
+			return bufferLength;
+		}
+		const int ret = sendto(connectionSocket, buffer, bufferLength, 0, &sockaddr, sizeof(sockaddr));
+		if (capture && ret > 0)
+		{
+			capture->Record(captureChannel, Capture::DirectionSent, reinterpret_cast<const unsigned char*>(buffer), ret);
+		}
+		return ret;
 	}
 
 	int UdpConnection::Receive(char* buffer, const size_t bufferLength)
@@ -125,6 +156,10 @@ namespace Network
 			errno = ECONNRESET;
 			return -1;
 		}
+		if (IsReplaying())
+		{
+			return capture->Replay(captureChannel, reinterpret_cast<unsigned char*>(buffer), bufferLength, std::chrono::seconds(1));
+		}
 		ssize_t ret;
 		do
 		{
@@ -134,6 +169,10 @@ namespace Network
 			}
 			ret = recvfrom(connectionSocket, buffer, bufferLength, 0, NULL, NULL);
 		} while(ret < 0 && errno == EAGAIN);
+		if (capture && ret > 0)
+		{
+			capture->Record(captureChannel, Capture::DirectionReceived, reinterpret_cast<unsigned char*>(buffer), ret);
+		}
 		return ret;
 	}
 }
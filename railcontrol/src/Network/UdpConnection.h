@@ -24,6 +24,7 @@ along with RailControl; see the file LICENCE. If not see
 #include <string>
 
 #include "Logger/Logger.h"
+#include "Network/Capture.h"
 
 namespace Network
 {
@@ -32,7 +33,11 @@ namespace Network
 		public:
 			UdpConnection() = delete;
 
-			UdpConnection(Logger::Logger* logger, const std::string& server, const unsigned short port);
+			// with a replaying capture no socket is created
+			UdpConnection(Logger::Logger* logger,
+				const std::string& server,
+				const unsigned short port,
+				Capture* capture = nullptr);
 
 			UdpConnection(Logger::Logger* logger, struct sockaddr* sockaddr);
 
@@ -72,7 +77,14 @@ namespace Network
 		private:
 			void CreateUdpSocket();
 
+			inline bool IsReplaying() const
+			{
+				return capture && capture->IsReplaying();
+			}
+
 			Logger::Logger* const logger;
+			Capture* const capture;
+			const unsigned char captureChannel;
 			int connectionSocket;
 			volatile bool connected;
 			struct sockaddr sockaddr;
@@ -256,7 +256,8 @@ int main (int argc, char* argv[])
 
 	if (input == 'r')
 	{
-		// restart RailControl
+		// restart RailControl, execv does not run the destructor of the logger
+		Logger::LoggerServer::Instance().Flush();
 		return execv(argv[0], argv);
 	}
 	else
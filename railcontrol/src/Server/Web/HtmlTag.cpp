@@ -18,13 +18,11 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
-#include <sstream>
-
 #include "Server/Web/HtmlTag.h"
 
 namespace Server { namespace Web
 {
-	HtmlTag HtmlTag::AddAttribute(const std::string& name, const std::string& value)
+	HtmlTag& HtmlTag::AddAttribute(const std::string& name, const std::string& value)
 	{
 		if (name.size() > 0)
 		{
@@ -33,59 +31,74 @@ namespace Server { namespace Web
 		return *this;
 	}
 
-	std::ostream& operator<<(std::ostream& stream, const HtmlTag& tag)
+	void HtmlTag::AppendTo(std::string& buffer) const
 	{
-		if (tag.name.size() > 0)
+		if (name.size() > 0)
 		{
-			stream << "<" << tag.name;
+			buffer += '<';
+			buffer += name;
 
-			if (tag.id.size() > 0)
+			if (id.size() > 0)
 			{
-				stream << " id=\"" << tag.id << "\"";
+				buffer += " id=\"";
+				buffer += id;
+				buffer += '"';
 			}
 
-			if (tag.classes.size() > 0)
+			if (classes.size() > 0)
 			{
-				stream << " class=\"";
-				for (auto& c : tag.classes)
+				buffer += " class=\"";
+				for (auto& c : classes)
 				{
-					stream << " " << c;
+					buffer += ' ';
+					buffer += c;
 				}
-				stream << "\"";
+				buffer += '"';
 			}
 
-			for (auto& attribute : tag.attributes)
+			for (auto& attribute : attributes)
 			{
-				stream << " " << attribute.first;
+				buffer += ' ';
+				buffer += attribute.first;
 				if (attribute.second.size() > 0)
 				{
-					stream << "=\"" << attribute.second << "\"";
+					buffer += "=\"";
+					buffer += attribute.second;
+					buffer += '"';
 				}
 			}
 
-			stream << ">";
+			buffer += '>';
 
-			if (tag.childTags.size() == 0 && tag.content.size() == 0 && (
-				tag.name.compare("input") == 0 ||
-				tag.name.compare("link") == 0 ||
-				tag.name.compare("meta") == 0 ||
-				tag.name.compare("br") == 0))
+			if (childTags.size() == 0 && content.size() == 0 && (
+				name.compare("input") == 0 ||
+				name.compare("link") == 0 ||
+				name.compare("meta") == 0 ||
+				name.compare("br") == 0))
 			{
-				return stream;
+				return;
 			}
 		}
 
-		for (auto& child : tag.childTags)
+		for (auto& child : childTags)
 		{
-			stream << child;
+			child.AppendTo(buffer);
 		}
 
-		stream << tag.content;
+		buffer += content;
 
-		if (tag.name.size() > 0)
+		if (name.size() > 0)
 		{
-			stream << "</" << tag.name << ">";
+			buffer += "</";
+			buffer += name;
+			buffer += '>';
 		}
-		return stream;
+	}
+
+	std::ostream& operator<<(std::ostream& stream, const HtmlTag& tag)
+	{
+		std::string buffer;
+		tag.AppendTo(buffer);
+		return stream << buffer;
 	}
 }} // namespace Server::Web
@@ -22,8 +22,8 @@ along with RailControl; see the file LICENCE. If not see
 
 #include <map>
 #include <ostream>
-#include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Languages.h"
@@ -36,6 +36,9 @@ namespace Server { namespace Web
 		public:
 			HtmlTag& operator=(const HtmlTag&) = delete;
 
+			HtmlTag(const HtmlTag&) = default;
+			HtmlTag(HtmlTag&&) = default;
+
 			inline HtmlTag()
 			{
 			}
@@ -49,32 +52,39 @@ namespace Server { namespace Web
 			{
 			}
 
-			virtual HtmlTag AddAttribute(const std::string& name, const std::string& value = "");
+			virtual HtmlTag& AddAttribute(const std::string& name, const std::string& value = "");
 
 			inline virtual bool IsAttributeSet(const std::string& name)
 			{
 				return attributes.count(name) == 1;
 			}
 
-			inline virtual HtmlTag AddChildTag(const HtmlTag& child)
+			inline virtual HtmlTag& AddChildTag(const HtmlTag& child)
 			{
 				this->childTags.push_back(child);
 				return *this;
 			}
 
-			inline virtual HtmlTag AddContent(const std::string& content)
+			// temporary tags are moved into the tree instead of being copied
+			inline HtmlTag& AddChildTag(HtmlTag&& child)
+			{
+				this->childTags.push_back(std::move(child));
+				return *this;
+			}
+
+			inline virtual HtmlTag& AddContent(const std::string& content)
 			{
 				this->content += content;
 				return *this;
 			}
 
 			template<typename... Args>
-			inline HtmlTag AddContent(const Languages::TextSelector text, Args... args)
+			inline HtmlTag& AddContent(const Languages::TextSelector text, Args... args)
 			{
 				return AddContent(Logger::Logger::Format(Languages::GetText(text), args...));
 			}
 
-			inline virtual HtmlTag AddClass(const std::string& className)
+			inline virtual HtmlTag& AddClass(const std::string& className)
 			{
 				if (className.length() > 0)
 				{
@@ -83,7 +93,7 @@ namespace Server { namespace Web
 				return *this;
 			}
 
-			inline virtual HtmlTag AddId(const std::string& id)
+			inline virtual HtmlTag& AddId(const std::string& id)
 			{
 				this->id = id;
 				return *this;
@@ -99,11 +109,14 @@ namespace Server { namespace Web
 				return childTags.size();
 			}
 
+			// appends the serialized tag with all its children to buffer
+			void AppendTo(std::string& buffer) const;
+
 			inline operator std::string () const
 			{
-				std::stringstream ss;
-				ss << *this;
-				return ss.str();
+				std::string buffer;
+				AppendTo(buffer);
+				return buffer;
 			}
 
 			friend std::ostream& operator<<(std::ostream& stream, const HtmlTag& tag);
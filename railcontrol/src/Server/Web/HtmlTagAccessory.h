@@ -38,7 +38,7 @@ namespace Server { namespace Web
 			HtmlTagAccessory(const DataModel::Accessory* accessory);
 			virtual ~HtmlTagAccessory() {}
 
-			inline virtual HtmlTag AddAttribute(const std::string& name, const std::string& value) override
+			inline virtual HtmlTag& AddAttribute(const std::string& name, const std::string& value) override
 			{
 				childTags[0].AddAttribute(name, value);
 				return *this;
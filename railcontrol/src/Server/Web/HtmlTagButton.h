@@ -56,7 +56,7 @@ namespace Server { namespace Web
 			{
 			}
 
-			virtual inline HtmlTag AddAttribute(const std::string& name, const std::string& value = "") override
+			virtual inline HtmlTag& AddAttribute(const std::string& name, const std::string& value = "") override
 			{
 				childTags[0].AddAttribute(name, value);
 				return *this;
@@ -67,7 +67,7 @@ namespace Server { namespace Web
 				return childTags[0].IsAttributeSet(name);
 			}
 
-			virtual inline HtmlTag AddClass(const std::string& value) override
+			virtual inline HtmlTag& AddClass(const std::string& value) override
 			{
 				childTags[0].AddClass(value);
 				return *this;
@@ -41,7 +41,7 @@ namespace Server { namespace Web
 			{
 			}
 
-			virtual inline HtmlTag AddAttribute(const std::string& name, const std::string& value) override
+			virtual inline HtmlTag& AddAttribute(const std::string& name, const std::string& value) override
 			{
 				childTags[0].AddAttribute(name, value);
 				return *this;
@@ -82,13 +82,13 @@ namespace Server { namespace Web
 			{
 			}
 
-			inline virtual HtmlTag AddAttribute(const std::string& name, const std::string& value) override
+			inline virtual HtmlTag& AddAttribute(const std::string& name, const std::string& value) override
 			{
 				childTags[1].AddAttribute(name, value);
 				return *this;
 			}
 
-			inline virtual HtmlTag AddClass(const std::string& _class) override
+			inline virtual HtmlTag& AddClass(const std::string& _class) override
 			{
 				childTags[1].AddClass(_class);
 				return *this;
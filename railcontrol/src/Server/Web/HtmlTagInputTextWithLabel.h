@@ -50,7 +50,7 @@ namespace Server { namespace Web
 			{
 			}
 
-			virtual inline HtmlTag AddAttribute(const std::string& name, const std::string& value) override
+			virtual inline HtmlTag& AddAttribute(const std::string& name, const std::string& value) override
 			{
 				childTags[1].AddAttribute(name, value);
 				return *this;
@@ -61,7 +61,7 @@ namespace Server { namespace Web
 				return childTags[0].IsAttributeSet(name);
 			}
 
-			virtual inline HtmlTag AddClass(const std::string& _class) override
+			virtual inline HtmlTag& AddClass(const std::string& _class) override
 			{
 				childTags[1].AddClass(_class);
 				return *this;
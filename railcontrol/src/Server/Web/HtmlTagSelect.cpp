@@ -70,7 +70,7 @@ namespace Server { namespace Web
 		AddChildTag(dropDown);
 	}
 
-	HtmlTag HtmlTagSelect::AddAttribute(const std::string& name, const std::string& value)
+	HtmlTag& HtmlTagSelect::AddAttribute(const std::string& name, const std::string& value)
 	{
 		childTags[0].AddAttribute(name, value);
 		return *this;
@@ -84,7 +84,7 @@ namespace Server { namespace Web
 				CheckDefaultKeyValue();
 			}
 
-			virtual HtmlTag AddAttribute(const std::string& name, const std::string& value = "") override;
+			virtual HtmlTag& AddAttribute(const std::string& name, const std::string& value = "") override;
 
 		private:
 			HtmlTagSelect(const std::string& name);
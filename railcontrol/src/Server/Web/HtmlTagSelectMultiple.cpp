@@ -46,7 +46,7 @@ namespace Server { namespace Web
 		AddChildTag(dropDown);
 	}
 
-	HtmlTag HtmlTagSelectMultiple::AddAttribute(const std::string& name, const std::string& value)
+	HtmlTag& HtmlTagSelectMultiple::AddAttribute(const std::string& name, const std::string& value)
 	{
 		childTags[0].AddAttribute(name, value);
 		return *this;
@@ -63,7 +63,7 @@ namespace Server { namespace Web
 
 			}
 
-			virtual HtmlTag AddAttribute(const std::string& name, const std::string& value = "") override;
+			virtual HtmlTag& AddAttribute(const std::string& name, const std::string& value = "") override;
 
 		private:
 			HtmlTagSelectMultiple(const std::string& name, const std::string& defaultValue);
@@ -22,7 +22,7 @@ along with RailControl; see the file LICENCE. If not see
 
 namespace Server { namespace Web
 {
-	HtmlTag HtmlTagSelectMultipleWithLabel::AddAttribute(const std::string& name, const std::string& value)
+	HtmlTag& HtmlTagSelectMultipleWithLabel::AddAttribute(const std::string& name, const std::string& value)
 	{
 		HtmlTagSelectMultiple& select = reinterpret_cast<HtmlTagSelectMultiple&>(childTags.at(1));
 		select.HtmlTagSelectMultiple::AddAttribute(name, value);
@@ -35,7 +35,7 @@ namespace Server { namespace Web
 		return select.HtmlTagSelectMultiple::IsAttributeSet(name);
 	}
 
-	HtmlTag HtmlTagSelectMultipleWithLabel::AddClass(const std::string& _class)
+	HtmlTag& HtmlTagSelectMultipleWithLabel::AddClass(const std::string& _class)
 	{
 		HtmlTagSelectMultiple& select = reinterpret_cast<HtmlTagSelectMultiple&>(childTags.at(1));
 		select.HtmlTagSelectMultiple::AddClass(_class);
@@ -51,11 +51,11 @@ namespace Server { namespace Web
 			{
 			}
 
-			virtual HtmlTag AddAttribute(const std::string& name, const std::string& value = "") override;
+			virtual HtmlTag& AddAttribute(const std::string& name, const std::string& value = "") override;
 
 			virtual bool IsAttributeSet(const std::string& name) override;
 
-			virtual HtmlTag AddClass(const std::string& _class) override;
+			virtual HtmlTag& AddClass(const std::string& _class) override;
 	};
 }} // namespace Server::Web
 
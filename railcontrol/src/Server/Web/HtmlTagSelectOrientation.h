@@ -43,7 +43,7 @@ namespace Server { namespace Web
 
 			virtual ~HtmlTagSelectOrientation() {}
 
-			virtual inline HtmlTag AddAttribute(const std::string& name, const std::string& value) override
+			virtual inline HtmlTag& AddAttribute(const std::string& name, const std::string& value) override
 			{
 				childTags[0].AddAttribute(name, value);
 				return *this;
@@ -54,7 +54,7 @@ namespace Server { namespace Web
 				return childTags[0].IsAttributeSet(name);
 			}
 
-			virtual inline HtmlTag AddClass(const std::string& className) override
+			virtual inline HtmlTag& AddClass(const std::string& className) override
 			{
 				childTags[0].AddClass(className);
 				return *this;
@@ -40,7 +40,7 @@ namespace Server { namespace Web
 
 			virtual ~HtmlTagSelectOrientationWithLabel() {}
 
-			virtual inline HtmlTag AddAttribute(const std::string& name, const std::string& value) override
+			virtual inline HtmlTag& AddAttribute(const std::string& name, const std::string& value) override
 			{
 				childTags[1].AddAttribute(name, value);
 				return *this;
@@ -51,7 +51,7 @@ namespace Server { namespace Web
 				return childTags[1].IsAttributeSet(name);
 			}
 
-			virtual inline HtmlTag AddClass(const std::string& _class) override
+			virtual inline HtmlTag& AddClass(const std::string& _class) override
 			{
 				childTags[1].AddClass(_class);
 				return *this;
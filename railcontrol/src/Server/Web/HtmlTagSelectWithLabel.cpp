@@ -33,7 +33,7 @@ namespace Server { namespace Web
 		AddChildTag(HtmlTagSelect(name, options, defaultValue));
 	}
 
-	HtmlTag HtmlTagSelectWithLabel::AddAttribute(const std::string& name, const std::string& value)
+	HtmlTag& HtmlTagSelectWithLabel::AddAttribute(const std::string& name, const std::string& value)
 	{
 		HtmlTagSelect& select = reinterpret_cast<HtmlTagSelect&>(childTags.at(1));
 		select.HtmlTagSelect::AddAttribute(name, value);
@@ -46,7 +46,7 @@ namespace Server { namespace Web
 		return select.HtmlTagSelect::IsAttributeSet(name);
 	}
 
-	HtmlTag HtmlTagSelectWithLabel::AddClass(const std::string& _class)
+	HtmlTag& HtmlTagSelectWithLabel::AddClass(const std::string& _class)
 	{
 		HtmlTagSelect& select = reinterpret_cast<HtmlTagSelect&>(childTags.at(1));
 		select.HtmlTagSelect::AddClass(_class);
@@ -0,0 +1,261 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <cctype>
+
+#include "Server/Web/HttpRequest.h"
+#include "Utils/Integer.h"
+
+using std::string;
+
+namespace Server { namespace Web
+{
+	HttpRequest::HttpRequest()
+	{
+		headers.reserve(32);
+		arguments.reserve(32);
+		Reset();
+	}
+
+	void HttpRequest::Reset()
+	{
+		used = 0;
+		scanned = 0;
+		lineStart = 0;
+		headerEnd = 0;
+		complete = false;
+		method = Span();
+		uri = Span();
+		protocol = Span();
+		headers.clear();
+		arguments.clear();
+	}
+
+	bool HttpRequest::Received(const size_t length)
+	{
+		used += length;
+		buffer[used] = 0;
+
+		// only the newly received bytes are scanned for the empty line at the end of the header
+		while (!complete && scanned < used)
+		{
+			const char c = buffer[scanned];
+			++scanned;
+			if (c != '\n')
+			{
+				continue;
+			}
+
+			size_t lineLength = scanned - 1 - lineStart;
+			if (lineLength > 0 && buffer[lineStart + lineLength - 1] == '\r')
+			{
+				--lineLength;
+			}
+
+			if (lineLength == 0 && lineStart > 0)
+			{
+				headerEnd = lineStart;
+				complete = true;
+			}
+			lineStart = scanned;
+		}
+		return complete;
+	}
+
+	bool HttpRequest::Parse()
+	{
+		if (!complete)
+		{
+			return false;
+		}
+
+		char* lineBegin = buffer;
+		char* const end = buffer + headerEnd;
+		bool firstLine = true;
+		while (lineBegin < end)
+		{
+			char* lineEnd = static_cast<char*>(memchr(lineBegin, '\n', end - lineBegin));
+			if (!lineEnd)
+			{
+				lineEnd = end;
+			}
+			char* nextLine = lineEnd + 1;
+			if (lineEnd > lineBegin && *(lineEnd - 1) == '\r')
+			{
+				--lineEnd;
+			}
+
+			if (firstLine)
+			{
+				firstLine = false;
+				char* methodEnd = static_cast<char*>(memchr(lineBegin, ' ', lineEnd - lineBegin));
+				if (!methodEnd)
+				{
+					return false;
+				}
+				char* uriBegin = methodEnd + 1;
+				char* uriEnd = static_cast<char*>(memchr(uriBegin, ' ', lineEnd - uriBegin));
+				if (!uriEnd)
+				{
+					return false;
+				}
+				char* protocolBegin = uriEnd + 1;
+				if (memchr(protocolBegin, ' ', lineEnd - protocolBegin))
+				{
+					return false;
+				}
+
+				for (char* c = lineBegin; c < methodEnd; ++c)
+				{
+					*c = toupper(*c);
+				}
+				method = Span(lineBegin, methodEnd - lineBegin);
+				uri = Span(uriBegin, uriEnd - uriBegin);
+				protocol = Span(protocolBegin, lineEnd - protocolBegin);
+
+				char* questionMark = static_cast<char*>(memchr(uriBegin, '?', uriEnd - uriBegin));
+				if (questionMark)
+				{
+					// the arguments are decoded in a copy, so the uri stays untouched
+					const size_t argumentsLength = uriEnd - questionMark - 1;
+					memcpy(decoded, questionMark + 1, argumentsLength);
+					ParseArguments(decoded, decoded + argumentsLength);
+				}
+			}
+			else
+			{
+				char* colon = static_cast<char*>(memchr(lineBegin, ':', lineEnd - lineBegin));
+				if (colon)
+				{
+					char* valueBegin = colon + 1;
+					while (valueBegin < lineEnd && *valueBegin == ' ')
+					{
+						++valueBegin;
+					}
+					headers.push_back(KeyValue(Span(lineBegin, colon - lineBegin), Span(valueBegin, lineEnd - valueBegin)));
+				}
+			}
+			lineBegin = nextLine;
+		}
+		return !firstLine;
+	}
+
+	void HttpRequest::ParseArguments(char* start, char* end)
+	{
+		while (start < end)
+		{
+			char* argumentEnd = static_cast<char*>(memchr(start, '&', end - start));
+			if (!argumentEnd)
+			{
+				argumentEnd = end;
+			}
+			if (argumentEnd > start)
+			{
+				char* equal = static_cast<char*>(memchr(start, '=', argumentEnd - start));
+				if (equal)
+				{
+					char* valueBegin = equal + 1;
+					const size_t valueLength = UrlDecodeInPlace(valueBegin, argumentEnd - valueBegin);
+					arguments.push_back(KeyValue(Span(start, equal - start), Span(valueBegin, valueLength)));
+				}
+				else
+				{
+					arguments.push_back(KeyValue(Span(start, argumentEnd - start), Span()));
+				}
+			}
+			start = argumentEnd + 1;
+		}
+	}
+
+	size_t HttpRequest::UrlDecodeInPlace(char* data, const size_t length)
+	{
+		size_t read = 0;
+		size_t write = 0;
+		while (read < length)
+		{
+			if (data[read] == '%' && read + 3 <= length)
+			{
+				const unsigned char highNibble = Utils::Integer::HexToChar(data[read + 1]);
+				const unsigned char lowNibble = Utils::Integer::HexToChar(data[read + 2]);
+				data[write] = (highNibble << 4) + lowNibble;
+				read += 3;
+			}
+			else
+			{
+				data[write] = data[read];
+				++read;
+			}
+			++write;
+		}
+		return write;
+	}
+
+	HttpRequest::Span HttpRequest::GetHeader(const char* name) const
+	{
+		for (auto& header : headers)
+		{
+			if (header.first.EqualsIgnoreCase(name))
+			{
+				return header.second;
+			}
+		}
+		return Span();
+	}
+
+	bool HttpRequest::FindArgument(const char* name, Span& value) const
+	{
+		for (auto argument = arguments.rbegin(); argument != arguments.rend(); ++argument)
+		{
+			if (argument->first.Equals(name))
+			{
+				value = argument->second;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	string HttpRequest::Arguments::GetString(const char* name, const string& defaultValue) const
+	{
+		Span value;
+		return request.FindArgument(name, value) ? value.ToString() : defaultValue;
+	}
+
+	int HttpRequest::Arguments::GetInteger(const char* name, const int defaultValue) const
+	{
+		Span value;
+		if (!request.FindArgument(name, value))
+		{
+			return defaultValue;
+		}
+		// values are not null terminated in the buffer, numbers fit into the small string buffer
+		return Utils::Integer::StringToInteger(value.ToString(), defaultValue);
+	}
+
+	bool HttpRequest::Arguments::GetBool(const char* name, const bool defaultValue) const
+	{
+		Span value;
+		if (!request.FindArgument(name, value))
+		{
+			return defaultValue;
+		}
+		return value.Equals("true") || value.Equals("on") || value.Equals("1") || value.Equals(name);
+	}
+}} // namespace Server::Web
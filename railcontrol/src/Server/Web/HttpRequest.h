@@ -0,0 +1,192 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <strings.h>
+#include <vector>
+
+namespace Server { namespace Web
+{
+	// Incremental parser for the header of a http request.
+	// The request is received into a fixed buffer that is reused for every request of a connection.
+	// Method, uri and headers reference this buffer, the url decoded arguments a second buffer of the same size.
+	class HttpRequest
+	{
+		public:
+			class Span
+			{
+				public:
+					inline Span()
+					:	data(""),
+						length(0)
+					{
+					}
+
+					inline Span(const char* data, const size_t length)
+					:	data(data),
+						length(length)
+					{
+					}
+
+					inline bool IsEmpty() const
+					{
+						return length == 0;
+					}
+
+					inline bool Equals(const char* other) const
+					{
+						return strlen(other) == length && strncmp(data, other, length) == 0;
+					}
+
+					inline bool EqualsIgnoreCase(const char* other) const
+					{
+						return strlen(other) == length && strncasecmp(data, other, length) == 0;
+					}
+
+					inline std::string ToString() const
+					{
+						return std::string(data, length);
+					}
+
+					const char* data;
+					size_t length;
+			};
+
+			static const size_t BufferSize = 8192;
+
+			HttpRequest(const HttpRequest&) = delete;
+			HttpRequest& operator=(const HttpRequest&) = delete;
+
+			HttpRequest();
+
+			void Reset();
+
+			inline char* FreeSpace()
+			{
+				return buffer + used;
+			}
+
+			inline size_t FreeSize() const
+			{
+				return BufferSize - 1 - used;
+			}
+
+			// adds length received bytes and returns true as soon as the header of the request is complete
+			bool Received(const size_t length);
+
+			inline bool IsComplete() const
+			{
+				return complete;
+			}
+
+			// parses the complete header, returns false on a malformed request line
+			bool Parse();
+
+			inline const Span& GetMethod() const
+			{
+				return method;
+			}
+
+			inline const Span& GetUri() const
+			{
+				return uri;
+			}
+
+			inline const Span& GetProtocol() const
+			{
+				return protocol;
+			}
+
+			// header names are compared case insensitive
+			Span GetHeader(const char* name) const;
+
+			// returns false if the request has no argument name, later arguments overrule earlier ones
+			bool FindArgument(const char* name, Span& value) const;
+
+			inline Span GetArgument(const char* name) const
+			{
+				Span value;
+				FindArgument(name, value);
+				return value;
+			}
+
+			// the arguments of a request as the handlers see them, looked up in place without building a map
+			class Arguments
+			{
+				public:
+					inline Arguments(const HttpRequest& request)
+					:	request(request)
+					{
+					}
+
+					std::string GetString(const char* name, const std::string& defaultValue = "") const;
+					int GetInteger(const char* name, const int defaultValue = 0) const;
+
+					// true, on, 1 and the name itself count as true
+					bool GetBool(const char* name, const bool defaultValue = false) const;
+
+					inline std::string GetString(const std::string& name, const std::string& defaultValue = "") const
+					{
+						return GetString(name.c_str(), defaultValue);
+					}
+
+					inline int GetInteger(const std::string& name, const int defaultValue = 0) const
+					{
+						return GetInteger(name.c_str(), defaultValue);
+					}
+
+					inline bool GetBool(const std::string& name, const bool defaultValue = false) const
+					{
+						return GetBool(name.c_str(), defaultValue);
+					}
+
+				private:
+					const HttpRequest& request;
+			};
+
+			inline Arguments GetArguments() const
+			{
+				return Arguments(*this);
+			}
+
+		private:
+			typedef std::pair<Span,Span> KeyValue;
+
+			void ParseArguments(char* start, char* end);
+			static size_t UrlDecodeInPlace(char* data, const size_t length);
+
+			char buffer[BufferSize];
+			char decoded[BufferSize];
+			size_t used;
+			size_t scanned;
+			size_t lineStart;
+			size_t headerEnd;
+			bool complete;
+
+			Span method;
+			Span uri;
+			Span protocol;
+			std::vector<KeyValue> headers;
+			std::vector<KeyValue> arguments;
+	};
+}} // namespace Server::Web
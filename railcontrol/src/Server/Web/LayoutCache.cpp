@@ -0,0 +1,104 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "Server/Web/LayoutCache.h"
+
+using std::string;
+using std::to_string;
+
+namespace Server { namespace Web
+{
+	LayoutCache::LayoutCache()
+	:	started(std::time(nullptr)),
+		version(0),
+		hits(0),
+		misses(0)
+	{
+	}
+
+	void LayoutCache::AppendTo(string& buffer,
+		const ObjectType objectType,
+		const ObjectID objectID,
+		const std::function<HtmlTag()>& render)
+	{
+		const unsigned long long key = ObjectKey(objectType, objectID);
+		unsigned long long renderedVersion;
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			auto item = items.find(key);
+			if (item != items.end())
+			{
+				++hits;
+				buffer += item->second;
+				return;
+			}
+			++misses;
+			renderedVersion = version;
+		}
+
+		string rendered;
+		render().AppendTo(rendered);
+		buffer += rendered;
+
+		std::lock_guard<std::mutex> guard(mutex);
+		// the item may have changed while it has been rendered
+		if (renderedVersion == version)
+		{
+			items[key] = std::move(rendered);
+		}
+	}
+
+	void LayoutCache::Invalidate(const ObjectType objectType, const ObjectID objectID)
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		++version;
+		items.erase(ObjectKey(objectType, objectID));
+	}
+
+	void LayoutCache::Invalidate(const ObjectType objectType)
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		++version;
+		items.erase(items.lower_bound(ObjectKey(objectType, 0)), items.lower_bound(ObjectKey(static_cast<ObjectType>(objectType + 1), 0)));
+	}
+
+	void LayoutCache::InvalidateAll()
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		++version;
+		items.clear();
+	}
+
+	string LayoutCache::GetETag(const LayerID layer) const
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		return "\"" + to_string(started) + "-" + to_string(layer) + "-" + to_string(version) + "\"";
+	}
+
+	string LayoutCache::GetStatistics() const
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		return "layoutcache;" + to_string(items.size())
+			+ ";" + to_string(hits)
+			+ ";" + to_string(misses)
+			+ ";" + to_string(version)
+			+ "\n";
+	}
+}} // namespace Server::Web
@@ -0,0 +1,76 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <ctime>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "DataTypes.h"
+#include "Server/Web/HtmlTag.h"
+
+namespace Server { namespace Web
+{
+	// Keeps the rendered layout items of the web clients, so an unchanged item is not rendered again
+	// for every layout request. WebServer invalidates an item whenever it publishes a change of it.
+	// Every invalidation changes the version, which is sent as ETag of the layout pages.
+	class LayoutCache
+	{
+		public:
+			LayoutCache(const LayoutCache&) = delete;
+			LayoutCache& operator=(const LayoutCache&) = delete;
+
+			LayoutCache();
+
+			// appends the rendered item to buffer, render is only called if the item is not cached
+			void AppendTo(std::string& buffer,
+				const ObjectType objectType,
+				const ObjectID objectID,
+				const std::function<HtmlTag()>& render);
+
+			void Invalidate(const ObjectType objectType, const ObjectID objectID);
+
+			void Invalidate(const ObjectType objectType);
+
+			// used when the language has changed
+			void InvalidateAll();
+
+			std::string GetETag(const LayerID layer) const;
+
+			// returns one CSV line: layoutcache;entries;hits;misses;version
+			std::string GetStatistics() const;
+
+		private:
+			static inline unsigned long long ObjectKey(const ObjectType objectType, const ObjectID objectID)
+			{
+				return (static_cast<unsigned long long>(objectType) << 32) | objectID;
+			}
+
+			const time_t started;
+			mutable std::mutex mutex;
+			std::map<unsigned long long,std::string> items;
+			unsigned long long version;
+			unsigned long long hits;
+			unsigned long long misses;
+	};
+}} // namespace Server::Web
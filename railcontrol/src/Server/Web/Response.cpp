@@ -26,7 +26,10 @@ along with RailControl; see the file LICENCE. If not see
 namespace Server { namespace Web
 {
 	const Response::responseCodeMap Response::responseTexts = {
+		{ Response::SwitchingProtocols, "Switching Protocols" },
 		{ Response::OK, "OK" },
+		{ Response::NotModified, "Not Modified" },
+		{ Response::BadRequest, "Bad Request" },
 		{ Response::NotFound, "Not found"},
 		{ Response::NotImplemented, "Not Implemented"}
 	};
@@ -33,7 +33,10 @@ namespace Server { namespace Web
 		public:
 			enum ResponseCode : unsigned short
 			{
+				SwitchingProtocols = 101,
 				OK = 200,
+				NotModified = 304,
+				BadRequest = 400,
 				NotFound = 404,
 				NotImplemented = 501
 			};
@@ -18,14 +18,13 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
-#include <sstream>
 #include <string>
 
 #include "Server/Web/ResponseHtml.h"
 
 namespace Server { namespace Web
 {
-	ResponseHtml::ResponseHtml(const ResponseCode responseCode, const std::string& title, const HtmlTag body)
+	ResponseHtml::ResponseHtml(const ResponseCode responseCode, const std::string& title, const HtmlTag& body)
 	:	Response(responseCode, body),
 		title(title)
 	{
@@ -48,36 +47,43 @@ namespace Server { namespace Web
 
 	ResponseHtml::operator std::string()
 	{
-		std::stringstream reply;
-		reply << *this;
-		return reply.str();
+		return Serialize();
 	}
 
 	std::ostream& operator<<(std::ostream& stream, const ResponseHtml& response)
 	{
-		stream << "HTTP/1.1 " << std::to_string(response.responseCode) << " " << ResponseHtml::responseTexts.at(response.responseCode) << "\r\n";
-		for (auto& header : response.headers)
+		return stream << response.Serialize();
+	}
+
+	std::string ResponseHtml::Serialize() const
+	{
+		std::string reply("HTTP/1.1 " + std::to_string(responseCode) + " " + responseTexts.at(responseCode) + "\r\n");
+		for (auto& header : headers)
 		{
-			stream << header.first << ": " << header.second << "\r\n";
+			reply += header.first;
+			reply += ": ";
+			reply += header.second;
+			reply += "\r\n";
 		}
 
-		std::stringstream body;
-		body << "<!DOCTYPE html>";
+		if (responseCode == NotModified)
+		{
+			reply += "\r\n";
+			return reply;
+		}
 
-		HtmlTag html("html");
-		if (response.title.length() > 0)
+		std::string body("<!DOCTYPE html><html>");
+		if (title.length() > 0)
 		{
-			HtmlTag head("head");
-			head.AddChildTag(HtmlTag("title").AddContent(response.title));
-			html.AddChildTag(head);
+			body += "<head><title>";
+			body += title;
+			body += "</title></head>";
 		}
-		html.AddChildTag(response.content);
-		body << html;
+		content.AppendTo(body);
+		body += "</html>";
 
-		std::string bodyString(body.str());
-		stream << "Content-Length: " << bodyString.size();
-		stream << "\r\n\r\n";
-		stream << bodyString;
-		return stream;
+		reply += "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n";
+		reply += body;
+		return reply;
 	}
 }} // namespace Server::Web
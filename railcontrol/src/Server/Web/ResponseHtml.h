@@ -39,17 +39,17 @@ namespace Server { namespace Web
 			{
 			}
 
-			inline ResponseHtml(const HtmlTag body)
+			inline ResponseHtml(const HtmlTag& body)
 			:	ResponseHtml("", body)
 			{
 			}
 
-			inline ResponseHtml(const std::string& title, const HtmlTag body)
+			inline ResponseHtml(const std::string& title, const HtmlTag& body)
 			:	ResponseHtml(Response::OK, title, body)
 			{
 			}
 
-			ResponseHtml(const ResponseCode responseCode, const std::string& title, const HtmlTag body);
+			ResponseHtml(const ResponseCode responseCode, const std::string& title, const HtmlTag& body);
 
 			virtual ~ResponseHtml()
 			{
@@ -63,6 +63,10 @@ namespace Server { namespace Web
 
 		protected:
 			std::string title;
+
+		private:
+			// a response with NotModified has no body
+			std::string Serialize() const;
 	};
 }} // namespace Server::Web
 
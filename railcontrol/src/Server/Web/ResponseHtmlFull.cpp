@@ -45,9 +45,9 @@ namespace Server { namespace Web
 
 		HtmlTag head("head");
 		head.AddChildTag(HtmlTag("title").AddId("title").AddContent(response.title));
-		head.AddChildTag(HtmlTag("link").AddAttribute("rel", "stylesheet").AddAttribute("type", "text/css").AddAttribute("href", "/style.css"));
-		head.AddChildTag(HtmlTag("script").AddAttribute("type", "application/javascript").AddAttribute("src", "/nosleep.js"));
-		head.AddChildTag(HtmlTag("script").AddAttribute("type", "application/javascript").AddAttribute("src", "/javascript.js"));
+		head.AddChildTag(HtmlTag("link").AddAttribute("rel", "stylesheet").AddAttribute("type", "text/css").AddAttribute("href", response.Path("/style.css")));
+		head.AddChildTag(HtmlTag("script").AddAttribute("type", "application/javascript").AddAttribute("src", response.Path("/nosleep.js")));
+		head.AddChildTag(HtmlTag("script").AddAttribute("type", "application/javascript").AddAttribute("src", response.Path("/javascript.js")));
 		head.AddChildTag(HtmlTag("meta").AddAttribute("name", "viewport").AddAttribute("content", "width=device-width, initial-scale=1.0, minimum-scale=1.0, maximum-scale=1.0"));
 		head.AddChildTag(HtmlTag("meta").AddAttribute("name", "robots").AddAttribute("content", "noindex,nofollow"));
 
@@ -24,6 +24,7 @@ along with RailControl; see the file LICENCE. If not see
 #include <string>
 
 #include "Server/Web/ResponseHtml.h"
+#include "Server/Web/StaticFiles.h"
 
 namespace Server { namespace Web
 {
@@ -35,17 +36,27 @@ namespace Server { namespace Web
 			ResponseHtmlFull& operator=(const ResponseHtmlFull&) = delete;
 
 			inline ResponseHtmlFull(const ResponseCode responseCode)
-			:	ResponseHtml(responseCode)
+			:	ResponseHtml(responseCode),
+				staticFiles(nullptr)
 			{
 			}
 
 			inline ResponseHtmlFull(const std::string& title, const HtmlTag body)
-			:	ResponseHtml(title, body)
+			:	ResponseHtml(title, body),
+				staticFiles(nullptr)
+			{
+			}
+
+			// the style sheet and scripts are referenced with their versioned path
+			inline ResponseHtmlFull(const std::string& title, const HtmlTag body, const StaticFiles& staticFiles)
+			:	ResponseHtml(title, body),
+				staticFiles(&staticFiles)
 			{
 			}
 
 			ResponseHtmlFull(const ResponseCode responseCode, const std::string& title, const HtmlTag body)
-			:	ResponseHtml(responseCode, title, body)
+			:	ResponseHtml(responseCode, title, body),
+				staticFiles(nullptr)
 			{
 			}
 
@@ -56,6 +67,14 @@ namespace Server { namespace Web
 			operator std::string();
 
 			friend std::ostream& operator<<(std::ostream& stream, const ResponseHtmlFull& response);
+
+		private:
+			inline std::string Path(const std::string& virtualFile) const
+			{
+				return staticFiles ? staticFiles->GetVersionedPath(virtualFile) : virtualFile;
+			}
+
+			const StaticFiles* const staticFiles;
 	};
 }} // namespace Server::Web
 
@@ -0,0 +1,68 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "Server/Web/StateStore.h"
+
+using std::string;
+using std::to_string;
+
+namespace Server { namespace Web
+{
+	void StateStore::Set(const Key& key, const unsigned int revision, const string& command)
+	{
+		Entry& entry = entries[key.value];
+		if (!entry.command.empty())
+		{
+			revisions.erase(entry.revision);
+		}
+		entry.revision = revision;
+		entry.command = command;
+		revisions[revision] = key.value;
+	}
+
+	void StateStore::Remove(const ObjectType objectType, const ObjectID objectID)
+	{
+		// all aspects of an object lie next to each other
+		const unsigned long long begin = Key(objectType, objectID).value;
+		auto entry = entries.lower_bound(begin);
+		while (entry != entries.end() && entry->first < begin + 0x10000)
+		{
+			revisions.erase(entry->second.revision);
+			entry = entries.erase(entry);
+		}
+	}
+
+	void StateStore::ForEachChange(const unsigned int since,
+		const unsigned int until,
+		const std::function<void(const unsigned int revision, const string& command)>& append)
+	{
+		++deltas;
+		const auto end = revisions.lower_bound(until);
+		for (auto revision = revisions.lower_bound(since); revision != end; ++revision)
+		{
+			append(revision->first, entries[revision->second].command);
+		}
+	}
+
+	string StateStore::GetStatistics() const
+	{
+		return "statestore;" + to_string(entries.size()) + ";" + to_string(deltas) + "\n";
+	}
+}} // namespace Server::Web
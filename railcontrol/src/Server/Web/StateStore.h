@@ -0,0 +1,89 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <string>
+
+#include "DataTypes.h"
+
+namespace Server { namespace Web
+{
+	// Keeps the last command of every state and every setting of the objects together with its revision,
+	// which is the ID of the update that has published it. A web client that reconnects after its
+	// Last-Event-ID has fallen out of the update window gets the commands changed since then.
+	// Not thread safe, WebServer uses it only while holding its update mutex.
+	class StateStore
+	{
+		public:
+			enum Aspect : unsigned short
+			{
+				AspectSettings = 0, // settings or deletion of the object
+				AspectState,
+				AspectSpeed,
+				AspectOrientation,
+				AspectFunction // the function number is added
+			};
+
+			struct Key
+			{
+				inline Key(const ObjectType objectType, const ObjectID objectID, const unsigned short aspect = AspectSettings)
+				:	value((static_cast<unsigned long long>(objectType) << 32) | (static_cast<unsigned long long>(objectID) << 16) | aspect)
+				{
+				}
+
+				unsigned long long value;
+			};
+
+			StateStore(const StateStore&) = delete;
+			StateStore& operator=(const StateStore&) = delete;
+
+			inline StateStore()
+			:	deltas(0)
+			{
+			}
+
+			void Set(const Key& key, const unsigned int revision, const std::string& command);
+
+			// the states of a deleted object are not needed anymore, its deletion is kept with Set
+			void Remove(const ObjectType objectType, const ObjectID objectID);
+
+			// calls append in the order of the revisions for every command changed from revision since up to before revision until
+			void ForEachChange(const unsigned int since,
+				const unsigned int until,
+				const std::function<void(const unsigned int revision, const std::string& command)>& append);
+
+			// returns one CSV line: statestore;entries;deltas
+			std::string GetStatistics() const;
+
+		private:
+			struct Entry
+			{
+				unsigned int revision;
+				std::string command;
+			};
+
+			std::map<unsigned long long,Entry> entries;
+			std::map<unsigned int,unsigned long long> revisions;
+			unsigned long long deltas;
+	};
+}} // namespace Server::Web
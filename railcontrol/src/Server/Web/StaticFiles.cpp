@@ -0,0 +1,230 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
+
+#include "Hardware/ZLib.h"
+#include "Server/Web/StaticFiles.h"
+#include "Utils/Utils.h"
+
+using std::string;
+
+namespace Server { namespace Web
+{
+	static string HtmlDirectory()
+	{
+		char workingDir[128];
+		if (getcwd(workingDir, sizeof(workingDir)) == nullptr)
+		{
+			return "html";
+		}
+		return string(workingDir) + "/html";
+	}
+
+	StaticFiles::StaticFiles()
+	:	directory(HtmlDirectory()),
+		run(true),
+		inotifyFd(-1)
+	{
+		DIR* dir = opendir(directory.c_str());
+		if (dir == nullptr)
+		{
+			return;
+		}
+		struct dirent* entry;
+		while ((entry = readdir(dir)) != nullptr)
+		{
+			if (entry->d_name[0] == '.')
+			{
+				continue;
+			}
+			Load(entry->d_name);
+		}
+		closedir(dir);
+
+#ifdef __linux__
+		inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (inotifyFd < 0)
+		{
+			return;
+		}
+		if (inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM) < 0)
+		{
+			close(inotifyFd);
+			inotifyFd = -1;
+			return;
+		}
+		watchThread = std::thread(&StaticFiles::Watch, this);
+#endif
+	}
+
+	StaticFiles::~StaticFiles()
+	{
+		run = false;
+		if (watchThread.joinable())
+		{
+			watchThread.join();
+		}
+		if (inotifyFd >= 0)
+		{
+			close(inotifyFd);
+		}
+	}
+
+	std::shared_ptr<const StaticFiles::File> StaticFiles::Get(const string& virtualFile) const
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		auto file = files.find(virtualFile);
+		if (file == files.end())
+		{
+			return nullptr;
+		}
+		return file->second;
+	}
+
+	string StaticFiles::GetVersionedPath(const string& virtualFile) const
+	{
+		std::shared_ptr<const File> file = Get(virtualFile);
+		if (!file)
+		{
+			return virtualFile;
+		}
+		return virtualFile + "?v=" + file->version;
+	}
+
+	const char* StaticFiles::GetContentType(const string& file)
+	{
+		const size_t dot = file.rfind('.');
+		if (dot == string::npos)
+		{
+			return nullptr;
+		}
+		const string extension = file.substr(dot + 1);
+		if (extension.compare("ico") == 0)
+		{
+			return "image/x-icon";
+		}
+		if (extension.compare("css") == 0)
+		{
+			return "text/css";
+		}
+		if (extension.compare("png") == 0)
+		{
+			return "image/png";
+		}
+		if (extension.compare("ttf") == 0)
+		{
+			return "application/x-font-ttf";
+		}
+		if (extension.compare("js") == 0)
+		{
+			return "application/javascript";
+		}
+		if (extension.compare("svg") == 0)
+		{
+			return "image/svg+xml";
+		}
+		return nullptr;
+	}
+
+	void StaticFiles::Load(const string& file)
+	{
+		const string virtualFile = "/" + file;
+		const string realFile = directory + virtualFile;
+		struct stat s;
+		std::ifstream stream(realFile, std::ios::binary);
+		if (stat(realFile.c_str(), &s) != 0 || !S_ISREG(s.st_mode) || !stream)
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			files.erase(virtualFile);
+			return;
+		}
+
+		std::shared_ptr<File> loaded = std::make_shared<File>();
+		std::stringstream content;
+		content << stream.rdbuf();
+		loaded->plain = content.str();
+		loaded->contentType = GetContentType(file);
+
+		// images are already compressed
+		const bool isText = loaded->contentType != nullptr
+			&& (strncmp(loaded->contentType, "text/", 5) == 0
+				|| strcmp(loaded->contentType, "application/javascript") == 0
+				|| strcmp(loaded->contentType, "image/svg+xml") == 0);
+		if (isText)
+		{
+			loaded->gzip = ZLib::GZip(loaded->plain);
+			if (loaded->gzip.size() >= loaded->plain.size())
+			{
+				loaded->gzip.clear();
+			}
+		}
+
+		char version[32];
+		snprintf(version, sizeof(version), "%08lx%zx", ZLib::Crc32(loaded->plain), loaded->plain.size());
+		loaded->version = version;
+		loaded->etag = "\"" + loaded->version + "\"";
+		loaded->etagGzip = "\"" + loaded->version + "-gzip\"";
+
+		std::lock_guard<std::mutex> guard(mutex);
+		files[virtualFile] = loaded;
+	}
+
+	void StaticFiles::Watch()
+	{
+#ifdef __linux__
+		Utils::Utils::SetThreadName("StaticFiles");
+		alignas(struct inotify_event) char buffer[4096];
+		while (run)
+		{
+			struct pollfd pollFd;
+			pollFd.fd = inotifyFd;
+			pollFd.events = POLLIN;
+			if (poll(&pollFd, 1, 1000) <= 0)
+			{
+				continue;
+			}
+			const ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+			ssize_t position = 0;
+			while (position < length)
+			{
+				const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(buffer + position);
+				position += sizeof(struct inotify_event) + event->len;
+				if (event->len == 0 || event->name[0] == '.')
+				{
+					continue;
+				}
+				// Load removes deleted and moved away files
+				Load(event->name);
+			}
+		}
+#endif
+	}
+}} // namespace Server::Web
@@ -0,0 +1,72 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Server { namespace Web
+{
+	// Keeps the files of the html directory in memory, text files also gzipped.
+	// On Linux the directory is watched with inotify and changed files are loaded again.
+	class StaticFiles
+	{
+		public:
+			struct File
+			{
+				const char* contentType;
+				std::string plain;
+				std::string gzip; // empty if compressing does not make the file smaller
+				std::string version;
+				std::string etag;
+				std::string etagGzip;
+			};
+
+			StaticFiles(const StaticFiles&) = delete;
+			StaticFiles& operator=(const StaticFiles&) = delete;
+
+			StaticFiles();
+			~StaticFiles();
+
+			// returns nullptr if the file is not known, virtualFile is the path of the URI like /style.css
+			std::shared_ptr<const File> Get(const std::string& virtualFile) const;
+
+			// appends the current version to the path, so a page can reference the file with an unlimited cache lifetime
+			std::string GetVersionedPath(const std::string& virtualFile) const;
+
+			static const char* GetContentType(const std::string& file);
+
+		private:
+			void Load(const std::string& file);
+
+			void Watch();
+
+			const std::string directory;
+			mutable std::mutex mutex;
+			std::map<std::string,std::shared_ptr<const File>> files;
+			volatile bool run;
+			int inotifyFd;
+			std::thread watchThread;
+	};
+}} // namespace Server::Web
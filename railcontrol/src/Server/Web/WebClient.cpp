@@ -76,710 +76,295 @@ using LayoutPosition = DataModel::LayoutItem::LayoutPosition;
 using LayoutItemSize = DataModel::LayoutItem::LayoutItemSize;
 using LayoutRotation = DataModel::LayoutItem::LayoutRotation;
 using Visible = DataModel::LayoutItem::Visible;
-using std::deque;
 using std::map;
 using std::string;
-using std::thread;
 using std::to_string;
 using std::vector;
 
 namespace Server { namespace Web
 {
+	// sorted by name for the binary search in FindCommand
+	const WebClient::Command WebClient::commands[] =
+	{
+		{ "accessoryaddress", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleAccessoryAddress(arguments); } },
+		{ "accessoryaskdelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleAccessoryAskDelete(arguments); } },
+		{ "accessorydelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleAccessoryDelete(arguments); } },
+		{ "accessoryedit", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleAccessoryEdit(arguments); } },
+		{ "accessoryget", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleAccessoryGet(arguments); } },
+		{ "accessorylist", [](WebClient& client, const HttpRequest::Arguments&) { client.HandleAccessoryList(); } },
+		{ "accessoryrelease", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleAccessoryRelease(arguments); } },
+		{ "accessorysave", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleAccessorySave(arguments); } },
+		{ "accessorystate", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleAccessoryState(arguments); } },
+		{ "askshutdown", [](WebClient& client, const HttpRequest::Arguments&) { client.HandleAskShutdown(); } },
+		{ "booster", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleBooster(arguments); } },
+		{ "clusteraskdelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.cluster.HandleClusterAskDelete(arguments); } },
+		{ "clusterdelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.cluster.HandleClusterDelete(arguments); } },
+		{ "clusteredit", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.cluster.HandleClusterEdit(arguments); } },
+		{ "clusterlist", [](WebClient& client, const HttpRequest::Arguments&) { client.cluster.HandleClusterList(); } },
+		{ "clustersave", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.cluster.HandleClusterSave(arguments); } },
+		{ "controlarguments", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleControlArguments(arguments); } },
+		{ "controlaskdelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleControlAskDelete(arguments); } },
+		{ "controldelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleControlDelete(arguments); } },
+		{ "controledit", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleControlEdit(arguments); } },
+		{ "controllist", [](WebClient& client, const HttpRequest::Arguments&) { client.HandleControlList(); } },
+		{ "controlsave", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleControlSave(arguments); } },
+		{ "counteraskdelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.counter.HandleCounterAskDelete(arguments); } },
+		{ "counterdecrement", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.counter.HandleCounterDecrement(arguments); } },
+		{ "counterdelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.counter.HandleCounterDelete(arguments); } },
+		{ "counteredit", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.counter.HandleCounterEdit(arguments); } },
+		{ "counterget", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.counter.HandleCounterGet(arguments); } },
+		{ "counterincrement", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.counter.HandleCounterIncrement(arguments); } },
+		{ "counterlist", [](WebClient& client, const HttpRequest::Arguments&) { client.counter.HandleCounterList(); } },
+		{ "countersave", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.counter.HandleCounterSave(arguments); } },
+		{ "devicebus", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleFeedbackDeviceBus(arguments); } },
+		{ "feedbackadd", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleFeedbackAdd(arguments); } },
+		{ "feedbackaskdelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleFeedbackAskDelete(arguments); } },
+		{ "feedbackdelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleFeedbackDelete(arguments); } },
+		{ "feedbackedit", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleFeedbackEdit(arguments); } },
+		{ "feedbackget", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleFeedbackGet(arguments); } },
+		{ "feedbacklist", [](WebClient& client, const HttpRequest::Arguments&) { client.HandleFeedbackList(); } },
+		{ "feedbacksave", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleFeedbackSave(arguments); } },
+		{ "feedbacksoftrack", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.route.HandleFeedbacksOfTrack(arguments); } },
+		{ "feedbackstate", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleFeedbackState(arguments); } },
+		{ "getcvfields", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleCvFields(arguments); } },
+		{ "getlocolist", [](WebClient& client, const HttpRequest::Arguments&) { client.HandleGetLocoList(); } },
+		{ "getroutelist", [](WebClient& client, const HttpRequest::Arguments&) { client.HandleGetRouteList(); } },
+		{ "layeraskdelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleLayerAskDelete(arguments); } },
+		{ "layerdelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleLayerDelete(arguments); } },
+		{ "layeredit", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleLayerEdit(arguments); } },
+		{ "layerlist", [](WebClient& client, const HttpRequest::Arguments&) { client.HandleLayerList(); } },
+		{ "layersave", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleLayerSave(arguments); } },
+		{ "layerselector", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleLayerSelector(arguments); } },
+		{ "layout", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleLayout(arguments); } },
+		{ "loco", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleLoco(arguments); } },
+		{ "locoaddtimetable", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleLocoAddTimeTable(arguments); } },
+		{ "locoaskdelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleLocoAskDelete(arguments); } },
+		{ "locodelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleLocoDelete(arguments); } },
+		{ "locoedit", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleLocoEdit(arguments); } },
+		{ "locofunction", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleLocoFunction(arguments); } },
+		{ "locolist", [](WebClient& client, const HttpRequest::Arguments&) { client.HandleLocoList(); } },
+		{ "locoorientation", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleLocoBaseOrientation(arguments); } },
+		{ "locorelease", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleLocoRelease(arguments); } },
+		{ "locosave", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleLocoSave(arguments); } },
+		{ "locoselector", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleLocoSelector(arguments); } },
+		{ "locospeed", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleLocoBaseSpeed(arguments); } },
+		{ "multipleunitaskdelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleMultipleUnitAskDelete(arguments); } },
+		{ "multipleunitdelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleMultipleUnitDelete(arguments); } },
+		{ "multipleunitedit", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleMultipleUnitEdit(arguments); } },
+		{ "multipleunitlist", [](WebClient& client, const HttpRequest::Arguments&) { client.HandleMultipleUnitList(); } },
+		{ "multipleunitrelease", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleMultipleUnitRelease(arguments); } },
+		{ "multipleunitsave", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleMultipleUnitSave(arguments); } },
+		{ "newposition", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleNewPosition(arguments); } },
+		{ "program", [](WebClient& client, const HttpRequest::Arguments&) { client.HandleProgram(); } },
+		{ "programmodeselector", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleProgramModeSelector(arguments); } },
+		{ "programread", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleProgramRead(arguments); } },
+		{ "programwrite", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleProgramWrite(arguments); } },
+		{ "protocol", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleProtocol(arguments); } },
+		{ "relationadd", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.route.HandleRelationAdd(arguments); } },
+		{ "relationobject", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.route.HandleRelationObject(arguments); } },
+		{ "rotate", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleRotate(arguments); } },
+		{ "routeaskdelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.route.HandleRouteAskDelete(arguments); } },
+		{ "routedelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.route.HandleRouteDelete(arguments); } },
+		{ "routeedit", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.route.HandleRouteEdit(arguments); } },
+		{ "routeexecute", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.route.HandleRouteExecute(arguments); } },
+		{ "routeget", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.route.HandleRouteGet(arguments); } },
+		{ "routelist", [](WebClient& client, const HttpRequest::Arguments&) { client.route.HandleRouteList(); } },
+		{ "routerelease", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.route.HandleRouteRelease(arguments); } },
+		{ "routesave", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.route.HandleRouteSave(arguments); } },
+		{ "settingsedit", [](WebClient& client, const HttpRequest::Arguments&) { client.HandleSettingsEdit(); } },
+		{ "settingssave", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleSettingsSave(arguments); } },
+		{ "shutdown", [](WebClient& client, const HttpRequest::Arguments&) { client.HandleShutdown(); } },
+		{ "signaladdresses", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.signal.HandleSignalAddresses(arguments); } },
+		{ "signalaskdelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.signal.HandleSignalAskDelete(arguments); } },
+		{ "signaldelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.signal.HandleSignalDelete(arguments); } },
+		{ "signaledit", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.signal.HandleSignalEdit(arguments); } },
+		{ "signalget", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.signal.HandleSignalGet(arguments); } },
+		{ "signallist", [](WebClient& client, const HttpRequest::Arguments&) { client.signal.HandleSignalList(); } },
+		{ "signalrelease", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.signal.HandleSignalRelease(arguments); } },
+		{ "signalsave", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.signal.HandleSignalSave(arguments); } },
+		{ "signalstate", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.signal.HandleSignalState(arguments); } },
+		{ "signalstates", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.signal.HandleSignalStates(arguments); } },
+		{ "slaveadd", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleSlaveAdd(arguments); } },
+		{ "startall", [](WebClient& client, const HttpRequest::Arguments&) { client.manager.LocoBaseStartAll(); } },
+		{ "stats", [](WebClient& client, const HttpRequest::Arguments&) { client.HandleStats(); } },
+		{ "stopall", [](WebClient& client, const HttpRequest::Arguments&) { client.manager.LocoBaseStopAll(); } },
+		{ "stopallimmediately", [](WebClient& client, const HttpRequest::Arguments&) { client.manager.LocoBaseStopAllImmediately(ControlTypeWebServer); } },
+		{ "switchaskdelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleSwitchAskDelete(arguments); } },
+		{ "switchdelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleSwitchDelete(arguments); } },
+		{ "switchedit", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleSwitchEdit(arguments); } },
+		{ "switchget", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleSwitchGet(arguments); } },
+		{ "switchlist", [](WebClient& client, const HttpRequest::Arguments&) { client.HandleSwitchList(); } },
+		{ "switchrelease", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleSwitchRelease(arguments); } },
+		{ "switchsave", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleSwitchSave(arguments); } },
+		{ "switchstate", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleSwitchState(arguments); } },
+		{ "switchstates", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.route.HandleRelationSwitchStates(arguments); } },
+		{ "textaskdelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.text.HandleTextAskDelete(arguments); } },
+		{ "textdelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.text.HandleTextDelete(arguments); } },
+		{ "textedit", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.text.HandleTextEdit(arguments); } },
+		{ "textget", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.text.HandleTextGet(arguments); } },
+		{ "textlist", [](WebClient& client, const HttpRequest::Arguments&) { client.text.HandleTextList(); } },
+		{ "textsave", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.text.HandleTextSave(arguments); } },
+		{ "timestamp", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleTimestamp(arguments); } },
+		{ "trackaskdelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.track.HandleTrackAskDelete(arguments); } },
+		{ "trackblock", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.track.HandleTrackBlock(arguments); } },
+		{ "trackdelete", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.track.HandleTrackDelete(arguments); } },
+		{ "trackedit", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.track.HandleTrackEdit(arguments); } },
+		{ "trackget", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.track.HandleTrackGet(arguments); } },
+		{ "tracklist", [](WebClient& client, const HttpRequest::Arguments&) { client.track.HandleTrackList(); } },
+		{ "trackorientation", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.track.HandleTrackOrientation(arguments); } },
+		{ "trackrelease", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.track.HandleTrackRelease(arguments); } },
+		{ "tracksave", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.track.HandleTrackSave(arguments); } },
+		{ "tracksetloco", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.track.HandleTrackSetLoco(arguments); } },
+		{ "trackstartloco", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.track.HandleTrackStartLoco(arguments); } },
+		{ "trackstoploco", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.track.HandleTrackStopLoco(arguments); } },
+		{ "updater", [](WebClient& client, const HttpRequest::Arguments&) { client.HandleUpdater(); } },
+		{ "websocket", [](WebClient& client, const HttpRequest::Arguments& arguments) { client.HandleWebSocket(arguments); } },
+	};
+
+	Utils::LatencyHistogram WebClient::commandLatencies[WebClient::NumberOfCommands];
+
 	WebClient::~WebClient()
 	{
-		run = false;
-		clientThread.join();
+		logger->Debug(Languages::TextTcpConnectionClosed, connection->AddressAsString());
 		delete connection;
 	}
 
-	// worker is the thread that handles client requests
-	void WebClient::Worker()
+	bool WebClient::ReadRequest()
 	{
-		Utils::Utils::SetThreadName("WebClient");
-		logger->Debug(Languages::TextTcpConnectionEstablished, connection->AddressAsString());
-		WorkerImpl();
-		logger->Debug(Languages::TextTcpConnectionClosed, connection->AddressAsString());
-		terminated = true;
+		// the previous request has been handled, a partial request is continued
+		if (request.IsComplete())
+		{
+			request.Reset();
+		}
+		if (request.FreeSize() == 0)
+		{
+			return false;
+		}
+		const int ret = connection->ReceiveNonBlocking(request.FreeSpace(), request.FreeSize());
+		if (ret == 0 || (ret < 0 && errno != EAGAIN))
+		{
+			return false;
+		}
+		if (ret > 0)
+		{
+			request.Received(ret);
+		}
+		return true;
 	}
 
-	void WebClient::WorkerImpl()
+	bool WebClient::HandleRequest()
 	{
-		run = true;
-		bool keepalive = true;
-
-		while (run && keepalive)
+		if (webSocket)
 		{
-			const int BufferSize = 8192;
-			char buffer[BufferSize];
-			memset(buffer, 0, BufferSize);
-
-			int pos = 0;
-			string s;
-			while (pos < BufferSize - 1 && s.find("\n\n") == string::npos && run)
-			{
-				int ret = connection->Receive(buffer + pos, BufferSize - 1 - pos, 0);
-				if (ret == -1)
-				{
-					if (errno != ETIMEDOUT)
-					{
-						logger->Debug(Languages::TextErrorReadingData, strerror(errno));
-						return;
-					}
-					if (run == false)
-					{
-						return;
-					}
-					continue;
-				}
-				pos += ret;
-				s = string(buffer);
-				Utils::Utils::ReplaceString(s, string("\r\n"), string("\n"));
-				Utils::Utils::ReplaceString(s, string("\r"), string("\n"));
-			}
-
-			deque<string> lines;
-			Utils::Utils::SplitString(s, string("\n"), lines);
+			return ReceiveWebSocket();
+		}
 
-			if (lines.size() <= 1)
-			{
-				return;
-			}
+		if (!request.Parse())
+		{
+			return false;
+		}
 
-			string method;
-			string uri;
-			string protocol;
-			map<string, string> arguments;
-			map<string, string> headers;
-			InterpretClientRequest(lines, method, uri, protocol, arguments, headers);
-			keepalive = (Utils::Utils::GetStringMapEntry(headers, "Connection", "close").compare("keep-alive") == 0);
-			logger->Info(Languages::TextHttpRequest, method, uri);
+		const string method = request.GetMethod().ToString();
+		const string uri = request.GetUri().ToString();
+		headOnly = request.GetMethod().Equals("HEAD");
+		const HttpRequest::Arguments arguments = request.GetArguments();
+		const bool keepalive = request.GetHeader("Connection").EqualsIgnoreCase("keep-alive");
+		logger->Info(Languages::TextHttpRequest, method, uri);
 
-			// if method is not implemented
-			if ((method.compare("GET") != 0) && (method.compare("HEAD") != 0))
-			{
-				logger->Info(Languages::TextMethodNotImplemented, id, method);
-				ResponseHtmlNotImplemented response(method);
-				connection->Send(response);
-				return;
-			}
+		// if method is not implemented
+		if ((method.compare("GET") != 0) && (method.compare("HEAD") != 0))
+		{
+			logger->Info(Languages::TextMethodNotImplemented, id, method);
+			ResponseHtmlNotImplemented response(method);
+			connection->Send(response);
+			return false;
+		}
 
-			// handle requests
-			if (uri.compare("/") == 0)
-			{
-				PrintMainHTML();
-				if (server.UpdateAvailable())
-				{
-					server.AddUpdate("warning", Languages::TextRailControlUpdateAvailable);
-				}
-			}
-			else if (arguments["cmd"].compare("askshutdown") == 0)
-			{
-				HandleAskShutdown();
-			}
-			else if (arguments["cmd"].compare("shutdown") == 0)
-			{
-				ReplyResponse(ResponseInfo, Languages::TextShutdownRailControl);
-				shutdownRailControlWebserver();
-			}
-			else if (arguments["cmd"].compare("booster") == 0)
-			{
-				bool on = Utils::Utils::GetBoolMapEntry(arguments, "on");
-				if (on)
-				{
-					ReplyHtmlWithHeaderAndParagraph(Languages::TextTurningBoosterOn);
-					manager.Booster(ControlTypeWebServer, BoosterStateGo);
-				}
-				else
-				{
-					ReplyHtmlWithHeaderAndParagraph(Languages::TextTurningBoosterOff);
-					manager.Booster(ControlTypeWebServer, BoosterStateStop);
-				}
-			}
-			else if (arguments["cmd"].compare("layeredit") == 0)
-			{
-				HandleLayerEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("layersave") == 0)
-			{
-				HandleLayerSave(arguments);
-			}
-			else if (arguments["cmd"].compare("layerlist") == 0)
-			{
-				HandleLayerList();
-			}
-			else if (arguments["cmd"].compare("layeraskdelete") == 0)
-			{
-				HandleLayerAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("layerdelete") == 0)
-			{
-				HandleLayerDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("controledit") == 0)
-			{
-				HandleControlEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("controlsave") == 0)
-			{
-				HandleControlSave(arguments);
-			}
-			else if (arguments["cmd"].compare("controllist") == 0)
-			{
-				HandleControlList();
-			}
-			else if (arguments["cmd"].compare("controlaskdelete") == 0)
-			{
-				HandleControlAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("controldelete") == 0)
-			{
-				HandleControlDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("loco") == 0)
-			{
-				HandleLoco(arguments);
-			}
-			else if (arguments["cmd"].compare("locospeed") == 0)
-			{
-				HandleLocoBaseSpeed(arguments);
-			}
-			else if (arguments["cmd"].compare("locoorientation") == 0)
-			{
-				HandleLocoBaseOrientation(arguments);
-			}
-			else if (arguments["cmd"].compare("locofunction") == 0)
-			{
-				HandleLocoFunction(arguments);
-			}
-			else if (arguments["cmd"].compare("locoedit") == 0)
-			{
-				HandleLocoEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("locosave") == 0)
-			{
-				HandleLocoSave(arguments);
-			}
-			else if (arguments["cmd"].compare("locolist") == 0)
-			{
-				HandleLocoList();
-			}
-			else if (arguments["cmd"].compare("locoaskdelete") == 0)
-			{
-				HandleLocoAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("locodelete") == 0)
-			{
-				HandleLocoDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("locorelease") == 0)
-			{
-				HandleLocoRelease(arguments);
-			}
-			else if (arguments["cmd"].compare("locoaddtimetable") == 0)
-			{
-				HandleLocoAddTimeTable(arguments);
-			}
-			else if (arguments["cmd"].compare("multipleunitedit") == 0)
-			{
-				HandleMultipleUnitEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("multipleunitsave") == 0)
-			{
-				HandleMultipleUnitSave(arguments);
-			}
-			else if (arguments["cmd"].compare("multipleunitlist") == 0)
-			{
-				HandleMultipleUnitList();
-			}
-			else if (arguments["cmd"].compare("multipleunitaskdelete") == 0)
-			{
-				HandleMultipleUnitAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("multipleunitdelete") == 0)
-			{
-				HandleMultipleUnitDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("multipleunitrelease") == 0)
-			{
-				HandleMultipleUnitRelease(arguments);
-			}
-			else if (arguments["cmd"].compare("accessoryedit") == 0)
-			{
-				HandleAccessoryEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("accessorysave") == 0)
-			{
-				HandleAccessorySave(arguments);
-			}
-			else if (arguments["cmd"].compare("accessorystate") == 0)
-			{
-				HandleAccessoryState(arguments);
-			}
-			else if (arguments["cmd"].compare("accessorylist") == 0)
-			{
-				HandleAccessoryList();
-			}
-			else if (arguments["cmd"].compare("accessoryaskdelete") == 0)
-			{
-				HandleAccessoryAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("accessorydelete") == 0)
-			{
-				HandleAccessoryDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("accessoryget") == 0)
-			{
-				HandleAccessoryGet(arguments);
-			}
-			else if (arguments["cmd"].compare("accessoryrelease") == 0)
-			{
-				HandleAccessoryRelease(arguments);
-			}
-			else if (arguments["cmd"].compare("switchedit") == 0)
-			{
-				HandleSwitchEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("switchsave") == 0)
-			{
-				HandleSwitchSave(arguments);
-			}
-			else if (arguments["cmd"].compare("switchstate") == 0)
-			{
-				HandleSwitchState(arguments);
-			}
-			else if (arguments["cmd"].compare("switchstates") == 0)
-			{
-				route.HandleRelationSwitchStates(arguments);
-			}
-			else if (arguments["cmd"].compare("switchlist") == 0)
-			{
-				HandleSwitchList();
-			}
-			else if (arguments["cmd"].compare("switchaskdelete") == 0)
-			{
-				HandleSwitchAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("switchdelete") == 0)
-			{
-				HandleSwitchDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("switchget") == 0)
-			{
-				HandleSwitchGet(arguments);
-			}
-			else if (arguments["cmd"].compare("switchrelease") == 0)
-			{
-				HandleSwitchRelease(arguments);
-			}
-			else if (arguments["cmd"].compare("signaladdresses") == 0)
-			{
-				signal.HandleSignalAddresses(arguments);
-			}
-			else if (arguments["cmd"].compare("signaledit") == 0)
-			{
-				signal.HandleSignalEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("signalsave") == 0)
-			{
-				signal.HandleSignalSave(arguments);
-			}
-			else if (arguments["cmd"].compare("signalstate") == 0)
-			{
-				signal.HandleSignalState(arguments);
-			}
-			else if (arguments["cmd"].compare("signalstates") == 0)
-			{
-				signal.HandleSignalStates(arguments);
-			}
-			else if (arguments["cmd"].compare("signallist") == 0)
-			{
-				signal.HandleSignalList();
-			}
-			else if (arguments["cmd"].compare("signalaskdelete") == 0)
-			{
-				signal.HandleSignalAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("signaldelete") == 0)
-			{
-				signal.HandleSignalDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("signalget") == 0)
-			{
-				signal.HandleSignalGet(arguments);
-			}
-			else if (arguments["cmd"].compare("signalrelease") == 0)
-			{
-				signal.HandleSignalRelease(arguments);
-			}
-			else if (arguments["cmd"].compare("routeedit") == 0)
-			{
-				route.HandleRouteEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("routesave") == 0)
-			{
-				route.HandleRouteSave(arguments);
-			}
-			else if (arguments["cmd"].compare("routelist") == 0)
-			{
-				route.HandleRouteList();
-			}
-			else if (arguments["cmd"].compare("routeaskdelete") == 0)
-			{
-				route.HandleRouteAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("routedelete") == 0)
-			{
-				route.HandleRouteDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("routeget") == 0)
-			{
-				route.HandleRouteGet(arguments);
-			}
-			else if (arguments["cmd"].compare("routeexecute") == 0)
-			{
-				route.HandleRouteExecute(arguments);
-			}
-			else if (arguments["cmd"].compare("routerelease") == 0)
-			{
-				route.HandleRouteRelease(arguments);
-			}
-			else if (arguments["cmd"].compare("textedit") == 0)
-			{
-				text.HandleTextEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("textsave") == 0)
-			{
-				text.HandleTextSave(arguments);
-			}
-			else if (arguments["cmd"].compare("textlist") == 0)
-			{
-				text.HandleTextList();
-			}
-			else if (arguments["cmd"].compare("textaskdelete") == 0)
-			{
-				text.HandleTextAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("textdelete") == 0)
-			{
-				text.HandleTextDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("textget") == 0)
-			{
-				text.HandleTextGet(arguments);
-			}
-			else if (arguments["cmd"].compare("trackedit") == 0)
-			{
-				track.HandleTrackEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("tracksave") == 0)
-			{
-				track.HandleTrackSave(arguments);
-			}
-			else if (arguments["cmd"].compare("tracklist") == 0)
-			{
-				track.HandleTrackList();
-			}
-			else if (arguments["cmd"].compare("trackaskdelete") == 0)
-			{
-				track.HandleTrackAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("trackdelete") == 0)
-			{
-				track.HandleTrackDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("trackget") == 0)
-			{
-				track.HandleTrackGet(arguments);
-			}
-			else if (arguments["cmd"].compare("tracksetloco") == 0)
-			{
-				track.HandleTrackSetLoco(arguments);
-			}
-			else if (arguments["cmd"].compare("trackrelease") == 0)
-			{
-				track.HandleTrackRelease(arguments);
-			}
-			else if (arguments["cmd"].compare("trackstartloco") == 0)
-			{
-				track.HandleTrackStartLoco(arguments);
-			}
-			else if (arguments["cmd"].compare("trackstoploco") == 0)
-			{
-				track.HandleTrackStopLoco(arguments);
-			}
-			else if (arguments["cmd"].compare("trackblock") == 0)
-			{
-				track.HandleTrackBlock(arguments);
-			}
-			else if (arguments["cmd"].compare("trackorientation") == 0)
-			{
-				track.HandleTrackOrientation(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbackedit") == 0)
-			{
-				HandleFeedbackEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbacksave") == 0)
-			{
-				HandleFeedbackSave(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbackstate") == 0)
-			{
-				HandleFeedbackState(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbacklist") == 0)
-			{
-				HandleFeedbackList();
-			}
-			else if (arguments["cmd"].compare("feedbackaskdelete") == 0)
-			{
-				HandleFeedbackAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbackdelete") == 0)
-			{
-				HandleFeedbackDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbackget") == 0)
-			{
-				HandleFeedbackGet(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbacksoftrack") == 0)
-			{
-				route.HandleFeedbacksOfTrack(arguments);
-			}
-			else if (arguments["cmd"].compare("devicebus") == 0)
-			{
-				HandleFeedbackDeviceBus(arguments);
-			}
-			else if (arguments["cmd"].compare("protocol") == 0)
-			{
-				HandleProtocol(arguments);
-			}
-			else if (arguments["cmd"].compare("accessoryaddress") == 0)
-			{
-				HandleAccessoryAddress(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbackadd") == 0)
-			{
-				HandleFeedbackAdd(arguments);
-			}
-			else if (arguments["cmd"].compare("relationadd") == 0)
-			{
-				route.HandleRelationAdd(arguments);
-			}
-			else if (arguments["cmd"].compare("relationobject") == 0)
-			{
-				route.HandleRelationObject(arguments);
-			}
-			else if (arguments["cmd"].compare("layout") == 0)
-			{
-				HandleLayout(arguments);
-			}
-			else if (arguments["cmd"].compare("locoselector") == 0)
-			{
-				HandleLocoSelector(arguments);
-			}
-			else if (arguments["cmd"].compare("layerselector") == 0)
-			{
-				HandleLayerSelector(arguments);
-			}
-			else if (arguments["cmd"].compare("stopallimmediately") == 0)
-			{
-				manager.LocoBaseStopAllImmediately(ControlTypeWebServer);
-			}
-			else if (arguments["cmd"].compare("startall") == 0)
-			{
-				manager.LocoBaseStartAll();
-			}
-			else if (arguments["cmd"].compare("stopall") == 0)
-			{
-				manager.LocoBaseStopAll();
-			}
-			else if (arguments["cmd"].compare("settingsedit") == 0)
-			{
-				HandleSettingsEdit();
-			}
-			else if (arguments["cmd"].compare("settingssave") == 0)
-			{
-				HandleSettingsSave(arguments);
-			}
-			else if (arguments["cmd"].compare("slaveadd") == 0)
-			{
-				HandleSlaveAdd(arguments);
-			}
-			else if (arguments["cmd"].compare("timestamp") == 0)
-			{
-				HandleTimestamp(arguments);
-			}
-			else if (arguments["cmd"].compare("controlarguments") == 0)
-			{
-				HandleControlArguments(arguments);
-			}
-			else if (arguments["cmd"].compare("program") == 0)
-			{
-				HandleProgram();
-			}
-			else if (arguments["cmd"].compare("programmodeselector") == 0)
-			{
-				HandleProgramModeSelector(arguments);
-			}
-			else if (arguments["cmd"].compare("programread") == 0)
-			{
-				HandleProgramRead(arguments);
-			}
-			else if (arguments["cmd"].compare("programwrite") == 0)
-			{
-				HandleProgramWrite(arguments);
-			}
-			else if (arguments["cmd"].compare("getcvfields") == 0)
-			{
-				HandleCvFields(arguments);
-			}
-			else if (arguments["cmd"].compare("clusterlist") == 0)
-			{
-				cluster.HandleClusterList();
-			}
-			else if (arguments["cmd"].compare("clusteredit") == 0)
-			{
-				cluster.HandleClusterEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("clustersave") == 0)
-			{
-				cluster.HandleClusterSave(arguments);
-			}
-			else if (arguments["cmd"].compare("clusteraskdelete") == 0)
-			{
-				cluster.HandleClusterAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("clusterdelete") == 0)
-			{
-				cluster.HandleClusterDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("counterlist") == 0)
-			{
-				counter.HandleCounterList();
-			}
-			else if (arguments["cmd"].compare("counteredit") == 0)
-			{
-				counter.HandleCounterEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("countersave") == 0)
-			{
-				counter.HandleCounterSave(arguments);
-			}
-			else if (arguments["cmd"].compare("counteraskdelete") == 0)
-			{
-				counter.HandleCounterAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("counterdelete") == 0)
-			{
-				counter.HandleCounterDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("counterget") == 0)
-			{
-				counter.HandleCounterGet(arguments);
-			}
-			else if (arguments["cmd"].compare("counterincrement") == 0)
-			{
-				counter.HandleCounterIncrement(arguments);
-			}
-			else if (arguments["cmd"].compare("counterdecrement") == 0)
+		// handle requests
+		if (uri.compare("/") == 0)
+		{
+			PrintMainHTML();
+			if (server.UpdateAvailable())
 			{
-				counter.HandleCounterDecrement(arguments);
+				server.AddUpdate("warning", Languages::TextRailControlUpdateAvailable);
 			}
-			else if (arguments["cmd"].compare("newposition") == 0)
+		}
+		else
+		{
+			HttpRequest::Span cmd;
+			const size_t command = (request.FindArgument("cmd", cmd) ? FindCommand(cmd) : NumberOfCommands);
+			if (command < NumberOfCommands)
 			{
-				HandleNewPosition(arguments);
+				const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				commands[command].handler(*this, arguments);
+				commandLatencies[command].Add(start);
 			}
-			else if (arguments["cmd"].compare("rotate") == 0)
+			else
 			{
-				HandleRotate(arguments);
+				DeliverFile(uri, arguments);
 			}
-			else if (arguments["cmd"].compare("getlocolist") == 0)
+		}
+		return keepalive;
+	}
+
+	size_t WebClient::FindCommand(const HttpRequest::Span& name)
+	{
+		static_assert(sizeof(commands) / sizeof(commands[0]) == NumberOfCommands, "NumberOfCommands does not match the command table");
+
+		size_t first = 0;
+		size_t last = NumberOfCommands;
+		while (first < last)
+		{
+			const size_t middle = first + (last - first) / 2;
+			const char* commandName = commands[middle].name;
+			int compare = strncmp(commandName, name.data, name.length);
+			if (compare == 0 && commandName[name.length] != '\0')
 			{
-				string s = manager.GetLocoList();
-				connection->Send(ResponseCsv(s));
+				// the name of the command is longer
+				compare = 1;
 			}
-			else if (arguments["cmd"].compare("getroutelist") == 0)
+			if (compare == 0)
 			{
-				string s = manager.GetRouteList();
-				connection->Send(ResponseCsv(s));
+				return middle;
 			}
-			else if (arguments["cmd"].compare("updater") == 0)
+			if (compare < 0)
 			{
-				HandleUpdater(headers);
+				first = middle + 1;
 			}
 			else
 			{
-				DeliverFile(uri);
+				last = middle;
 			}
 		}
+		return NumberOfCommands;
 	}
 
-	void WebClient::InterpretClientRequest(const deque<string>& lines, string& method, string& uri, string& protocol, map<string,string>& arguments, map<string,string>& headers)
+	string WebClient::GetCommandStatistics()
 	{
-		if (lines.size() == 0)
+		string statistics;
+		for (size_t command = 0; command < NumberOfCommands; ++command)
 		{
-			return;
-		}
-
-		for (auto& line : lines)
-		{
-			if (line.find("HTTP/1.") == string::npos)
-			{
-				deque<string> list;
-				Utils::Utils::SplitString(line, string(": "), list);
-				if (list.size() == 2)
-				{
-					headers[list[0]] = list[1];
-				}
-				continue;
-			}
-
-			deque<string> list;
-			Utils::Utils::SplitString(line, string(" "), list);
-			if (list.size() != 3)
+			const Utils::LatencyHistogram& latency = commandLatencies[command];
+			if (latency.GetCount() == 0)
 			{
 				continue;
 			}
-
-			method = list[0];
-			// transform method to uppercase
-			std::transform(method.begin(), method.end(), method.begin(), ::toupper);
-
-			// if method == HEAD set membervariable
-			headOnly = method.compare("HEAD") == 0;
-
-			// set uri and protocol
-			uri = list[1];
-			protocol = list[2];
-
-			// read GET-arguments from uri
-			deque<string> uriParts;
-			Utils::Utils::SplitString(uri, "?", uriParts);
-			if (uriParts.size() != 2)
-			{
-				continue;
-			}
-
-			deque<string> argumentStrings;
-			Utils::Utils::SplitString(uriParts[1], "&", argumentStrings);
-			for (auto& argument : argumentStrings)
-			{
-				if (argument.length() == 0)
-				{
-					continue;
-				}
-				string key;
-				string value;
-				Utils::Utils::SplitString(argument, "=", key, value);
-				arguments[key] = Utils::Utils::UrlDecode(value);
-			}
+			statistics += latency.ToCsv(string("webcommand;") + commands[command].name);
 		}
+		return statistics;
 	}
 
-	void WebClient::DeliverFile(const string& virtualFile)
+	void WebClient::DeliverFile(const string& uri, const HttpRequest::Arguments& arguments)
 	{
+		const string virtualFile = uri.substr(0, uri.find('?'));
+		std::shared_ptr<const StaticFiles::File> file = server.GetStaticFiles().Get(virtualFile);
+		if (file)
+		{
+			const bool versioned = arguments.GetString("v").compare(file->version) == 0;
+			DeliverStaticFile(*file, versioned);
+			return;
+		}
+
 		std::stringstream ss;
 		char workingDir[128];
 		if (getcwd(workingDir, sizeof(workingDir)))
@@ -810,31 +395,7 @@ namespace Server { namespace Web
 			return;
 		}
 
-		size_t length = virtualFile.length();
-		const char* contentType = nullptr;
-		if (length > 4 && virtualFile[length - 4] == '.')
-		{
-			if (virtualFile[length - 3] == 'i' && virtualFile[length - 2] == 'c' && virtualFile[length - 1] == 'o')
-			{
-				contentType = "image/x-icon";
-			}
-			else if (virtualFile[length - 3] == 'c' && virtualFile[length - 2] == 's' && virtualFile[length - 1] == 's')
-			{
-				contentType = "text/css";
-			}
-			else if (virtualFile[length - 3] == 'p' && virtualFile[length - 2] == 'n' && virtualFile[length - 1] == 'g')
-			{
-				contentType = "image/png";
-			}
-			else if (virtualFile[length - 3] == 't' && virtualFile[length - 2] == 't' && virtualFile[length - 1] == 'f')
-			{
-				contentType = "application/x-font-ttf";
-			}
-		}
-		else if (length > 3 && virtualFile[length - 3] == '.' && virtualFile[length - 2] == 'j' && virtualFile[length - 1] == 's')
-		{
-			contentType = "application/javascript";
-		}
+		const char* contentType = StaticFiles::GetContentType(virtualFile);
 
 		Response response;
 		response.AddHeader("Cache-Control", "no-cache, must-revalidate");
@@ -863,6 +424,44 @@ namespace Server { namespace Web
 		free(buffer);
 	}
 
+	void WebClient::DeliverStaticFile(const StaticFiles::File& file, const bool versioned)
+	{
+		const bool gzip = !file.gzip.empty() && request.GetHeader("Accept-Encoding").ToString().find("gzip") != string::npos;
+		const string& etag = gzip ? file.etagGzip : file.etag;
+
+		Response response;
+		response.AddHeader("ETag", etag);
+		// a versioned path changes together with the content, so it never has to be checked again
+		response.AddHeader("Cache-Control", versioned ? "public, max-age=31536000, immutable" : "no-cache");
+		if (!file.gzip.empty())
+		{
+			response.AddHeader("Vary", "Accept-Encoding");
+		}
+		if (request.GetHeader("If-None-Match").Equals(etag.c_str()))
+		{
+			response.responseCode = Response::NotModified;
+			connection->Send(response);
+			return;
+		}
+
+		const string& content = gzip ? file.gzip : file.plain;
+		if (gzip)
+		{
+			response.AddHeader("Content-Encoding", "gzip");
+		}
+		response.AddHeader("Content-Length", to_string(content.size()));
+		if (file.contentType != nullptr)
+		{
+			response.AddHeader("Content-Type", file.contentType);
+		}
+		string reply = response;
+		if (headOnly == false)
+		{
+			reply += content;
+		}
+		connection->Send(reply);
+	}
+
 	void WebClient::HandleAskShutdown()
 	{
 		HtmlTag content;
@@ -874,10 +473,48 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleLayerEdit(const map<string, string>& arguments)
+	void WebClient::HandleShutdown()
+	{
+		ReplyResponse(ResponseInfo, Languages::TextShutdownRailControl);
+		shutdownRailControlWebserver();
+	}
+
+	void WebClient::HandleBooster(const HttpRequest::Arguments& arguments)
+	{
+		bool on = arguments.GetBool("on");
+		if (on)
+		{
+			ReplyHtmlWithHeaderAndParagraph(Languages::TextTurningBoosterOn);
+			manager.Booster(ControlTypeWebServer, BoosterStateGo);
+		}
+		else
+		{
+			ReplyHtmlWithHeaderAndParagraph(Languages::TextTurningBoosterOff);
+			manager.Booster(ControlTypeWebServer, BoosterStateStop);
+		}
+	}
+
+	void WebClient::HandleGetLocoList()
+	{
+		string s = manager.GetLocoList();
+		connection->Send(ResponseCsv(s));
+	}
+
+	void WebClient::HandleGetRouteList()
+	{
+		string s = manager.GetRouteList();
+		connection->Send(ResponseCsv(s));
+	}
+
+	void WebClient::HandleStats()
+	{
+		connection->Send(ResponseCsv(manager.GetStatistics()));
+	}
+
+	void WebClient::HandleLayerEdit(const HttpRequest::Arguments& arguments)
 	{
 		HtmlTag content;
-		LayerID layerID = Utils::Utils::GetIntegerMapEntry(arguments, "layer", LayerNone);
+		LayerID layerID = arguments.GetInteger("layer", LayerNone);
 		string name = Languages::GetText(Languages::TextNew);
 
 		if (layerID != LayerNone)
@@ -901,10 +538,10 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleLayerSave(const map<string, string>& arguments)
+	void WebClient::HandleLayerSave(const HttpRequest::Arguments& arguments)
 	{
-		LayerID layerID = Utils::Utils::GetIntegerMapEntry(arguments, "layer", LayerNone);
-		string name = Utils::Utils::GetStringMapEntry(arguments, "name");
+		LayerID layerID = arguments.GetInteger("layer", LayerNone);
+		string name = arguments.GetString("name");
 		string result;
 
 		if (!manager.LayerSave(layerID, name, result))
@@ -916,9 +553,9 @@ namespace Server { namespace Web
 		ReplyResponse(ResponseInfo, Languages::TextLayerSaved, name);
 	}
 
-	void WebClient::HandleLayerAskDelete(const map<string, string>& arguments)
+	void WebClient::HandleLayerAskDelete(const HttpRequest::Arguments& arguments)
 	{
-		LayerID layerID = Utils::Utils::GetIntegerMapEntry(arguments, "layer", LayerNone);
+		LayerID layerID = arguments.GetInteger("layer", LayerNone);
 
 		if (layerID == LayerNone)
 		{
@@ -951,9 +588,9 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleLayerDelete(const map<string, string>& arguments)
+	void WebClient::HandleLayerDelete(const HttpRequest::Arguments& arguments)
 	{
-		LayerID layerID = Utils::Utils::GetIntegerMapEntry(arguments, "layer", LayerNone);
+		LayerID layerID = arguments.GetInteger("layer", LayerNone);
 
 		if (layerID == LayerNone)
 		{
@@ -1011,10 +648,10 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleControlEdit(const map<string, string>& arguments)
+	void WebClient::HandleControlEdit(const HttpRequest::Arguments& arguments)
 	{
 		HtmlTag content;
-		ControlID controlID = Utils::Utils::GetIntegerMapEntry(arguments, "control", ControlIdNone);
+		ControlID controlID = arguments.GetInteger("control", ControlIdNone);
 		HardwareType hardwareType = HardwareTypeNone;
 		string name = Languages::GetText(Languages::TextNew);
 		string arg1;
@@ -1062,16 +699,16 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleControlSave(const map<string, string>& arguments)
+	void WebClient::HandleControlSave(const HttpRequest::Arguments& arguments)
 	{
-		ControlID controlID = Utils::Utils::GetIntegerMapEntry(arguments, "control", ControlIdNone);
-		string name = Utils::Utils::GetStringMapEntry(arguments, "name");
-		HardwareType hardwareType = static_cast<HardwareType>(Utils::Utils::GetIntegerMapEntry(arguments, "hardwaretype", HardwareTypeNone));
-		string arg1 = Utils::Utils::GetStringMapEntry(arguments, "arg1");
-		string arg2 = Utils::Utils::GetStringMapEntry(arguments, "arg2");
-		string arg3 = Utils::Utils::GetStringMapEntry(arguments, "arg3");
-		string arg4 = Utils::Utils::GetStringMapEntry(arguments, "arg4");
-		string arg5 = Utils::Utils::GetStringMapEntry(arguments, "arg5");
+		ControlID controlID = arguments.GetInteger("control", ControlIdNone);
+		string name = arguments.GetString("name");
+		HardwareType hardwareType = static_cast<HardwareType>(arguments.GetInteger("hardwaretype", HardwareTypeNone));
+		string arg1 = arguments.GetString("arg1");
+		string arg2 = arguments.GetString("arg2");
+		string arg3 = arguments.GetString("arg3");
+		string arg4 = arguments.GetString("arg4");
+		string arg5 = arguments.GetString("arg5");
 		string result;
 
 		if (!manager.ControlSave(controlID, hardwareType, name, arg1, arg2, arg3, arg4, arg5, result))
@@ -1083,9 +720,9 @@ namespace Server { namespace Web
 		ReplyResponse(ResponseInfo, Languages::TextControlSaved, name);
 	}
 
-	void WebClient::HandleControlAskDelete(const map<string, string>& arguments)
+	void WebClient::HandleControlAskDelete(const HttpRequest::Arguments& arguments)
 	{
-		ControlID controlID = Utils::Utils::GetIntegerMapEntry(arguments, "control", ControlNone);
+		ControlID controlID = arguments.GetInteger("control", ControlNone);
 
 		if (controlID == ControlNone)
 		{
@@ -1112,9 +749,9 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleControlDelete(const map<string, string>& arguments)
+	void WebClient::HandleControlDelete(const HttpRequest::Arguments& arguments)
 	{
-		ControlID controlID = Utils::Utils::GetIntegerMapEntry(arguments, "control", ControlNone);
+		ControlID controlID = arguments.GetInteger("control", ControlNone);
 		const Hardware::HardwareParams* control = manager.GetHardware(controlID);
 		if (control == nullptr)
 		{
@@ -1156,10 +793,10 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleLocoBaseSpeed(const map<string, string>& arguments)
+	void WebClient::HandleLocoBaseSpeed(const HttpRequest::Arguments& arguments)
 	{
-		const LocoID locoID = Utils::Utils::GetIntegerMapEntry(arguments, "loco", LocoNone);
-		const Speed speed = Utils::Utils::GetIntegerMapEntry(arguments, "speed", MinSpeed);
+		const LocoID locoID = arguments.GetInteger("loco", LocoNone);
+		const Speed speed = arguments.GetInteger("speed", MinSpeed);
 
 		const ObjectIdentifier locoBaseIdentifier(WebClientStatic::LocoIdToObjectIdentifier(locoID));
 
@@ -1168,10 +805,10 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeaderAndParagraph(Languages::TextLocoSpeedIs, manager.GetLocoBaseName(locoBaseIdentifier), speed);
 	}
 
-	void WebClient::HandleLocoBaseOrientation(const map<string, string>& arguments)
+	void WebClient::HandleLocoBaseOrientation(const HttpRequest::Arguments& arguments)
 	{
-		const LocoID locoID = Utils::Utils::GetIntegerMapEntry(arguments, "loco", LocoNone);
-		const Orientation orientation = (Utils::Utils::GetBoolMapEntry(arguments, "on") ? OrientationRight : OrientationLeft);
+		const LocoID locoID = arguments.GetInteger("loco", LocoNone);
+		const Orientation orientation = (arguments.GetBool("on") ? OrientationRight : OrientationLeft);
 
 		const ObjectIdentifier locoBaseIdentifier(WebClientStatic::LocoIdToObjectIdentifier(locoID));
 
@@ -1180,11 +817,11 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeaderAndParagraph(orientation == OrientationLeft ? Languages::TextLocoDirectionOfTravelIsLeft : Languages::TextLocoDirectionOfTravelIsRight, manager.GetLocoBaseName(locoBaseIdentifier));
 	}
 
-	void WebClient::HandleLocoFunction(const map<string, string>& arguments)
+	void WebClient::HandleLocoFunction(const HttpRequest::Arguments& arguments)
 	{
-		const LocoID locoID = Utils::Utils::GetIntegerMapEntry(arguments, "loco", LocoNone);
-		const DataModel::LocoFunctionNr function = Utils::Utils::GetIntegerMapEntry(arguments, "function", 0);
-		const DataModel::LocoFunctionState state = static_cast<DataModel::LocoFunctionState>(Utils::Utils::GetBoolMapEntry(arguments, "on"));
+		const LocoID locoID = arguments.GetInteger("loco", LocoNone);
+		const DataModel::LocoFunctionNr function = arguments.GetInteger("function", 0);
+		const DataModel::LocoFunctionState state = static_cast<DataModel::LocoFunctionState>(arguments.GetBool("on"));
 
 		const ObjectIdentifier locoBaseIdentifier(WebClientStatic::LocoIdToObjectIdentifier(locoID));
 
@@ -1193,44 +830,44 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeaderAndParagraph(state ? Languages::TextLocoFunctionIsOn : Languages::TextLocoFunctionIsOff, manager.GetLocoBaseName(locoBaseIdentifier), function);
 	}
 
-	void WebClient::HandleLocoRelease(const map<string, string>& arguments)
+	void WebClient::HandleLocoRelease(const HttpRequest::Arguments& arguments)
 	{
 		bool ret = false;
-		const LocoID locoID = Utils::Utils::GetIntegerMapEntry(arguments, "loco", LocoNone);
+		const LocoID locoID = arguments.GetInteger("loco", LocoNone);
 		if (locoID != LocoNone)
 		{
 			ret = manager.LocoRelease(locoID);
 		}
 		else
 		{
-			TrackID trackID = static_cast<TrackID>(Utils::Utils::GetIntegerMapEntry(arguments, "track", TrackNone));
+			TrackID trackID = static_cast<TrackID>(arguments.GetInteger("track", TrackNone));
 			ret = manager.LocoBaseReleaseOnTrack(trackID);
 		}
 		ReplyHtmlWithHeaderAndParagraph(ret ? "Loco released" : "Loco not released");
 	}
 
-	void WebClient::HandleMultipleUnitRelease(const map<string, string>& arguments)
+	void WebClient::HandleMultipleUnitRelease(const HttpRequest::Arguments& arguments)
 	{
 		bool ret = false;
-		MultipleUnitID multipleUnitID = Utils::Utils::GetIntegerMapEntry(arguments, "multipleunit", MultipleUnitNone);
+		MultipleUnitID multipleUnitID = arguments.GetInteger("multipleunit", MultipleUnitNone);
 		if (multipleUnitID != LocoNone)
 		{
 			ret = manager.MultipleUnitRelease(multipleUnitID);
 		}
 		else
 		{
-			TrackID trackID = static_cast<TrackID>(Utils::Utils::GetIntegerMapEntry(arguments, "track", TrackNone));
+			TrackID trackID = static_cast<TrackID>(arguments.GetInteger("track", TrackNone));
 			ret = manager.LocoBaseReleaseOnTrack(trackID);
 		}
 		ReplyHtmlWithHeaderAndParagraph(ret ? "Loco released" : "Loco not released");
 	}
 
-	void WebClient::HandleLocoAddTimeTable(const map<string, string>& arguments)
+	void WebClient::HandleLocoAddTimeTable(const HttpRequest::Arguments& arguments)
 	{
-		const TrackID trackID = Utils::Utils::GetIntegerMapEntry(arguments, "track", TrackNone);
+		const TrackID trackID = arguments.GetInteger("track", TrackNone);
 		const ObjectIdentifier locoBaseIdentifier = manager.GetLocoBaseIdentifierOfTrack(trackID);
-		const RouteID routeID = static_cast<RouteID>(Utils::Utils::GetIntegerMapEntry(arguments, "route"));
-		const bool automode = Utils::Utils::GetStringMapEntry(arguments, "followup", "manual").compare("automode") == 0;
+		const RouteID routeID = static_cast<RouteID>(arguments.GetInteger("route"));
+		const bool automode = arguments.GetString("followup", "manual").compare("automode") == 0;
 		bool ret = manager.LocoBaseAddTimeTable(locoBaseIdentifier, routeID, automode);
 		manager.TrackStartLocoBase(trackID);
 		ReplyHtmlWithHeaderAndParagraph(ret ? "Route added" : "Route not added");
@@ -1294,16 +931,16 @@ namespace Server { namespace Web
 		return WebClientStatic::HtmlTagProtocol(protocolMap, selectedProtocol);
 	}
 
-	void WebClient::HandleProtocol(const map<string, string>& arguments)
+	void WebClient::HandleProtocol(const HttpRequest::Arguments& arguments)
 	{
-		const ControlID controlID = Utils::Utils::GetIntegerMapEntry(arguments, "control", ControlIdNone);
+		const ControlID controlID = arguments.GetInteger("control", ControlIdNone);
 		if (controlID == ControlIdNone)
 		{
 			ReplyHtmlWithHeaderAndParagraph(Languages::TextControlDoesNotExist);
 			return;
 		}
 
-		const LocoID locoID = Utils::Utils::GetIntegerMapEntry(arguments, "loco", LocoNone);
+		const LocoID locoID = arguments.GetInteger("loco", LocoNone);
 		if (locoID != LocoNone)
 		{
 			const LocoConfig loco = manager.GetLoco(locoID);
@@ -1311,7 +948,7 @@ namespace Server { namespace Web
 			return;
 		}
 
-		const AccessoryID accessoryID = Utils::Utils::GetIntegerMapEntry(arguments, "accessory", AccessoryNone);
+		const AccessoryID accessoryID = arguments.GetInteger("accessory", AccessoryNone);
 		if (accessoryID != AccessoryNone)
 		{
 			const Accessory* accessory = manager.GetAccessory(accessoryID);
@@ -1319,7 +956,7 @@ namespace Server { namespace Web
 			return;
 		}
 
-		const SwitchID switchID = Utils::Utils::GetIntegerMapEntry(arguments, "switch", SwitchNone);
+		const SwitchID switchID = arguments.GetInteger("switch", SwitchNone);
 		if (switchID != SwitchNone)
 		{
 			const Switch* mySwitch = manager.GetSwitch(switchID);
@@ -1327,7 +964,7 @@ namespace Server { namespace Web
 			return;
 		}
 
-		const SignalID signalID = Utils::Utils::GetIntegerMapEntry(arguments, "signal", SignalNone);
+		const SignalID signalID = arguments.GetInteger("signal", SignalNone);
 		if (signalID != SignalNone)
 		{
 			const Signal* signal = manager.GetSignal(signalID);
@@ -1338,19 +975,19 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(HtmlTagProtocolAccessory(controlID, ProtocolNone));
 	}
 
-	void WebClient::HandleAccessoryAddress(const map<string, string>& arguments)
+	void WebClient::HandleAccessoryAddress(const HttpRequest::Arguments& arguments)
 	{
-		const AccessoryType type = static_cast<AccessoryType>(Utils::Utils::GetIntegerMapEntry(arguments, "type", AccessoryTypeDefault));
-		const Address address = static_cast<Address>(Utils::Utils::GetIntegerMapEntry(arguments, "address", AddressDefault));
-		const AddressPort port = static_cast<AddressPort>(Utils::Utils::GetIntegerMapEntry(arguments, "port", AddressPortRed));
+		const AccessoryType type = static_cast<AccessoryType>(arguments.GetInteger("type", AccessoryTypeDefault));
+		const Address address = static_cast<Address>(arguments.GetInteger("address", AddressDefault));
+		const AddressPort port = static_cast<AddressPort>(arguments.GetInteger("port", AddressPortRed));
 		ReplyHtmlWithHeader(WebClientStatic::HtmlTagAccessoryAddress(type, address, port));
 	}
 
-	void WebClient::HandleFeedbackDeviceBus(const map<string, string>& arguments)
+	void WebClient::HandleFeedbackDeviceBus(const HttpRequest::Arguments& arguments)
 	{
-		const ControlID controlID = static_cast<ControlID>(Utils::Utils::GetIntegerMapEntry(arguments, "control"));
-		const FeedbackDevice device = static_cast<FeedbackDevice>(Utils::Utils::GetIntegerMapEntry(arguments, "device", FeedbackDeviceNone));
-		const FeedbackBus bus = static_cast<FeedbackBus>(Utils::Utils::GetIntegerMapEntry(arguments, "bus", FeedbackBusNone));
+		const ControlID controlID = static_cast<ControlID>(arguments.GetInteger("control"));
+		const FeedbackDevice device = static_cast<FeedbackDevice>(arguments.GetInteger("device", FeedbackDeviceNone));
+		const FeedbackBus bus = static_cast<FeedbackBus>(arguments.GetInteger("bus", FeedbackBusNone));
 		ReplyHtmlWithHeader(HtmlTagFeedbackDeviceBus(controlID, device, bus));
 	}
 
@@ -1449,11 +1086,11 @@ namespace Server { namespace Web
 		return content;
 	}
 
-	void WebClient::HandleSlaveAdd(const map<string, string>& arguments)
+	void WebClient::HandleSlaveAdd(const HttpRequest::Arguments& arguments)
 	{
-		string priorityString = Utils::Utils::GetStringMapEntry(arguments, "priority", "1");
+		string priorityString = arguments.GetString("priority", "1");
 		Priority priority = Utils::Integer::StringToInteger(priorityString, 1);
-		string prefix = Utils::Utils::GetStringMapEntry(arguments, "prefix");
+		string prefix = arguments.GetString("prefix");
 		HtmlTag container;
 		std::map<std::string,ObjectID> options;
 		if (prefix.compare("track") == 0)
@@ -1477,10 +1114,10 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(container);
 	}
 
-	void WebClient::HandleFeedbackAdd(const map<string, string>& arguments)
+	void WebClient::HandleFeedbackAdd(const HttpRequest::Arguments& arguments)
 	{
-		const unsigned int counter = Utils::Utils::GetIntegerMapEntry(arguments, "counter", 1);
-		const TrackID trackID = Utils::Utils::GetIntegerMapEntry(arguments, "track", TrackNone);
+		const unsigned int counter = arguments.GetInteger("counter", 1);
+		const TrackID trackID = arguments.GetInteger("track", TrackNone);
 		ReplyHtmlWithHeader(HtmlTagSelectFeedbackForTrack(counter, trackID));
 	}
 
@@ -1496,16 +1133,16 @@ namespace Server { namespace Web
 		return options;
 	}
 
-	void WebClient::HandleLocoEdit(const map<string, string>& arguments)
+	void WebClient::HandleLocoEdit(const HttpRequest::Arguments& arguments)
 	{
 		HtmlTag content;
-		const LocoID locoID = Utils::Utils::GetIntegerMapEntry(arguments, "loco", LocoNone);
-		ControlID controlID = Utils::Utils::GetIntegerMapEntry(arguments, "control", ControlNone);
+		const LocoID locoID = arguments.GetInteger("loco", LocoNone);
+		ControlID controlID = arguments.GetInteger("control", ControlNone);
 		if (controlID == ControlNone)
 		{
 			controlID = manager.GetPossibleControlForLoco();
 		}
-		string matchKey = Utils::Utils::GetStringMapEntry(arguments, "matchkey");
+		string matchKey = arguments.GetString("matchkey");
 		Protocol protocol = ProtocolNone;
 		Address address = AddressDefault;
 		Address serverAddress = AddressNone;
@@ -1597,12 +1234,12 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleMultipleUnitEdit(const map<string, string>& arguments)
+	void WebClient::HandleMultipleUnitEdit(const HttpRequest::Arguments& arguments)
 	{
 		HtmlTag content;
-		const MultipleUnitID multipleUnitID = Utils::Utils::GetIntegerMapEntry(arguments, "multipleunit", MultipleUnitNone);
-		ControlID controlID = Utils::Utils::GetIntegerMapEntry(arguments, "control", ControlNone);
-		string matchKey = Utils::Utils::GetStringMapEntry(arguments, "matchkey");
+		const MultipleUnitID multipleUnitID = arguments.GetInteger("multipleunit", MultipleUnitNone);
+		ControlID controlID = arguments.GetInteger("control", ControlNone);
+		string matchKey = arguments.GetString("matchkey");
 		string name = Languages::GetText(Languages::TextNew);
 		bool pushpull = false;
 		Address serverAddress = AddressNone;
@@ -1689,35 +1326,35 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleLocoSave(const map<string, string>& arguments)
+	void WebClient::HandleLocoSave(const HttpRequest::Arguments& arguments)
 	{
-		const LocoID locoId = Utils::Utils::GetIntegerMapEntry(arguments, "loco", LocoNone);
-		const string name = Utils::Utils::GetStringMapEntry(arguments, "name", Languages::GetText(Languages::TextLoco));
-		const ControlID controlId = Utils::Utils::GetIntegerMapEntry(arguments, "control", ControlIdNone);
-		const string matchKey = Utils::Utils::GetStringMapEntry(arguments, "matchkey");
-		const Protocol protocol = static_cast<Protocol>(Utils::Utils::GetIntegerMapEntry(arguments, "protocol", ProtocolNone));
-		const Address address = Utils::Utils::GetIntegerMapEntry(arguments, "address", AddressDefault);
-		const Address serverAddress = Utils::Utils::GetIntegerMapEntry(arguments, "serveraddress", AddressNone);
-		const Length length = Utils::Utils::GetIntegerMapEntry(arguments, "length", 0);
-		const bool pushpull = Utils::Utils::GetBoolMapEntry(arguments, "pushpull", false);
-		const Speed maxSpeed = Utils::Utils::GetIntegerMapEntry(arguments, "maxspeed", MaxSpeed);
-		Speed travelSpeed = Utils::Utils::GetIntegerMapEntry(arguments, "travelspeed", DefaultTravelSpeed);
+		const LocoID locoId = arguments.GetInteger("loco", LocoNone);
+		const string name = arguments.GetString("name", Languages::GetText(Languages::TextLoco));
+		const ControlID controlId = arguments.GetInteger("control", ControlIdNone);
+		const string matchKey = arguments.GetString("matchkey");
+		const Protocol protocol = static_cast<Protocol>(arguments.GetInteger("protocol", ProtocolNone));
+		const Address address = arguments.GetInteger("address", AddressDefault);
+		const Address serverAddress = arguments.GetInteger("serveraddress", AddressNone);
+		const Length length = arguments.GetInteger("length", 0);
+		const bool pushpull = arguments.GetBool("pushpull", false);
+		const Speed maxSpeed = arguments.GetInteger("maxspeed", MaxSpeed);
+		Speed travelSpeed = arguments.GetInteger("travelspeed", DefaultTravelSpeed);
 		if (travelSpeed > maxSpeed)
 		{
 			travelSpeed = maxSpeed;
 		}
-		Speed reducedSpeed = Utils::Utils::GetIntegerMapEntry(arguments, "reducedspeed", DefaultReducedSpeed);
+		Speed reducedSpeed = arguments.GetInteger("reducedspeed", DefaultReducedSpeed);
 		if (reducedSpeed > travelSpeed)
 		{
 			reducedSpeed = travelSpeed;
 		}
-		Speed creepingSpeed = Utils::Utils::GetIntegerMapEntry(arguments, "creepingspeed", DefaultCreepingSpeed);
+		Speed creepingSpeed = arguments.GetInteger("creepingspeed", DefaultCreepingSpeed);
 		if (creepingSpeed > reducedSpeed)
 		{
 			creepingSpeed = reducedSpeed;
 		}
-		const Propulsion propulsion = static_cast<Propulsion>(Utils::Utils::GetIntegerMapEntry(arguments, "propulsion", PropulsionOther));
-		const TrainType type = static_cast<TrainType>(Utils::Utils::GetIntegerMapEntry(arguments, "type", TrainTypeOther));
+		const Propulsion propulsion = static_cast<Propulsion>(arguments.GetInteger("propulsion", PropulsionOther));
+		const TrainType type = static_cast<TrainType>(arguments.GetInteger("type", TrainTypeOther));
 
 		vector<DataModel::LocoFunctionEntry> locoFunctions;
 		DataModel::LocoFunctionEntry locoFunctionEntry;
@@ -1725,15 +1362,15 @@ namespace Server { namespace Web
 		{
 			string nrString = "f" + to_string(nr) + "_";
 			locoFunctionEntry.nr = nr;
-			locoFunctionEntry.type = static_cast<DataModel::LocoFunctionType>(Utils::Utils::GetIntegerMapEntry(arguments, nrString + "type", DataModel::LocoFunctionTypeNone));
+			locoFunctionEntry.type = static_cast<DataModel::LocoFunctionType>(arguments.GetInteger(nrString + "type", DataModel::LocoFunctionTypeNone));
 			if (locoFunctionEntry.type == DataModel::LocoFunctionTypeNone)
 			{
 				continue;
 			}
-			locoFunctionEntry.icon = static_cast<DataModel::LocoFunctionIcon>(Utils::Utils::GetIntegerMapEntry(arguments, nrString + "icon", DataModel::LocoFunctionIconNone));
+			locoFunctionEntry.icon = static_cast<DataModel::LocoFunctionIcon>(arguments.GetInteger(nrString + "icon", DataModel::LocoFunctionIconNone));
 			if (locoFunctionEntry.type == DataModel::LocoFunctionTypeTimer)
 			{
-				locoFunctionEntry.timer = Utils::Utils::GetIntegerMapEntry(arguments, nrString + "timer", 1);
+				locoFunctionEntry.timer = arguments.GetInteger(nrString + "timer", 1);
 				if (locoFunctionEntry.timer == 0)
 				{
 					locoFunctionEntry.timer = 1;
@@ -1773,33 +1410,33 @@ namespace Server { namespace Web
 		ReplyResponse(ResponseInfo, Languages::TextLocoSaved, name);
 	}
 
-	void WebClient::HandleMultipleUnitSave(__attribute__((unused)) const map<string, string>& arguments)
+	void WebClient::HandleMultipleUnitSave(__attribute__((unused)) const HttpRequest::Arguments& arguments)
 	{
-		const MultipleUnitID multipleUnitId = Utils::Utils::GetIntegerMapEntry(arguments, "multipleunit", MultipleUnitNone);
-		const string name = Utils::Utils::GetStringMapEntry(arguments, "name");
-		const ControlID controlId = Utils::Utils::GetIntegerMapEntry(arguments, "control", ControlIdNone);
-		const string matchKey = Utils::Utils::GetStringMapEntry(arguments, "matchkey");
-		const Address address = Utils::Utils::GetIntegerMapEntry(arguments, "address", AddressDefault);
-		const Address serverAddress = Utils::Utils::GetIntegerMapEntry(arguments, "serveraddress", AddressNone);
-		const Length length = Utils::Utils::GetIntegerMapEntry(arguments, "length", 0);
-		const bool pushpull = Utils::Utils::GetBoolMapEntry(arguments, "pushpull", false);
-		const Speed maxSpeed = Utils::Utils::GetIntegerMapEntry(arguments, "maxspeed", MaxSpeed);
-		Speed travelSpeed = Utils::Utils::GetIntegerMapEntry(arguments, "travelspeed", DefaultTravelSpeed);
+		const MultipleUnitID multipleUnitId = arguments.GetInteger("multipleunit", MultipleUnitNone);
+		const string name = arguments.GetString("name");
+		const ControlID controlId = arguments.GetInteger("control", ControlIdNone);
+		const string matchKey = arguments.GetString("matchkey");
+		const Address address = arguments.GetInteger("address", AddressDefault);
+		const Address serverAddress = arguments.GetInteger("serveraddress", AddressNone);
+		const Length length = arguments.GetInteger("length", 0);
+		const bool pushpull = arguments.GetBool("pushpull", false);
+		const Speed maxSpeed = arguments.GetInteger("maxspeed", MaxSpeed);
+		Speed travelSpeed = arguments.GetInteger("travelspeed", DefaultTravelSpeed);
 		if (travelSpeed > maxSpeed)
 		{
 			travelSpeed = maxSpeed;
 		}
-		Speed reducedSpeed = Utils::Utils::GetIntegerMapEntry(arguments, "reducedspeed", DefaultReducedSpeed);
+		Speed reducedSpeed = arguments.GetInteger("reducedspeed", DefaultReducedSpeed);
 		if (reducedSpeed > travelSpeed)
 		{
 			reducedSpeed = travelSpeed;
 		}
-		Speed creepingSpeed = Utils::Utils::GetIntegerMapEntry(arguments, "creepingspeed", DefaultCreepingSpeed);
+		Speed creepingSpeed = arguments.GetInteger("creepingspeed", DefaultCreepingSpeed);
 		if (creepingSpeed > reducedSpeed)
 		{
 			creepingSpeed = reducedSpeed;
 		}
-		const TrainType type = static_cast<TrainType>(Utils::Utils::GetIntegerMapEntry(arguments, "type", TrainTypeOther));
+		const TrainType type = static_cast<TrainType>(arguments.GetInteger("type", TrainTypeOther));
 
 		vector<DataModel::LocoFunctionEntry> locoFunctions;
 		DataModel::LocoFunctionEntry locoFunctionEntry;
@@ -1807,15 +1444,15 @@ namespace Server { namespace Web
 		{
 			string nrString = "f" + to_string(nr) + "_";
 			locoFunctionEntry.nr = nr;
-			locoFunctionEntry.type = static_cast<DataModel::LocoFunctionType>(Utils::Utils::GetIntegerMapEntry(arguments, nrString + "type", DataModel::LocoFunctionTypeNone));
+			locoFunctionEntry.type = static_cast<DataModel::LocoFunctionType>(arguments.GetInteger(nrString + "type", DataModel::LocoFunctionTypeNone));
 			if (locoFunctionEntry.type == DataModel::LocoFunctionTypeNone)
 			{
 				continue;
 			}
-			locoFunctionEntry.icon = static_cast<DataModel::LocoFunctionIcon>(Utils::Utils::GetIntegerMapEntry(arguments, nrString + "icon", DataModel::LocoFunctionIconNone));
+			locoFunctionEntry.icon = static_cast<DataModel::LocoFunctionIcon>(arguments.GetInteger(nrString + "icon", DataModel::LocoFunctionIconNone));
 			if (locoFunctionEntry.type == DataModel::LocoFunctionTypeTimer)
 			{
-				locoFunctionEntry.timer = Utils::Utils::GetIntegerMapEntry(arguments, nrString + "timer", 1);
+				locoFunctionEntry.timer = arguments.GetInteger(nrString + "timer", 1);
 				if (locoFunctionEntry.timer == 0)
 				{
 					locoFunctionEntry.timer = 1;
@@ -1947,9 +1584,9 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleLocoAskDelete(const map<string, string>& arguments)
+	void WebClient::HandleLocoAskDelete(const HttpRequest::Arguments& arguments)
 	{
-		LocoID locoID = Utils::Utils::GetIntegerMapEntry(arguments, "loco", LocoNone);
+		LocoID locoID = arguments.GetInteger("loco", LocoNone);
 
 		if (locoID == LocoNone)
 		{
@@ -1977,9 +1614,9 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleMultipleUnitAskDelete(const map<string, string>& arguments)
+	void WebClient::HandleMultipleUnitAskDelete(const HttpRequest::Arguments& arguments)
 	{
-		MultipleUnitID multipleUnitID = Utils::Utils::GetIntegerMapEntry(arguments, "multipleunit", MultipleUnitNone);
+		MultipleUnitID multipleUnitID = arguments.GetInteger("multipleunit", MultipleUnitNone);
 
 		if (multipleUnitID == MultipleUnitNone)
 		{
@@ -2007,9 +1644,9 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleLocoDelete(const map<string, string>& arguments)
+	void WebClient::HandleLocoDelete(const HttpRequest::Arguments& arguments)
 	{
-		LocoID locoID = Utils::Utils::GetIntegerMapEntry(arguments, "loco", LocoNone);
+		LocoID locoID = arguments.GetInteger("loco", LocoNone);
 		const LocoConfig loco = manager.GetLoco(locoID);
 		if (loco.GetLocoID() != locoID)
 		{
@@ -2028,9 +1665,9 @@ namespace Server { namespace Web
 		ReplyResponse(ResponseInfo, Languages::TextLocoDeleted, name);
 	}
 
-	void WebClient::HandleMultipleUnitDelete(const map<string, string>& arguments)
+	void WebClient::HandleMultipleUnitDelete(const HttpRequest::Arguments& arguments)
 	{
-		MultipleUnitID multipleUnitID = Utils::Utils::GetIntegerMapEntry(arguments, "multipleunit", MultipleUnitNone);
+		MultipleUnitID multipleUnitID = arguments.GetInteger("multipleunit", MultipleUnitNone);
 		const LocoConfig multipleUnit = manager.GetMultipleUnit(multipleUnitID);
 		if (multipleUnit.GetLocoID() != multipleUnitID)
 		{
@@ -2055,13 +1692,13 @@ namespace Server { namespace Web
 		return HtmlTagSelect("layer", options, layerID).AddAttribute("onchange", "loadLayout();");
 	}
 
-	void WebClient::HandleLayout(const map<string, string>& arguments)
+	void WebClient::HandleLayout(const HttpRequest::Arguments& arguments)
 	{
-		const LayerID layer = static_cast<LayerID>(Utils::Utils::GetIntegerMapEntry(arguments, "layer", INT_MIN));
-		HtmlTag content;
+		const LayerID layer = static_cast<LayerID>(arguments.GetInteger("layer", INT_MIN));
 
 		if (layer < LayerUndeletable)
 		{
+			HtmlTag content;
 			const map<FeedbackID,Feedback*>& feedbacks = manager.FeedbackList();
 			for (auto& f : feedbacks)
 			{
@@ -2076,6 +1713,17 @@ namespace Server { namespace Web
 			return;
 		}
 
+		LayoutCache& layoutCache = server.GetLayoutCache();
+		// taken before rendering, a change while rendering leads to a new ETag on the next request
+		const string etag = layoutCache.GetETag(layer);
+		if (request.GetHeader("If-None-Match").Equals(etag.c_str()))
+		{
+			ReplyNotModified(etag);
+			return;
+		}
+
+		string content;
+
 		const map<TextID,DataModel::Text*>& texts = manager.TextList();
 		for (auto& text : texts)
 		{
@@ -2083,7 +1731,8 @@ namespace Server { namespace Web
 			{
 				continue;
 			}
-			content.AddChildTag(HtmlTagText(text.second));
+			const DataModel::Text* item = text.second;
+			layoutCache.AppendTo(content, ObjectTypeText, text.first, [item]() -> HtmlTag { return HtmlTagText(item); });
 		}
 
 		const map<SwitchID,DataModel::Track*>& tracks = manager.TrackList();
@@ -2093,7 +1742,8 @@ namespace Server { namespace Web
 			{
 				continue;
 			}
-			content.AddChildTag(HtmlTagTrack(manager, track.second));
+			const DataModel::Track* item = track.second;
+			layoutCache.AppendTo(content, ObjectTypeTrack, track.first, [this, item]() -> HtmlTag { return HtmlTagTrack(manager, item); });
 		}
 
 		const map<SignalID,DataModel::Signal*>& signals = manager.SignalList();
@@ -2103,7 +1753,8 @@ namespace Server { namespace Web
 			{
 				continue;
 			}
-			content.AddChildTag(HtmlTagSignal(manager, signal.second));
+			const DataModel::Signal* item = signal.second;
+			layoutCache.AppendTo(content, ObjectTypeSignal, signal.first, [this, item]() -> HtmlTag { return HtmlTagSignal(manager, item); });
 		}
 
 		const map<AccessoryID,DataModel::Accessory*>& accessories = manager.AccessoryList();
@@ -2113,7 +1764,8 @@ namespace Server { namespace Web
 			{
 				continue;
 			}
-			content.AddChildTag(HtmlTagAccessory(accessory.second));
+			const DataModel::Accessory* item = accessory.second;
+			layoutCache.AppendTo(content, ObjectTypeAccessory, accessory.first, [item]() -> HtmlTag { return HtmlTagAccessory(item); });
 		}
 
 		const map<SwitchID,DataModel::Switch*>& switches = manager.SwitchList();
@@ -2123,7 +1775,8 @@ namespace Server { namespace Web
 			{
 				continue;
 			}
-			content.AddChildTag(HtmlTagSwitch(mySwitch.second));
+			const DataModel::Switch* item = mySwitch.second;
+			layoutCache.AppendTo(content, ObjectTypeSwitch, mySwitch.first, [item]() -> HtmlTag { return HtmlTagSwitch(item); });
 		}
 
 		const map<FeedbackID,Feedback*>& feedbacks = manager.FeedbackList();
@@ -2133,7 +1786,8 @@ namespace Server { namespace Web
 			{
 				continue;
 			}
-			content.AddChildTag(HtmlTagFeedback(feedback.second));
+			const Feedback* item = feedback.second;
+			layoutCache.AppendTo(content, ObjectTypeFeedback, feedback.first, [item]() -> HtmlTag { return HtmlTagFeedback(item); });
 		}
 
 		const map<RouteID,DataModel::Route*>& routes = manager.RouteList();
@@ -2143,7 +1797,8 @@ namespace Server { namespace Web
 			{
 				continue;
 			}
-			content.AddChildTag(HtmlTagRoute(route.second));
+			const DataModel::Route* item = route.second;
+			layoutCache.AppendTo(content, ObjectTypeRoute, route.first, [item]() -> HtmlTag { return HtmlTagRoute(item); });
 		}
 
 		const map<CounterID,DataModel::Counter*>& counters = manager.CounterList();
@@ -2153,10 +1808,11 @@ namespace Server { namespace Web
 			{
 				continue;
 			}
-			content.AddChildTag(HtmlTagCounter(counter.second));
+			const DataModel::Counter* item = counter.second;
+			layoutCache.AppendTo(content, ObjectTypeCounter, counter.first, [item]() -> HtmlTag { return HtmlTagCounter(item); });
 		}
 
-		ReplyHtmlWithHeader(content);
+		ReplyHtmlWithHeader(HtmlTag().AddContent(content), etag);
 	}
 
 	HtmlTag WebClient::HtmlTagControlLoco(ControlID& controlId,
@@ -2188,27 +1844,27 @@ namespace Server { namespace Web
 		return WebClientStatic::HtmlTagControlFeedback(controls, controlId);
 	}
 
-	void WebClient::HandleAccessoryEdit(const map<string, string>& arguments)
+	void WebClient::HandleAccessoryEdit(const HttpRequest::Arguments& arguments)
 	{
 		HtmlTag content;
-		AccessoryID accessoryID = Utils::Utils::GetIntegerMapEntry(arguments, "accessory", AccessoryNone);
+		AccessoryID accessoryID = arguments.GetInteger("accessory", AccessoryNone);
 		string name = Languages::GetText(Languages::TextNew);
-		ControlID controlId = Utils::Utils::GetIntegerMapEntry(arguments, "control", ControlNone);
+		ControlID controlId = arguments.GetInteger("control", ControlNone);
 		if (controlId == ControlNone)
 		{
 			controlId = manager.GetPossibleControlForAccessory();
 		}
-		string matchKey = Utils::Utils::GetStringMapEntry(arguments, "matchkey");
+		string matchKey = arguments.GetString("matchkey");
 		Protocol protocol = ProtocolNone;
 		Address address = AddressDefault;
 		AddressPort port = AddressPortRed;
 		Address serverAddress = AddressNone;
-		DataModel::AccessoryType accessoryType = static_cast<DataModel::AccessoryType>(Utils::Utils::GetIntegerMapEntry(arguments, "accessorytype", AccessoryTypeDefault));
+		DataModel::AccessoryType accessoryType = static_cast<DataModel::AccessoryType>(arguments.GetInteger("accessorytype", AccessoryTypeDefault));
 		DataModel::AccessoryType connectionType;
-		LayoutPosition posx = Utils::Utils::GetIntegerMapEntry(arguments, "posx", 0);
-		LayoutPosition posy = Utils::Utils::GetIntegerMapEntry(arguments, "posy", 0);
-		LayoutPosition posz = Utils::Utils::GetIntegerMapEntry(arguments, "posz", LayerUndeletable);
-		LayoutRotation rotation = Utils::Utils::GetIntegerMapEntry(arguments, "rotation", DataModel::LayoutItem::Rotation90);
+		LayoutPosition posx = arguments.GetInteger("posx", 0);
+		LayoutPosition posy = arguments.GetInteger("posy", 0);
+		LayoutPosition posz = arguments.GetInteger("posz", LayerUndeletable);
+		LayoutRotation rotation = arguments.GetInteger("rotation", DataModel::LayoutItem::Rotation90);
 		DataModel::AccessoryPulseDuration duration = manager.GetDefaultAccessoryDuration();
 		bool inverted = false;
 		if (accessoryID > AccessoryNone)
@@ -2297,9 +1953,9 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleAccessoryGet(const map<string, string>& arguments)
+	void WebClient::HandleAccessoryGet(const HttpRequest::Arguments& arguments)
 	{
-		AccessoryID accessoryID = Utils::Utils::GetIntegerMapEntry(arguments, "accessory");
+		AccessoryID accessoryID = arguments.GetInteger("accessory");
 		const DataModel::Accessory* accessory = manager.GetAccessory(accessoryID);
 		if (accessory == nullptr)
 		{
@@ -2309,24 +1965,24 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(HtmlTagAccessory(accessory));
 	}
 
-	void WebClient::HandleAccessorySave(const map<string, string>& arguments)
-	{
-		const AccessoryID accessoryID = Utils::Utils::GetIntegerMapEntry(arguments, "accessory", AccessoryNone);
-		const string name = Utils::Utils::GetStringMapEntry(arguments, "name");
-		const ControlID controlId = Utils::Utils::GetIntegerMapEntry(arguments, "control", ControlIdNone);
-		const string matchKey = Utils::Utils::GetStringMapEntry(arguments, "matchkey");
-		const Protocol protocol = static_cast<Protocol>(Utils::Utils::GetIntegerMapEntry(arguments, "protocol", ProtocolNone));
-		const Address address = Utils::Utils::GetIntegerMapEntry(arguments, "address", AddressDefault);
-		const AddressPort port = static_cast<AddressPort>(Utils::Utils::GetIntegerMapEntry(arguments, "port", AddressPortRed));
-		const Address serverAddress = Utils::Utils::GetIntegerMapEntry(arguments, "serveraddress", AddressNone);
-		const DataModel::AccessoryType connectionType = static_cast<DataModel::AccessoryType>(Utils::Utils::GetIntegerMapEntry(arguments, "connectiontype", AccessoryTypeOnOn));
-		const DataModel::AccessoryType accessoryType = static_cast<DataModel::AccessoryType>(Utils::Utils::GetIntegerMapEntry(arguments, "accessorytype", AccessoryTypeDefault) + connectionType);
-		const LayoutPosition posX = Utils::Utils::GetIntegerMapEntry(arguments, "posx", 0);
-		const LayoutPosition posY = Utils::Utils::GetIntegerMapEntry(arguments, "posy", 0);
-		const LayoutPosition posZ = Utils::Utils::GetIntegerMapEntry(arguments, "posz", 0);
-		const LayoutRotation rotation = Utils::Utils::GetIntegerMapEntry(arguments, "rotation", DataModel::LayoutItem::Rotation90);
-		const DataModel::AccessoryPulseDuration duration = Utils::Utils::GetIntegerMapEntry(arguments, "duration", manager.GetDefaultAccessoryDuration());
-		const bool inverted = Utils::Utils::GetBoolMapEntry(arguments, "inverted");
+	void WebClient::HandleAccessorySave(const HttpRequest::Arguments& arguments)
+	{
+		const AccessoryID accessoryID = arguments.GetInteger("accessory", AccessoryNone);
+		const string name = arguments.GetString("name");
+		const ControlID controlId = arguments.GetInteger("control", ControlIdNone);
+		const string matchKey = arguments.GetString("matchkey");
+		const Protocol protocol = static_cast<Protocol>(arguments.GetInteger("protocol", ProtocolNone));
+		const Address address = arguments.GetInteger("address", AddressDefault);
+		const AddressPort port = static_cast<AddressPort>(arguments.GetInteger("port", AddressPortRed));
+		const Address serverAddress = arguments.GetInteger("serveraddress", AddressNone);
+		const DataModel::AccessoryType connectionType = static_cast<DataModel::AccessoryType>(arguments.GetInteger("connectiontype", AccessoryTypeOnOn));
+		const DataModel::AccessoryType accessoryType = static_cast<DataModel::AccessoryType>(arguments.GetInteger("accessorytype", AccessoryTypeDefault) + connectionType);
+		const LayoutPosition posX = arguments.GetInteger("posx", 0);
+		const LayoutPosition posY = arguments.GetInteger("posy", 0);
+		const LayoutPosition posZ = arguments.GetInteger("posz", 0);
+		const LayoutRotation rotation = arguments.GetInteger("rotation", DataModel::LayoutItem::Rotation90);
+		const DataModel::AccessoryPulseDuration duration = arguments.GetInteger("duration", manager.GetDefaultAccessoryDuration());
+		const bool inverted = arguments.GetBool("inverted");
 		string result;
 		if (!manager.AccessorySave(accessoryID,
 			name,
@@ -2352,10 +2008,10 @@ namespace Server { namespace Web
 		ReplyResponse(ResponseInfo, Languages::TextAccessorySaved, name);
 	}
 
-	void WebClient::HandleAccessoryState(const map<string, string>& arguments)
+	void WebClient::HandleAccessoryState(const HttpRequest::Arguments& arguments)
 	{
-		const AccessoryID accessoryID = Utils::Utils::GetIntegerMapEntry(arguments, "accessory", AccessoryNone);
-		const DataModel::AccessoryState accessoryState = (Utils::Utils::GetStringMapEntry(arguments, "state", "off").compare("off") == 0 ? DataModel::AccessoryStateOff : DataModel::AccessoryStateOn);
+		const AccessoryID accessoryID = arguments.GetInteger("accessory", AccessoryNone);
+		const DataModel::AccessoryState accessoryState = (arguments.GetString("state", "off").compare("off") == 0 ? DataModel::AccessoryStateOff : DataModel::AccessoryStateOn);
 
 		manager.AccessoryState(ControlTypeWebServer, accessoryID, accessoryState, false);
 
@@ -2402,9 +2058,9 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleAccessoryAskDelete(const map<string, string>& arguments)
+	void WebClient::HandleAccessoryAskDelete(const HttpRequest::Arguments& arguments)
 	{
-		AccessoryID accessoryID = Utils::Utils::GetIntegerMapEntry(arguments, "accessory", AccessoryNone);
+		AccessoryID accessoryID = arguments.GetInteger("accessory", AccessoryNone);
 
 		if (accessoryID == AccessoryNone)
 		{
@@ -2432,9 +2088,9 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleAccessoryDelete(const map<string, string>& arguments)
+	void WebClient::HandleAccessoryDelete(const HttpRequest::Arguments& arguments)
 	{
-		AccessoryID accessoryID = Utils::Utils::GetIntegerMapEntry(arguments, "accessory", AccessoryNone);
+		AccessoryID accessoryID = arguments.GetInteger("accessory", AccessoryNone);
 		const DataModel::Accessory* accessory = manager.GetAccessory(accessoryID);
 		if (accessory == nullptr)
 		{
@@ -2453,31 +2109,31 @@ namespace Server { namespace Web
 		ReplyResponse(ResponseInfo, Languages::TextAccessoryDeleted, name);
 	}
 
-	void WebClient::HandleAccessoryRelease(const map<string, string>& arguments)
+	void WebClient::HandleAccessoryRelease(const HttpRequest::Arguments& arguments)
 	{
-		AccessoryID accessoryID = Utils::Utils::GetIntegerMapEntry(arguments, "accessory");
+		AccessoryID accessoryID = arguments.GetInteger("accessory");
 		bool ret = manager.AccessoryRelease(accessoryID);
 		ReplyHtmlWithHeaderAndParagraph(ret ? "Accessory released" : "Accessory not released");
 	}
 
-	void WebClient::HandleSwitchEdit(const map<string, string>& arguments)
+	void WebClient::HandleSwitchEdit(const HttpRequest::Arguments& arguments)
 	{
 		HtmlTag content;
-		SwitchID switchID = Utils::Utils::GetIntegerMapEntry(arguments, "switch", SwitchNone);
+		SwitchID switchID = arguments.GetInteger("switch", SwitchNone);
 		ControlID controlId = manager.GetPossibleControlForAccessory();
 		if (controlId == ControlNone)
 		{
 			controlId = manager.GetPossibleControlForAccessory();
 		}
-		string matchKey = Utils::Utils::GetStringMapEntry(arguments, "matchkey");
+		string matchKey = arguments.GetString("matchkey");
 		Protocol protocol = ProtocolNone;
 		Address address = AddressDefault;
 		Address serverAddress = AddressNone;
 		string name = Languages::GetText(Languages::TextNew);
-		LayoutPosition posx = Utils::Utils::GetIntegerMapEntry(arguments, "posx", 0);
-		LayoutPosition posy = Utils::Utils::GetIntegerMapEntry(arguments, "posy", 0);
-		LayoutPosition posz = Utils::Utils::GetIntegerMapEntry(arguments, "posz", LayerUndeletable);
-		LayoutRotation rotation = Utils::Utils::GetIntegerMapEntry(arguments, "rotation", DataModel::LayoutItem::Rotation90);
+		LayoutPosition posx = arguments.GetInteger("posx", 0);
+		LayoutPosition posy = arguments.GetInteger("posy", 0);
+		LayoutPosition posz = arguments.GetInteger("posz", LayerUndeletable);
+		LayoutRotation rotation = arguments.GetInteger("rotation", DataModel::LayoutItem::Rotation90);
 		DataModel::AccessoryType type = DataModel::SwitchTypeLeft;
 		DataModel::AccessoryPulseDuration duration = manager.GetDefaultAccessoryDuration();
 		bool inverted = false;
@@ -2555,22 +2211,22 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleSwitchSave(const map<string, string>& arguments)
-	{
-		const SwitchID switchID = Utils::Utils::GetIntegerMapEntry(arguments, "switch", SwitchNone);
-		const string name = Utils::Utils::GetStringMapEntry(arguments, "name");
-		const ControlID controlId = Utils::Utils::GetIntegerMapEntry(arguments, "control", ControlIdNone);
-		const string matchKey = Utils::Utils::GetStringMapEntry(arguments, "matchkey");
-		const Protocol protocol = static_cast<Protocol>(Utils::Utils::GetIntegerMapEntry(arguments, "protocol", ProtocolNone));
-		const Address address = Utils::Utils::GetIntegerMapEntry(arguments, "address", AddressDefault);
-		const Address serverAddress = Utils::Utils::GetIntegerMapEntry(arguments, "serveraddress", AddressNone);
-		const LayoutPosition posX = Utils::Utils::GetIntegerMapEntry(arguments, "posx", 0);
-		const LayoutPosition posY = Utils::Utils::GetIntegerMapEntry(arguments, "posy", 0);
-		const LayoutPosition posZ = Utils::Utils::GetIntegerMapEntry(arguments, "posz", 0);
-		const LayoutRotation rotation = Utils::Utils::GetIntegerMapEntry(arguments, "rotation", DataModel::LayoutItem::Rotation90);
-		const DataModel::AccessoryType type = static_cast<DataModel::AccessoryType>(Utils::Utils::GetIntegerMapEntry(arguments, "type", DataModel::SwitchTypeLeft));
-		const DataModel::AccessoryPulseDuration duration = Utils::Utils::GetIntegerMapEntry(arguments, "duration", manager.GetDefaultAccessoryDuration());
-		const bool inverted = Utils::Utils::GetBoolMapEntry(arguments, "inverted");
+	void WebClient::HandleSwitchSave(const HttpRequest::Arguments& arguments)
+	{
+		const SwitchID switchID = arguments.GetInteger("switch", SwitchNone);
+		const string name = arguments.GetString("name");
+		const ControlID controlId = arguments.GetInteger("control", ControlIdNone);
+		const string matchKey = arguments.GetString("matchkey");
+		const Protocol protocol = static_cast<Protocol>(arguments.GetInteger("protocol", ProtocolNone));
+		const Address address = arguments.GetInteger("address", AddressDefault);
+		const Address serverAddress = arguments.GetInteger("serveraddress", AddressNone);
+		const LayoutPosition posX = arguments.GetInteger("posx", 0);
+		const LayoutPosition posY = arguments.GetInteger("posy", 0);
+		const LayoutPosition posZ = arguments.GetInteger("posz", 0);
+		const LayoutRotation rotation = arguments.GetInteger("rotation", DataModel::LayoutItem::Rotation90);
+		const DataModel::AccessoryType type = static_cast<DataModel::AccessoryType>(arguments.GetInteger("type", DataModel::SwitchTypeLeft));
+		const DataModel::AccessoryPulseDuration duration = arguments.GetInteger("duration", manager.GetDefaultAccessoryDuration());
+		const bool inverted = arguments.GetBool("inverted");
 		string result;
 		if (!manager.SwitchSave(switchID,
 			name,
@@ -2595,10 +2251,10 @@ namespace Server { namespace Web
 		ReplyResponse(ResponseInfo, Languages::TextSwitchSaved, name);
 	}
 
-	void WebClient::HandleSwitchState(const map<string, string>& arguments)
+	void WebClient::HandleSwitchState(const HttpRequest::Arguments& arguments)
 	{
-		SwitchID switchID = Utils::Utils::GetIntegerMapEntry(arguments, "switch", SwitchNone);
-		string switchStateText = Utils::Utils::GetStringMapEntry(arguments, "state", "turnout");
+		SwitchID switchID = arguments.GetInteger("switch", SwitchNone);
+		string switchStateText = arguments.GetString("state", "turnout");
 		DataModel::AccessoryState switchState;
 		if (switchStateText.compare("turnout") == 0)
 		{
@@ -2657,9 +2313,9 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleSwitchAskDelete(const map<string, string>& arguments)
+	void WebClient::HandleSwitchAskDelete(const HttpRequest::Arguments& arguments)
 	{
-		SwitchID switchID = Utils::Utils::GetIntegerMapEntry(arguments, "switch", SwitchNone);
+		SwitchID switchID = arguments.GetInteger("switch", SwitchNone);
 
 		if (switchID == SwitchNone)
 		{
@@ -2687,9 +2343,9 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleSwitchDelete(const map<string, string>& arguments)
+	void WebClient::HandleSwitchDelete(const HttpRequest::Arguments& arguments)
 	{
-		SwitchID switchID = Utils::Utils::GetIntegerMapEntry(arguments, "switch", SwitchNone);
+		SwitchID switchID = arguments.GetInteger("switch", SwitchNone);
 		const DataModel::Switch* mySwitch = manager.GetSwitch(switchID);
 		if (mySwitch == nullptr)
 		{
@@ -2708,9 +2364,9 @@ namespace Server { namespace Web
 		ReplyResponse(ResponseInfo, Languages::TextSwitchDeleted, name);
 	}
 
-	void WebClient::HandleSwitchGet(const map<string, string>& arguments)
+	void WebClient::HandleSwitchGet(const HttpRequest::Arguments& arguments)
 	{
-		SwitchID switchID = Utils::Utils::GetIntegerMapEntry(arguments, "switch");
+		SwitchID switchID = arguments.GetInteger("switch");
 		const DataModel::Switch* mySwitch = manager.GetSwitch(switchID);
 		if (mySwitch == nullptr)
 		{
@@ -2720,9 +2376,9 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(HtmlTagSwitch(mySwitch));
 	}
 
-	void WebClient::HandleSwitchRelease(const map<string, string>& arguments)
+	void WebClient::HandleSwitchRelease(const HttpRequest::Arguments& arguments)
 	{
-		SwitchID switchID = Utils::Utils::GetIntegerMapEntry(arguments, "switch");
+		SwitchID switchID = arguments.GetInteger("switch");
 		bool ret = manager.SwitchRelease(switchID);
 		ReplyHtmlWithHeaderAndParagraph(ret ? "Switch released" : "Switch not released");
 	}
@@ -2766,23 +2422,23 @@ namespace Server { namespace Web
 		return HtmlTagSelect(name + "_state", stateOptions, static_cast<DataModel::AccessoryState>(data)).AddClass("select_relation_state");
 	}
 
-	void WebClient::HandleFeedbackEdit(const map<string, string>& arguments)
+	void WebClient::HandleFeedbackEdit(const HttpRequest::Arguments& arguments)
 	{
 		HtmlTag content;
-		FeedbackID feedbackID = Utils::Utils::GetIntegerMapEntry(arguments, "feedback", FeedbackNone);
+		FeedbackID feedbackID = arguments.GetInteger("feedback", FeedbackNone);
 		string name = Languages::GetText(Languages::TextNew);
-		ControlID controlId = Utils::Utils::GetIntegerMapEntry(arguments, "controlid", manager.GetPossibleControlForFeedback());
-		string matchKey = Utils::Utils::GetStringMapEntry(arguments, "matchkey");
-		FeedbackPin pin = Utils::Utils::GetIntegerMapEntry(arguments, "pin", FeedbackPinNone);
-		FeedbackDevice device = static_cast<FeedbackDevice>(Utils::Utils::GetIntegerMapEntry(arguments, "device", FeedbackDeviceNone));
-		FeedbackBus bus = static_cast<FeedbackBus>(Utils::Utils::GetIntegerMapEntry(arguments, "bus", FeedbackBusNone));
-		DataModel::FeedbackType feedbackType = static_cast<DataModel::FeedbackType>(Utils::Utils::GetIntegerMapEntry(arguments, "feedbacktype", FeedbackTypeDefault));
-		RouteID routeId = Utils::Utils::GetIntegerMapEntry(arguments, "route", RouteNone);
-		LayoutPosition posx = Utils::Utils::GetIntegerMapEntry(arguments, "posx", 0);
-		LayoutPosition posy = Utils::Utils::GetIntegerMapEntry(arguments, "posy", 0);
-		LayoutPosition posz = Utils::Utils::GetIntegerMapEntry(arguments, "posz", LayerUndeletable);
-		LayoutRotation rotation = Utils::Utils::GetIntegerMapEntry(arguments, "rotation", DataModel::LayoutItem::Rotation90);
-		DataModel::LayoutItem::Visible visible = static_cast<Visible>(Utils::Utils::GetBoolMapEntry(arguments, "visible", feedbackID == FeedbackNone && ((posx || posy) && posz >= LayerUndeletable) ? DataModel::LayoutItem::VisibleYes : DataModel::LayoutItem::VisibleNo));
+		ControlID controlId = arguments.GetInteger("controlid", manager.GetPossibleControlForFeedback());
+		string matchKey = arguments.GetString("matchkey");
+		FeedbackPin pin = arguments.GetInteger("pin", FeedbackPinNone);
+		FeedbackDevice device = static_cast<FeedbackDevice>(arguments.GetInteger("device", FeedbackDeviceNone));
+		FeedbackBus bus = static_cast<FeedbackBus>(arguments.GetInteger("bus", FeedbackBusNone));
+		DataModel::FeedbackType feedbackType = static_cast<DataModel::FeedbackType>(arguments.GetInteger("feedbacktype", FeedbackTypeDefault));
+		RouteID routeId = arguments.GetInteger("route", RouteNone);
+		LayoutPosition posx = arguments.GetInteger("posx", 0);
+		LayoutPosition posy = arguments.GetInteger("posy", 0);
+		LayoutPosition posz = arguments.GetInteger("posz", LayerUndeletable);
+		LayoutRotation rotation = arguments.GetInteger("rotation", DataModel::LayoutItem::Rotation90);
+		DataModel::LayoutItem::Visible visible = static_cast<Visible>(arguments.GetBool("visible", feedbackID == FeedbackNone && ((posx || posy) && posz >= LayerUndeletable) ? DataModel::LayoutItem::VisibleYes : DataModel::LayoutItem::VisibleNo));
 		if (posz < LayerUndeletable)
 		{
 			if (controlId == ControlNone)
@@ -2795,6 +2451,8 @@ namespace Server { namespace Web
 			}
 		}
 		bool inverted = false;
+		Delay onDelay = DataModel::Feedback::DefaultOnDelay;
+		Delay offDelay = DataModel::Feedback::DefaultOffDelay;
 		if (feedbackID > FeedbackNone)
 		{
 			// existing feedback
@@ -2808,6 +2466,8 @@ namespace Server { namespace Web
 				device = feedback->GetDevice();
 				bus = feedback->GetBus();
 				inverted = feedback->GetInverted();
+				onDelay = feedback->GetOnDelay();
+				offDelay = feedback->GetOffDelay();
 				feedbackType = feedback->GetFeedbackType();
 				routeId = feedback->GetRouteId();
 				visible = feedback->GetVisible();
@@ -2877,6 +2537,8 @@ namespace Server { namespace Web
 		modulePin += HtmlTag("span").AddId("calc_pin").AddContent(to_string(((pin - 1) & 0x0F) + 1));
 		mainContent.AddChildTag(HtmlTagInputIntegerWithLabel("pin", Languages::TextPin, pin, FeedbackPinMin, FeedbackPinMax).AddContent(modulePin));
 		mainContent.AddChildTag(HtmlTagInputCheckboxWithLabel("inverted", Languages::TextInverted, "true", inverted));
+		mainContent.AddChildTag(HtmlTagInputIntegerWithLabel("ondelay", Languages::TextOnDelay, onDelay, 0, 65535));
+		mainContent.AddChildTag(HtmlTagInputIntegerWithLabel("offdelay", Languages::TextOffDelay, offDelay, 0, 65535));
 		mainContent.AddChildTag(HtmlTagSelectWithLabel("feedbacktype", Languages::TextType, typeOptions, feedbackType));
 		mainContent.AddChildTag(HtmlTagSelectWithLabel("route", Languages::TextExecuteRoute, routeOptions, routeId));
 		formContent.AddChildTag(mainContent);
@@ -2889,23 +2551,25 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleFeedbackSave(const map<string, string>& arguments)
-	{
-		const FeedbackID feedbackID = Utils::Utils::GetIntegerMapEntry(arguments, "feedback", FeedbackNone);
-		const string name = Utils::Utils::GetStringMapEntry(arguments, "name");
-		const ControlID controlId = Utils::Utils::GetIntegerMapEntry(arguments, "control", ControlIdNone);
-		const string matchKey = Utils::Utils::GetStringMapEntry(arguments, "matchkey");
-		const FeedbackPin pin = static_cast<FeedbackPin>(Utils::Utils::GetIntegerMapEntry(arguments, "pin", 1));
-		const FeedbackDevice device = static_cast<FeedbackDevice>(Utils::Utils::GetIntegerMapEntry(arguments, "device", FeedbackDeviceNone));
-		const FeedbackBus bus = static_cast<FeedbackBus>(Utils::Utils::GetIntegerMapEntry(arguments, "bus", FeedbackBusNone));
-		const bool inverted = Utils::Utils::GetBoolMapEntry(arguments, "inverted");
-		const DataModel::FeedbackType feedbackType = static_cast<DataModel::FeedbackType>(Utils::Utils::GetIntegerMapEntry(arguments, "feedbacktype", FeedbackTypeDefault));
-		const RouteID routeId = Utils::Utils::GetIntegerMapEntry(arguments, "route", RouteNone);
-		const DataModel::LayoutItem::Visible visible = static_cast<Visible>(Utils::Utils::GetBoolMapEntry(arguments, "visible", DataModel::LayoutItem::VisibleNo));
-		const LayoutPosition posX = Utils::Utils::GetIntegerMapEntry(arguments, "posx", 0);
-		const LayoutPosition posY = Utils::Utils::GetIntegerMapEntry(arguments, "posy", 0);
-		const LayoutPosition posZ = Utils::Utils::GetIntegerMapEntry(arguments, "posz", 0);
-		const LayoutRotation rotation = Utils::Utils::GetIntegerMapEntry(arguments, "rotation", DataModel::LayoutItem::Rotation90);
+	void WebClient::HandleFeedbackSave(const HttpRequest::Arguments& arguments)
+	{
+		const FeedbackID feedbackID = arguments.GetInteger("feedback", FeedbackNone);
+		const string name = arguments.GetString("name");
+		const ControlID controlId = arguments.GetInteger("control", ControlIdNone);
+		const string matchKey = arguments.GetString("matchkey");
+		const FeedbackPin pin = static_cast<FeedbackPin>(arguments.GetInteger("pin", 1));
+		const FeedbackDevice device = static_cast<FeedbackDevice>(arguments.GetInteger("device", FeedbackDeviceNone));
+		const FeedbackBus bus = static_cast<FeedbackBus>(arguments.GetInteger("bus", FeedbackBusNone));
+		const bool inverted = arguments.GetBool("inverted");
+		const DataModel::FeedbackType feedbackType = static_cast<DataModel::FeedbackType>(arguments.GetInteger("feedbacktype", FeedbackTypeDefault));
+		const RouteID routeId = arguments.GetInteger("route", RouteNone);
+		const Delay onDelay = arguments.GetInteger("ondelay", DataModel::Feedback::DefaultOnDelay);
+		const Delay offDelay = arguments.GetInteger("offdelay", DataModel::Feedback::DefaultOffDelay);
+		const DataModel::LayoutItem::Visible visible = static_cast<Visible>(arguments.GetBool("visible", DataModel::LayoutItem::VisibleNo));
+		const LayoutPosition posX = arguments.GetInteger("posx", 0);
+		const LayoutPosition posY = arguments.GetInteger("posy", 0);
+		const LayoutPosition posZ = arguments.GetInteger("posz", 0);
+		const LayoutRotation rotation = arguments.GetInteger("rotation", DataModel::LayoutItem::Rotation90);
 		string result;
 		if (!manager.FeedbackSave(feedbackID,
 			name,
@@ -2922,6 +2586,8 @@ namespace Server { namespace Web
 			inverted,
 			feedbackType,
 			routeId,
+			onDelay,
+			offDelay,
 			result))
 		{
 			ReplyResponse(ResponseError, result);
@@ -2931,10 +2597,10 @@ namespace Server { namespace Web
 		ReplyResponse(ResponseInfo, Languages::TextFeedbackSaved, name);
 	}
 
-	void WebClient::HandleFeedbackState(const map<string, string>& arguments)
+	void WebClient::HandleFeedbackState(const HttpRequest::Arguments& arguments)
 	{
-		FeedbackID feedbackID = Utils::Utils::GetIntegerMapEntry(arguments, "feedback", FeedbackNone);
-		DataModel::Feedback::FeedbackState state = (Utils::Utils::GetStringMapEntry(arguments, "state", "occupied").compare("occupied") == 0 ? DataModel::Feedback::FeedbackStateOccupied : DataModel::Feedback::FeedbackStateFree);
+		FeedbackID feedbackID = arguments.GetInteger("feedback", FeedbackNone);
+		DataModel::Feedback::FeedbackState state = (arguments.GetString("state", "occupied").compare("occupied") == 0 ? DataModel::Feedback::FeedbackStateOccupied : DataModel::Feedback::FeedbackStateFree);
 
 		manager.FeedbackState(feedbackID, state);
 
@@ -2975,9 +2641,9 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleFeedbackAskDelete(const map<string, string>& arguments)
+	void WebClient::HandleFeedbackAskDelete(const HttpRequest::Arguments& arguments)
 	{
-		FeedbackID feedbackID = Utils::Utils::GetIntegerMapEntry(arguments, "feedback", FeedbackNone);
+		FeedbackID feedbackID = arguments.GetInteger("feedback", FeedbackNone);
 
 		if (feedbackID == FeedbackNone)
 		{
@@ -3005,9 +2671,9 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleFeedbackDelete(const map<string, string>& arguments)
+	void WebClient::HandleFeedbackDelete(const HttpRequest::Arguments& arguments)
 	{
-		FeedbackID feedbackID = Utils::Utils::GetIntegerMapEntry(arguments, "feedback", FeedbackNone);
+		FeedbackID feedbackID = arguments.GetInteger("feedback", FeedbackNone);
 		const DataModel::Feedback* feedback = manager.GetFeedback(feedbackID);
 		if (feedback == nullptr)
 		{
@@ -3026,9 +2692,9 @@ namespace Server { namespace Web
 		ReplyResponse(ResponseInfo, Languages::TextFeedbackDeleted, name);
 	}
 
-	void WebClient::HandleFeedbackGet(const map<string, string>& arguments)
+	void WebClient::HandleFeedbackGet(const HttpRequest::Arguments& arguments)
 	{
-		FeedbackID feedbackID = Utils::Utils::GetIntegerMapEntry(arguments, "feedback", FeedbackNone);
+		FeedbackID feedbackID = arguments.GetInteger("feedback", FeedbackNone);
 		const DataModel::Feedback* feedback = manager.GetFeedback(feedbackID);
 		if (!feedback)
 		{
@@ -3036,7 +2702,7 @@ namespace Server { namespace Web
 			return;
 		}
 
-		const LayerID layer = Utils::Utils::GetIntegerMapEntry(arguments, "layer", LayerNone);
+		const LayerID layer = arguments.GetInteger("layer", LayerNone);
 		if (feedback->CheckControl(layer))
 		{
 			ReplyHtmlWithHeader(HtmlTagFeedback(feedback, true));
@@ -3052,16 +2718,16 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(HtmlTagFeedback(feedback));
 	}
 
-	void WebClient::HandleLocoSelector(const map<string,string>& arguments)
+	void WebClient::HandleLocoSelector(const HttpRequest::Arguments& arguments)
 	{
-		const unsigned int selector = Utils::Utils::GetIntegerMapEntry(arguments, "selector", 1);
-		const LocoID locoID = Utils::Utils::GetIntegerMapEntry(arguments, "loco");
+		const unsigned int selector = arguments.GetInteger("selector", 1);
+		const LocoID locoID = arguments.GetInteger("loco");
 		ReplyHtmlWithHeader(HtmlTagLocoSelector(to_string(selector), locoID));
 	}
 
-	void WebClient::HandleLayerSelector(const map<string,string>& arguments)
+	void WebClient::HandleLayerSelector(const HttpRequest::Arguments& arguments)
 	{
-		const LayerID layerID = Utils::Utils::GetIntegerMapEntry(arguments, "layer");
+		const LayerID layerID = arguments.GetInteger("layer");
 		ReplyHtmlWithHeader(HtmlTagLayerSelector(layerID));
 	}
 
@@ -3133,17 +2799,17 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleSettingsSave(const map<string, string>& arguments)
+	void WebClient::HandleSettingsSave(const HttpRequest::Arguments& arguments)
 	{
-		const Languages::Language language = static_cast<Languages::Language>(Utils::Utils::GetIntegerMapEntry(arguments, "language", Languages::EN));
-		const Logger::Logger::Level logLevel = static_cast<Logger::Logger::Level>(Utils::Utils::GetIntegerMapEntry(arguments, "loglevel", Logger::Logger::LevelInfo));
-		const StartupInitLocos startupInitLocos = static_cast<StartupInitLocos>(Utils::Utils::GetIntegerMapEntry(arguments, "startupinitlocos", StartupInitLocosAll));
-		const DataModel::AccessoryPulseDuration defaultAccessoryDuration = Utils::Utils::GetIntegerMapEntry(arguments, "duration", manager.GetDefaultAccessoryDuration());
-		const bool executeAccessory = Utils::Utils::GetBoolMapEntry(arguments, "executeaccessory", manager.GetExecuteAccessory());
-		const bool autoAddFeedback = Utils::Utils::GetBoolMapEntry(arguments, "autoaddfeedback", manager.GetAutoAddFeedback());
-		const bool stopOnFeedbackInFreeTrack = Utils::Utils::GetBoolMapEntry(arguments, "stoponfeedbackinfreetrack", manager.GetStopOnFeedbackInFreeTrack());
-		const DataModel::SelectRouteApproach selectRouteApproach = static_cast<DataModel::SelectRouteApproach>(Utils::Utils::GetIntegerMapEntry(arguments, "selectrouteapproach", DataModel::SelectRouteRandom));
-		const DataModel::Loco::NrOfTracksToReserve nrOfTracksToReserve = static_cast<DataModel::Loco::NrOfTracksToReserve>(Utils::Utils::GetIntegerMapEntry(arguments, "nroftrackstoreserve", DataModel::Loco::ReserveOne));
+		const Languages::Language language = static_cast<Languages::Language>(arguments.GetInteger("language", Languages::EN));
+		const Logger::Logger::Level logLevel = static_cast<Logger::Logger::Level>(arguments.GetInteger("loglevel", Logger::Logger::LevelInfo));
+		const StartupInitLocos startupInitLocos = static_cast<StartupInitLocos>(arguments.GetInteger("startupinitlocos", StartupInitLocosAll));
+		const DataModel::AccessoryPulseDuration defaultAccessoryDuration = arguments.GetInteger("duration", manager.GetDefaultAccessoryDuration());
+		const bool executeAccessory = arguments.GetBool("executeaccessory", manager.GetExecuteAccessory());
+		const bool autoAddFeedback = arguments.GetBool("autoaddfeedback", manager.GetAutoAddFeedback());
+		const bool stopOnFeedbackInFreeTrack = arguments.GetBool("stoponfeedbackinfreetrack", manager.GetStopOnFeedbackInFreeTrack());
+		const DataModel::SelectRouteApproach selectRouteApproach = static_cast<DataModel::SelectRouteApproach>(arguments.GetInteger("selectrouteapproach", DataModel::SelectRouteRandom));
+		const DataModel::Loco::NrOfTracksToReserve nrOfTracksToReserve = static_cast<DataModel::Loco::NrOfTracksToReserve>(arguments.GetInteger("nroftrackstoreserve", DataModel::Loco::ReserveOne));
 		manager.SettingsSave(language,
 			startupInitLocos,
 			defaultAccessoryDuration,
@@ -3153,15 +2819,16 @@ namespace Server { namespace Web
 			selectRouteApproach,
 			nrOfTracksToReserve,
 			logLevel);
+		server.GetLayoutCache().InvalidateAll();
 		ReplyResponse(ResponseInfo, Languages::TextSettingsSaved);
 	}
 
-	void WebClient::HandleTimestamp(__attribute__((unused)) const map<string, string>& arguments)
+	void WebClient::HandleTimestamp(__attribute__((unused)) const HttpRequest::Arguments& arguments)
 	{
 #ifdef __CYGWIN__
 		ReplyHtmlWithHeaderAndParagraph(Languages::TextTimestampNotSet);
 #else
-		const time_t timestamp = Utils::Utils::GetIntegerMapEntry(arguments, "timestamp", 0);
+		const time_t timestamp = arguments.GetInteger("timestamp", 0);
 		if (timestamp == 0)
 		{
 			ReplyHtmlWithHeaderAndParagraph(Languages::TextTimestampNotSet);
@@ -3186,9 +2853,9 @@ namespace Server { namespace Web
 #endif
 	}
 
-	void WebClient::HandleControlArguments(const map<string, string>& arguments)
+	void WebClient::HandleControlArguments(const HttpRequest::Arguments& arguments)
 	{
-		HardwareType hardwareType = static_cast<HardwareType>(Utils::Utils::GetIntegerMapEntry(arguments, "hardwaretype"));
+		HardwareType hardwareType = static_cast<HardwareType>(arguments.GetInteger("hardwaretype"));
 		ReplyHtmlWithHeader(WebClientStatic::HtmlTagControlArguments(hardwareType));
 	}
 
@@ -3345,10 +3012,10 @@ namespace Server { namespace Web
 		return content;
 	}
 
-	void WebClient::HandleCvFields(const map<string, string>& arguments)
+	void WebClient::HandleCvFields(const HttpRequest::Arguments& arguments)
 	{
-		ControlID controlID = static_cast<ControlID>(Utils::Utils::GetIntegerMapEntry(arguments, "control", ControlNone));
-		ProgramMode programMode = static_cast<ProgramMode>(Utils::Utils::GetIntegerMapEntry(arguments, "mode", ProgramModeNone));
+		ControlID controlID = static_cast<ControlID>(arguments.GetInteger("control", ControlNone));
+		ProgramMode programMode = static_cast<ProgramMode>(arguments.GetInteger("mode", ProgramModeNone));
 		ReplyHtmlWithHeader(HtmlTagCvFields(controlID, programMode));
 	}
 
@@ -3455,18 +3122,18 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(content);
 	}
 
-	void WebClient::HandleProgramModeSelector(const map<string, string>& arguments)
+	void WebClient::HandleProgramModeSelector(const HttpRequest::Arguments& arguments)
 	{
-		ControlID controlID = static_cast<ControlID>(Utils::Utils::GetIntegerMapEntry(arguments, "control"));
-		ProgramMode mode = static_cast<ProgramMode>(Utils::Utils::GetIntegerMapEntry(arguments, "mode"));
+		ControlID controlID = static_cast<ControlID>(arguments.GetInteger("control"));
+		ProgramMode mode = static_cast<ProgramMode>(arguments.GetInteger("mode"));
 		return ReplyHtmlWithHeader(HtmlTagProgramModeSelector(controlID, mode));
 	}
 
-	void WebClient::HandleProgramRead(const map<string, string>& arguments)
+	void WebClient::HandleProgramRead(const HttpRequest::Arguments& arguments)
 	{
-		ControlID controlID = static_cast<ControlID>(Utils::Utils::GetIntegerMapEntry(arguments, "control"));
-		CvNumber cv = static_cast<CvNumber>(Utils::Utils::GetIntegerMapEntry(arguments, "cv"));
-		ProgramMode mode = static_cast<ProgramMode>(Utils::Utils::GetIntegerMapEntry(arguments, "mode"));
+		ControlID controlID = static_cast<ControlID>(arguments.GetInteger("control"));
+		CvNumber cv = static_cast<CvNumber>(arguments.GetInteger("cv"));
+		ProgramMode mode = static_cast<ProgramMode>(arguments.GetInteger("mode"));
 		switch (mode)
 		{
 			case ProgramModeDccRegister:
@@ -3479,7 +3146,7 @@ namespace Server { namespace Web
 			case ProgramModeDccPomAccessory:
 			case ProgramModeMfx:
 			{
-				Address address = static_cast<Address>(Utils::Utils::GetIntegerMapEntry(arguments, "address"));
+				Address address = static_cast<Address>(arguments.GetInteger("address"));
 				manager.ProgramRead(controlID, mode, address, cv);
 				break;
 			}
@@ -3490,12 +3157,12 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeaderAndParagraph(Languages::TextProgramDccDirectRead, cv);
 	}
 
-	void WebClient::HandleProgramWrite(const map<string, string>& arguments)
+	void WebClient::HandleProgramWrite(const HttpRequest::Arguments& arguments)
 	{
-		ControlID controlID = static_cast<ControlID>(Utils::Utils::GetIntegerMapEntry(arguments, "control"));
-		ProgramMode mode = static_cast<ProgramMode>(Utils::Utils::GetIntegerMapEntry(arguments, "mode"));
-		CvNumber cv = static_cast<CvNumber>(Utils::Utils::GetIntegerMapEntry(arguments, "cv"));
-		CvValue value = static_cast<CvValue>(Utils::Utils::GetIntegerMapEntry(arguments, "value"));
+		ControlID controlID = static_cast<ControlID>(arguments.GetInteger("control"));
+		ProgramMode mode = static_cast<ProgramMode>(arguments.GetInteger("mode"));
+		CvNumber cv = static_cast<CvNumber>(arguments.GetInteger("cv"));
+		CvValue value = static_cast<CvValue>(arguments.GetInteger("value"));
 		switch (mode)
 		{
 			case ProgramModeMm:
@@ -3510,7 +3177,7 @@ namespace Server { namespace Web
 			case ProgramModeDccPomAccessory:
 			case ProgramModeMfx:
 			{
-				Address address = static_cast<Address>(Utils::Utils::GetIntegerMapEntry(arguments, "address"));
+				Address address = static_cast<Address>(arguments.GetInteger("address"));
 				manager.ProgramWrite(controlID, mode, address, cv, value);
 				break;
 			}
@@ -3521,7 +3188,7 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeaderAndParagraph(Languages::TextProgramDccDirectWrite, cv, value);
 	}
 
-	void WebClient::HandleUpdater(const map<string, string>& headers)
+	void WebClient::HandleUpdater()
 	{
 		Response response;
 		response.AddHeader("Cache-Control", "no-cache, must-revalidate");
@@ -3534,32 +3201,167 @@ namespace Server { namespace Web
 			return;
 		}
 
-		unsigned int updateID = Utils::Utils::GetIntegerMapEntry(headers, "Last-Event-ID", 1);
-		while(run)
+		// from now on the updates are pushed by the reactor of the webserver
+		// the browser sends the ID of the last update it has received when it reconnects
+		const int lastEventID = Utils::Integer::StringToInteger(request.GetHeader("Last-Event-ID").ToString(), -1);
+		updateID = (lastEventID < 0 ? 0 : lastEventID + 1);
+		state = ClientStateUpdater;
+	}
+
+	void WebClient::HandleWebSocket(const HttpRequest::Arguments& arguments)
+	{
+		const string key = request.GetHeader("Sec-WebSocket-Key").ToString();
+		if (!request.GetHeader("Upgrade").EqualsIgnoreCase("websocket") || key.empty())
+		{
+			Response response(Response::BadRequest, HtmlTag());
+			response.AddHeader("Content-Length", "0");
+			connection->Send(response);
+			return;
+		}
+
+		Response response(Response::SwitchingProtocols, HtmlTag());
+		response.AddHeader("Upgrade", "websocket");
+		response.AddHeader("Connection", "Upgrade");
+		response.AddHeader("Sec-WebSocket-Accept", WebSocket::AcceptKey(key));
+		int ret = connection->Send(response);
+		if (ret <= 0)
+		{
+			return;
+		}
+
+		// from now on the updates are pushed by the reactor of the webserver
+		// and the messages of the browser are read by the request workers
+		// a reconnecting browser sends the revision it has seen last
+		const int revision = arguments.GetInteger("revision", -1);
+		updateID = (revision < 0 ? 0 : revision + 1);
+		webSocket = true;
+		state = ClientStateWebSocket;
+	}
+
+	bool WebClient::ReceiveWebSocket()
+	{
+		char buffer[1024];
+		// the reactor has seen the socket readable, so there is no need to wait like Receive does
+		const int ret = connection->ReceiveNonBlocking(buffer, sizeof(buffer));
+		if (ret == 0 || (ret < 0 && errno != EAGAIN))
+		{
+			return false;
+		}
+		if (ret > 0)
+		{
+			webSocketBuffer.append(buffer, ret);
+		}
+
+		while (true)
 		{
-			string s;
-			bool ok = server.NextUpdate(updateID, s);
-			if (!ok)
+			size_t frameSize;
+			WebSocket::Opcode opcode;
+			string payload;
+			const WebSocket::ParseResult result = WebSocket::ParseFrame(webSocketBuffer, frameSize, opcode, payload);
+			if (result == WebSocket::ParseIncomplete)
 			{
-				// FIXME: use signaling instead of sleep
-				Utils::Utils::SleepForMilliseconds(100);
-				continue;
+				break;
+			}
+			if (result == WebSocket::ParseError)
+			{
+				return false;
 			}
+			webSocketBuffer.erase(0, frameSize);
 
-			string reply("id: ");
-			reply += to_string(updateID);
-			reply += "\r\n";
-			reply += s;
-			reply += "\r\n\r\n";
+			// replies are queued behind the updates, an update may be sent partially yet
+			switch (opcode)
+			{
+				case WebSocket::OpcodeBinary:
+					HandleWebSocketMessage(payload);
+					break;
+
+				case WebSocket::OpcodePing:
+					WebSocket::AppendFrame(updaterBuffer, WebSocket::OpcodePong, payload);
+					break;
 
-			++updateID;
+				case WebSocket::OpcodeClose:
+					WebSocket::AppendFrame(updaterBuffer, WebSocket::OpcodeClose, payload.substr(0, 2));
+					connection->Send(updaterBuffer);
+					return false;
 
-			ret = connection->Send(reply);
-			if (ret < 0)
+				default:
+					// text messages and pongs are not used by the browser
+					break;
+			}
+		}
+		state = ClientStateWebSocket;
+		return true;
+	}
+
+	void WebClient::HandleWebSocketMessage(const string& payload)
+	{
+		WebSocket::Message message;
+		if (!WebSocket::DecodeMessage(payload, message))
+		{
+			return;
+		}
+		switch (message.type)
+		{
+			case WebSocket::MessageLocoSpeed:
+				manager.LocoBaseSpeed(ControlTypeWebServer, WebClientStatic::LocoIdToObjectIdentifier(message.id), message.value);
+				break;
+
+			case WebSocket::MessageLocoOrientation:
+				manager.LocoBaseOrientation(ControlTypeWebServer, WebClientStatic::LocoIdToObjectIdentifier(message.id), message.value ? OrientationRight : OrientationLeft);
+				break;
+
+			case WebSocket::MessageLocoFunction:
+				manager.LocoBaseFunctionState(ControlTypeWebServer,
+					WebClientStatic::LocoIdToObjectIdentifier(message.id),
+					message.argument,
+					message.value ? DataModel::LocoFunctionStateOn : DataModel::LocoFunctionStateOff);
+				break;
+
+			case WebSocket::MessageFeedback:
+				manager.FeedbackState(message.id, message.value ? DataModel::Feedback::FeedbackStateOccupied : DataModel::Feedback::FeedbackStateFree);
+				break;
+
+			case WebSocket::MessageSwitch:
+				manager.SwitchState(ControlTypeWebServer, message.id, static_cast<DataModel::AccessoryState>(message.value), false);
+				break;
+
+			case WebSocket::MessageSignal:
+				manager.SignalState(ControlTypeWebServer, static_cast<SignalID>(message.id), static_cast<DataModel::AccessoryState>(message.value), false);
+				break;
+		}
+	}
+
+	bool WebClient::HasPendingUpdates() const
+	{
+		return !updaterBuffer.empty() || server.HasNewUpdates(updateID);
+	}
+
+	bool WebClient::SendUpdates()
+	{
+		server.NextUpdates(updateID, updaterBuffer, updaterAdded, webSocket);
+		if (updaterBuffer.empty())
+		{
+			return true;
+		}
+
+		int ret = connection->SendNonBlocking(updaterBuffer);
+		if (ret < 0 && errno != EAGAIN)
+		{
+			return false;
+		}
+
+		if (ret > 0)
+		{
+			updaterBuffer.erase(0, ret);
+			if (updaterBuffer.empty())
 			{
-				return;
+				server.UpdatesSent(updaterAdded);
+				updaterAdded.clear();
 			}
 		}
+
+		// a browser that does not read its updates gets disconnected and reconnects with its Last-Event-ID
+		return updaterBuffer.size() <= MaxUpdaterBuffer;
 	}
 
 	HtmlTag WebClient::HtmlTagLocoSelector(const string& selector, const LocoID locoID) const
@@ -3572,10 +3374,10 @@ namespace Server { namespace Web
 		return HtmlTagSelect("loco_" + selector, options, locoID).AddAttribute("onchange", "loadLoco(" + selector + ");");
 	}
 
-	void WebClient::HandleLoco(const map<string, string>& arguments)
+	void WebClient::HandleLoco(const HttpRequest::Arguments& arguments)
 	{
 		string content;
-		const LocoID locoBaseID = Utils::Utils::GetIntegerMapEntry(arguments, "loco", LocoNone);
+		const LocoID locoBaseID = arguments.GetInteger("loco", LocoNone);
 		const ObjectIdentifier locoBaseIdentifier(WebClientStatic::LocoIdToObjectIdentifier(locoBaseID));
 		if (!locoBaseIdentifier.IsSet())
 		{
@@ -3655,34 +3457,44 @@ namespace Server { namespace Web
 		ReplyHtmlWithHeader(container);
 	}
 
-	void WebClient::HandleNewPosition(const map<string, string>& arguments)
+	void WebClient::HandleNewPosition(const HttpRequest::Arguments& arguments)
 	{
 		string result;
 		HandleNewPositionInternal(arguments, result);
 		ReplyHtmlWithHeaderAndParagraph(result);
 	}
 
-	void WebClient::HandleNewPositionInternal(const map<string, string>& arguments, string& result)
+	void WebClient::HandleNewPositionInternal(const HttpRequest::Arguments& arguments, string& result)
 	{
-		const LayoutPosition posX = static_cast<LayoutPosition>(Utils::Utils::GetIntegerMapEntry(arguments, "x", -1));
+		const LayoutPosition posX = static_cast<LayoutPosition>(arguments.GetInteger("x", -1));
 		if (posX == -1)
 		{
 			return;
 		}
 
-		const LayoutPosition posY = static_cast<LayoutPosition>(Utils::Utils::GetIntegerMapEntry(arguments, "y", -1));
+		const LayoutPosition posY = static_cast<LayoutPosition>(arguments.GetInteger("y", -1));
 		if (posY == -1)
 		{
 			return;
 		}
 
-		manager.LayoutItemNewPosition(ObjectIdentifier(arguments), posX, posY, result);
+		manager.LayoutItemNewPosition(GetObjectIdentifier(arguments), posX, posY, result);
+	}
+
+	ObjectIdentifier WebClient::GetObjectIdentifier(const HttpRequest::Arguments& arguments)
+	{
+		ObjectIdentifier identifier;
+		identifier.Deserialize([&arguments](const char* name)
+			{
+				return arguments.GetInteger(name, ObjectNone);
+			});
+		return identifier;
 	}
 
-	void WebClient::HandleRotate(const map<string, string>& arguments)
+	void WebClient::HandleRotate(const HttpRequest::Arguments& arguments)
 	{
 		string result;
-		manager.LayoutItemRotate(ObjectIdentifier(arguments), result);
+		manager.LayoutItemRotate(GetObjectIdentifier(arguments), result);
 		ReplyHtmlWithHeaderAndParagraph(result);
 	}
 
@@ -3797,6 +3609,6 @@ namespace Server { namespace Web
 			.AddChildTag(HtmlTag("li").AddClass("contextentry").AddClass("real_layer_only").AddContent(Languages::GetText(Languages::TextAddCounter)).AddAttribute("onClick", "loadPopup('/?cmd=counteredit&counter=0');"))
 			));
 
-		connection->Send(ResponseHtmlFull("RailControl", body));
+		connection->Send(ResponseHtmlFull("RailControl", body, server.GetStaticFiles()));
 	}
 }} // namespace Server::Web
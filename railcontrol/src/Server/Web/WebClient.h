@@ -20,11 +20,11 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <cstring>
-#include <deque>
 #include <map>
 #include <string>
-#include <thread>
 #include <vector>
 
 #include "DataModel/AccessoryBase.h"
@@ -33,6 +33,8 @@ along with RailControl; see the file LICENCE. If not see
 #include "Manager.h"
 #include "Network/TcpConnection.h"
 #include "ResponseHtml.h"
+#include "Server/Web/HttpRequest.h"
+#include "Server/Web/StaticFiles.h"
 #include "Server/Web/WebClientCluster.h"
 #include "Server/Web/WebClientCounter.h"
 #include "Server/Web/WebClientRoute.h"
@@ -40,6 +42,8 @@ along with RailControl; see the file LICENCE. If not see
 #include "Server/Web/WebClientStatic.h"
 #include "Server/Web/WebClientText.h"
 #include "Server/Web/WebClientTrack.h"
+#include "Server/Web/WebSocket.h"
+#include "Utils/LatencyHistogram.h"
 
 namespace DataModel
 {
@@ -61,6 +65,15 @@ namespace Server { namespace Web
 				ResponseError = 'e'
 			};
 
+			enum ClientState : unsigned char
+			{
+				ClientStateIdle = 0,
+				ClientStateBusy,
+				ClientStateUpdater,
+				ClientStateTerminated,
+				ClientStateWebSocket
+			};
+
 			WebClient() = delete;
 			WebClient(const WebClient&) = delete;
 			WebClient& operator=(const WebClient&) = delete;
@@ -72,10 +85,9 @@ namespace Server { namespace Web
 			:	logger(Logger::Logger::GetLogger("WebClient # " + std::to_string(id))),
 				id(id),
 				connection(connection),
-				run(false),
-				terminated(false),
+				run(true),
+				state(ClientStateIdle),
 				server(webserver),
-				clientThread(&WebClient::Worker, this),
 				manager(manager),
 				cluster(manager, *this),
 				track(manager, *this, logger),
@@ -84,22 +96,60 @@ namespace Server { namespace Web
 				text(manager, *this),
 				counter(manager, *this),
 				headOnly(false),
-				buttonID(0)
+				webSocket(false),
+				buttonID(0),
+				updateID(0)
 			{
+				logger->Debug(Languages::TextTcpConnectionEstablished, connection->AddressAsString());
 			}
 
 			~WebClient();
 
-			void Worker();
+			// called by the reactor, reads the available part of the next request without blocking,
+			// returns false if the connection has to be closed
+			bool ReadRequest();
+
+			inline bool IsRequestComplete() const
+			{
+				return request.IsComplete();
+			}
+
+			// handles the complete request read by ReadRequest or the available WebSocket messages,
+			// returns false if the connection has to be closed
+			bool HandleRequest();
+
+			// sends pending updates to an updater or WebSocket client without blocking, returns false if the connection has to be closed
+			bool SendUpdates();
+
+			// also true for updates added while a request worker was handling the client
+			bool HasPendingUpdates() const;
+
+			inline int GetSocket() const
+			{
+				return connection->GetSocket();
+			}
+
+			// returns the latency histogram of every command requested so far, named webcommand;command
+			static std::string GetCommandStatistics();
+
+			inline ClientState GetState() const
+			{
+				return state;
+			}
+
+			inline void SetState(const ClientState newState)
+			{
+				state = newState;
+			}
 
 			inline void Stop()
 			{
 				run = false;
 			}
 
-			inline bool IsTerminated()
+			inline bool IsTerminated() const
 			{
-				return terminated;
+				return state == ClientStateTerminated;
 			}
 
 			inline void ReplyHtmlWithHeader(const HtmlTag& tag)
@@ -107,6 +157,20 @@ namespace Server { namespace Web
 				connection->Send(ResponseHtml(tag));
 			}
 
+			inline void ReplyHtmlWithHeader(const HtmlTag& tag, const std::string& etag)
+			{
+				ResponseHtml response(tag);
+				response.AddHeader("ETag", etag);
+				connection->Send(response);
+			}
+
+			inline void ReplyNotModified(const std::string& etag)
+			{
+				ResponseHtml response(Response::NotModified);
+				response.AddHeader("ETag", etag);
+				connection->Send(response);
+			}
+
 			inline void ReplyResponse(const std::string& text)
 			{
 				ReplyHtmlWithHeader(HtmlTag().AddContent(text));
@@ -201,10 +265,23 @@ namespace Server { namespace Web
 				const FeedbackBus bus);
 
 		private:
-			void InterpretClientRequest(const std::deque<std::string>& lines, std::string& method, std::string& uri, std::string& protocol, std::map<std::string,std::string>& arguments, std::map<std::string,std::string>& headers);
-			void HandleLoco(const std::map<std::string, std::string>& arguments);
+			typedef void (*CommandHandler)(WebClient& client, const HttpRequest::Arguments& arguments);
+
+			struct Command
+			{
+				const char* name;
+				CommandHandler handler;
+			};
+
+			static const size_t NumberOfCommands = 133;
+
+			// returns NumberOfCommands if the command is unknown
+			static size_t FindCommand(const HttpRequest::Span& name);
+
+			void HandleLoco(const HttpRequest::Arguments& arguments);
 			void PrintMainHTML();
-			void DeliverFile(const std::string& file);
+			void DeliverFile(const std::string& uri, const HttpRequest::Arguments& arguments);
+			void DeliverStaticFile(const StaticFiles::File& file, const bool versioned);
 			void DeliverFileInternal(FILE* f, const char* realFile, const std::string& file);
 			HtmlTag HtmlTagLocoSelector(const std::string& selector, const LocoID locoID = LocoNone) const;
 			HtmlTag HtmlTagLayerSelector(const LayerID layerID = LayerNone) const;
@@ -232,86 +309,95 @@ namespace Server { namespace Web
 			std::map<std::string,ObjectID> GetMultipleUnitSlaveOptions() const;
 
 			void HandleAskShutdown();
-			void HandleSelectLoco(const std::map<std::string, std::string>& arguments);
-			void HandleLayerEdit(const std::map<std::string, std::string>& arguments);
-			void HandleLayerSave(const std::map<std::string, std::string>& arguments);
+			void HandleShutdown();
+			void HandleBooster(const HttpRequest::Arguments& arguments);
+			void HandleGetLocoList();
+			void HandleGetRouteList();
+			void HandleStats();
+			void HandleSelectLoco(const HttpRequest::Arguments& arguments);
+			void HandleLayerEdit(const HttpRequest::Arguments& arguments);
+			void HandleLayerSave(const HttpRequest::Arguments& arguments);
 			void HandleLayerList();
-			void HandleLayerAskDelete(const std::map<std::string, std::string>& arguments);
-			void HandleLayerDelete(const std::map<std::string, std::string>& arguments);
-			void HandleControlEdit(const std::map<std::string, std::string>& arguments);
-			void HandleControlSave(const std::map<std::string, std::string>& arguments);
+			void HandleLayerAskDelete(const HttpRequest::Arguments& arguments);
+			void HandleLayerDelete(const HttpRequest::Arguments& arguments);
+			void HandleControlEdit(const HttpRequest::Arguments& arguments);
+			void HandleControlSave(const HttpRequest::Arguments& arguments);
 			void HandleControlList();
-			void HandleControlAskDelete(const std::map<std::string, std::string>& arguments);
-			void HandleControlDelete(const std::map<std::string, std::string>& arguments);
-			void HandleLocoBaseSpeed(const std::map<std::string,std::string>& arguments);
-			void HandleLocoBaseOrientation(const std::map<std::string,std::string>& arguments);
-			void HandleLocoFunction(const std::map<std::string, std::string>& arguments);
-			void HandleLocoEdit(const std::map<std::string, std::string>& arguments);
-			void HandleLocoSave(const std::map<std::string, std::string>& arguments);
+			void HandleControlAskDelete(const HttpRequest::Arguments& arguments);
+			void HandleControlDelete(const HttpRequest::Arguments& arguments);
+			void HandleLocoBaseSpeed(const HttpRequest::Arguments& arguments);
+			void HandleLocoBaseOrientation(const HttpRequest::Arguments& arguments);
+			void HandleLocoFunction(const HttpRequest::Arguments& arguments);
+			void HandleLocoEdit(const HttpRequest::Arguments& arguments);
+			void HandleLocoSave(const HttpRequest::Arguments& arguments);
 			void HandleLocoList();
-			void HandleLocoAskDelete(const std::map<std::string, std::string>& arguments);
-			void HandleLocoDelete(const std::map<std::string, std::string>& arguments);
-			void HandleLocoRelease(const std::map<std::string, std::string>& arguments);
-			void HandleLocoAddTimeTable(const std::map<std::string, std::string>& arguments);
-			void HandleMultipleUnitEdit(const std::map<std::string, std::string>& arguments);
-			void HandleMultipleUnitSave(const std::map<std::string, std::string>& arguments);
+			void HandleLocoAskDelete(const HttpRequest::Arguments& arguments);
+			void HandleLocoDelete(const HttpRequest::Arguments& arguments);
+			void HandleLocoRelease(const HttpRequest::Arguments& arguments);
+			void HandleLocoAddTimeTable(const HttpRequest::Arguments& arguments);
+			void HandleMultipleUnitEdit(const HttpRequest::Arguments& arguments);
+			void HandleMultipleUnitSave(const HttpRequest::Arguments& arguments);
 			void HandleMultipleUnitList();
-			void HandleMultipleUnitAskDelete(const std::map<std::string, std::string>& arguments);
-			void HandleMultipleUnitDelete(const std::map<std::string, std::string>& arguments);
-			void HandleMultipleUnitRelease(const std::map<std::string, std::string>& arguments);
-			void HandleProtocol(const std::map<std::string, std::string>& arguments);
-			void HandleAccessoryAddress(const std::map<std::string, std::string>& arguments);
-			void HandleFeedbackDeviceBus(const std::map<std::string, std::string>& arguments);
-			void HandleLayout(const std::map<std::string,std::string>& arguments);
-			void HandleAccessoryEdit(const std::map<std::string,std::string>& arguments);
-			void HandleAccessorySave(const std::map<std::string,std::string>& arguments);
-			void HandleAccessoryState(const std::map<std::string,std::string>& arguments);
+			void HandleMultipleUnitAskDelete(const HttpRequest::Arguments& arguments);
+			void HandleMultipleUnitDelete(const HttpRequest::Arguments& arguments);
+			void HandleMultipleUnitRelease(const HttpRequest::Arguments& arguments);
+			void HandleProtocol(const HttpRequest::Arguments& arguments);
+			void HandleAccessoryAddress(const HttpRequest::Arguments& arguments);
+			void HandleFeedbackDeviceBus(const HttpRequest::Arguments& arguments);
+			void HandleLayout(const HttpRequest::Arguments& arguments);
+			void HandleAccessoryEdit(const HttpRequest::Arguments& arguments);
+			void HandleAccessorySave(const HttpRequest::Arguments& arguments);
+			void HandleAccessoryState(const HttpRequest::Arguments& arguments);
 			void HandleAccessoryList();
-			void HandleAccessoryAskDelete(const std::map<std::string,std::string>& arguments);
-			void HandleAccessoryDelete(const std::map<std::string,std::string>& arguments);
-			void HandleAccessoryGet(const std::map<std::string,std::string>& arguments);
-			void HandleAccessoryRelease(const std::map<std::string,std::string>& arguments);
-			void HandleSwitchEdit(const std::map<std::string,std::string>& arguments);
-			void HandleSwitchSave(const std::map<std::string,std::string>& arguments);
-			void HandleSwitchState(const std::map<std::string,std::string>& arguments);
+			void HandleAccessoryAskDelete(const HttpRequest::Arguments& arguments);
+			void HandleAccessoryDelete(const HttpRequest::Arguments& arguments);
+			void HandleAccessoryGet(const HttpRequest::Arguments& arguments);
+			void HandleAccessoryRelease(const HttpRequest::Arguments& arguments);
+			void HandleSwitchEdit(const HttpRequest::Arguments& arguments);
+			void HandleSwitchSave(const HttpRequest::Arguments& arguments);
+			void HandleSwitchState(const HttpRequest::Arguments& arguments);
 			void HandleSwitchList();
-			void HandleSwitchAskDelete(const std::map<std::string,std::string>& arguments);
-			void HandleSwitchDelete(const std::map<std::string,std::string>& arguments);
-			void HandleSwitchGet(const std::map<std::string,std::string>& arguments);
-			void HandleSwitchRelease(const std::map<std::string,std::string>& arguments);
-			void HandleFeedbackEdit(const std::map<std::string,std::string>& arguments);
-			void HandleFeedbackSave(const std::map<std::string,std::string>& arguments);
-			void HandleFeedbackState(const std::map<std::string,std::string>& arguments);
+			void HandleSwitchAskDelete(const HttpRequest::Arguments& arguments);
+			void HandleSwitchDelete(const HttpRequest::Arguments& arguments);
+			void HandleSwitchGet(const HttpRequest::Arguments& arguments);
+			void HandleSwitchRelease(const HttpRequest::Arguments& arguments);
+			void HandleFeedbackEdit(const HttpRequest::Arguments& arguments);
+			void HandleFeedbackSave(const HttpRequest::Arguments& arguments);
+			void HandleFeedbackState(const HttpRequest::Arguments& arguments);
 			void HandleFeedbackList();
-			void HandleFeedbackAskDelete(const std::map<std::string,std::string>& arguments);
-			void HandleFeedbackDelete(const std::map<std::string,std::string>& arguments);
-			void HandleFeedbackGet(const std::map<std::string,std::string>& arguments);
-			void HandleLocoSelector(const std::map<std::string,std::string>& arguments);
-			void HandleLayerSelector(const std::map<std::string,std::string>& arguments);
-			void HandleFeedbackAdd(const std::map<std::string,std::string>& arguments);
+			void HandleFeedbackAskDelete(const HttpRequest::Arguments& arguments);
+			void HandleFeedbackDelete(const HttpRequest::Arguments& arguments);
+			void HandleFeedbackGet(const HttpRequest::Arguments& arguments);
+			void HandleLocoSelector(const HttpRequest::Arguments& arguments);
+			void HandleLayerSelector(const HttpRequest::Arguments& arguments);
+			void HandleFeedbackAdd(const HttpRequest::Arguments& arguments);
 			void HandleSettingsEdit();
-			void HandleSettingsSave(const std::map<std::string, std::string>& arguments);
-			void HandleSlaveAdd(const std::map<std::string,std::string>& arguments);
-			void HandleTimestamp(const std::map<std::string,std::string>& arguments);
-			void HandleControlArguments(const std::map<std::string,std::string>& arguments);
+			void HandleSettingsSave(const HttpRequest::Arguments& arguments);
+			void HandleSlaveAdd(const HttpRequest::Arguments& arguments);
+			void HandleTimestamp(const HttpRequest::Arguments& arguments);
+			void HandleControlArguments(const HttpRequest::Arguments& arguments);
 			void HandleProgram();
-			void HandleProgramModeSelector(const std::map<std::string,std::string>& arguments);
-			void HandleProgramRead(const std::map<std::string,std::string>& arguments);
-			void HandleProgramWrite(const std::map<std::string,std::string>& arguments);
-			void HandleCvFields(const std::map<std::string,std::string>& arguments);
-			void HandleNewPosition(const std::map<std::string,std::string>& arguments);
-			void HandleNewPositionInternal(const std::map<std::string,std::string>& arguments, std::string& result);
-			void HandleRotate(const std::map<std::string,std::string>& arguments);
-			void HandleUpdater(const std::map<std::string,std::string>& headers);
-			void WorkerImpl();
+			void HandleProgramModeSelector(const HttpRequest::Arguments& arguments);
+			void HandleProgramRead(const HttpRequest::Arguments& arguments);
+			void HandleProgramWrite(const HttpRequest::Arguments& arguments);
+			void HandleCvFields(const HttpRequest::Arguments& arguments);
+			void HandleNewPosition(const HttpRequest::Arguments& arguments);
+			void HandleNewPositionInternal(const HttpRequest::Arguments& arguments, std::string& result);
+			void HandleRotate(const HttpRequest::Arguments& arguments);
+
+			// the layout item given by an argument like track=5
+			static DataModel::ObjectIdentifier GetObjectIdentifier(const HttpRequest::Arguments& arguments);
+			void HandleUpdater();
+			void HandleWebSocket(const HttpRequest::Arguments& arguments);
+			bool ReceiveWebSocket();
+			void HandleWebSocketMessage(const std::string& payload);
 
 			Logger::Logger* logger;
 			unsigned int id;
 			Network::TcpConnection* connection;
 			volatile bool run;
-			bool terminated;
+			std::atomic<ClientState> state;
 			WebServer& server;
-			std::thread clientThread;
 			Manager& manager;
 			WebClientCluster cluster;
 			WebClientTrack track;
@@ -319,8 +405,20 @@ namespace Server { namespace Web
 			WebClientRoute route;
 			WebClientText text;
 			WebClientCounter counter;
+			HttpRequest request;
 			bool headOnly;
+			bool webSocket;
+			std::string webSocketBuffer;
 			unsigned int buttonID;
+			unsigned int updateID;
+			std::string updaterBuffer;
+			std::vector<std::chrono::steady_clock::time_point> updaterAdded;
+
+			static const size_t MaxUpdaterBuffer = 65536;
+
+			// the commands of all clients are looked up in this table, their latencies are shared as well
+			static const Command commands[];
+			static Utils::LatencyHistogram commandLatencies[NumberOfCommands];
 	};
 
 }} // namespace Server::Web
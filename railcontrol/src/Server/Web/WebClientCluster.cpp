@@ -132,11 +132,11 @@ namespace Server { namespace Web
 		return content;
 	}
 
-	void WebClientCluster::HandleClusterEdit(const map<string, string>& arguments)
+	void WebClientCluster::HandleClusterEdit(const HttpRequest::Arguments& arguments)
 	{
 		HtmlTag content;
-		ClusterID clusterID = Utils::Utils::GetIntegerMapEntry(arguments, "cluster", ClusterNone);
-		string name = Utils::Utils::GetStringMapEntry(arguments, "name");
+		ClusterID clusterID = arguments.GetInteger("cluster", ClusterNone);
+		string name = arguments.GetString("name");
 		vector<Relation*> tracks;
 
 		if (clusterID != ClusterNone)
@@ -174,23 +174,23 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(content);
 	}
 
-	void WebClientCluster::HandleClusterSave(const map<string, string>& arguments)
+	void WebClientCluster::HandleClusterSave(const HttpRequest::Arguments& arguments)
 	{
-		ClusterID clusterID = Utils::Utils::GetIntegerMapEntry(arguments, "cluster", ClusterNone);
-		string name = Utils::Utils::GetStringMapEntry(arguments, "name");
-		const unsigned int count = Utils::Utils::GetIntegerMapEntry(arguments, "trackcounter", 0);
+		ClusterID clusterID = arguments.GetInteger("cluster", ClusterNone);
+		string name = arguments.GetString("name");
+		const unsigned int count = arguments.GetInteger("trackcounter", 0);
 
 		vector<Relation*> tracks;
 		{
 			for (unsigned int index = 1; index <= count; ++index)
 			{
 				const string indexAsString = to_string(index);
-				const TrackID trackID = Utils::Utils::GetIntegerMapEntry(arguments, "track_id_" + indexAsString, TrackNone);
+				const TrackID trackID = arguments.GetInteger("track_id_" + indexAsString, TrackNone);
 				if (trackID == TrackNone)
 				{
 					continue;
 				}
-				const bool inverted = Utils::Utils::GetBoolMapEntry(arguments, "track_inverted_" + indexAsString, false);
+				const bool inverted = arguments.GetBool("track_inverted_" + indexAsString, false);
 
 				tracks.push_back(new Relation(&manager,
 					ObjectIdentifier(ObjectTypeCluster, clusterID),
@@ -211,9 +211,9 @@ namespace Server { namespace Web
 		client.ReplyResponse(WebClient::ResponseInfo, Languages::TextClusterSaved, name);
 	}
 
-	void WebClientCluster::HandleClusterAskDelete(const map<string, string>& arguments)
+	void WebClientCluster::HandleClusterAskDelete(const HttpRequest::Arguments& arguments)
 	{
-		ClusterID clusterID = Utils::Utils::GetIntegerMapEntry(arguments, "cluster", ClusterNone);
+		ClusterID clusterID = arguments.GetInteger("cluster", ClusterNone);
 
 		if (clusterID == ControlNone)
 		{
@@ -240,9 +240,9 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(content);
 	}
 
-	void WebClientCluster::HandleClusterDelete(const map<string, string>& arguments)
+	void WebClientCluster::HandleClusterDelete(const HttpRequest::Arguments& arguments)
 	{
-		ClusterID clusterID = Utils::Utils::GetIntegerMapEntry(arguments, "cluster", ClusterNone);
+		ClusterID clusterID = arguments.GetInteger("cluster", ClusterNone);
 		const Cluster* cluster = manager.GetCluster(clusterID);
 		if (!cluster)
 		{
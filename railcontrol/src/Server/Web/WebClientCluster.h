@@ -26,6 +26,7 @@ along with RailControl; see the file LICENCE. If not see
 
 #include "DataModel/Relation.h"
 #include "Manager.h"
+#include "Server/Web/HttpRequest.h"
 
 namespace Server { namespace Web
 {
@@ -53,13 +54,13 @@ namespace Server { namespace Web
 			HtmlTag HtmlTagSelectTrack(const std::vector<DataModel::Relation*>& relations,
 				const ClusterID clusterID) const;
 
-			void HandleClusterEdit(const std::map<std::string,std::string>& arguments);
+			void HandleClusterEdit(const HttpRequest::Arguments& arguments);
 
-			void HandleClusterSave(const std::map<std::string,std::string>& arguments);
+			void HandleClusterSave(const HttpRequest::Arguments& arguments);
 
-			void HandleClusterAskDelete(const std::map<std::string,std::string>& arguments);
+			void HandleClusterAskDelete(const HttpRequest::Arguments& arguments);
 
-			void HandleClusterDelete(const std::map<std::string,std::string>& arguments);
+			void HandleClusterDelete(const HttpRequest::Arguments& arguments);
 
 			std::map<std::string,ObjectID> GetTrackOptions(const ClusterID clusterId = ClusterNone) const;
 
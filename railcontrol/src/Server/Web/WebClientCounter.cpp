@@ -45,17 +45,17 @@ using std::vector;
 
 namespace Server { namespace Web
 {
-	void WebClientCounter::HandleCounterEdit(const map<string, string>& arguments)
+	void WebClientCounter::HandleCounterEdit(const HttpRequest::Arguments& arguments)
 	{
 		HtmlTag content;
-		const CounterID counterID = Utils::Utils::GetIntegerMapEntry(arguments, "counter", CounterNone);
+		const CounterID counterID = arguments.GetInteger("counter", CounterNone);
 		string name = Languages::GetText(Languages::TextNew);
-		int max = Utils::Utils::GetIntegerMapEntry(arguments, "max", 1);
-		int min = Utils::Utils::GetIntegerMapEntry(arguments, "min", 0);
-		LayoutPosition posx = Utils::Utils::GetIntegerMapEntry(arguments, "posx", 0);
-		LayoutPosition posy = Utils::Utils::GetIntegerMapEntry(arguments, "posy", 0);
-		LayoutPosition posz = Utils::Utils::GetIntegerMapEntry(arguments, "posz", LayerUndeletable);
-		LayoutRotation rotation = Utils::Utils::GetIntegerMapEntry(arguments, "rotation", DataModel::LayoutItem::Rotation0);
+		int max = arguments.GetInteger("max", 1);
+		int min = arguments.GetInteger("min", 0);
+		LayoutPosition posx = arguments.GetInteger("posx", 0);
+		LayoutPosition posy = arguments.GetInteger("posy", 0);
+		LayoutPosition posz = arguments.GetInteger("posz", LayerUndeletable);
+		LayoutRotation rotation = arguments.GetInteger("rotation", DataModel::LayoutItem::Rotation0);
 
 		if (counterID > CounterNone)
 		{
@@ -99,16 +99,16 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(content);
 	}
 
-	void WebClientCounter::HandleCounterSave(const map<string, string>& arguments)
+	void WebClientCounter::HandleCounterSave(const HttpRequest::Arguments& arguments)
 	{
-		const CounterID counterID = Utils::Utils::GetIntegerMapEntry(arguments, "counter", CounterNone);
-		const string name = Utils::Utils::GetStringMapEntry(arguments, "name");
-		const int max = Utils::Utils::GetIntegerMapEntry(arguments, "max", 1);
-		const int min = Utils::Utils::GetIntegerMapEntry(arguments, "min", 0);
-		const LayoutPosition posX = Utils::Utils::GetIntegerMapEntry(arguments, "posx", 0);
-		const LayoutPosition posY = Utils::Utils::GetIntegerMapEntry(arguments, "posy", 0);
-		const LayoutPosition posZ = Utils::Utils::GetIntegerMapEntry(arguments, "posz", 0);
-		const LayoutRotation rotation = Utils::Utils::GetIntegerMapEntry(arguments, "rotation", DataModel::LayoutItem::Rotation0);
+		const CounterID counterID = arguments.GetInteger("counter", CounterNone);
+		const string name = arguments.GetString("name");
+		const int max = arguments.GetInteger("max", 1);
+		const int min = arguments.GetInteger("min", 0);
+		const LayoutPosition posX = arguments.GetInteger("posx", 0);
+		const LayoutPosition posY = arguments.GetInteger("posy", 0);
+		const LayoutPosition posZ = arguments.GetInteger("posz", 0);
+		const LayoutRotation rotation = arguments.GetInteger("rotation", DataModel::LayoutItem::Rotation0);
 		string result;
 		if (!manager.CounterSave(counterID,
 			name,
@@ -150,9 +150,9 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(content);
 	}
 
-	void WebClientCounter::HandleCounterAskDelete(const map<string, string>& arguments)
+	void WebClientCounter::HandleCounterAskDelete(const HttpRequest::Arguments& arguments)
 	{
-		const CounterID counterID = Utils::Utils::GetIntegerMapEntry(arguments, "counter", CounterNone);
+		const CounterID counterID = arguments.GetInteger("counter", CounterNone);
 		if (counterID == CounterNone)
 		{
 			client.ReplyHtmlWithHeaderAndParagraph(Languages::TextCounterDoesNotExist);
@@ -179,9 +179,9 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(content);
 	}
 
-	void WebClientCounter::HandleCounterDelete(const map<string, string>& arguments)
+	void WebClientCounter::HandleCounterDelete(const HttpRequest::Arguments& arguments)
 	{
-		const CounterID counterID = Utils::Utils::GetIntegerMapEntry(arguments, "counter", CounterNone);
+		const CounterID counterID = arguments.GetInteger("counter", CounterNone);
 		const DataModel::Counter* counter = manager.GetCounter(counterID);
 		if (!counter)
 		{
@@ -200,9 +200,9 @@ namespace Server { namespace Web
 		client.ReplyResponse(WebClient::ResponseInfo, Languages::TextCounterDeleted, name);
 	}
 
-	void WebClientCounter::HandleCounterGet(const map<string, string>& arguments)
+	void WebClientCounter::HandleCounterGet(const HttpRequest::Arguments& arguments)
 	{
-		const CounterID counterID = Utils::Utils::GetIntegerMapEntry(arguments, "counter");
+		const CounterID counterID = arguments.GetInteger("counter");
 		const DataModel::Counter* counter = manager.GetCounter(counterID);
 		if (!counter)
 		{
@@ -212,9 +212,9 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(HtmlTagCounter(counter));
 	}
 
-	void WebClientCounter::HandleCounterIncrement(const map<string, string>& arguments)
+	void WebClientCounter::HandleCounterIncrement(const HttpRequest::Arguments& arguments)
 	{
-		const CounterID counterID = Utils::Utils::GetIntegerMapEntry(arguments, "counter");
+		const CounterID counterID = arguments.GetInteger("counter");
 		const bool result = manager.Count(counterID, CounterTypeIncrement);
 		if (result)
 		{
@@ -226,9 +226,9 @@ namespace Server { namespace Web
 		}
 	}
 
-	void WebClientCounter::HandleCounterDecrement(const map<string, string>& arguments)
+	void WebClientCounter::HandleCounterDecrement(const HttpRequest::Arguments& arguments)
 	{
-		const CounterID counterID = Utils::Utils::GetIntegerMapEntry(arguments, "counter");
+		const CounterID counterID = arguments.GetInteger("counter");
 		const bool result = manager.Count(counterID, CounterTypeDecrement);
 		if (result)
 		{
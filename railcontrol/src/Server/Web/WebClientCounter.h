@@ -24,6 +24,7 @@ along with RailControl; see the file LICENCE. If not see
 #include <string>
 
 #include "Manager.h"
+#include "Server/Web/HttpRequest.h"
 
 namespace Server { namespace Web
 {
@@ -42,14 +43,14 @@ namespace Server { namespace Web
 			{
 			}
 
-			void HandleCounterEdit(const std::map<std::string,std::string>& arguments);
-			void HandleCounterSave(const std::map<std::string,std::string>& arguments);
+			void HandleCounterEdit(const HttpRequest::Arguments& arguments);
+			void HandleCounterSave(const HttpRequest::Arguments& arguments);
 			void HandleCounterList();
-			void HandleCounterAskDelete(const std::map<std::string,std::string>& arguments);
-			void HandleCounterDelete(const std::map<std::string,std::string>& arguments);
-			void HandleCounterGet(const std::map<std::string, std::string>& arguments);
-			void HandleCounterIncrement(const std::map<std::string, std::string>& arguments);
-			void HandleCounterDecrement(const std::map<std::string, std::string>& arguments);
+			void HandleCounterAskDelete(const HttpRequest::Arguments& arguments);
+			void HandleCounterDelete(const HttpRequest::Arguments& arguments);
+			void HandleCounterGet(const HttpRequest::Arguments& arguments);
+			void HandleCounterIncrement(const HttpRequest::Arguments& arguments);
+			void HandleCounterDecrement(const HttpRequest::Arguments& arguments);
 
 		private:
 			Manager& manager;
@@ -59,9 +59,9 @@ using std::vector;
 
 namespace Server { namespace Web
 {
-	void WebClientRoute::HandleRouteGet(const map<string, string>& arguments)
+	void WebClientRoute::HandleRouteGet(const HttpRequest::Arguments& arguments)
 	{
-		RouteID routeID = Utils::Utils::GetIntegerMapEntry(arguments, "route");
+		RouteID routeID = arguments.GetInteger("route");
 		const DataModel::Route* route = manager.GetRoute(routeID);
 		if (route == nullptr || route->GetVisible() == DataModel::LayoutItem::VisibleNo)
 		{
@@ -71,10 +71,10 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(HtmlTagRoute(route));
 	}
 
-	void WebClientRoute::HandleRouteEdit(const map<string, string>& arguments)
+	void WebClientRoute::HandleRouteEdit(const HttpRequest::Arguments& arguments)
 	{
 		HtmlTag content;
-		const RouteID routeID = Utils::Utils::GetIntegerMapEntry(arguments, "route", RouteNone);
+		const RouteID routeID = arguments.GetInteger("route", RouteNone);
 		string name = Languages::GetText(Languages::TextNew);
 		Delay delay = Route::DefaultDelay;
 		Route::PushpullType pushpull = Route::PushpullTypeBoth;
@@ -85,25 +85,25 @@ namespace Server { namespace Web
 		vector<Relation*> relationsAtLock;
 		vector<Relation*> relationsAtUnlock;
 		vector<Relation*> relationsConditions;
-		LayoutPosition posx = Utils::Utils::GetIntegerMapEntry(arguments, "posx", 0);
-		LayoutPosition posy = Utils::Utils::GetIntegerMapEntry(arguments, "posy", 0);
-		LayoutPosition posz = Utils::Utils::GetIntegerMapEntry(arguments, "posz", LayerUndeletable);
-		DataModel::LayoutItem::Visible visible = static_cast<Visible>(Utils::Utils::GetBoolMapEntry(arguments, "visible", routeID == RouteNone && ((posx || posy) && posz >= LayerUndeletable) ? DataModel::LayoutItem::VisibleYes : DataModel::LayoutItem::VisibleNo));
-		Automode automode = static_cast<Automode>(Utils::Utils::GetBoolMapEntry(arguments, "automode", AutomodeNo));
-		TrackID fromTrack = static_cast<TrackID>(Utils::Utils::GetIntegerMapEntry(arguments, "fromtrack", TrackNone));
-		Orientation fromOrientation = static_cast<Orientation>(Utils::Utils::GetBoolMapEntry(arguments, "fromorientation", OrientationRight));
-		TrackID toTrack = static_cast<TrackID>(Utils::Utils::GetIntegerMapEntry(arguments, "totrack", TrackNone));
-		Orientation toOrientation = static_cast<Orientation>(Utils::Utils::GetBoolMapEntry(arguments, "toorientation", OrientationRight));
-		Route::Speed speed = static_cast<Route::Speed>(Utils::Utils::GetIntegerMapEntry(arguments, "speed", Route::SpeedTravel));
-		FeedbackID feedbackIdReduced = Utils::Utils::GetIntegerMapEntry(arguments, "feedbackreduced", FeedbackNone);
-		Delay reducedDelay = Utils::Utils::GetIntegerMapEntry(arguments, "reduceddelay", 0);
-		FeedbackID feedbackIdCreep = Utils::Utils::GetIntegerMapEntry(arguments, "feedbackcreep", FeedbackNone);
-		Delay creepDelay = Utils::Utils::GetIntegerMapEntry(arguments, "creepdelay", 0);
-		FeedbackID feedbackIdStop = Utils::Utils::GetIntegerMapEntry(arguments, "feedbackstop", FeedbackNone);
-		Delay stopDelay = Utils::Utils::GetIntegerMapEntry(arguments, "stopdelay", 0);
-		FeedbackID feedbackIdOver = Utils::Utils::GetIntegerMapEntry(arguments, "feedbackover", FeedbackNone);
-		Pause waitAfterRelease = Utils::Utils::GetIntegerMapEntry(arguments, "waitafterrelease", 0);
-		RouteID followUpRoute = Utils::Utils::GetIntegerMapEntry(arguments, "followuproute", RouteNone);
+		LayoutPosition posx = arguments.GetInteger("posx", 0);
+		LayoutPosition posy = arguments.GetInteger("posy", 0);
+		LayoutPosition posz = arguments.GetInteger("posz", LayerUndeletable);
+		DataModel::LayoutItem::Visible visible = static_cast<Visible>(arguments.GetBool("visible", routeID == RouteNone && ((posx || posy) && posz >= LayerUndeletable) ? DataModel::LayoutItem::VisibleYes : DataModel::LayoutItem::VisibleNo));
+		Automode automode = static_cast<Automode>(arguments.GetBool("automode", AutomodeNo));
+		TrackID fromTrack = static_cast<TrackID>(arguments.GetInteger("fromtrack", TrackNone));
+		Orientation fromOrientation = static_cast<Orientation>(arguments.GetBool("fromorientation", OrientationRight));
+		TrackID toTrack = static_cast<TrackID>(arguments.GetInteger("totrack", TrackNone));
+		Orientation toOrientation = static_cast<Orientation>(arguments.GetBool("toorientation", OrientationRight));
+		Route::Speed speed = static_cast<Route::Speed>(arguments.GetInteger("speed", Route::SpeedTravel));
+		FeedbackID feedbackIdReduced = arguments.GetInteger("feedbackreduced", FeedbackNone);
+		Delay reducedDelay = arguments.GetInteger("reduceddelay", 0);
+		FeedbackID feedbackIdCreep = arguments.GetInteger("feedbackcreep", FeedbackNone);
+		Delay creepDelay = arguments.GetInteger("creepdelay", 0);
+		FeedbackID feedbackIdStop = arguments.GetInteger("feedbackstop", FeedbackNone);
+		Delay stopDelay = arguments.GetInteger("stopdelay", 0);
+		FeedbackID feedbackIdOver = arguments.GetInteger("feedbackover", FeedbackNone);
+		Pause waitAfterRelease = arguments.GetInteger("waitafterrelease", 0);
+		RouteID followUpRoute = arguments.GetInteger("followuproute", RouteNone);
 		if (routeID > RouteNone)
 		{
 			const DataModel::Route* route = manager.GetRoute(routeID);
@@ -328,55 +328,55 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(content);
 	}
 
-	void WebClientRoute::HandleRouteSave(const map<string, string>& arguments)
+	void WebClientRoute::HandleRouteSave(const HttpRequest::Arguments& arguments)
 	{
-		const RouteID routeID = Utils::Utils::GetIntegerMapEntry(arguments, "route", RouteNone);
-		const string name = Utils::Utils::GetStringMapEntry(arguments, "name");
-		const Delay delay = static_cast<Delay>(Utils::Utils::GetIntegerMapEntry(arguments, "delay"));
-		const Route::PushpullType pushpull = static_cast<Route::PushpullType>(Utils::Utils::GetIntegerMapEntry(arguments, "pushpull", Route::PushpullTypeBoth));
-		Propulsion propulsion = static_cast<Propulsion>(Utils::Utils::GetIntegerMapEntry(arguments, "propulsion", PropulsionAll));
+		const RouteID routeID = arguments.GetInteger("route", RouteNone);
+		const string name = arguments.GetString("name");
+		const Delay delay = static_cast<Delay>(arguments.GetInteger("delay"));
+		const Route::PushpullType pushpull = static_cast<Route::PushpullType>(arguments.GetInteger("pushpull", Route::PushpullTypeBoth));
+		Propulsion propulsion = static_cast<Propulsion>(arguments.GetInteger("propulsion", PropulsionAll));
 		if (propulsion == PropulsionUnknown)
 		{
 			propulsion = PropulsionAll;
 		}
-		TrainType trainType = static_cast<TrainType>(Utils::Utils::GetIntegerMapEntry(arguments, "traintype", TrainTypeAll));
+		TrainType trainType = static_cast<TrainType>(arguments.GetInteger("traintype", TrainTypeAll));
 		if (trainType == TrainTypeUnknown)
 		{
 			trainType = TrainTypeAll;
 		}
-		const Length mintrainlength = static_cast<Length>(Utils::Utils::GetIntegerMapEntry(arguments, "mintrainlength", 0));
-		const Length maxtrainlength = static_cast<Length>(Utils::Utils::GetIntegerMapEntry(arguments, "maxtrainlength", 0));
-		const Visible visible = static_cast<Visible>(Utils::Utils::GetBoolMapEntry(arguments, "visible"));
-		const LayoutPosition posx = Utils::Utils::GetIntegerMapEntry(arguments, "posx", 0);
-		const LayoutPosition posy = Utils::Utils::GetIntegerMapEntry(arguments, "posy", 0);
-		const LayoutPosition posz = Utils::Utils::GetIntegerMapEntry(arguments, "posz", 0);
-		const Automode automode = static_cast<Automode>(Utils::Utils::GetBoolMapEntry(arguments, "automode"));
-		const TrackID fromTrack = static_cast<TrackID>(Utils::Utils::GetIntegerMapEntry(arguments, "fromtrack", TrackNone));
-		const Orientation fromOrientation = static_cast<Orientation>(Utils::Utils::GetBoolMapEntry(arguments, "fromorientation", OrientationRight));
-		const TrackID toTrack = static_cast<TrackID>(Utils::Utils::GetIntegerMapEntry(arguments, "totrack", TrackNone));
-		const Orientation toOrientation = static_cast<Orientation>(Utils::Utils::GetBoolMapEntry(arguments, "toorientation", OrientationRight));
-		const Route::Speed speed = static_cast<Route::Speed>(Utils::Utils::GetIntegerMapEntry(arguments, "speed", Route::SpeedTravel));
-		const FeedbackID feedbackIdReduced = Utils::Utils::GetIntegerMapEntry(arguments, "feedbackreduced", FeedbackNone);
-		const Delay reducedDelay = Utils::Utils::GetIntegerMapEntry(arguments, "reduceddelay", 0);
-		const FeedbackID feedbackIdCreep = Utils::Utils::GetIntegerMapEntry(arguments, "feedbackcreep", FeedbackNone);
-		const Delay creepDelay = Utils::Utils::GetIntegerMapEntry(arguments, "creepdelay", 0);
-		const FeedbackID feedbackIdStop = Utils::Utils::GetIntegerMapEntry(arguments, "feedbackstop", FeedbackNone);
-		const Delay stopDelay = Utils::Utils::GetIntegerMapEntry(arguments, "stopdelay", 0);
-		const FeedbackID feedbackIdOver = Utils::Utils::GetIntegerMapEntry(arguments, "feedbackover", FeedbackNone);
-		const Pause waitAfterRelease = Utils::Utils::GetIntegerMapEntry(arguments, "waitafterrelease", 0);
-		const RouteID followUpRoute = Utils::Utils::GetIntegerMapEntry(arguments, "followuproute", RouteNone);
-
-		Priority relationCountAtLock = Utils::Utils::GetIntegerMapEntry(arguments, "relationcounteratlock", 0);
-		Priority relationCountAtUnlock = Utils::Utils::GetIntegerMapEntry(arguments, "relationcounteratunlock", 0);
-		Priority relationCounterConditions = Utils::Utils::GetIntegerMapEntry(arguments, "relationcounterconditions", 0);
+		const Length mintrainlength = static_cast<Length>(arguments.GetInteger("mintrainlength", 0));
+		const Length maxtrainlength = static_cast<Length>(arguments.GetInteger("maxtrainlength", 0));
+		const Visible visible = static_cast<Visible>(arguments.GetBool("visible"));
+		const LayoutPosition posx = arguments.GetInteger("posx", 0);
+		const LayoutPosition posy = arguments.GetInteger("posy", 0);
+		const LayoutPosition posz = arguments.GetInteger("posz", 0);
+		const Automode automode = static_cast<Automode>(arguments.GetBool("automode"));
+		const TrackID fromTrack = static_cast<TrackID>(arguments.GetInteger("fromtrack", TrackNone));
+		const Orientation fromOrientation = static_cast<Orientation>(arguments.GetBool("fromorientation", OrientationRight));
+		const TrackID toTrack = static_cast<TrackID>(arguments.GetInteger("totrack", TrackNone));
+		const Orientation toOrientation = static_cast<Orientation>(arguments.GetBool("toorientation", OrientationRight));
+		const Route::Speed speed = static_cast<Route::Speed>(arguments.GetInteger("speed", Route::SpeedTravel));
+		const FeedbackID feedbackIdReduced = arguments.GetInteger("feedbackreduced", FeedbackNone);
+		const Delay reducedDelay = arguments.GetInteger("reduceddelay", 0);
+		const FeedbackID feedbackIdCreep = arguments.GetInteger("feedbackcreep", FeedbackNone);
+		const Delay creepDelay = arguments.GetInteger("creepdelay", 0);
+		const FeedbackID feedbackIdStop = arguments.GetInteger("feedbackstop", FeedbackNone);
+		const Delay stopDelay = arguments.GetInteger("stopdelay", 0);
+		const FeedbackID feedbackIdOver = arguments.GetInteger("feedbackover", FeedbackNone);
+		const Pause waitAfterRelease = arguments.GetInteger("waitafterrelease", 0);
+		const RouteID followUpRoute = arguments.GetInteger("followuproute", RouteNone);
+
+		Priority relationCountAtLock = arguments.GetInteger("relationcounteratlock", 0);
+		Priority relationCountAtUnlock = arguments.GetInteger("relationcounteratunlock", 0);
+		Priority relationCounterConditions = arguments.GetInteger("relationcounterconditions", 0);
 
 		vector<Relation*> relationsAtLock;
 		Priority priorityAtLock = 1;
 		for (Priority relationId = 1; relationId <= relationCountAtLock; ++relationId)
 		{
 			string priorityString = to_string(relationId);
-			ObjectType objectType = static_cast<ObjectType>(Utils::Utils::GetIntegerMapEntry(arguments, "relation_atlock_" + priorityString + "_type"));
-			ObjectID objectId = Utils::Utils::GetIntegerMapEntry(arguments, "relation_atlock_" + priorityString + "_id", ObjectNone);
+			ObjectType objectType = static_cast<ObjectType>(arguments.GetInteger("relation_atlock_" + priorityString + "_type"));
+			ObjectID objectId = arguments.GetInteger("relation_atlock_" + priorityString + "_id", ObjectNone);
 			if (objectId == 0
 				&& objectType != ObjectTypeLoco
 				&& objectType != ObjectTypePause
@@ -393,7 +393,7 @@ namespace Server { namespace Web
 			{
 				continue;
 			}
-			unsigned short state = Utils::Utils::GetIntegerMapEntry(arguments, "relation_atlock_" + priorityString + "_state");
+			unsigned short state = arguments.GetInteger("relation_atlock_" + priorityString + "_state");
 			relationsAtLock.push_back(new Relation(&manager,
 				ObjectIdentifier(ObjectTypeRoute, routeID),
 				ObjectIdentifier(objectType, objectId),
@@ -408,8 +408,8 @@ namespace Server { namespace Web
 		for (Priority relationId = 1; relationId <= relationCountAtUnlock; ++relationId)
 		{
 			string priorityString = to_string(relationId);
-			ObjectType objectType = static_cast<ObjectType>(Utils::Utils::GetIntegerMapEntry(arguments, "relation_atunlock_" + priorityString + "_type"));
-			ObjectID objectId = Utils::Utils::GetIntegerMapEntry(arguments, "relation_atunlock_" + priorityString + "_id", ObjectNone);
+			ObjectType objectType = static_cast<ObjectType>(arguments.GetInteger("relation_atunlock_" + priorityString + "_type"));
+			ObjectID objectId = arguments.GetInteger("relation_atunlock_" + priorityString + "_id", ObjectNone);
 			if (objectId == 0
 				&& objectType != ObjectTypeLoco
 				&& objectType != ObjectTypePause
@@ -426,7 +426,7 @@ namespace Server { namespace Web
 			{
 				continue;
 			}
-			unsigned char state = Utils::Utils::GetIntegerMapEntry(arguments, "relation_atunlock_" + priorityString + "_state");
+			unsigned char state = arguments.GetInteger("relation_atunlock_" + priorityString + "_state");
 			relationsAtUnlock.push_back(new Relation(&manager,
 				ObjectIdentifier(ObjectTypeRoute, routeID),
 				ObjectIdentifier(objectType, objectId),
@@ -441,8 +441,8 @@ namespace Server { namespace Web
 		for (Priority relationId = 1; relationId <= relationCounterConditions; ++relationId)
 		{
 			string priorityString = to_string(relationId);
-			ObjectType objectType = static_cast<ObjectType>(Utils::Utils::GetIntegerMapEntry(arguments, "relation_conditions_" + priorityString + "_type"));
-			ObjectID objectId = Utils::Utils::GetIntegerMapEntry(arguments, "relation_conditions_" + priorityString + "_id", ObjectNone);
+			ObjectType objectType = static_cast<ObjectType>(arguments.GetInteger("relation_conditions_" + priorityString + "_type"));
+			ObjectID objectId = arguments.GetInteger("relation_conditions_" + priorityString + "_id", ObjectNone);
 			if (objectId == 0
 				&& objectType != ObjectTypeLoco
 				&& objectType != ObjectTypePause
@@ -459,7 +459,7 @@ namespace Server { namespace Web
 			{
 				continue;
 			}
-			unsigned char state = Utils::Utils::GetIntegerMapEntry(arguments, "relation_conditions_" + priorityString + "_state");
+			unsigned char state = arguments.GetInteger("relation_conditions_" + priorityString + "_state");
 			conditions.push_back(new Relation(&manager,
 				ObjectIdentifier(ObjectTypeRoute, routeID),
 				ObjectIdentifier(objectType, objectId),
@@ -508,9 +508,9 @@ namespace Server { namespace Web
 		client.ReplyResponse(client.ResponseInfo, Languages::TextRouteSaved, name);
 	}
 
-	void WebClientRoute::HandleRouteAskDelete(const map<string, string>& arguments)
+	void WebClientRoute::HandleRouteAskDelete(const HttpRequest::Arguments& arguments)
 	{
-		RouteID routeID = Utils::Utils::GetIntegerMapEntry(arguments, "route", RouteNone);
+		RouteID routeID = arguments.GetInteger("route", RouteNone);
 
 		if (routeID == RouteNone)
 		{
@@ -538,9 +538,9 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(content);
 	}
 
-	void WebClientRoute::HandleRouteDelete(const map<string, string>& arguments)
+	void WebClientRoute::HandleRouteDelete(const HttpRequest::Arguments& arguments)
 	{
-		RouteID routeID = Utils::Utils::GetIntegerMapEntry(arguments, "route", RouteNone);
+		RouteID routeID = arguments.GetInteger("route", RouteNone);
 		const DataModel::Route* route = manager.GetRoute(routeID);
 		if (route == nullptr)
 		{
@@ -586,24 +586,24 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(content);
 	}
 
-	void WebClientRoute::HandleRouteExecute(const map<string, string>& arguments)
+	void WebClientRoute::HandleRouteExecute(const HttpRequest::Arguments& arguments)
 	{
-		RouteID routeID = Utils::Utils::GetIntegerMapEntry(arguments, "route", RouteNone);
+		RouteID routeID = arguments.GetInteger("route", RouteNone);
 		manager.RouteExecuteAsync(logger, routeID);
 		client.ReplyHtmlWithHeaderAndParagraph("Route executed");
 	}
 
-	void WebClientRoute::HandleRouteRelease(const map<string, string>& arguments)
+	void WebClientRoute::HandleRouteRelease(const HttpRequest::Arguments& arguments)
 	{
-		RouteID routeID = Utils::Utils::GetIntegerMapEntry(arguments, "route");
+		RouteID routeID = arguments.GetInteger("route");
 		bool ret = manager.RouteRelease(routeID);
 		client.ReplyHtmlWithHeaderAndParagraph(ret ? "Route released" : "Route not released");
 	}
 
-	void WebClientRoute::HandleRelationAdd(const map<string, string>& arguments)
+	void WebClientRoute::HandleRelationAdd(const HttpRequest::Arguments& arguments)
 	{
-		string priorityString = Utils::Utils::GetStringMapEntry(arguments, "priority", "1");
-		string type = Utils::Utils::GetStringMapEntry(arguments, "type", "atlock");
+		string priorityString = arguments.GetString("priority", "1");
+		string type = arguments.GetString("type", "atlock");
 		if ((type.compare("atunlock") != 0)
 			&& (type.compare("conditions") != 0))
 		{
@@ -616,20 +616,20 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(container);
 	}
 
-	void WebClientRoute::HandleRelationObject(const map<string, string>& arguments)
+	void WebClientRoute::HandleRelationObject(const HttpRequest::Arguments& arguments)
 	{
-		const string priority = Utils::Utils::GetStringMapEntry(arguments, "priority");
-		const string atlock = Utils::Utils::GetStringMapEntry(arguments, "atlock");
-		const ObjectType objectType = static_cast<ObjectType>(Utils::Utils::GetIntegerMapEntry(arguments, "objecttype"));
-		const ObjectID id = static_cast<ObjectID>(Utils::Utils::GetIntegerMapEntry(arguments, "id"));
-		const DataModel::Relation::Data state = static_cast<DataModel::Relation::Data>(Utils::Utils::GetIntegerMapEntry(arguments, "state"));
+		const string priority = arguments.GetString("priority");
+		const string atlock = arguments.GetString("atlock");
+		const ObjectType objectType = static_cast<ObjectType>(arguments.GetInteger("objecttype"));
+		const ObjectID id = static_cast<ObjectID>(arguments.GetInteger("id"));
+		const DataModel::Relation::Data state = static_cast<DataModel::Relation::Data>(arguments.GetInteger("state"));
 		client.ReplyHtmlWithHeader(HtmlTagRelationObject(atlock, priority, objectType, id, state));
 	}
 
-	void WebClientRoute::HandleRelationSwitchStates(const map<string, string>& arguments)
+	void WebClientRoute::HandleRelationSwitchStates(const HttpRequest::Arguments& arguments)
 	{
-		const string name = Utils::Utils::GetStringMapEntry(arguments, "name");
-		const SwitchID switchId = static_cast<SwitchID>(Utils::Utils::GetIntegerMapEntry(arguments, "switch"));
+		const string name = arguments.GetString("name");
+		const SwitchID switchId = static_cast<SwitchID>(arguments.GetInteger("switch"));
 		client.ReplyHtmlWithHeader(HtmlTagRelationSwitchState(name, switchId));
 	}
 
@@ -1102,9 +1102,9 @@ namespace Server { namespace Web
 		return tag;
 	}
 
-	void WebClientRoute::HandleFeedbacksOfTrack(const map<string, string>& arguments)
+	void WebClientRoute::HandleFeedbacksOfTrack(const HttpRequest::Arguments& arguments)
 	{
-		const TrackID trackID = static_cast<TrackID>(Utils::Utils::GetIntegerMapEntry(arguments, "track", TrackNone));
+		const TrackID trackID = static_cast<TrackID>(arguments.GetInteger("track", TrackNone));
 		client.ReplyHtmlWithHeader(HtmlTagSelectFeedbacksOfTrack(trackID));
 	}
 }} // namespace Server::Web
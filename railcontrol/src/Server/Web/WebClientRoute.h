@@ -42,18 +42,18 @@ namespace Server { namespace Web
 			{
 			}
 
-			void HandleRouteEdit(const std::map<std::string,std::string>& arguments);
-			void HandleRouteSave(const std::map<std::string,std::string>& arguments);
+			void HandleRouteEdit(const HttpRequest::Arguments& arguments);
+			void HandleRouteSave(const HttpRequest::Arguments& arguments);
 			void HandleRouteList();
-			void HandleRouteAskDelete(const std::map<std::string,std::string>& arguments);
-			void HandleRouteDelete(const std::map<std::string,std::string>& arguments);
-			void HandleRouteGet(const std::map<std::string,std::string>& arguments);
-			void HandleRouteExecute(const std::map<std::string,std::string>& arguments);
-			void HandleRouteRelease(const std::map<std::string,std::string>& arguments);
-			void HandleRelationAdd(const std::map<std::string,std::string>& arguments);
-			void HandleRelationObject(const std::map<std::string, std::string>& arguments);
-			void HandleRelationSwitchStates(const std::map<std::string,std::string>& arguments);
-			void HandleFeedbacksOfTrack(const std::map<std::string,std::string>& arguments);
+			void HandleRouteAskDelete(const HttpRequest::Arguments& arguments);
+			void HandleRouteDelete(const HttpRequest::Arguments& arguments);
+			void HandleRouteGet(const HttpRequest::Arguments& arguments);
+			void HandleRouteExecute(const HttpRequest::Arguments& arguments);
+			void HandleRouteRelease(const HttpRequest::Arguments& arguments);
+			void HandleRelationAdd(const HttpRequest::Arguments& arguments);
+			void HandleRelationObject(const HttpRequest::Arguments& arguments);
+			void HandleRelationSwitchStates(const HttpRequest::Arguments& arguments);
+			void HandleFeedbacksOfTrack(const HttpRequest::Arguments& arguments);
 
 		private:
 			HtmlTag HtmlTagRelation(const std::string& atlock,
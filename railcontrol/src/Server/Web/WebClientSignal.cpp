@@ -52,24 +52,24 @@ using std::vector;
 
 namespace Server { namespace Web
 {
-	void WebClientSignal::HandleSignalEdit(const map<string, string>& arguments)
+	void WebClientSignal::HandleSignalEdit(const HttpRequest::Arguments& arguments)
 	{
 		HtmlTag content;
-		SignalID signalID = Utils::Utils::GetIntegerMapEntry(arguments, "signal", SignalNone);
+		SignalID signalID = arguments.GetInteger("signal", SignalNone);
 		ControlID controlId = manager.GetPossibleControlForAccessory();
 		if (controlId == ControlNone)
 		{
 			controlId = manager.GetPossibleControlForAccessory();
 		}
-		string matchKey = Utils::Utils::GetStringMapEntry(arguments, "matchkey");
+		string matchKey = arguments.GetString("matchkey");
 		Protocol protocol = ProtocolNone;
 		Address address = AddressDefault;
 		Address serverAddress = AddressNone;
 		string name = Languages::GetText(Languages::TextNew);
-		LayoutPosition posx = Utils::Utils::GetIntegerMapEntry(arguments, "posx", 0);
-		LayoutPosition posy = Utils::Utils::GetIntegerMapEntry(arguments, "posy", 0);
-		LayoutPosition posz = Utils::Utils::GetIntegerMapEntry(arguments, "posz", LayerUndeletable);
-		LayoutRotation rotation = Utils::Utils::GetIntegerMapEntry(arguments, "rotation", DataModel::LayoutItem::Rotation90);
+		LayoutPosition posx = arguments.GetInteger("posx", 0);
+		LayoutPosition posy = arguments.GetInteger("posy", 0);
+		LayoutPosition posz = arguments.GetInteger("posz", LayerUndeletable);
+		LayoutRotation rotation = arguments.GetInteger("rotation", DataModel::LayoutItem::Rotation90);
 		DataModel::AccessoryType signalType = DataModel::SignalTypeSimpleLeft;
 		DataModel::AccessoryPulseDuration duration = manager.GetDefaultAccessoryDuration();
 		bool inverted = false;
@@ -163,11 +163,11 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(content);
 	}
 
-	void WebClientSignal::HandleSignalAddresses(const map<string, string>& arguments)
+	void WebClientSignal::HandleSignalAddresses(const HttpRequest::Arguments& arguments)
 	{
 		Signal signalDummy(&manager, SignalNone);
-		AccessoryType type = static_cast<AccessoryType>(Utils::Utils::GetIntegerMapEntry(arguments, "type"));
-		SignalID signalId = Utils::Utils::GetIntegerMapEntry(arguments, "signal", SignalNone);
+		AccessoryType type = static_cast<AccessoryType>(arguments.GetInteger("type"));
+		SignalID signalId = arguments.GetInteger("signal", SignalNone);
 		Signal* signal = manager.GetSignal(signalId);
 		if (signal == nullptr || signal->GetAccessoryType() != type)
 		{
@@ -175,7 +175,7 @@ namespace Server { namespace Web
 			signal = &signalDummy;
 		}
 
-		Address address = Utils::Utils::GetIntegerMapEntry(arguments, "address", AddressNone);
+		Address address = arguments.GetInteger("address", AddressNone);
 
 		const std::map<DataModel::AccessoryState,DataModel::Signal::StateOption> stateOptions = signal->GetStateOptions();
 
@@ -199,32 +199,32 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(addressContent);
 	}
 
-	void WebClientSignal::HandleSignalSave(const map<string, string>& arguments)
+	void WebClientSignal::HandleSignalSave(const HttpRequest::Arguments& arguments)
 	{
-		const SignalID signalID = Utils::Utils::GetIntegerMapEntry(arguments, "signal", SignalNone);
-		const string name = Utils::Utils::GetStringMapEntry(arguments, "name");
-		const ControlID controlId = Utils::Utils::GetIntegerMapEntry(arguments, "control", ControlIdNone);
-		const string matchKey = Utils::Utils::GetStringMapEntry(arguments, "matchkey");
-		const Protocol protocol = static_cast<Protocol>(Utils::Utils::GetIntegerMapEntry(arguments, "protocol", ProtocolNone));
-		const Address address = Utils::Utils::GetIntegerMapEntry(arguments, "address", AddressDefault);
-		const Address serverAddress = Utils::Utils::GetIntegerMapEntry(arguments, "serveraddress", AddressNone);
-		const LayoutPosition posX = Utils::Utils::GetIntegerMapEntry(arguments, "posx", 0);
-		const LayoutPosition posY = Utils::Utils::GetIntegerMapEntry(arguments, "posy", 0);
-		const LayoutPosition posZ = Utils::Utils::GetIntegerMapEntry(arguments, "posz", 0);
-		const LayoutItemSize height = Utils::Utils::GetIntegerMapEntry(arguments, "length", 1);
-		const LayoutRotation rotation = Utils::Utils::GetIntegerMapEntry(arguments, "rotation", DataModel::LayoutItem::Rotation90);
-		const DataModel::AccessoryType signalType = static_cast<DataModel::AccessoryType>(Utils::Utils::GetIntegerMapEntry(arguments, "signaltype", DataModel::SignalTypeSimpleLeft));
+		const SignalID signalID = arguments.GetInteger("signal", SignalNone);
+		const string name = arguments.GetString("name");
+		const ControlID controlId = arguments.GetInteger("control", ControlIdNone);
+		const string matchKey = arguments.GetString("matchkey");
+		const Protocol protocol = static_cast<Protocol>(arguments.GetInteger("protocol", ProtocolNone));
+		const Address address = arguments.GetInteger("address", AddressDefault);
+		const Address serverAddress = arguments.GetInteger("serveraddress", AddressNone);
+		const LayoutPosition posX = arguments.GetInteger("posx", 0);
+		const LayoutPosition posY = arguments.GetInteger("posy", 0);
+		const LayoutPosition posZ = arguments.GetInteger("posz", 0);
+		const LayoutItemSize height = arguments.GetInteger("length", 1);
+		const LayoutRotation rotation = arguments.GetInteger("rotation", DataModel::LayoutItem::Rotation90);
+		const DataModel::AccessoryType signalType = static_cast<DataModel::AccessoryType>(arguments.GetInteger("signaltype", DataModel::SignalTypeSimpleLeft));
 		std::map<AccessoryState,AddressOffset> offsets;
 		for (AddressOffset offset = 0; offset <= SignalStateMax; ++offset)
 		{
-			const AddressOffset address = Utils::Utils::GetIntegerMapEntry(arguments, "address" + to_string(offset), -1);
+			const AddressOffset address = arguments.GetInteger("address" + to_string(offset), -1);
 			if (address >= 0)
 			{
 				offsets[static_cast<AccessoryState>(offset)] = address;
 			}
 		}
-		const DataModel::AccessoryPulseDuration duration = Utils::Utils::GetIntegerMapEntry(arguments, "duration", manager.GetDefaultAccessoryDuration());
-		const bool inverted = Utils::Utils::GetBoolMapEntry(arguments, "inverted");
+		const DataModel::AccessoryPulseDuration duration = arguments.GetInteger("duration", manager.GetDefaultAccessoryDuration());
+		const bool inverted = arguments.GetBool("inverted");
 		string result;
 		if (!manager.SignalSave(signalID,
 			name,
@@ -251,10 +251,10 @@ namespace Server { namespace Web
 		client.ReplyResponse(WebClient::ResponseInfo, Languages::TextSignalSaved, name);
 	}
 
-	void WebClientSignal::HandleSignalState(const map<string, string>& arguments)
+	void WebClientSignal::HandleSignalState(const HttpRequest::Arguments& arguments)
 	{
-		SignalID signalID = Utils::Utils::GetIntegerMapEntry(arguments, "signal", SignalNone);
-		string signalStateText = Utils::Utils::GetStringMapEntry(arguments, "state", "stop");
+		SignalID signalID = arguments.GetInteger("signal", SignalNone);
+		string signalStateText = arguments.GetString("state", "stop");
 		DataModel::AccessoryState signalState = DataModel::SignalStateStop;
 		if (signalStateText.compare("clear") == 0)
 		{
@@ -390,9 +390,9 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(content);
 	}
 
-	void WebClientSignal::HandleSignalAskDelete(const map<string, string>& arguments)
+	void WebClientSignal::HandleSignalAskDelete(const HttpRequest::Arguments& arguments)
 	{
-		SignalID signalID = Utils::Utils::GetIntegerMapEntry(arguments, "signal", SignalNone);
+		SignalID signalID = arguments.GetInteger("signal", SignalNone);
 
 		if (signalID == SignalNone)
 		{
@@ -420,9 +420,9 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(content);
 	}
 
-	void WebClientSignal::HandleSignalDelete(const map<string, string>& arguments)
+	void WebClientSignal::HandleSignalDelete(const HttpRequest::Arguments& arguments)
 	{
-		SignalID signalID = Utils::Utils::GetIntegerMapEntry(arguments, "signal", SignalNone);
+		SignalID signalID = arguments.GetInteger("signal", SignalNone);
 		const DataModel::Signal* signal = manager.GetSignal(signalID);
 		if (signal == nullptr)
 		{
@@ -441,9 +441,9 @@ namespace Server { namespace Web
 		client.ReplyResponse(WebClient::ResponseInfo, Languages::TextSignalDeleted, name);
 	}
 
-	void WebClientSignal::HandleSignalGet(const map<string, string>& arguments)
+	void WebClientSignal::HandleSignalGet(const HttpRequest::Arguments& arguments)
 	{
-		SignalID signalID = Utils::Utils::GetIntegerMapEntry(arguments, "signal");
+		SignalID signalID = arguments.GetInteger("signal");
 		const DataModel::Signal* signal = manager.GetSignal(signalID);
 		if (signal == nullptr)
 		{
@@ -453,17 +453,17 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(HtmlTagSignal(manager, signal));
 	}
 
-	void WebClientSignal::HandleSignalRelease(const map<string, string>& arguments)
+	void WebClientSignal::HandleSignalRelease(const HttpRequest::Arguments& arguments)
 	{
-		const SignalID signalID = static_cast<SignalID>(Utils::Utils::GetIntegerMapEntry(arguments, "signal"));
+		const SignalID signalID = static_cast<SignalID>(arguments.GetInteger("signal"));
 		const bool ret = manager.SignalRelease(signalID);
 		client.ReplyHtmlWithHeaderAndParagraph(ret ? "Signal released" : "Signal not released");
 	}
 
-	void WebClientSignal::HandleSignalStates(const map<string, string>& arguments)
+	void WebClientSignal::HandleSignalStates(const HttpRequest::Arguments& arguments)
 	{
-		const string name = Utils::Utils::GetStringMapEntry(arguments, "name");
-		const SignalID signalId = static_cast<SignalID>(Utils::Utils::GetIntegerMapEntry(arguments, "signal"));
+		const string name = arguments.GetString("name");
+		const SignalID signalId = static_cast<SignalID>(arguments.GetInteger("signal"));
 		client.ReplyHtmlWithHeader(client.HtmlTagRelationSignalState(name, signalId));
 	}
 }} // namespace Server::Web
@@ -25,6 +25,7 @@ along with RailControl; see the file LICENCE. If not see
 
 #include "Logger/Logger.h"
 #include "Manager.h"
+#include "Server/Web/HttpRequest.h"
 
 namespace Server { namespace Web
 {
@@ -44,17 +45,17 @@ namespace Server { namespace Web
 			{
 			}
 
-			void HandleSignalEdit(const std::map<std::string,std::string>& arguments);
-			void HandleSignalSave(const std::map<std::string,std::string>& arguments);
+			void HandleSignalEdit(const HttpRequest::Arguments& arguments);
+			void HandleSignalSave(const HttpRequest::Arguments& arguments);
 			void HandleSignalList();
-			void HandleSignalAskDelete(const std::map<std::string,std::string>& arguments);
-			void HandleSignalDelete(const std::map<std::string,std::string>& arguments);
-			void HandleSignalGet(const std::map<std::string, std::string>& arguments);
-			void HandleSignalSetLoco(const std::map<std::string, std::string>& arguments);
-			void HandleSignalRelease(const std::map<std::string, std::string>& arguments);
-			void HandleSignalState(const std::map<std::string, std::string>& arguments);
-			void HandleSignalStates(const std::map<std::string, std::string>& arguments);
-			void HandleSignalAddresses(const std::map<std::string, std::string>& arguments);
+			void HandleSignalAskDelete(const HttpRequest::Arguments& arguments);
+			void HandleSignalDelete(const HttpRequest::Arguments& arguments);
+			void HandleSignalGet(const HttpRequest::Arguments& arguments);
+			void HandleSignalSetLoco(const HttpRequest::Arguments& arguments);
+			void HandleSignalRelease(const HttpRequest::Arguments& arguments);
+			void HandleSignalState(const HttpRequest::Arguments& arguments);
+			void HandleSignalStates(const HttpRequest::Arguments& arguments);
+			void HandleSignalAddresses(const HttpRequest::Arguments& arguments);
 
 		private:
 			Manager& manager;
@@ -87,6 +87,13 @@ namespace Server { namespace Web
 				return HtmlTagSelectWithLabel(argumentNumber, argumentName, mainSecondaryOptions, value);
 			}
 
+			case ArgumentTypeSimulationSpeed:
+			{
+				argumentName = Languages::TextSimulationSpeed;
+				const int valueInteger = Utils::Integer::StringToInteger(value, 1, 1000);
+				return HtmlTagInputIntegerWithLabel(argumentNumber, argumentName, valueInteger, 1, 1000);
+			}
+
 			default:
 				return HtmlTag();
 		}
@@ -153,6 +160,7 @@ namespace Server { namespace Web
 		hardwareList["Uhlenbrock Intellibox"] = HardwareTypeIntellibox;
 		hardwareList["Uhlenbrock Intellibox II"] = HardwareTypeIntellibox2;
 		hardwareList["Virtual Command Station"] = HardwareTypeVirtual;
+		hardwareList["Virtual Layout Simulator"] = HardwareTypeSimulator;
 		return hardwareList;
 	}
 
@@ -269,6 +277,7 @@ namespace Server { namespace Web
 		options[DataModel::SelectRouteRandom] = Languages::TextRandom;
 		options[DataModel::SelectRouteMinTrackLength] = Languages::TextMinTrackLength;
 		options[DataModel::SelectRouteLongestUnused] = Languages::TextLongestUnused;
+		options[DataModel::SelectRoutePlannedPath] = Languages::TextPlannedPath;
 		return HtmlTagSelectWithLabel("selectrouteapproach", Languages::TextSelectRouteBy, options, selectRouteApproach);
 	}
 
@@ -372,14 +381,14 @@ namespace Server { namespace Web
 		return HtmlTagSelectWithLabel(name, Languages::TextControl, controls, controlIdFirst).AddAttribute("onchange", "loadProgramModeSelector();");
 	}
 
-	vector<ObjectID> WebClientStatic::InterpretSlaveData(const string& prefix, const map<string, string>& arguments)
+	vector<ObjectID> WebClientStatic::InterpretSlaveData(const string& prefix, const HttpRequest::Arguments& arguments)
 	{
 		vector<ObjectID> ids;
-		const unsigned int count = Utils::Utils::GetIntegerMapEntry(arguments, prefix + "counter", 0);
+		const unsigned int count = arguments.GetInteger(prefix + "counter", 0);
 		for (unsigned int index = 1; index <= count; ++index)
 		{
 			const string indexAsString = to_string(index);
-			const ObjectID id = Utils::Utils::GetIntegerMapEntry(arguments, prefix + "_id_" + indexAsString, ObjectNone);
+			const ObjectID id = arguments.GetInteger(prefix + "_id_" + indexAsString, ObjectNone);
 			if (id == ObjectNone)
 			{
 				continue;
@@ -28,6 +28,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "Server/Web/HtmlTag.h"
 #include "Server/Web/HtmlTagInputHidden.h"
 #include "Server/Web/HtmlTagSelectWithLabel.h"
+#include "Server/Web/HttpRequest.h"
 
 namespace Server { namespace Web
 {
@@ -113,7 +114,7 @@ namespace Server { namespace Web
 
 			static const std::map<std::string,HardwareType> ListHardwareNames();
 
-			static std::vector<ObjectID> InterpretSlaveData(const std::string& prefix, const std::map<std::string,std::string>& arguments);
+			static std::vector<ObjectID> InterpretSlaveData(const std::string& prefix, const HttpRequest::Arguments& arguments);
 
 			static HtmlTag HtmlTagTabMenuItem(const std::string& tabName,
 				const Languages::TextSelector buttonValue,
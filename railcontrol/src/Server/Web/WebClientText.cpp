@@ -45,18 +45,18 @@ using std::vector;
 
 namespace Server { namespace Web
 {
-	void WebClientText::HandleTextEdit(const map<string, string>& arguments)
+	void WebClientText::HandleTextEdit(const HttpRequest::Arguments& arguments)
 	{
 		HtmlTag content;
-		TextID textID = Utils::Utils::GetIntegerMapEntry(arguments, "text", TextNone);
+		TextID textID = arguments.GetInteger("text", TextNone);
 		string name = Languages::GetText(Languages::TextNew);
-		LayoutPosition posx = Utils::Utils::GetIntegerMapEntry(arguments, "posx", 0);
-		LayoutPosition posy = Utils::Utils::GetIntegerMapEntry(arguments, "posy", 0);
-		LayoutPosition posz = Utils::Utils::GetIntegerMapEntry(arguments, "posz", LayerUndeletable);
+		LayoutPosition posx = arguments.GetInteger("posx", 0);
+		LayoutPosition posy = arguments.GetInteger("posy", 0);
+		LayoutPosition posz = arguments.GetInteger("posz", LayerUndeletable);
 
-		LayoutItemSize width = Utils::Utils::GetIntegerMapEntry(arguments, "width", 1);
+		LayoutItemSize width = arguments.GetInteger("width", 1);
 
-		LayoutRotation rotation = Utils::Utils::GetIntegerMapEntry(arguments, "rotation", DataModel::LayoutItem::Rotation0);
+		LayoutRotation rotation = arguments.GetInteger("rotation", DataModel::LayoutItem::Rotation0);
 
 		if (textID > TextNone)
 		{
@@ -98,15 +98,15 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(content);
 	}
 
-	void WebClientText::HandleTextSave(const map<string, string>& arguments)
+	void WebClientText::HandleTextSave(const HttpRequest::Arguments& arguments)
 	{
-		TextID textID = Utils::Utils::GetIntegerMapEntry(arguments, "text", TextNone);
-		string name = Utils::Utils::GetStringMapEntry(arguments, "name");
-		LayoutPosition posX = Utils::Utils::GetIntegerMapEntry(arguments, "posx", 0);
-		LayoutPosition posY = Utils::Utils::GetIntegerMapEntry(arguments, "posy", 0);
-		LayoutPosition posZ = Utils::Utils::GetIntegerMapEntry(arguments, "posz", 0);
-		LayoutItemSize width = Utils::Utils::GetIntegerMapEntry(arguments, "width", 1);
-		LayoutRotation rotation = Utils::Utils::GetIntegerMapEntry(arguments, "rotation", DataModel::LayoutItem::Rotation0);
+		TextID textID = arguments.GetInteger("text", TextNone);
+		string name = arguments.GetString("name");
+		LayoutPosition posX = arguments.GetInteger("posx", 0);
+		LayoutPosition posY = arguments.GetInteger("posy", 0);
+		LayoutPosition posZ = arguments.GetInteger("posz", 0);
+		LayoutItemSize width = arguments.GetInteger("width", 1);
+		LayoutRotation rotation = arguments.GetInteger("rotation", DataModel::LayoutItem::Rotation0);
 		string result;
 		if (!manager.TextSave(textID,
 			name,
@@ -147,9 +147,9 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(content);
 	}
 
-	void WebClientText::HandleTextAskDelete(const map<string, string>& arguments)
+	void WebClientText::HandleTextAskDelete(const HttpRequest::Arguments& arguments)
 	{
-		TextID textID = Utils::Utils::GetIntegerMapEntry(arguments, "text", TextNone);
+		TextID textID = arguments.GetInteger("text", TextNone);
 
 		if (textID == TextNone)
 		{
@@ -177,9 +177,9 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(content);
 	}
 
-	void WebClientText::HandleTextDelete(const map<string, string>& arguments)
+	void WebClientText::HandleTextDelete(const HttpRequest::Arguments& arguments)
 	{
-		TextID textID = Utils::Utils::GetIntegerMapEntry(arguments, "text", TextNone);
+		TextID textID = arguments.GetInteger("text", TextNone);
 		const DataModel::Text* text = manager.GetText(textID);
 		if (!text)
 		{
@@ -198,9 +198,9 @@ namespace Server { namespace Web
 		client.ReplyResponse(WebClient::ResponseInfo, Languages::TextTextDeleted, name);
 	}
 
-	void WebClientText::HandleTextGet(const map<string, string>& arguments)
+	void WebClientText::HandleTextGet(const HttpRequest::Arguments& arguments)
 	{
-		TextID textID = Utils::Utils::GetIntegerMapEntry(arguments, "text");
+		TextID textID = arguments.GetInteger("text");
 		const DataModel::Text* text = manager.GetText(textID);
 		if (!text)
 		{
@@ -24,6 +24,7 @@ along with RailControl; see the file LICENCE. If not see
 #include <string>
 
 #include "Manager.h"
+#include "Server/Web/HttpRequest.h"
 
 namespace Server { namespace Web
 {
@@ -42,12 +43,12 @@ namespace Server { namespace Web
 			{
 			}
 
-			void HandleTextEdit(const std::map<std::string,std::string>& arguments);
-			void HandleTextSave(const std::map<std::string,std::string>& arguments);
+			void HandleTextEdit(const HttpRequest::Arguments& arguments);
+			void HandleTextSave(const HttpRequest::Arguments& arguments);
 			void HandleTextList();
-			void HandleTextAskDelete(const std::map<std::string,std::string>& arguments);
-			void HandleTextDelete(const std::map<std::string,std::string>& arguments);
-			void HandleTextGet(const std::map<std::string, std::string>& arguments);
+			void HandleTextAskDelete(const HttpRequest::Arguments& arguments);
+			void HandleTextDelete(const HttpRequest::Arguments& arguments);
+			void HandleTextGet(const HttpRequest::Arguments& arguments);
 
 		private:
 			Manager& manager;
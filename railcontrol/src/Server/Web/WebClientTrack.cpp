@@ -104,26 +104,26 @@ namespace Server { namespace Web
 		return tag;
 	}
 
-	void WebClientTrack::HandleTrackEdit(const map<string, string>& arguments)
+	void WebClientTrack::HandleTrackEdit(const HttpRequest::Arguments& arguments)
 	{
 		HtmlTag content;
-		TrackID trackID = Utils::Utils::GetIntegerMapEntry(arguments, "track", TrackNone);
+		TrackID trackID = arguments.GetInteger("track", TrackNone);
 		string name = Languages::GetText(Languages::TextNew);
 		bool showName = true;
 		string displayName;
-		LayoutPosition posx = Utils::Utils::GetIntegerMapEntry(arguments, "posx", 0);
-		LayoutPosition posy = Utils::Utils::GetIntegerMapEntry(arguments, "posy", 0);
-		LayoutPosition posz = Utils::Utils::GetIntegerMapEntry(arguments, "posz", 0);
-		LayoutItemSize height = Utils::Utils::GetIntegerMapEntry(arguments, "length", DataModel::LayoutItem::Height1);
-		LayoutRotation rotation = Utils::Utils::GetIntegerMapEntry(arguments, "rotation", DataModel::LayoutItem::Rotation90);
+		LayoutPosition posx = arguments.GetInteger("posx", 0);
+		LayoutPosition posy = arguments.GetInteger("posy", 0);
+		LayoutPosition posz = arguments.GetInteger("posz", 0);
+		LayoutItemSize height = arguments.GetInteger("length", DataModel::LayoutItem::Height1);
+		LayoutRotation rotation = arguments.GetInteger("rotation", DataModel::LayoutItem::Rotation90);
 		DataModel::TrackType type = DataModel::TrackTypeStraight;
 		TrackID main = TrackNone;
 		vector<Relation*> feedbacks;
 		vector<Relation*> signals;
 		Cluster* cluster = nullptr;
-		DataModel::SelectRouteApproach selectRouteApproach = static_cast<DataModel::SelectRouteApproach>(Utils::Utils::GetIntegerMapEntry(arguments, "selectrouteapproach", DataModel::SelectRouteSystemDefault));
-		bool allowLocoTurn = Utils::Utils::GetBoolMapEntry(arguments, "allowlocoturn", false);
-		bool releaseWhenFree = Utils::Utils::GetBoolMapEntry(arguments, "releasewhenfree", false);
+		DataModel::SelectRouteApproach selectRouteApproach = static_cast<DataModel::SelectRouteApproach>(arguments.GetInteger("selectrouteapproach", DataModel::SelectRouteSystemDefault));
+		bool allowLocoTurn = arguments.GetBool("allowlocoturn", false);
+		bool releaseWhenFree = arguments.GetBool("releasewhenfree", false);
 		if (trackID > TrackNone)
 		{
 			const DataModel::Track* track = manager.GetTrack(trackID);
@@ -266,19 +266,19 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(content);
 	}
 
-	void WebClientTrack::HandleTrackSave(const map<string, string>& arguments)
+	void WebClientTrack::HandleTrackSave(const HttpRequest::Arguments& arguments)
 	{
-		const TrackID trackId = Utils::Utils::GetIntegerMapEntry(arguments, "track", TrackNone);
-		const string name = Utils::Utils::GetStringMapEntry(arguments, "name");
-		const bool showName = Utils::Utils::GetBoolMapEntry(arguments, "showname", true);
-		const string displayName = Utils::Utils::GetStringMapEntry(arguments, "displayname");
-		const LayoutPosition posX = Utils::Utils::GetIntegerMapEntry(arguments, "posx", 0);
-		const LayoutPosition posY = Utils::Utils::GetIntegerMapEntry(arguments, "posy", 0);
-		const LayoutPosition posZ = Utils::Utils::GetIntegerMapEntry(arguments, "posz", 0);
+		const TrackID trackId = arguments.GetInteger("track", TrackNone);
+		const string name = arguments.GetString("name");
+		const bool showName = arguments.GetBool("showname", true);
+		const string displayName = arguments.GetString("displayname");
+		const LayoutPosition posX = arguments.GetInteger("posx", 0);
+		const LayoutPosition posY = arguments.GetInteger("posy", 0);
+		const LayoutPosition posZ = arguments.GetInteger("posz", 0);
 		LayoutItemSize height;
-		const LayoutRotation rotation = Utils::Utils::GetIntegerMapEntry(arguments, "rotation", DataModel::LayoutItem::Rotation90);
-		const DataModel::TrackType type = static_cast<DataModel::TrackType>(Utils::Utils::GetIntegerMapEntry(arguments, "tracktype", DataModel::TrackTypeStraight));
-		const TrackID main = static_cast<TrackID>(Utils::Utils::GetIntegerMapEntry(arguments, "main", TrackNone));
+		const LayoutRotation rotation = arguments.GetInteger("rotation", DataModel::LayoutItem::Rotation90);
+		const DataModel::TrackType type = static_cast<DataModel::TrackType>(arguments.GetInteger("tracktype", DataModel::TrackTypeStraight));
+		const TrackID main = static_cast<TrackID>(arguments.GetInteger("main", TrackNone));
 		switch (type)
 		{
 			case DataModel::TrackTypeTurn:
@@ -293,7 +293,7 @@ namespace Server { namespace Web
 				break;
 
 			default:
-				height = Utils::Utils::GetIntegerMapEntry(arguments, "length", 1);
+				height = arguments.GetInteger("length", 1);
 				break;
 		}
 
@@ -321,9 +321,9 @@ namespace Server { namespace Web
 			}
 		}
 
-		const DataModel::SelectRouteApproach selectRouteApproach = static_cast<DataModel::SelectRouteApproach>(Utils::Utils::GetIntegerMapEntry(arguments, "selectrouteapproach", DataModel::SelectRouteSystemDefault));
-		const bool allowLocoTurn = Utils::Utils::GetBoolMapEntry(arguments, "allowlocoturn", false);
-		const bool releaseWhenFree = Utils::Utils::GetBoolMapEntry(arguments, "releasewhenfree", false);
+		const DataModel::SelectRouteApproach selectRouteApproach = static_cast<DataModel::SelectRouteApproach>(arguments.GetInteger("selectrouteapproach", DataModel::SelectRouteSystemDefault));
+		const bool allowLocoTurn = arguments.GetBool("allowlocoturn", false);
+		const bool releaseWhenFree = arguments.GetBool("releasewhenfree", false);
 
 		string result;
 		if (!manager.TrackSave(trackId,
@@ -351,9 +351,9 @@ namespace Server { namespace Web
 		client.ReplyResponse(WebClient::ResponseInfo, Languages::TextTrackSaved, name);
 	}
 
-	void WebClientTrack::HandleTrackAskDelete(const map<string, string>& arguments)
+	void WebClientTrack::HandleTrackAskDelete(const HttpRequest::Arguments& arguments)
 	{
-		TrackID trackID = Utils::Utils::GetIntegerMapEntry(arguments, "track", TrackNone);
+		TrackID trackID = arguments.GetInteger("track", TrackNone);
 
 		if (trackID == TrackNone)
 		{
@@ -408,9 +408,9 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(content);
 	}
 
-	void WebClientTrack::HandleTrackDelete(const map<string, string>& arguments)
+	void WebClientTrack::HandleTrackDelete(const HttpRequest::Arguments& arguments)
 	{
-		TrackID trackID = Utils::Utils::GetIntegerMapEntry(arguments, "track", TrackNone);
+		TrackID trackID = arguments.GetInteger("track", TrackNone);
 		const DataModel::Track* track = manager.GetTrack(trackID);
 		if (track == nullptr)
 		{
@@ -429,9 +429,9 @@ namespace Server { namespace Web
 		client.ReplyResponse(WebClient::ResponseInfo, Languages::TextTrackDeleted, name);
 	}
 
-	void WebClientTrack::HandleTrackGet(const map<string, string>& arguments)
+	void WebClientTrack::HandleTrackGet(const HttpRequest::Arguments& arguments)
 	{
-		TrackID trackID = Utils::Utils::GetIntegerMapEntry(arguments, "track");
+		TrackID trackID = arguments.GetInteger("track");
 		const DataModel::Track* track = manager.GetTrack(trackID);
 		if (track == nullptr)
 		{
@@ -441,10 +441,10 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(HtmlTagTrack(manager, track));
 	}
 
-	void WebClientTrack::HandleTrackSetLoco(const map<string, string>& arguments)
+	void WebClientTrack::HandleTrackSetLoco(const HttpRequest::Arguments& arguments)
 	{
 		HtmlTag content;
-		const TrackID trackID = static_cast<TrackID>(Utils::Utils::GetIntegerMapEntry(arguments, "track", TrackNone));
+		const TrackID trackID = static_cast<TrackID>(arguments.GetInteger("track", TrackNone));
 		Track* track = manager.GetTrack(trackID);
 		if (track == nullptr)
 		{
@@ -459,7 +459,7 @@ namespace Server { namespace Web
 			return;
 		}
 
-		const LocoID locoID = Utils::Utils::GetIntegerMapEntry(arguments, "loco", LocoNone);
+		const LocoID locoID = arguments.GetInteger("loco", LocoNone);
 		const ObjectIdentifier locoBaseIdentifier(WebClientStatic::LocoIdToObjectIdentifier(locoID));
 		if (locoBaseIdentifier.IsSet())
 		{
@@ -481,39 +481,39 @@ namespace Server { namespace Web
 		client.ReplyHtmlWithHeader(HtmlTag("form").AddId("editform").AddChildTag(content));
 	}
 
-	void WebClientTrack::HandleTrackRelease(const map<string, string>& arguments)
+	void WebClientTrack::HandleTrackRelease(const HttpRequest::Arguments& arguments)
 	{
-		const TrackID trackID = static_cast<TrackID>(Utils::Utils::GetIntegerMapEntry(arguments, "track", TrackNone));
+		const TrackID trackID = static_cast<TrackID>(arguments.GetInteger("track", TrackNone));
 		bool ret = manager.TrackRelease(trackID);
 		client.ReplyHtmlWithHeaderAndParagraph(ret ? "Track released" : "Track not released");
 	}
 
-	void WebClientTrack::HandleTrackStartLoco(const map<string, string>& arguments)
+	void WebClientTrack::HandleTrackStartLoco(const HttpRequest::Arguments& arguments)
 	{
-		const TrackID trackID = static_cast<TrackID>(Utils::Utils::GetIntegerMapEntry(arguments, "track", TrackNone));
+		const TrackID trackID = static_cast<TrackID>(arguments.GetInteger("track", TrackNone));
 		bool ret = manager.TrackStartLocoBase(trackID);
 		client.ReplyHtmlWithHeaderAndParagraph(ret ? "Loco started" : "Loco not started");
 	}
 
-	void WebClientTrack::HandleTrackStopLoco(const map<string, string>& arguments)
+	void WebClientTrack::HandleTrackStopLoco(const HttpRequest::Arguments& arguments)
 	{
-		const TrackID trackID = static_cast<TrackID>(Utils::Utils::GetIntegerMapEntry(arguments, "track", TrackNone));
+		const TrackID trackID = static_cast<TrackID>(arguments.GetInteger("track", TrackNone));
 		bool ret = manager.TrackStopLocoBase(trackID);
 		client.ReplyHtmlWithHeaderAndParagraph(ret ? "Loco stopped" : "Loco not stopped");
 	}
 
-	void WebClientTrack::HandleTrackBlock(const map<string, string>& arguments)
+	void WebClientTrack::HandleTrackBlock(const HttpRequest::Arguments& arguments)
 	{
-		bool blocked = Utils::Utils::GetBoolMapEntry(arguments, "blocked");
-		const TrackID trackID = static_cast<TrackID>(Utils::Utils::GetIntegerMapEntry(arguments, "track", TrackNone));
+		bool blocked = arguments.GetBool("blocked");
+		const TrackID trackID = static_cast<TrackID>(arguments.GetInteger("track", TrackNone));
 		manager.TrackBlock(trackID, blocked);
 		client.ReplyHtmlWithHeaderAndParagraph(blocked ? "Block received" : "Unblock received");
 	}
 
-	void WebClientTrack::HandleTrackOrientation(const map<string, string>& arguments)
+	void WebClientTrack::HandleTrackOrientation(const HttpRequest::Arguments& arguments)
 	{
-		Orientation orientation = (Utils::Utils::GetBoolMapEntry(arguments, "orientation") ? OrientationRight : OrientationLeft);
-		const TrackID trackID = static_cast<TrackID>(Utils::Utils::GetIntegerMapEntry(arguments, "track", TrackNone));
+		Orientation orientation = (arguments.GetBool("orientation") ? OrientationRight : OrientationLeft);
+		const TrackID trackID = static_cast<TrackID>(arguments.GetInteger("track", TrackNone));
 		manager.TrackSetLocoOrientation(trackID, orientation);
 		client.ReplyHtmlWithHeaderAndParagraph("Loco orientation of track set");
 	}
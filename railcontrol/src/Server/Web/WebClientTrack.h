@@ -25,6 +25,7 @@ along with RailControl; see the file LICENCE. If not see
 
 #include "Logger/Logger.h"
 #include "Manager.h"
+#include "Server/Web/HttpRequest.h"
 
 namespace Server { namespace Web
 {
@@ -42,18 +43,18 @@ namespace Server { namespace Web
 			{
 			}
 
-			void HandleTrackEdit(const std::map<std::string,std::string>& arguments);
-			void HandleTrackSave(const std::map<std::string,std::string>& arguments);
+			void HandleTrackEdit(const HttpRequest::Arguments& arguments);
+			void HandleTrackSave(const HttpRequest::Arguments& arguments);
 			void HandleTrackList();
-			void HandleTrackAskDelete(const std::map<std::string,std::string>& arguments);
-			void HandleTrackDelete(const std::map<std::string,std::string>& arguments);
-			void HandleTrackGet(const std::map<std::string, std::string>& arguments);
-			void HandleTrackSetLoco(const std::map<std::string, std::string>& arguments);
-			void HandleTrackRelease(const std::map<std::string, std::string>& arguments);
-			void HandleTrackStartLoco(const std::map<std::string, std::string>& arguments);
-			void HandleTrackStopLoco(const std::map<std::string, std::string>& arguments);
-			void HandleTrackBlock(const std::map<std::string, std::string>& arguments);
-			void HandleTrackOrientation(const std::map<std::string, std::string>& arguments);
+			void HandleTrackAskDelete(const HttpRequest::Arguments& arguments);
+			void HandleTrackDelete(const HttpRequest::Arguments& arguments);
+			void HandleTrackGet(const HttpRequest::Arguments& arguments);
+			void HandleTrackSetLoco(const HttpRequest::Arguments& arguments);
+			void HandleTrackRelease(const HttpRequest::Arguments& arguments);
+			void HandleTrackStartLoco(const HttpRequest::Arguments& arguments);
+			void HandleTrackStopLoco(const HttpRequest::Arguments& arguments);
+			void HandleTrackBlock(const HttpRequest::Arguments& arguments);
+			void HandleTrackOrientation(const HttpRequest::Arguments& arguments);
 
 			std::map<std::string,ObjectID> GetFeedbackOptions(const TrackID trackId = TrackNone) const;
 			std::map<std::string,ObjectID> GetSignalOptions(const TrackID trackId = TrackNone) const;
@@ -21,8 +21,10 @@ along with RailControl; see the file LICENCE. If not see
 #include <algorithm>
 #include <arpa/inet.h>
 #include <cstring>		//memset
+#include <fcntl.h>
 #include <ifaddrs.h>
 #include <netinet/in.h>
+#include <poll.h>
 #include <signal.h>
 #include <sstream>
 #include <sys/socket.h>
@@ -65,8 +67,20 @@ namespace Server { namespace Web
 		lastClientID(0),
 		manager(manager),
 		updateID(1),
-		updateAvailable(false)
+		updateAvailable(false),
+		run(true)
 	{
+		if (pipe(wakeupPipe) == 0)
+		{
+			fcntl(wakeupPipe[0], F_SETFL, O_NONBLOCK);
+			fcntl(wakeupPipe[1], F_SETFL, O_NONBLOCK);
+		}
+		else
+		{
+			wakeupPipe[0] = -1;
+			wakeupPipe[1] = -1;
+		}
+
 		AddUpdate(Languages::TextRailControlStarted);
 
 		LogBrowserInfo(webserveraddress, port);
@@ -77,6 +91,8 @@ namespace Server { namespace Web
 
 	WebServer::~WebServer()
 	{
+		StopThreads();
+
 		// delete all client memory
 		while (clients.size())
 		{
@@ -84,11 +100,18 @@ namespace Server { namespace Web
 			clients.pop_back();
 			delete client;
 		}
+		close(wakeupPipe[0]);
+		close(wakeupPipe[1]);
 		logger->Info(Languages::TextWebServerStopped);
 	}
 
 	void WebServer::Start()
 	{
+		reactorThread = thread(&WebServer::Reactor, this);
+		for (unsigned char worker = 0; worker < NumberOfRequestWorkers; ++worker)
+		{
+			requestWorkers.push_back(thread(&WebServer::RequestWorker, this));
+		}
 		StartTcpServer();
 		logger->Info(Languages::TextWebServerStarted);
 	}
@@ -97,10 +120,31 @@ namespace Server { namespace Web
 	{
 		AddUpdate(Languages::TextShutdownRailControl);
 		TerminateTcpServer();
-		// stopping all clients
-		for (auto client : clients)
+		StopThreads();
+	}
+
+	void WebServer::StopThreads()
+	{
+		run = false;
 		{
-			client->Stop();
+			// stopping all clients
+			std::lock_guard<std::mutex> lock(clientMutex);
+			for (auto client : clients)
+			{
+				client->Stop();
+			}
+		}
+		requestQueue.Terminate();
+		Wakeup();
+
+		while (requestWorkers.size())
+		{
+			requestWorkers.back().join();
+			requestWorkers.pop_back();
+		}
+		if (reactorThread.joinable())
+		{
+			reactorThread.join();
 		}
 	}
 
@@ -165,33 +209,177 @@ namespace Server { namespace Web
 
 	void WebServer::Work(Network::TcpConnection* connection)
 	{
-		clients.push_back(new WebClient(++lastClientID, connection, *this, manager));
+		{
+			std::lock_guard<std::mutex> lock(clientMutex);
+			clients.push_back(new WebClient(++lastClientID, connection, *this, manager));
+		}
+		Wakeup();
+	}
+
+	void WebServer::Wakeup()
+	{
+		const char c = 0;
+		__attribute__((unused)) ssize_t ret = write(wakeupPipe[1], &c, 1);
+	}
 
-		// clean up unused clients
-		for (auto iterator = clients.begin(); iterator != clients.end();)
+	void WebServer::Reactor()
+	{
+		Utils::Utils::SetThreadName("WebReactor");
+		vector<struct pollfd> fds;
+		vector<WebClient*> polledClients;
+		vector<WebClient*> updaterClients;
+		while (run)
 		{
-			WebClient* client = *iterator;
-			if (client->IsTerminated())
+			fds.clear();
+			polledClients.clear();
+			updaterClients.clear();
+
+			struct pollfd wakeup;
+			wakeup.fd = wakeupPipe[0];
+			wakeup.events = POLLIN;
+			wakeup.revents = 0;
+			fds.push_back(wakeup);
+
 			{
-				iterator = clients.erase(iterator);
-				delete client;
+				std::lock_guard<std::mutex> lock(clientMutex);
+				for (auto iterator = clients.begin(); iterator != clients.end();)
+				{
+					WebClient* client = *iterator;
+					struct pollfd fd;
+					fd.fd = client->GetSocket();
+					fd.revents = 0;
+					switch (client->GetState())
+					{
+						case WebClient::ClientStateTerminated:
+							// clean up unused clients
+							iterator = clients.erase(iterator);
+							delete client;
+							continue;
+
+						case WebClient::ClientStateIdle:
+							fd.events = POLLIN;
+							break;
+
+						case WebClient::ClientStateUpdater:
+						case WebClient::ClientStateWebSocket:
+							// an updater never sends data, so readability means the browser has closed the connection
+							// a WebSocket is readable when the browser has sent messages
+							fd.events = POLLIN | (client->HasPendingUpdates() ? POLLOUT : 0);
+							updaterClients.push_back(client);
+							break;
+
+						default:
+							++iterator;
+							continue;
+					}
+					fds.push_back(fd);
+					polledClients.push_back(client);
+					++iterator;
+				}
 			}
-			else
+
+			int ret = TEMP_FAILURE_RETRY(poll(fds.data(), fds.size(), 1000));
+			if (ret < 0)
 			{
-				++iterator;
+				continue;
+			}
+
+			if (fds[0].revents & POLLIN)
+			{
+				char buffer[64];
+				while (read(wakeupPipe[0], buffer, sizeof(buffer)) > 0)
+				{
+				}
+			}
+
+			for (size_t index = 1; index < fds.size(); ++index)
+			{
+				const short revents = fds[index].revents;
+				if (revents == 0)
+				{
+					continue;
+				}
+				WebClient* client = polledClients[index - 1];
+				const WebClient::ClientState state = client->GetState();
+				if (state == WebClient::ClientStateIdle)
+				{
+					// a request is read here as far as it has arrived, only complete requests are handed to a worker,
+					// so slow clients can not block the workers
+					if (!client->ReadRequest())
+					{
+						client->SetState(WebClient::ClientStateTerminated);
+						continue;
+					}
+					if (client->IsRequestComplete())
+					{
+						client->SetState(WebClient::ClientStateBusy);
+						requestQueue.EnqueueBack(client);
+					}
+					continue;
+				}
+				if (state == WebClient::ClientStateWebSocket && (revents & POLLIN))
+				{
+					// the messages of a WebSocket are read by a request worker
+					client->SetState(WebClient::ClientStateBusy);
+					requestQueue.EnqueueBack(client);
+					continue;
+				}
+				if (revents & (POLLIN | POLLERR | POLLHUP))
+				{
+					client->SetState(WebClient::ClientStateTerminated);
+				}
+			}
+
+			for (auto client : updaterClients)
+			{
+				const WebClient::ClientState state = client->GetState();
+				if ((state == WebClient::ClientStateUpdater || state == WebClient::ClientStateWebSocket) && !client->SendUpdates())
+				{
+					client->SetState(WebClient::ClientStateTerminated);
+				}
+			}
+		}
+
+		// deliver the last updates like shutdown message
+		std::lock_guard<std::mutex> lock(clientMutex);
+		for (auto client : clients)
+		{
+			const WebClient::ClientState state = client->GetState();
+			if (state == WebClient::ClientStateUpdater || state == WebClient::ClientStateWebSocket)
+			{
+				client->SendUpdates();
 			}
 		}
 	}
 
+	void WebServer::RequestWorker()
+	{
+		Utils::Utils::SetThreadName("WebClient");
+		while (run)
+		{
+			WebClient* client = requestQueue.Dequeue();
+			if (!client)
+			{
+				continue;
+			}
+			const bool keepalive = client->HandleRequest();
+			if (client->GetState() == WebClient::ClientStateBusy)
+			{
+				client->SetState(keepalive ? WebClient::ClientStateIdle : WebClient::ClientStateTerminated);
+			}
+			Wakeup();
+		}
+	}
+
 	void WebServer::Booster(__attribute__((unused)) const ControlType controlType, const BoosterState status)
 	{
 		if (status)
 		{
-			AddUpdate("booster;on=true", Languages::TextTurningBoosterOn);
+			AddUpdate(StateStore::Key(ObjectTypeBooster, 0, StateStore::AspectState), "booster;on=true", Languages::TextTurningBoosterOn);
 		}
 		else
 		{
-			AddUpdate("booster;on=false", Languages::TextTurningBoosterOff);
+			AddUpdate(StateStore::Key(ObjectTypeBooster, 0, StateStore::AspectState), "booster;on=false", Languages::TextTurningBoosterOff);
 		}
 	}
 
@@ -207,7 +395,8 @@ namespace Server { namespace Web
 	{
 		const LocoID locoIDwithPrefix = LocoIDWithPrefix(locoID, locoType);
 		string command = "locospeed;loco=" + to_string(locoIDwithPrefix) + ";speed=" + to_string(speed);
-		AddUpdate(command, Languages::TextLocoSpeedIs, name, speed);
+		const WebSocket::Message message = { WebSocket::MessageLocoSpeed, 0, locoIDwithPrefix, static_cast<uint16_t>(speed) };
+		AddUpdate(StateStore::Key(ObjectTypeLoco, locoIDwithPrefix, StateStore::AspectSpeed), message, command, Languages::TextLocoSpeedIs, name, speed);
 	}
 
 	void WebServer::LocoBaseOrientation(__attribute__((unused)) const ControlType controlType,
@@ -223,7 +412,8 @@ namespace Server { namespace Web
 	{
 		const LocoID locoIDwithPrefix = LocoIDWithPrefix(locoID, locoType);
 		const string command("locoorientation;loco=" + to_string(locoIDwithPrefix) + ";orientation=" + (orientation ? "true" : "false"));
-		AddUpdate(command, orientation ? Languages::TextLocoDirectionOfTravelIsRight : Languages::TextLocoDirectionOfTravelIsLeft, name);
+		const WebSocket::Message message = { WebSocket::MessageLocoOrientation, 0, locoIDwithPrefix, static_cast<uint16_t>(orientation) };
+		AddUpdate(StateStore::Key(ObjectTypeLoco, locoIDwithPrefix, StateStore::AspectOrientation), message, command, orientation ? Languages::TextLocoDirectionOfTravelIsRight : Languages::TextLocoDirectionOfTravelIsLeft, name);
 	}
 
 	void WebServer::LocoBaseFunctionState(__attribute__((unused)) const ControlType controlType,
@@ -240,14 +430,16 @@ namespace Server { namespace Web
 		const bool stateBool = (state != DataModel::LocoFunctionStateOff);
 		const LocoID locoIDwithPrefix = LocoIDWithPrefix(locoID, locoType);
 		const string command("locofunction;loco=" + to_string(locoIDwithPrefix) + ";function=" + to_string(function) + ";on=" + (stateBool ? "true" : "false"));
-		AddUpdate(command, stateBool ? Languages::TextLocoFunctionIsOn : Languages::TextLocoFunctionIsOff, name, function);
+		const WebSocket::Message message = { WebSocket::MessageLocoFunction, static_cast<unsigned char>(function), locoIDwithPrefix, stateBool };
+		AddUpdate(StateStore::Key(ObjectTypeLoco, locoIDwithPrefix, StateStore::AspectFunction + function), message, command, stateBool ? Languages::TextLocoFunctionIsOn : Languages::TextLocoFunctionIsOff, name, function);
 	}
 
 	void WebServer::AccessoryState(__attribute__((unused)) const ControlType controlType, const DataModel::Accessory* accessory)
 	{
+		layoutCache.Invalidate(ObjectTypeAccessory, accessory->GetID());
 		const DataModel::AccessoryState state = accessory->GetAccessoryState();
 		const string command("accessory;accessory=" + to_string(accessory->GetID()) + ";state=" + (state ? "green" : "red"));
-		AddUpdate(command, state ? Languages::TextAccessoryStateIsGreen : Languages::TextAccessoryStateIsRed, accessory->GetName());
+		AddUpdate(StateStore::Key(ObjectTypeAccessory, accessory->GetID(), StateStore::AspectState), command, state ? Languages::TextAccessoryStateIsGreen : Languages::TextAccessoryStateIsRed, accessory->GetName());
 	}
 
 	void WebServer::AccessorySettings(const AccessoryID accessoryID,
@@ -255,54 +447,66 @@ namespace Server { namespace Web
 		const DataModel::LayoutItem::LayoutPosition posZ,
 		__attribute__((unused)) const std::string& matchkey)
 	{
+		layoutCache.Invalidate(ObjectTypeAccessory, accessoryID);
 		const string command("accessorysettings;accessory=" + to_string(accessoryID) + ";layer=" + to_string(posZ));
-		AddUpdate(command, Languages::TextAccessoryUpdated, name);
+		AddUpdate(StateStore::Key(ObjectTypeAccessory, accessoryID), command, Languages::TextAccessoryUpdated, name);
 	}
 
 	void WebServer::AccessoryDelete(const AccessoryID accessoryID,
 		const std::string& name,
 		__attribute__((unused)) const std::string& matchkey)
 	{
+		layoutCache.Invalidate(ObjectTypeAccessory, accessoryID);
 		const string command("accessorydelete;accessory=" + to_string(accessoryID));
-		AddUpdate(command, Languages::TextAccessoryDeleted, name);
+		RemoveStates(ObjectTypeAccessory, accessoryID);
+		AddUpdate(StateStore::Key(ObjectTypeAccessory, accessoryID), command, Languages::TextAccessoryDeleted, name);
 	}
 
 	void WebServer::FeedbackState(const std::string& name, const FeedbackID feedbackID, const DataModel::Feedback::FeedbackState state)
 	{
+		layoutCache.Invalidate(ObjectTypeFeedback, feedbackID);
 		const string command("feedback;feedback=" + to_string(feedbackID) + ";state=" + (state ? "on" : "off"));
-		AddUpdate(command, state ? Languages::TextFeedbackStateIsOn : Languages::TextFeedbackStateIsOff, name);
+		const WebSocket::Message message = { WebSocket::MessageFeedback, 0, feedbackID, static_cast<uint16_t>(state) };
+		AddUpdate(StateStore::Key(ObjectTypeFeedback, feedbackID, StateStore::AspectState), message, command, state ? Languages::TextFeedbackStateIsOn : Languages::TextFeedbackStateIsOff, name);
 	}
 
 	void WebServer::FeedbackSettings(const FeedbackID feedbackID,
 		const std::string& name,
 		const DataModel::LayoutItem::LayoutPosition posZ)
 	{
+		layoutCache.Invalidate(ObjectTypeFeedback, feedbackID);
 		const string command("feedbacksettings;feedback=" + to_string(feedbackID) + ";layer=" + to_string(posZ));
-		AddUpdate(command, Languages::TextFeedbackUpdated, name);
+		AddUpdate(StateStore::Key(ObjectTypeFeedback, feedbackID), command, Languages::TextFeedbackUpdated, name);
 	}
 
 	void WebServer::FeedbackDelete(const FeedbackID feedbackID, const std::string& name)
 	{
+		layoutCache.Invalidate(ObjectTypeFeedback, feedbackID);
 		const string command("feedbackdelete;feedback=" + to_string(feedbackID));
-		AddUpdate(command, Languages::TextFeedbackDeleted, name);
+		RemoveStates(ObjectTypeFeedback, feedbackID);
+		AddUpdate(StateStore::Key(ObjectTypeFeedback, feedbackID), command, Languages::TextFeedbackDeleted, name);
 	}
 
 	void WebServer::RouteSettings(const RouteID routeID,
 		const std::string& name,
 		const DataModel::LayoutItem::LayoutPosition posZ)
 	{
+		layoutCache.Invalidate(ObjectTypeRoute, routeID);
 		const string command("routesettings;route=" + to_string(routeID) + ";layer=" + to_string(posZ));
-		AddUpdate(command, Languages::TextRouteUpdated, name);
+		AddUpdate(StateStore::Key(ObjectTypeRoute, routeID), command, Languages::TextRouteUpdated, name);
 	}
 
 	void WebServer::RouteDelete(const RouteID routeID, const std::string& name)
 	{
+		layoutCache.Invalidate(ObjectTypeRoute, routeID);
 		const string command("routedelete;route=" + to_string(routeID));
-		AddUpdate(command, Languages::TextRouteDeleted, name);
+		RemoveStates(ObjectTypeRoute, routeID);
+		AddUpdate(StateStore::Key(ObjectTypeRoute, routeID), command, Languages::TextRouteDeleted, name);
 	}
 
 	void WebServer::SwitchState(__attribute__((unused)) const ControlType controlType, const DataModel::Switch* mySwitch)
 	{
+		layoutCache.Invalidate(ObjectTypeSwitch, mySwitch->GetID());
 		const DataModel::AccessoryState state = mySwitch->GetAccessoryState();
 		string command("switch;switch=" + to_string(mySwitch->GetID()) + ";state=");
 		Languages::TextSelector text;
@@ -324,7 +528,8 @@ namespace Server { namespace Web
 				text = Languages::TextSwitchStateIsStraight;
 				break;
 		}
-		AddUpdate(command, text, mySwitch->GetName());
+		const WebSocket::Message message = { WebSocket::MessageSwitch, 0, mySwitch->GetID(), state };
+		AddUpdate(StateStore::Key(ObjectTypeSwitch, mySwitch->GetID(), StateStore::AspectState), message, command, text, mySwitch->GetName());
 	}
 
 	void WebServer::SwitchSettings(const SwitchID switchID,
@@ -332,20 +537,25 @@ namespace Server { namespace Web
 		const DataModel::LayoutItem::LayoutPosition posZ,
 		__attribute__((unused)) const std::string& matchKey)
 	{
+		layoutCache.Invalidate(ObjectTypeSwitch, switchID);
 		const string command("switchsettings;switch=" + to_string(switchID) + ";layer=" + to_string(posZ));
-		AddUpdate(command, Languages::TextSwitchUpdated, name);
+		AddUpdate(StateStore::Key(ObjectTypeSwitch, switchID), command, Languages::TextSwitchUpdated, name);
 	}
 
 	void WebServer::SwitchDelete(const SwitchID switchID,
 		const std::string& name,
 		__attribute__((unused)) const std::string& matchkey)
 	{
+		layoutCache.Invalidate(ObjectTypeSwitch, switchID);
 		const string command("switchdelete;switch=" + to_string(switchID));
-		AddUpdate(command, Languages::TextSwitchDeleted, name);
+		RemoveStates(ObjectTypeSwitch, switchID);
+		AddUpdate(StateStore::Key(ObjectTypeSwitch, switchID), command, Languages::TextSwitchDeleted, name);
 	}
 
 	void WebServer::TrackState(const DataModel::Track* track)
 	{
+		// linked tracks show the state of their main track
+		layoutCache.Invalidate(ObjectTypeTrack);
 		const LocoConfig locoConfig = manager.GetLocoBase(track->GetMainLocoBaseDelayed());
 		const bool reserved = locoConfig.GetType() != LocoTypeNone;
 		const string& trackName = track->GetMainName();
@@ -364,39 +574,40 @@ namespace Server { namespace Web
 			+ ";blocked=" + blockedText
 			+ ";orientation=" + orientationText
 			+ ";loconame=" + locoName);
+		const StateStore::Key key(ObjectTypeTrack, track->GetID(), StateStore::AspectState);
 
 		if (track->GetMain())
 		{
-			AddUpdate(command);
+			AddUpdate(key, command);
 		}
 		else if (blocked)
 		{
 			if (reserved)
 			{
-				AddUpdate(command, Languages::TextTrackStatusIsBlockedAndReserved, trackName, locoName);
+				AddUpdate(key, command, Languages::TextTrackStatusIsBlockedAndReserved, trackName, locoName);
 			}
 			else if (occupied)
 			{
-				AddUpdate(command, Languages::TextTrackStatusIsBlockedAndOccupied, trackName);
+				AddUpdate(key, command, Languages::TextTrackStatusIsBlockedAndOccupied, trackName);
 			}
 			else
 			{
-				AddUpdate(command, Languages::TextTrackStatusIsBlocked, trackName);
+				AddUpdate(key, command, Languages::TextTrackStatusIsBlocked, trackName);
 			}
 		}
 		else
 		{
 			if (reserved)
 			{
-				AddUpdate(command, Languages::TextTrackStatusIsReserved, trackName, locoName);;
+				AddUpdate(key, command, Languages::TextTrackStatusIsReserved, trackName, locoName);;
 			}
 			else if (occupied)
 			{
-				AddUpdate(command, Languages::TextTrackStatusIsOccupied, trackName);
+				AddUpdate(key, command, Languages::TextTrackStatusIsOccupied, trackName);
 			}
 			else
 			{
-				AddUpdate(command, Languages::TextTrackStatusIsFree, trackName);
+				AddUpdate(key, command, Languages::TextTrackStatusIsFree, trackName);
 			}
 		}
 	}
@@ -405,18 +616,22 @@ namespace Server { namespace Web
 		const std::string& name,
 		const DataModel::LayoutItem::LayoutPosition posZ)
 	{
+		layoutCache.Invalidate(ObjectTypeTrack);
 		const string command("tracksettings;track=" + to_string(trackID) + ";layer=" + to_string(posZ));
-		AddUpdate(command, Languages::TextTrackUpdated, name);
+		AddUpdate(StateStore::Key(ObjectTypeTrack, trackID), command, Languages::TextTrackUpdated, name);
 	}
 
 	void WebServer::TrackDelete(const TrackID trackID, const std::string& name)
 	{
+		layoutCache.Invalidate(ObjectTypeTrack);
 		const string command("trackdelete;track=" + to_string(trackID));
-		AddUpdate(command, Languages::TextTrackDeleted, name);
+		RemoveStates(ObjectTypeTrack, trackID);
+		AddUpdate(StateStore::Key(ObjectTypeTrack, trackID), command, Languages::TextTrackDeleted, name);
 	}
 
 	void WebServer::SignalState(__attribute__((unused)) const ControlType controlType, const DataModel::Signal* signal)
 	{
+		layoutCache.Invalidate(ObjectTypeSignal, signal->GetID());
 		const DataModel::AccessoryState state = signal->GetAccessoryState();
 		string stateText;
 		Languages::TextSelector text;
@@ -540,7 +755,8 @@ namespace Server { namespace Web
 		}
 		const string signalIdText(to_string(signal->GetID()));
 		const string command("signal;signal=" + signalIdText + ";state=" + stateText);
-		AddUpdate(command, text, signal->GetName());
+		const WebSocket::Message message = { WebSocket::MessageSignal, 0, signal->GetID(), state };
+		AddUpdate(StateStore::Key(ObjectTypeSignal, signal->GetID(), StateStore::AspectState), message, command, text, signal->GetName());
 	}
 
 	void WebServer::SignalSettings(const SignalID signalID,
@@ -548,62 +764,75 @@ namespace Server { namespace Web
 		const DataModel::LayoutItem::LayoutPosition posZ,
 		__attribute__((unused)) const std::string& matchKey)
 	{
+		layoutCache.Invalidate(ObjectTypeSignal, signalID);
 		const string command("signalsettings;signal=" + to_string(signalID) + ";layer=" + to_string(posZ));
-		AddUpdate(command, Languages::TextSignalUpdated, name);
+		AddUpdate(StateStore::Key(ObjectTypeSignal, signalID), command, Languages::TextSignalUpdated, name);
 	}
 
 	void WebServer::SignalDelete(const SignalID signalID,
 		const std::string& name,
 		__attribute__((unused)) const std::string& matchkey)
 	{
+		layoutCache.Invalidate(ObjectTypeSignal, signalID);
 		const string command("signaldelete;signal=" + to_string(signalID));
-		AddUpdate(command, Languages::TextSignalDeleted, name);
+		RemoveStates(ObjectTypeSignal, signalID);
+		AddUpdate(StateStore::Key(ObjectTypeSignal, signalID), command, Languages::TextSignalDeleted, name);
 	}
 
 	void WebServer::ClusterSettings(const ClusterID clusterID, const std::string& name)
 	{
+		layoutCache.Invalidate(ObjectTypeTrack);
 		const string command("clustersettings;cluster=" + to_string(clusterID));
-		AddUpdate(command, Languages::TextClusterUpdated, name);
+		AddUpdate(StateStore::Key(ObjectTypeCluster, clusterID), command, Languages::TextClusterUpdated, name);
 	}
 
 	void WebServer::ClusterDelete(const ClusterID clusterID, const std::string& name)
 	{
+		layoutCache.Invalidate(ObjectTypeTrack);
 		const string command("clusterdelete;cluster=" + to_string(clusterID));
-		AddUpdate(command, Languages::TextClusterDeleted, name);
+		RemoveStates(ObjectTypeCluster, clusterID);
+		AddUpdate(StateStore::Key(ObjectTypeCluster, clusterID), command, Languages::TextClusterDeleted, name);
 	}
 
 	void WebServer::TextSettings(const TextID textID,
 		const std::string& name,
 		const DataModel::LayoutItem::LayoutPosition posZ)
 	{
+		layoutCache.Invalidate(ObjectTypeText, textID);
 		const string command("textsettings;text=" + to_string(textID) + ";layer=" + to_string(posZ));
-		AddUpdate(command, Languages::TextTextUpdated, name);
+		AddUpdate(StateStore::Key(ObjectTypeText, textID), command, Languages::TextTextUpdated, name);
 	}
 
 	void WebServer::TextDelete(const TextID textID, const std::string& name)
 	{
+		layoutCache.Invalidate(ObjectTypeText, textID);
 		const string command("textdelete;text=" + to_string(textID));
-		AddUpdate(command, Languages::TextTextDeleted, name);
+		RemoveStates(ObjectTypeText, textID);
+		AddUpdate(StateStore::Key(ObjectTypeText, textID), command, Languages::TextTextDeleted, name);
 	}
 
 	void WebServer::CounterSettings(const CounterID counterID,
 		const std::string& name,
 		const DataModel::LayoutItem::LayoutPosition posZ)
 	{
+		layoutCache.Invalidate(ObjectTypeCounter, counterID);
 		const string command("countersettings;counter=" + to_string(counterID) + ";layer=" + to_string(posZ));
-		AddUpdate(command, Languages::TextCounterUpdated, name);
+		AddUpdate(StateStore::Key(ObjectTypeCounter, counterID), command, Languages::TextCounterUpdated, name);
 	}
 
 	void WebServer::CounterDelete(const CounterID counterID, const std::string& name)
 	{
+		layoutCache.Invalidate(ObjectTypeCounter, counterID);
 		const string command("counterdelete;counter=" + to_string(counterID));
-		AddUpdate(command, Languages::TextCounterDeleted, name);
+		RemoveStates(ObjectTypeCounter, counterID);
+		AddUpdate(StateStore::Key(ObjectTypeCounter, counterID), command, Languages::TextCounterDeleted, name);
 	}
 
 	void WebServer::CounterState(const DataModel::Counter* const counter)
 	{
+		layoutCache.Invalidate(ObjectTypeCounter, counter->GetID());
 		const string command("counterstate;counter=" + to_string(counter->GetID()) + ";count=" + to_string(counter->GetCounter()));
-		AddUpdate(command, Languages::TextCounterUpdated, counter->GetName());
+		AddUpdate(StateStore::Key(ObjectTypeCounter, counter->GetID(), StateStore::AspectState), command, Languages::TextCounterUpdated, counter->GetName());
 	}
 
 	void WebServer::LocoBaseRelease(const ObjectIdentifier& locoIdentifier,
@@ -650,44 +879,53 @@ namespace Server { namespace Web
 		const std::string& locoName,
 		__attribute__((unused)) const std::string& matchKey)
 	{
+		// the tracks show the names of the locos
+		layoutCache.Invalidate(ObjectTypeTrack);
 		const string command("locosettings;loco=" + to_string(locoID));
-		AddUpdate(command, Languages::TextLocoUpdated, locoName);
+		AddUpdate(StateStore::Key(ObjectTypeLoco, locoID), command, Languages::TextLocoUpdated, locoName);
 	}
 
 	void WebServer::LocoDelete(const LocoID locoID,
 		const std::string& locoName,
 		__attribute__((unused)) const std::string& matchkey)
 	{
+		layoutCache.Invalidate(ObjectTypeTrack);
 		const string command("locodelete;loco=" + to_string(locoID));
-		AddUpdate(command, Languages::TextLocoDeleted, locoName);
+		RemoveStates(ObjectTypeLoco, locoID);
+		AddUpdate(StateStore::Key(ObjectTypeLoco, locoID), command, Languages::TextLocoDeleted, locoName);
 	}
 
 	void WebServer::MultipleUnitSettings(const MultipleUnitID multipleUnitID,
 		const std::string& multipleUnitName,
 		__attribute__((unused)) const std::string& matchKey)
 	{
+		layoutCache.Invalidate(ObjectTypeTrack);
 		const string command("multipleunitsettings;loco=" + to_string(multipleUnitID));
-		AddUpdate(command, Languages::TextLocoUpdated, multipleUnitName);
+		AddUpdate(StateStore::Key(ObjectTypeMultipleUnit, multipleUnitID), command, Languages::TextLocoUpdated, multipleUnitName);
 	}
 
 	void WebServer::MultipleUnitDelete(const MultipleUnitID multipleUnitID,
 		const std::string& multipleUnitName,
 		__attribute__((unused)) const std::string& matchkey)
 	{
+		layoutCache.Invalidate(ObjectTypeTrack);
 		const string command("multipleunitdelete;loco=" + to_string(multipleUnitID));
-		AddUpdate(command, Languages::TextLocoDeleted, multipleUnitName);
+		RemoveStates(ObjectTypeMultipleUnit, multipleUnitID);
+		RemoveStates(ObjectTypeLoco, LocoIDWithPrefix(multipleUnitID, LocoTypeMultipleUnit));
+		AddUpdate(StateStore::Key(ObjectTypeMultipleUnit, multipleUnitID), command, Languages::TextLocoDeleted, multipleUnitName);
 	}
 
 	void WebServer::LayerSettings(const LayerID layerID, const std::string& name)
 	{
 		const string command("layersettings;layer=" + to_string(layerID));
-		AddUpdate(command, Languages::TextLayerUpdated, name);
+		AddUpdate(StateStore::Key(ObjectTypeLayer, layerID), command, Languages::TextLayerUpdated, name);
 	}
 
 	void WebServer::LayerDelete(const LayerID layerID, const std::string& name)
 	{
 		const string command("layerdelete;layer=" + to_string(layerID));
-		AddUpdate(command, Languages::TextLayerDeleted, name);
+		RemoveStates(ObjectTypeLayer, layerID);
+		AddUpdate(StateStore::Key(ObjectTypeLayer, layerID), command, Languages::TextLayerDeleted, name);
 	}
 
 	void WebServer::ProgramValue(const CvNumber cv, const CvValue value)
@@ -696,30 +934,124 @@ namespace Server { namespace Web
 		AddUpdate(command, Languages::TextProgramReadValue , static_cast<int>(cv), static_cast<int>(value));
 	}
 
-	void WebServer::AddUpdateInternal(const string& data)
+	void WebServer::AddUpdateInternal(const string& data,
+		const string& message,
+		const StateStore::Key* key,
+		const string& command)
 	{
-		std::lock_guard<std::mutex> lock(updateMutex);
-		updates[updateID] = data;
-		++updateID;
-		updates.erase(updateID - MaxUpdates);
+		string webSocketFrame;
+		if (message.empty())
+		{
+			// the command text without the framing of the server sent events
+			const size_t begin = (data.compare(0, 6, "data: ") == 0 ? 6 : 0);
+			const size_t end = data.find_last_not_of("\r\n");
+			WebSocket::AppendFrame(webSocketFrame, WebSocket::OpcodeText, data.substr(begin, end == string::npos ? 0 : end + 1 - begin));
+		}
+		else
+		{
+			WebSocket::AppendFrame(webSocketFrame, WebSocket::OpcodeBinary, message);
+		}
+		{
+			std::lock_guard<std::mutex> lock(updateMutex);
+			Update& update = updates[updateID];
+			update.data = data;
+			update.webSocketFrame = std::move(webSocketFrame);
+			update.added = std::chrono::steady_clock::now();
+			if (key)
+			{
+				stateStore.Set(*key, updateID, command);
+			}
+			++updateID;
+			updates.erase(updateID - MaxUpdates);
+		}
+		Wakeup();
 	}
 
-	bool WebServer::NextUpdate(unsigned int& updateIDClient, string& s)
+	bool WebServer::NextUpdates(unsigned int& updateIDClient,
+		string& reply,
+		vector<std::chrono::steady_clock::time_point>& added,
+		const bool webSocket)
 	{
 		std::lock_guard<std::mutex> lock(updateMutex);
 
-		if (updateIDClient + MaxUpdates <= updateID)
+		bool found = false;
+		const unsigned int firstAvailable = (updates.empty() ? updateID : updates.begin()->first);
+		const bool delta = (updateIDClient != 0 && updateIDClient < firstAvailable);
+		if (delta)
+		{
+			stateStore.ForEachChange(updateIDClient, firstAvailable,
+				[&reply, &found, webSocket](const unsigned int revision, const string& command)
+				{
+					found = true;
+					if (webSocket)
+					{
+						WebSocket::AppendFrame(reply, WebSocket::OpcodeText, "command=" + command);
+						return;
+					}
+					reply += "id: ";
+					reply += to_string(revision);
+					reply += "\r\ndata: command=";
+					reply += command;
+					reply += "\r\n\r\n";
+				});
+		}
+
+		for (auto update = updates.lower_bound(updateIDClient); update != updates.end(); ++update)
 		{
-			updateIDClient = updateID - MaxUpdates + 1;
+			added.push_back(update->second.added);
+			found = true;
+			if (webSocket)
+			{
+				reply += update->second.webSocketFrame;
+				continue;
+			}
+			reply += "id: ";
+			reply += to_string(update->first);
+			reply += "\r\n";
+			reply += update->second.data;
+			reply += "\r\n\r\n";
 		}
 
-		if (updates.count(updateIDClient) == 1)
+		// WebSocket frames have no ID, so the browser counts them from the last announced revision
+		if (webSocket && (updateIDClient == 0 || delta))
+		{
+			WebSocket::AppendFrame(reply, WebSocket::OpcodeText, "command=revision;revision=" + to_string(updateID - 1));
+			found = true;
+		}
+
+		// also skips the IDs of a Last-Event-ID from before a restart
+		updateIDClient = updateID;
+		return found;
+	}
+
+	void WebServer::RemoveStates(const ObjectType objectType, const ObjectID objectID)
+	{
+		std::lock_guard<std::mutex> lock(updateMutex);
+		stateStore.Remove(objectType, objectID);
+	}
+
+	bool WebServer::HasNewUpdates(const unsigned int updateIDClient)
+	{
+		std::lock_guard<std::mutex> lock(updateMutex);
+		return updateIDClient != updateID;
+	}
+
+	void WebServer::UpdatesSent(const vector<std::chrono::steady_clock::time_point>& added)
+	{
+		for (auto& time : added)
 		{
-			s = updates.at(updateIDClient);
-			return true;
+			updateLatency.Add(time);
 		}
+	}
 
-		return false;
+	string WebServer::GetStatistics() const
+	{
+		string stateStatistics;
+		{
+			std::lock_guard<std::mutex> lock(updateMutex);
+			stateStatistics = stateStore.GetStatistics();
+		}
+		return updateLatency.ToCsv("updatelatency") + layoutCache.GetStatistics() + stateStatistics + WebClient::GetCommandStatistics();
 	}
 
 }} // namespace Server::Web
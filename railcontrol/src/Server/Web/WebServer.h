@@ -20,9 +20,11 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <chrono>
 #include <map>
 #include <mutex>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #include "ControlInterface.h"
@@ -30,6 +32,12 @@ along with RailControl; see the file LICENCE. If not see
 #include "Logger/Logger.h"
 #include "Manager.h"
 #include "Network/TcpServer.h"
+#include "Server/Web/LayoutCache.h"
+#include "Server/Web/StateStore.h"
+#include "Server/Web/StaticFiles.h"
+#include "Server/Web/WebSocket.h"
+#include "Utils/LatencyHistogram.h"
+#include "Utils/ThreadSafeQueue.h"
 
 namespace Server { namespace Web
 {
@@ -56,7 +64,21 @@ namespace Server { namespace Web
 				AddUpdate("warning", textSelector);
 			}
 
-			bool NextUpdate(unsigned int& updateIDClient, std::string& s);
+			// appends all updates newer than updateIDClient to reply as server sent events
+			// or as WebSocket frames, their creation times to added.
+			// If updates of a client that has been connected before are not available anymore,
+			// the latest commands of the objects changed since then are sent first.
+			// updateIDClient 0 is a new client, which gets the available updates.
+			bool NextUpdates(unsigned int& updateIDClient,
+				std::string& reply,
+				std::vector<std::chrono::steady_clock::time_point>& added,
+				const bool webSocket);
+
+			bool HasNewUpdates(const unsigned int updateIDClient);
+
+			void UpdatesSent(const std::vector<std::chrono::steady_clock::time_point>& added);
+
+			std::string GetStatistics() const override;
 
 			inline const std::string& GetName() const override
 			{
@@ -193,6 +215,16 @@ namespace Server { namespace Web
 			void CounterState(const DataModel::Counter* const counter) override;
 			void ProgramValue(const CvNumber cv, const CvValue value) override;
 
+			inline LayoutCache& GetLayoutCache()
+			{
+				return layoutCache;
+			}
+
+			inline const StaticFiles& GetStaticFiles() const
+			{
+				return staticFiles;
+			}
+
 			inline bool UpdateAvailable()
 			{
 				return updateAvailable;
@@ -225,7 +257,39 @@ namespace Server { namespace Web
 				AddUpdate(std::string("data: status=") + Languages::GetText(status) + "\r\n\r\n");
 			}
 
-			void AddUpdateInternal(const std::string& data);
+			// the command is kept as the latest one of key for reconnecting clients
+			template<typename... Args>
+			inline void AddUpdate(const StateStore::Key& key, const std::string& command, const Languages::TextSelector text, Args... args)
+			{
+				const std::string status = Logger::Logger::Format(Languages::GetText(text), args...);
+				AddUpdateInternal("data: command=" + command + ";status=" + status + "\r\n\r\n", "", &key, command);
+			}
+
+			inline void AddUpdate(const StateStore::Key& key, const std::string& command)
+			{
+				AddUpdateInternal("data: command=" + command + "\r\n\r\n", "", &key, command);
+			}
+
+			// WebSocket clients get the update as binary message instead of the command text
+			template<typename... Args>
+			inline void AddUpdate(const StateStore::Key& key, const WebSocket::Message& message, const std::string& command, const Languages::TextSelector text, Args... args)
+			{
+				const std::string status = Logger::Logger::Format(Languages::GetText(text), args...);
+				AddUpdateInternal("data: command=" + command + ";status=" + status + "\r\n\r\n", WebSocket::EncodeMessage(message) + status, &key, command);
+			}
+
+			void AddUpdateInternal(const std::string& data,
+				const std::string& message = "",
+				const StateStore::Key* key = nullptr,
+				const std::string& command = "");
+
+			void RemoveStates(const ObjectType objectType, const ObjectID objectID);
+
+			// the reactor waits for requests on idle connections and pushes the updates to the updater connections
+			void Reactor();
+			void RequestWorker();
+			void Wakeup();
+			void StopThreads();
 
 			void LogBrowserInfo(const std::string& webserveraddress, const unsigned short port);
 
@@ -234,17 +298,36 @@ namespace Server { namespace Web
 				return locoID + (type == LocoTypeMultipleUnit ? MultipleUnitIdPrefix : 0);
 			}
 
+			struct Update
+			{
+				std::string data;
+				std::string webSocketFrame;
+				std::chrono::steady_clock::time_point added;
+			};
+
 			Logger::Logger* logger;
+			LayoutCache layoutCache;
+			StaticFiles staticFiles;
 			unsigned int lastClientID;
 			std::vector<WebClient*> clients;
+			std::mutex clientMutex;
 			Manager& manager;
 
-			std::map<unsigned int,std::string> updates;
-			std::mutex updateMutex;
+			std::map<unsigned int,Update> updates;
+			mutable std::mutex updateMutex;
+			StateStore stateStore;
 			unsigned int updateID;
 			bool updateAvailable;
+			volatile bool run;
+			Utils::LatencyHistogram updateLatency;
+
+			int wakeupPipe[2];
+			std::thread reactorThread;
+			std::vector<std::thread> requestWorkers;
+			Utils::ThreadSafeQueue<WebClient*> requestQueue;
 
 			static const unsigned int MaxUpdates = 10;
+			static const unsigned char NumberOfRequestWorkers = 4;
 	};
 }} // namespace Server::Web
 
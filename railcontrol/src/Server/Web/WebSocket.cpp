@@ -0,0 +1,273 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "Server/Web/WebSocket.h"
+
+using std::string;
+
+namespace Server { namespace Web
+{
+	static inline uint32_t RotateLeft(const uint32_t value, const unsigned char bits)
+	{
+		return (value << bits) | (value >> (32 - bits));
+	}
+
+	// SHA-1 is only used for the handshake, as required by RFC 6455
+	static string Sha1(const string& input)
+	{
+		uint32_t h[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+
+		string data(input);
+		const uint64_t bits = static_cast<uint64_t>(input.size()) * 8;
+		data += static_cast<char>(0x80);
+		while (data.size() % 64 != 56)
+		{
+			data += static_cast<char>(0x00);
+		}
+		for (int shift = 56; shift >= 0; shift -= 8)
+		{
+			data += static_cast<char>((bits >> shift) & 0xFF);
+		}
+
+		for (size_t chunk = 0; chunk < data.size(); chunk += 64)
+		{
+			uint32_t w[80];
+			for (unsigned char i = 0; i < 16; ++i)
+			{
+				const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data.data() + chunk + i * 4);
+				w[i] = (static_cast<uint32_t>(bytes[0]) << 24) | (bytes[1] << 16) | (bytes[2] << 8) | bytes[3];
+			}
+			for (unsigned char i = 16; i < 80; ++i)
+			{
+				w[i] = RotateLeft(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+			}
+
+			uint32_t a = h[0];
+			uint32_t b = h[1];
+			uint32_t c = h[2];
+			uint32_t d = h[3];
+			uint32_t e = h[4];
+			for (unsigned char i = 0; i < 80; ++i)
+			{
+				uint32_t f;
+				uint32_t k;
+				if (i < 20)
+				{
+					f = (b & c) | (~b & d);
+					k = 0x5A827999;
+				}
+				else if (i < 40)
+				{
+					f = b ^ c ^ d;
+					k = 0x6ED9EBA1;
+				}
+				else if (i < 60)
+				{
+					f = (b & c) | (b & d) | (c & d);
+					k = 0x8F1BBCDC;
+				}
+				else
+				{
+					f = b ^ c ^ d;
+					k = 0xCA62C1D6;
+				}
+				const uint32_t temp = RotateLeft(a, 5) + f + e + k + w[i];
+				e = d;
+				d = c;
+				c = RotateLeft(b, 30);
+				b = a;
+				a = temp;
+			}
+			h[0] += a;
+			h[1] += b;
+			h[2] += c;
+			h[3] += d;
+			h[4] += e;
+		}
+
+		string digest;
+		for (unsigned char i = 0; i < 5; ++i)
+		{
+			digest += static_cast<char>(h[i] >> 24);
+			digest += static_cast<char>(h[i] >> 16);
+			digest += static_cast<char>(h[i] >> 8);
+			digest += static_cast<char>(h[i]);
+		}
+		return digest;
+	}
+
+	static string Base64(const string& input)
+	{
+		static const char Characters[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+		string output;
+		size_t i = 0;
+		for (; i + 2 < input.size(); i += 3)
+		{
+			const uint32_t value = (static_cast<unsigned char>(input[i]) << 16)
+				| (static_cast<unsigned char>(input[i + 1]) << 8)
+				| static_cast<unsigned char>(input[i + 2]);
+			output += Characters[(value >> 18) & 0x3F];
+			output += Characters[(value >> 12) & 0x3F];
+			output += Characters[(value >> 6) & 0x3F];
+			output += Characters[value & 0x3F];
+		}
+		const size_t rest = input.size() - i;
+		if (rest == 0)
+		{
+			return output;
+		}
+		uint32_t value = static_cast<unsigned char>(input[i]) << 16;
+		if (rest == 2)
+		{
+			value |= static_cast<unsigned char>(input[i + 1]) << 8;
+		}
+		output += Characters[(value >> 18) & 0x3F];
+		output += Characters[(value >> 12) & 0x3F];
+		output += (rest == 2 ? Characters[(value >> 6) & 0x3F] : '=');
+		output += '=';
+		return output;
+	}
+
+	string WebSocket::AcceptKey(const string& key)
+	{
+		return Base64(Sha1(key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"));
+	}
+
+	void WebSocket::AppendFrame(string& buffer, const Opcode opcode, const string& payload)
+	{
+		// the server never fragments and never masks its frames
+		buffer += static_cast<char>(0x80 | opcode);
+		const size_t size = payload.size();
+		if (size < 126)
+		{
+			buffer += static_cast<char>(size);
+		}
+		else if (size <= 0xFFFF)
+		{
+			buffer += static_cast<char>(126);
+			buffer += static_cast<char>(size >> 8);
+			buffer += static_cast<char>(size);
+		}
+		else
+		{
+			buffer += static_cast<char>(127);
+			for (int shift = 56; shift >= 0; shift -= 8)
+			{
+				buffer += static_cast<char>((static_cast<uint64_t>(size) >> shift) & 0xFF);
+			}
+		}
+		buffer += payload;
+	}
+
+	WebSocket::ParseResult WebSocket::ParseFrame(const string& data,
+		size_t& frameSize,
+		Opcode& opcode,
+		string& payload)
+	{
+		if (data.size() < 2)
+		{
+			return ParseIncomplete;
+		}
+		const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data.data());
+		const bool fin = bytes[0] & 0x80;
+		opcode = static_cast<Opcode>(bytes[0] & 0x0F);
+		const bool masked = bytes[1] & 0x80;
+		// fragmented messages are not needed by the browser code, frames of a browser are always masked
+		if (!fin || opcode == OpcodeContinuation || !masked)
+		{
+			return ParseError;
+		}
+
+		uint64_t size = bytes[1] & 0x7F;
+		size_t position = 2;
+		if (size == 126)
+		{
+			if (data.size() < 4)
+			{
+				return ParseIncomplete;
+			}
+			size = (bytes[2] << 8) | bytes[3];
+			position = 4;
+		}
+		else if (size == 127)
+		{
+			if (data.size() < 10)
+			{
+				return ParseIncomplete;
+			}
+			size = 0;
+			for (unsigned char i = 2; i < 10; ++i)
+			{
+				size = (size << 8) | bytes[i];
+			}
+			position = 10;
+		}
+		if (size > MaxPayload)
+		{
+			return ParseError;
+		}
+		if (data.size() < position + 4 + size)
+		{
+			return ParseIncomplete;
+		}
+
+		const unsigned char* mask = bytes + position;
+		position += 4;
+		payload.resize(size);
+		for (size_t i = 0; i < size; ++i)
+		{
+			payload[i] = static_cast<char>(bytes[position + i] ^ mask[i & 3]);
+		}
+		frameSize = position + size;
+		return ParseOk;
+	}
+
+	string WebSocket::EncodeMessage(const Message& message)
+	{
+		string payload(MessageSize, '\0');
+		payload[0] = static_cast<char>(message.type);
+		payload[1] = static_cast<char>(message.argument);
+		payload[2] = static_cast<char>(message.id >> 24);
+		payload[3] = static_cast<char>(message.id >> 16);
+		payload[4] = static_cast<char>(message.id >> 8);
+		payload[5] = static_cast<char>(message.id);
+		payload[6] = static_cast<char>(message.value >> 8);
+		payload[7] = static_cast<char>(message.value);
+		return payload;
+	}
+
+	bool WebSocket::DecodeMessage(const string& payload, Message& message)
+	{
+		if (payload.size() < MessageSize)
+		{
+			return false;
+		}
+		const unsigned char* bytes = reinterpret_cast<const unsigned char*>(payload.data());
+		if (bytes[0] < MessageLocoSpeed || bytes[0] > MessageSignal)
+		{
+			return false;
+		}
+		message.type = static_cast<MessageType>(bytes[0]);
+		message.argument = bytes[1];
+		message.id = (static_cast<uint32_t>(bytes[2]) << 24) | (bytes[3] << 16) | (bytes[4] << 8) | bytes[5];
+		message.value = static_cast<uint16_t>((bytes[6] << 8) | bytes[7]);
+		return true;
+	}
+}} // namespace Server::Web
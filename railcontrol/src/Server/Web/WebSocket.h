@@ -0,0 +1,91 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Server { namespace Web
+{
+	// Framing of the WebSocket connection of the web clients (RFC 6455)
+	// and the compact binary messages sent over it in both directions.
+	//
+	// A binary message starts with 8 bytes: type, argument, 32 bit id and 16 bit value, both big endian.
+	// Updates sent by the server append the status text as UTF-8.
+	class WebSocket
+	{
+		public:
+			enum Opcode : unsigned char
+			{
+				OpcodeContinuation = 0x0,
+				OpcodeText = 0x1,
+				OpcodeBinary = 0x2,
+				OpcodeClose = 0x8,
+				OpcodePing = 0x9,
+				OpcodePong = 0xA
+			};
+
+			enum MessageType : unsigned char
+			{
+				MessageLocoSpeed = 1, // id: loco, value: speed
+				MessageLocoOrientation, // id: loco, value: orientation
+				MessageLocoFunction, // id: loco, argument: function, value: state
+				MessageFeedback, // id: feedback, value: state
+				MessageSwitch, // id: switch, value: accessory state
+				MessageSignal // id: signal, value: accessory state
+			};
+
+			struct Message
+			{
+				MessageType type;
+				unsigned char argument;
+				uint32_t id;
+				uint16_t value;
+			};
+
+			enum ParseResult : unsigned char
+			{
+				ParseIncomplete = 0,
+				ParseOk,
+				ParseError
+			};
+
+			static const size_t MessageSize = 8;
+			static const size_t MaxPayload = 4096;
+
+			WebSocket() = delete;
+
+			// returns the value of the Sec-WebSocket-Accept header for the Sec-WebSocket-Key of the browser
+			static std::string AcceptKey(const std::string& key);
+
+			static void AppendFrame(std::string& buffer, const Opcode opcode, const std::string& payload);
+
+			// parses the masked frame of a browser at the beginning of data, frameSize is the number of bytes used by it
+			static ParseResult ParseFrame(const std::string& data,
+				size_t& frameSize,
+				Opcode& opcode,
+				std::string& payload);
+
+			static std::string EncodeMessage(const Message& message);
+
+			static bool DecodeMessage(const std::string& payload, Message& message);
+	};
+}} // namespace Server::Web
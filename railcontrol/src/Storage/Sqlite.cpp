@@ -18,6 +18,7 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
+#include <cstdio>
 #include <ctime>
 #include <map>
 #include <string>
@@ -39,11 +40,35 @@ using std::to_string;
 
 namespace Storage
 {
+	// integer parameters have to be placed before text parameters, see BindStatement
+	const char* const SQLite::StatementQueries[NumberOfStatements] =
+	{
+		"INSERT OR REPLACE INTO hardware (controlid, hardwaretype, name, arg1, arg2, arg3, arg4, arg5) VALUES (?, ?, ?, ?, ?, ?, ?, ?);",
+		"DELETE FROM hardware WHERE controlid = ?;",
+		"INSERT OR REPLACE INTO objects (objecttype, objectid, name, object) VALUES (?, ?, ?, ?);",
+		"DELETE FROM objects WHERE objecttype = ? AND objectid = ?;",
+		"SELECT object FROM objects WHERE objecttype = ? ORDER BY objectid;",
+		"INSERT OR REPLACE INTO relations (type, objectid1, objecttype2, objectid2, priority, relation) VALUES (?, ?, ?, ?, ?, ?);",
+		"DELETE FROM relations WHERE type = ? AND objectid1 = ?;",
+		"DELETE FROM relations WHERE objecttype2 = ? AND objectid2 = ?;",
+		"SELECT relation FROM relations WHERE type = ? AND objectid1 = ? ORDER BY priority ASC;",
+		"SELECT relation FROM relations WHERE objecttype2 = ? AND objectid2 = ?;",
+		"INSERT OR REPLACE INTO settings (key, value) VALUES (?, ?);",
+		"SELECT value FROM settings WHERE key = ?;",
+		"SELECT objecttype, object FROM objects ORDER BY objecttype, objectid;",
+		"SELECT type, objectid1, relation FROM relations ORDER BY type, objectid1, priority ASC;"
+	};
+
 	SQLite::SQLite(const StorageParams* params)
 	:	filename(params->filename),
 		logger(Logger::Logger::GetLogger("SQLite")),
 		keepBackups(params->keepBackups)
 	{
+		for (auto& statement : statements)
+		{
+			statement = nullptr;
+		}
+
 		Utils::Utils::RemoveOldBackupFiles (logger, filename, keepBackups);
 		logger->Info(Languages::TextOpeningSQLite, filename);
 		int rc = sqlite3_open(filename.c_str(), &db);
@@ -55,6 +80,10 @@ namespace Storage
 			return;
 		}
 
+		// write ahead log: writers do not block readers and a crash can not corrupt the database
+		Execute("PRAGMA journal_mode = WAL;");
+		Execute("PRAGMA synchronous = NORMAL;");
+
 		// check if needed tables exist
 		map<string, bool> tablenames;
 		const char* query = "SELECT name FROM sqlite_master WHERE type='table' ORDER BY name;";
@@ -108,6 +137,10 @@ namespace Storage
 				return;
 			}
 		}
+
+		PrepareStatements();
+
+		CheckBinaryFormat();
 	}
 
 
@@ -119,6 +152,7 @@ namespace Storage
 		}
 
 		logger->Info(Languages::TextClosingSQLite);
+		FinalizeStatements();
 		sqlite3_close(db);
 		db = nullptr;
 
@@ -244,6 +278,101 @@ namespace Storage
 		return true;
 	}
 
+	// objects and relations are stored as binary records since binary format 1, older databases are converted once
+	bool SQLite::CheckBinaryFormat()
+	{
+		const string key = "binaryformat";
+		const string version = to_string(DataModel::Serializable::BinaryVersion);
+		if (GetSetting(key).compare(version) == 0)
+		{
+			return true;
+		}
+
+		map<long long, string> objects;
+		map<long long, string> relations;
+		bool ret = Execute("SELECT rowid, object FROM objects;", CallbackRowIds, &objects)
+			&& Execute("SELECT rowid, relation FROM relations;", CallbackRowIds, &relations);
+		if (!ret)
+		{
+			return false;
+		}
+
+		// the conversion can not be undone and older versions of RailControl can not read binary records
+		if (objects.size() > 0 || relations.size() > 0)
+		{
+			const string backup = filename + ".textformat.bak";
+			logger->Info(Languages::TextBackupBeforeBinaryFormat, backup);
+			remove(backup.c_str());
+			string escapedBackup = backup;
+			for (size_t position = escapedBackup.find('\''); position != string::npos; position = escapedBackup.find('\'', position + 2))
+			{
+				escapedBackup.insert(position, 1, '\'');
+			}
+			ret = Execute("VACUUM INTO '" + escapedBackup + "';");
+			if (!ret)
+			{
+				return false;
+			}
+		}
+
+		StartTransaction();
+		ret = ConvertToBinary("objects", "object", objects) && ConvertToBinary("relations", "relation", relations);
+		if (!ret)
+		{
+			Execute("ROLLBACK;");
+			return false;
+		}
+		SaveSetting(key, version);
+		CommitTransaction();
+		return true;
+	}
+
+	bool SQLite::ConvertToBinary(const string& table, const string& column, const map<long long, string>& rows)
+	{
+		if (rows.size() == 0)
+		{
+			return true;
+		}
+		logger->Info(Languages::TextConvertingToBinary, table);
+		bool ret = true;
+		sqlite3_stmt* statement = nullptr;
+		const string query = "UPDATE " + table + " SET " + column + " = ? WHERE rowid = ?;";
+		if (sqlite3_prepare_v2(db, query.c_str(), -1, &statement, nullptr) != SQLITE_OK)
+		{
+			logger->Error(Languages::TextSQLiteErrorQuery, sqlite3_errmsg(db), query);
+			return false;
+		}
+		for (auto& row : rows)
+		{
+			const string binary = DataModel::Serializable::ToBinary(row.second);
+			sqlite3_bind_blob(statement, 1, binary.data(), static_cast<int>(binary.size()), SQLITE_STATIC);
+			sqlite3_bind_int64(statement, 2, row.first);
+			ret = ExecuteStatement(statement);
+			if (!ret)
+			{
+				break;
+			}
+		}
+		sqlite3_finalize(statement);
+		return ret;
+	}
+
+	int SQLite::CallbackRowIds(void* v, int argc, char **argv, __attribute__((unused)) char **colName)
+	{
+		map<long long, string>* rows = static_cast<map<long long, string>*>(v);
+		if (argc != 2 || argv[0] == nullptr || argv[1] == nullptr)
+		{
+			return 0;
+		}
+		// rows that are already binary are not readable as text and are kept
+		if (DataModel::Serializable::IsBinary(argv[1]))
+		{
+			return 0;
+		}
+		(*rows)[std::stoll(argv[0])] = argv[1];
+		return 0;
+	}
+
 	bool SQLite::UpdateTableRelations1()
 	{
 		const string tableName = "relations";
@@ -296,16 +425,15 @@ namespace Storage
 
 	void SQLite::SaveHardwareParams(const Hardware::HardwareParams& hardwareParams)
 	{
-		string query = "INSERT OR REPLACE INTO hardware VALUES ("
-			+ to_string(hardwareParams.GetControlID()) + ", "
-			+ to_string(hardwareParams.GetHardwareType()) + ", '"
-			+ EscapeString(hardwareParams.GetName()) + "', '"
-			+ EscapeString(hardwareParams.GetArg1()) + "', '"
-			+ EscapeString(hardwareParams.GetArg2()) + "', '"
-			+ EscapeString(hardwareParams.GetArg3()) + "', '"
-			+ EscapeString(hardwareParams.GetArg4()) + "', '"
-			+ EscapeString(hardwareParams.GetArg5()) + "');";
-		Execute(query);
+		const string name = hardwareParams.GetName();
+		const string arg1 = hardwareParams.GetArg1();
+		const string arg2 = hardwareParams.GetArg2();
+		const string arg3 = hardwareParams.GetArg3();
+		const string arg4 = hardwareParams.GetArg4();
+		const string arg5 = hardwareParams.GetArg5();
+		ExecuteStatement(BindStatement(StatementSaveHardwareParams,
+			{ hardwareParams.GetControlID(), hardwareParams.GetHardwareType() },
+			{ &name, &arg1, &arg2, &arg3, &arg4, &arg5 }));
 	}
 
 	void SQLite::AllHardwareParams(std::map<ControlID, Hardware::HardwareParams*>& hardwareParams)
@@ -332,91 +460,91 @@ namespace Storage
 	// delete control
 	void SQLite::DeleteHardwareParams(const ControlID controlID)
 	{
-		string query = "DELETE FROM hardware WHERE controlid = " + to_string(controlID) + ";";
-		Execute(query);
+		ExecuteStatement(BindStatement(StatementDeleteHardwareParams, { controlID }));
 	}
 
 	// save DataModel object
 	void SQLite::SaveObject(const ObjectType objectType, const ObjectID objectID, const std::string& name, const std::string& object)
 	{
-		string query = "INSERT OR REPLACE INTO objects (objecttype, objectid, name, object) VALUES ("
-			+ to_string(objectType) + ", "
-			+ to_string(objectID) + ", '"
-			+ EscapeString(name) + "', '"
-			+ EscapeString(object) + "');";
-		Execute(query);
+		const string binary = DataModel::Serializable::ToBinary(object);
+		ExecuteStatement(BindStatement(StatementSaveObject, { objectType, objectID }, { &name }, { &binary }));
 	}
 
 	// delete DataModel object
 	void SQLite::DeleteObject(const ObjectType objectType, const ObjectID objectID)
 	{
-		string query = "DELETE FROM objects WHERE objecttype = " + to_string(objectType)
-			+ " AND objectid = " + to_string(objectID) + ";";
-		Execute(query);
+		ExecuteStatement(BindStatement(StatementDeleteObject, { objectType, objectID }));
 	}
 
 	// read DataModel objects
 	void SQLite::ObjectsOfType(const ObjectType objectType, vector<string>& objects)
 	{
-		string query = "SELECT object FROM objects WHERE objecttype = " + to_string(objectType) + " ORDER BY objectid;";
-		Execute(query, CallbackStringVector, &objects);
+		ExecuteStatement(BindStatement(StatementObjectsOfType, { objectType }), &objects);
+	}
+
+	// read all DataModel objects in a single pass
+	void SQLite::AllObjects(map<ObjectType,vector<string>>& objects)
+	{
+		ExecuteStatement(BindStatement(StatementAllObjects, {}),
+			[&objects](sqlite3_stmt* statement)
+			{
+				const ObjectType objectType = static_cast<ObjectType>(sqlite3_column_int(statement, 0));
+				objects[objectType].push_back(ColumnBlob(statement, 1));
+			});
 	}
 
 	// save DataModel relation
 	void SQLite::SaveRelation(const DataModel::Relation::RelationType type, const ObjectID objectID1, const ObjectType objectType2, const ObjectID objectID2, const Priority priority, const std::string& relation)
 	{
-		string query = "INSERT OR REPLACE INTO relations (type, objectid1, objecttype2, objectid2, priority, relation) VALUES ("
-			+ to_string(type) + ", "
-			+ to_string(objectID1) + ", "
-			+ to_string(objectType2) + ", "
-			+ to_string(objectID2) + ", "
-			+ to_string(priority) + ", '"
-			+ EscapeString(relation) + "');";
-		Execute(query);
+		const string binary = DataModel::Serializable::ToBinary(relation);
+		ExecuteStatement(BindStatement(StatementSaveRelation, { type, objectID1, objectType2, objectID2, priority }, {}, { &binary }));
 	}
 
 	// delete DataModel relation
 	void SQLite::DeleteRelationsFrom(const DataModel::Relation::RelationType type, const ObjectID objectID)
 	{
-		string query = "DELETE FROM relations WHERE type = " + to_string(type)
-			+ " AND objectid1 = " + to_string(objectID) + ";";
-		Execute(query);
+		ExecuteStatement(BindStatement(StatementDeleteRelationsFrom, { type, objectID }));
 	}
 
 	// delete DataModel relation
 	void SQLite::DeleteRelationsTo(const ObjectType objectType, const ObjectID objectID)
 	{
-		string query = "DELETE FROM relations WHERE objecttype2 = " + to_string(objectType)
-			+ " AND objectid2 = " + to_string(objectID) + ";";
-		Execute(query);
+		ExecuteStatement(BindStatement(StatementDeleteRelationsTo, { objectType, objectID }));
 	}
 
 	// read DataModel relations
 	void SQLite::RelationsFrom(const DataModel::Relation::RelationType type, const ObjectID objectID, vector<string>& relations)
 	{
-		string query = "SELECT relation FROM relations WHERE type = " + to_string(type)
-			+ " AND objectid1 = " + to_string(objectID) + " ORDER BY priority ASC;";
-		Execute(query, CallbackStringVector, &relations);
+		ExecuteStatement(BindStatement(StatementRelationsFrom, { type, objectID }), &relations);
 	}
 
 	// read DataModel relations
 	void SQLite::RelationsTo(const ObjectType objectType, const ObjectID objectID, vector<string>& relations)
 	{
-		string query = "SELECT relation FROM relations WHERE objecttype2 = " + to_string(objectType)
-			+ " AND objectid2 = " + to_string(objectID) + ";";
-		Execute(query, CallbackStringVector, &relations);
+		ExecuteStatement(BindStatement(StatementRelationsTo, { objectType, objectID }), &relations);
+	}
+
+	// read all DataModel relations in a single pass
+	void SQLite::AllRelations(map<DataModel::Relation::RelationType,map<ObjectID,vector<string>>>& relations)
+	{
+		ExecuteStatement(BindStatement(StatementAllRelations, {}),
+			[&relations](sqlite3_stmt* statement)
+			{
+				const DataModel::Relation::RelationType type = static_cast<DataModel::Relation::RelationType>(sqlite3_column_int(statement, 0));
+				const ObjectID objectID = static_cast<ObjectID>(sqlite3_column_int(statement, 1));
+				relations[type][objectID].push_back(ColumnBlob(statement, 2));
+			});
 	}
 
 	void SQLite::SaveSetting(const string& key, const string& value)
 	{
-		Execute("INSERT OR REPLACE INTO settings (key, value) values ('" + EscapeString(key) + "', '" + EscapeString(value) + "');");
+		ExecuteStatement(BindStatement(StatementSaveSetting, {}, { &key, &value }));
 	}
 
 	string SQLite::GetSetting(const string& key)
 	{
 		vector<string> values;
-		string query = "SELECT value FROM settings WHERE key = '" + EscapeString(key) + "';";
-		bool ret = Execute(query, CallbackStringVector, &values);
+		bool ret = ExecuteStatement(BindStatement(StatementGetSetting, {}, { &key }), &values);
 		if (ret == false || values.size() == 0)
 		{
 			return "";
@@ -425,18 +553,6 @@ namespace Storage
 		return values[0];
 	}
 
-	// callback read all DataModel objects/relations
-	int SQLite::CallbackStringVector(void* v, int argc, char **argv, __attribute__((unused)) char **colName)
-	{
-		vector<string>* objects = static_cast<vector<string>*>(v);
-		if (argc != 1)
-		{
-			return 0;
-		}
-		objects->push_back(argv[0]);
-		return 0;
-	}
-
 	void SQLite::StartTransaction()
 	{
 		Execute("BEGIN TRANSACTION;");
@@ -476,17 +592,107 @@ namespace Storage
 		return false;
 	}
 
-	string SQLite::EscapeString(const string& input)
+	void SQLite::PrepareStatements()
+	{
+		for (unsigned char statement = 0; statement < NumberOfStatements; ++statement)
+		{
+			const int rc = sqlite3_prepare_v2(db, StatementQueries[statement], -1, &statements[statement], nullptr);
+			if (rc == SQLITE_OK)
+			{
+				continue;
+			}
+			logger->Error(Languages::TextSQLiteErrorQuery, sqlite3_errmsg(db), StatementQueries[statement]);
+			statements[statement] = nullptr;
+		}
+	}
+
+	void SQLite::FinalizeStatements()
+	{
+		for (auto& statement : statements)
+		{
+			sqlite3_finalize(statement);
+			statement = nullptr;
+		}
+	}
+
+	sqlite3_stmt* SQLite::BindStatement(const Statement statementType,
+		const vector<int>& integers,
+		const vector<const string*>& texts,
+		const vector<const string*>& blobs)
+	{
+		if (!db)
+		{
+			return nullptr;
+		}
+
+		sqlite3_stmt* statement = statements[statementType];
+		if (!statement)
+		{
+			return nullptr;
+		}
+
+		int index = 1;
+		for (const int integer : integers)
+		{
+			sqlite3_bind_int(statement, index++, integer);
+		}
+		for (const string* text : texts)
+		{
+			// the texts outlive the execution of the statement, so sqlite does not need to copy them
+			sqlite3_bind_text(statement, index++, text->c_str(), static_cast<int>(text->size()), SQLITE_STATIC);
+		}
+		for (const string* blob : blobs)
+		{
+			sqlite3_bind_blob(statement, index++, blob->data(), static_cast<int>(blob->size()), SQLITE_STATIC);
+		}
+		return statement;
+	}
+
+	bool SQLite::ExecuteStatement(sqlite3_stmt* statement, vector<string>* result)
 	{
-		string output;
-		for (size_t i = 0; i < input.size(); ++i)
+		return ExecuteStatement(statement,
+			[result](sqlite3_stmt* rowStatement)
+			{
+				if (result)
+				{
+					result->push_back(ColumnBlob(rowStatement, 0));
+				}
+			});
+	}
+
+	bool SQLite::ExecuteStatement(sqlite3_stmt* statement, const std::function<void(sqlite3_stmt*)>& row)
+	{
+		if (!statement)
+		{
+			return false;
+		}
+
+		int rc;
+		while ((rc = sqlite3_step(statement)) == SQLITE_ROW)
+		{
+			row(statement);
+		}
+
+		const bool ok = (rc == SQLITE_DONE);
+		if (ok)
 		{
-			if (input[i] == '\'')
+			int affected = sqlite3_changes(db);
+			if (affected)
 			{
-				output += "'";
+				logger->Debug(Languages::TextQueryAffected, sqlite3_sql(statement), affected);
+			}
+			else
+			{
+				logger->Debug(Languages::TextQuery, sqlite3_sql(statement));
 			}
-			output += input[i];
 		}
-		return output;
+		else
+		{
+			logger->Error(Languages::TextSQLiteErrorQuery, sqlite3_errmsg(db), sqlite3_sql(statement));
+		}
+
+		sqlite3_reset(statement);
+		sqlite3_clear_bindings(statement);
+		return ok;
 	}
 } // namespace Storage
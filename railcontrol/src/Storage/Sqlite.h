@@ -20,7 +20,10 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <functional>
 #include <map>
+#include <string>
+#include <vector>
 #include <sqlite3.h>
 
 #include "DataModel/DataModel.h"
@@ -43,21 +46,45 @@ namespace Storage
 			void SaveObject(const ObjectType objectType, const ObjectID objectID, const std::string& name, const std::string& object) override;
 			void DeleteObject(const ObjectType objectType, const ObjectID objectID) override;
 			void ObjectsOfType(const ObjectType objectType, std::vector<std::string>& objects) override;
+			void AllObjects(std::map<ObjectType,std::vector<std::string>>& objects) override;
 			void SaveRelation(const DataModel::Relation::RelationType type, const ObjectID objectID1, const ObjectType objectType2, const ObjectID objectID2, const Priority priority, const std::string& relation) override;
 			void DeleteRelationsFrom(const DataModel::Relation::RelationType type, const ObjectID objectID) override;
 			void DeleteRelationsTo(const ObjectType objectType, const ObjectID objectID) override;
 			void RelationsFrom(const DataModel::Relation::RelationType type, const ObjectID objectID, std::vector<std::string>& relations) override;
 			void RelationsTo(const ObjectType objectType, const ObjectID objectID, std::vector<std::string>& relations) override;
+			void AllRelations(std::map<DataModel::Relation::RelationType,std::map<ObjectID,std::vector<std::string>>>& relations) override;
 			void SaveSetting(const std::string& key, const std::string& value) override;
 			std::string GetSetting(const std::string& key) override;
 			void StartTransaction() override;
 			void CommitTransaction() override;
 
 		private:
+			enum Statement : unsigned char
+			{
+				StatementSaveHardwareParams = 0,
+				StatementDeleteHardwareParams,
+				StatementSaveObject,
+				StatementDeleteObject,
+				StatementObjectsOfType,
+				StatementSaveRelation,
+				StatementDeleteRelationsFrom,
+				StatementDeleteRelationsTo,
+				StatementRelationsFrom,
+				StatementRelationsTo,
+				StatementSaveSetting,
+				StatementGetSetting,
+				StatementAllObjects,
+				StatementAllRelations,
+				NumberOfStatements
+			};
+
+			static const char* const StatementQueries[NumberOfStatements];
+
 			sqlite3 *db;
 			const std::string filename;
 			Logger::Logger* logger;
 			unsigned int keepBackups;
+			sqlite3_stmt* statements[NumberOfStatements];
 
 			inline bool Execute(const std::string& query, sqlite3_callback callback = nullptr, void* result = nullptr)
 			{
@@ -65,6 +92,28 @@ namespace Storage
 			}
 
 			bool Execute(const char* query, sqlite3_callback callback, void* result);
+
+			void PrepareStatements();
+			void FinalizeStatements();
+
+			// returns the cached statement with all parameters bound, integers first, blobs last, or nullptr on error
+			sqlite3_stmt* BindStatement(const Statement statement,
+				const std::vector<int>& integers,
+				const std::vector<const std::string*>& texts = std::vector<const std::string*>(),
+				const std::vector<const std::string*>& blobs = std::vector<const std::string*>());
+
+			bool ExecuteStatement(sqlite3_stmt* statement, std::vector<std::string>* result = nullptr);
+
+			// calls row for every row of the result
+			bool ExecuteStatement(sqlite3_stmt* statement, const std::function<void(sqlite3_stmt*)>& row);
+
+			// blobs may contain zero bytes, so the length is taken from sqlite for texts and blobs
+			static inline std::string ColumnBlob(sqlite3_stmt* statement, const int column)
+			{
+				const char* data = static_cast<const char*>(sqlite3_column_blob(statement, column));
+				return data ? std::string(data, sqlite3_column_bytes(statement, column)) : std::string();
+			}
+
 			bool DropTable(const std::string table);
 			bool CreateTableHardware();
 			bool CreateTableObjects();
@@ -73,12 +122,13 @@ namespace Storage
 			bool CheckTableRelations();
 			bool UpdateTableRelations1();
 			bool RenameTable(const std::string& oldName, const std::string& newName);
+			bool CheckBinaryFormat();
+			bool ConvertToBinary(const std::string& table, const std::string& column, const std::map<long long, std::string>& rows);
 
 			static int CallbackTableInfo(void *v, int argc, char **argv, char **colName);
 			static int CallbackListTables(void *v, int argc, char **argv, char **colName);
+			static int CallbackRowIds(void *v, int argc, char **argv, char **colName);
 			static int CallbackAllHardwareParams(void *v, int argc, char **argv, char **colName);
-			static int CallbackStringVector(void* v, int argc, char **argv, char **colName);
-			static std::string EscapeString(const std::string& input);
 	};
 } // namespace Storage
 
@@ -18,6 +18,8 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
+#include <iterator>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -45,10 +47,197 @@ using std::vector;
 
 namespace Storage
 {
+	const std::chrono::milliseconds StorageHandler::WriteDelay(200);
+
+	StorageHandler::StorageHandler(Manager* manager, const StorageParams* params)
+	:	manager(manager),
+		sqlite(params),
+		run(true),
+		writerThread(&StorageHandler::Writer, this),
+		preloaded(false)
+	{
+	}
+
+	StorageHandler::~StorageHandler()
+	{
+		{
+			std::lock_guard<std::mutex> lock(writeMutex);
+			run = false;
+			writerCondition.notify_all();
+		}
+		writerThread.join();
+		Flush();
+	}
+
+	void StorageHandler::Enqueue(const string& key, const Write& write)
+	{
+		std::lock_guard<std::mutex> lock(writeMutex);
+		if (key.size())
+		{
+			// the previous write of the same object is obsolete, the new one is queued at the end
+			// so that it is still written after everything that has been queued before it
+			auto previous = writeKeys.find(key);
+			if (previous != writeKeys.end())
+			{
+				writes.erase(previous->second);
+			}
+		}
+		writes.push_back(std::make_pair(key, write));
+		if (key.size())
+		{
+			writeKeys[key] = std::prev(writes.end());
+		}
+		writerCondition.notify_all();
+	}
+
+	void StorageHandler::Flush()
+	{
+		// do not split writes of a TransactionGuard that is still open
+		std::lock_guard<std::mutex> transactionLock(transactionMutex);
+		std::list<std::pair<string,Write>> flushWrites;
+		{
+			std::lock_guard<std::mutex> lock(writeMutex);
+			flushWrites.swap(writes);
+			writeKeys.clear();
+		}
+		if (flushWrites.empty())
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> sqliteLock(sqliteMutex);
+		sqlite.StartTransaction();
+		for (auto& write : flushWrites)
+		{
+			write.second();
+		}
+		sqlite.CommitTransaction();
+	}
+
+	void StorageHandler::Writer()
+	{
+		Utils::Utils::SetThreadName("StorageWriter");
+		std::unique_lock<std::mutex> lock(writeMutex);
+		while (true)
+		{
+			if (writes.empty())
+			{
+				if (!run)
+				{
+					return;
+				}
+				writerCondition.wait(lock);
+				continue;
+			}
+
+			// give following writes of the same objects the chance to be coalesced
+			const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + WriteDelay;
+			while (run && writerCondition.wait_until(lock, deadline) != std::cv_status::timeout)
+			{
+			}
+
+			lock.unlock();
+			Flush();
+			lock.lock();
+		}
+	}
+
+	void StorageHandler::AllHardwareParams(map<ControlID,Hardware::HardwareParams*>& hardwareParams)
+	{
+		Flush();
+		std::lock_guard<std::mutex> sqliteLock(sqliteMutex);
+		sqlite.AllHardwareParams(hardwareParams);
+	}
+
+	void StorageHandler::DeleteHardwareParams(const ControlID controlID)
+	{
+		Enqueue("control " + std::to_string(controlID),
+			[this, controlID]()
+			{
+				sqlite.DeleteHardwareParams(controlID);
+			});
+	}
+
+	void StorageHandler::Save(const Hardware::HardwareParams& hardwareParams)
+	{
+		// HardwareParams can not be copied
+		std::shared_ptr<Hardware::HardwareParams> params = std::make_shared<Hardware::HardwareParams>(hardwareParams.GetControlID(),
+			hardwareParams.GetHardwareType(),
+			hardwareParams.GetName(),
+			hardwareParams.GetArg1(),
+			hardwareParams.GetArg2(),
+			hardwareParams.GetArg3(),
+			hardwareParams.GetArg4(),
+			hardwareParams.GetArg5());
+		Enqueue("control " + std::to_string(params->GetControlID()),
+			[this, params]()
+			{
+				sqlite.SaveHardwareParams(*params);
+			});
+	}
+
+	void StorageHandler::SaveSetting(const string& key, const string& value)
+	{
+		Enqueue("setting " + key,
+			[this, key, value]()
+			{
+				sqlite.SaveSetting(key, value);
+			});
+	}
+
+	string StorageHandler::GetSetting(const string& key)
+	{
+		Flush();
+		std::lock_guard<std::mutex> sqliteLock(sqliteMutex);
+		return sqlite.GetSetting(key);
+	}
+
+	void StorageHandler::Preload(size_t& nrOfObjects, size_t& nrOfRelations)
+	{
+		Flush();
+		std::lock_guard<std::mutex> preloadLock(preloadMutex);
+		{
+			std::lock_guard<std::mutex> sqliteLock(sqliteMutex);
+			sqlite.AllObjects(preloadedObjects);
+			sqlite.AllRelations(preloadedRelations);
+		}
+		preloaded = true;
+
+		nrOfObjects = 0;
+		for (auto& objects : preloadedObjects)
+		{
+			nrOfObjects += objects.second.size();
+		}
+		nrOfRelations = 0;
+		for (auto& relationsOfType : preloadedRelations)
+		{
+			for (auto& relations : relationsOfType.second)
+			{
+				nrOfRelations += relations.second.size();
+			}
+		}
+	}
+
+	void StorageHandler::ReleasePreload()
+	{
+		std::lock_guard<std::mutex> preloadLock(preloadMutex);
+		preloaded = false;
+		preloadedObjects.clear();
+		preloadedRelations.clear();
+	}
+
+	void StorageHandler::DeleteObject(const ObjectType objectType, const ObjectID objectID)
+	{
+		Enqueue(ObjectKey(objectType, objectID),
+			[this, objectType, objectID]()
+			{
+				sqlite.DeleteObject(objectType, objectID);
+			});
+	}
+
 	void StorageHandler::AllLocos(map<LocoID,DataModel::Loco*>& locos)
 	{
-		vector<string> serializedObjects;
-		sqlite.ObjectsOfType(ObjectTypeLoco, serializedObjects);
+		const vector<string> serializedObjects = ObjectsOfType(ObjectTypeLoco);
 		for (auto& serializedObject : serializedObjects)
 		{
 			Loco* loco = new Loco(manager, serializedObject);
@@ -62,15 +251,18 @@ namespace Storage
 
 	void StorageHandler::DeleteLoco(const LocoID locoID)
 	{
-		sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeLocoSlave, locoID);
-		sqlite.DeleteRelationsTo(ObjectTypeLoco, locoID);
-		sqlite.DeleteObject(ObjectTypeLoco, locoID);
+		Enqueue(ObjectKey(ObjectTypeLoco, locoID),
+			[this, locoID]()
+			{
+				sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeLocoSlave, locoID);
+				sqlite.DeleteRelationsTo(ObjectTypeLoco, locoID);
+				sqlite.DeleteObject(ObjectTypeLoco, locoID);
+			});
 	}
 
 	void StorageHandler::AllMultipleUnits(map<MultipleUnitID,DataModel::MultipleUnit*>& multipleUnits)
 	{
-		vector<string> serializedObjects;
-		sqlite.ObjectsOfType(ObjectTypeMultipleUnit, serializedObjects);
+		const vector<string> serializedObjects = ObjectsOfType(ObjectTypeMultipleUnit);
 		for (auto& serializedObject : serializedObjects)
 		{
 			MultipleUnit* multipleUnit = new MultipleUnit(manager, serializedObject);
@@ -86,15 +278,18 @@ namespace Storage
 
 	void StorageHandler::DeleteMultipleUnit(const MultipleUnitID multipleUnitID)
 	{
-		sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeMultipleUnitLoco, multipleUnitID);
-		sqlite.DeleteRelationsTo(ObjectTypeMultipleUnit, multipleUnitID);
-		sqlite.DeleteObject(ObjectTypeMultipleUnit, multipleUnitID);
+		Enqueue(ObjectKey(ObjectTypeMultipleUnit, multipleUnitID),
+			[this, multipleUnitID]()
+			{
+				sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeMultipleUnitLoco, multipleUnitID);
+				sqlite.DeleteRelationsTo(ObjectTypeMultipleUnit, multipleUnitID);
+				sqlite.DeleteObject(ObjectTypeMultipleUnit, multipleUnitID);
+			});
 	}
 
 	void StorageHandler::AllAccessories(std::map<AccessoryID,DataModel::Accessory*>& accessories)
 	{
-		vector<string> serializedObjects;
-		sqlite.ObjectsOfType(ObjectTypeAccessory, serializedObjects);
+		const vector<string> serializedObjects = ObjectsOfType(ObjectTypeAccessory);
 		for (auto& serializedObject : serializedObjects)
 		{
 			Accessory* accessory = new Accessory(serializedObject);
@@ -108,8 +303,7 @@ namespace Storage
 
 	void StorageHandler::AllFeedbacks(std::map<FeedbackID,DataModel::Feedback*>& feedbacks)
 	{
-		vector<string> serializedObjects;
-		sqlite.ObjectsOfType(ObjectTypeFeedback, serializedObjects);
+		const vector<string> serializedObjects = ObjectsOfType(ObjectTypeFeedback);
 		for (auto& serializedObject : serializedObjects)
 		{
 			Feedback* feedback = new Feedback(manager, serializedObject);
@@ -123,8 +317,7 @@ namespace Storage
 
 	void StorageHandler::AllTracks(std::map<TrackID,DataModel::Track*>& tracks)
 	{
-		vector<string> serializedObjects;
-		sqlite.ObjectsOfType(ObjectTypeTrack, serializedObjects);
+		const vector<string> serializedObjects = ObjectsOfType(ObjectTypeTrack);
 		for (auto& serializedObject : serializedObjects)
 		{
 			Track* track = new Track(manager, serializedObject);
@@ -149,16 +342,19 @@ namespace Storage
 
 	void StorageHandler::DeleteTrack(const TrackID trackID)
 	{
-		sqlite.DeleteRelationsFrom(Relation::RelationTypeTrackSignal, trackID);
-		sqlite.DeleteRelationsFrom(Relation::RelationTypeTrackFeedback, trackID);
-		sqlite.DeleteRelationsTo(ObjectTypeTrack, trackID);
-		sqlite.DeleteObject(ObjectTypeTrack, trackID);
+		Enqueue(ObjectKey(ObjectTypeTrack, trackID),
+			[this, trackID]()
+			{
+				sqlite.DeleteRelationsFrom(Relation::RelationTypeTrackSignal, trackID);
+				sqlite.DeleteRelationsFrom(Relation::RelationTypeTrackFeedback, trackID);
+				sqlite.DeleteRelationsTo(ObjectTypeTrack, trackID);
+				sqlite.DeleteObject(ObjectTypeTrack, trackID);
+			});
 	}
 
 	void StorageHandler::AllSwitches(std::map<SwitchID,DataModel::Switch*>& switches)
 	{
-		vector<string> serializedObjects;
-		sqlite.ObjectsOfType(ObjectTypeSwitch, serializedObjects);
+		const vector<string> serializedObjects = ObjectsOfType(ObjectTypeSwitch);
 		for (auto& serializedObject : serializedObjects)
 		{
 			Switch* mySwitch = new Switch(serializedObject);
@@ -174,56 +370,87 @@ namespace Storage
 	{
 		const string serialized = route.Serialize();
 		const RouteID routeID = route.GetID();
-		sqlite.SaveObject(ObjectTypeRoute, routeID, route.GetName(), serialized);
-		sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeRouteAtLock, routeID);
-		SaveRelations(route.GetRelationsAtLock());
-		sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeRouteAtUnlock, routeID);
-		SaveRelations(route.GetRelationsAtUnlock());
-		sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeRouteConditions, routeID);
-		SaveRelations(route.GetRelationsConditions());
+		const string name = route.GetName();
+		const vector<SerializedRelation> relationsAtLock = SerializeRelations(route.GetRelationsAtLock());
+		const vector<SerializedRelation> relationsAtUnlock = SerializeRelations(route.GetRelationsAtUnlock());
+		const vector<SerializedRelation> relationsConditions = SerializeRelations(route.GetRelationsConditions());
+		Enqueue(ObjectKey(ObjectTypeRoute, routeID),
+			[this, serialized, routeID, name, relationsAtLock, relationsAtUnlock, relationsConditions]()
+			{
+				sqlite.SaveObject(ObjectTypeRoute, routeID, name, serialized);
+				sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeRouteAtLock, routeID);
+				SaveRelations(relationsAtLock);
+				sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeRouteAtUnlock, routeID);
+				SaveRelations(relationsAtUnlock);
+				sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeRouteConditions, routeID);
+				SaveRelations(relationsConditions);
+			});
 	}
 
 	void StorageHandler::Save(const DataModel::Loco& loco)
 	{
 		const string serialized = loco.Serialize();
 		const LocoID locoID = loco.GetID();
-		sqlite.SaveObject(ObjectTypeLoco, locoID, loco.GetName(), serialized);
-		sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeLocoSlave, locoID);
+		const string name = loco.GetName();
+		Enqueue(ObjectKey(ObjectTypeLoco, locoID),
+			[this, serialized, locoID, name]()
+			{
+				sqlite.SaveObject(ObjectTypeLoco, locoID, name, serialized);
+				sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeLocoSlave, locoID);
+			});
 	}
 
 	void StorageHandler::Save(const DataModel::MultipleUnit& multipleUnit)
 	{
 		const string serialized = multipleUnit.Serialize();
 		const MultipleUnitID multipleUnitID = multipleUnit.GetID();
-		sqlite.SaveObject(ObjectTypeMultipleUnit, multipleUnitID, multipleUnit.GetName(), serialized);
-		sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeMultipleUnitLoco, multipleUnitID);
-		SaveRelations(multipleUnit.GetSlaves());
+		const string name = multipleUnit.GetName();
+		const vector<SerializedRelation> slaves = SerializeRelations(multipleUnit.GetSlaves());
+		Enqueue(ObjectKey(ObjectTypeMultipleUnit, multipleUnitID),
+			[this, serialized, multipleUnitID, name, slaves]()
+			{
+				sqlite.SaveObject(ObjectTypeMultipleUnit, multipleUnitID, name, serialized);
+				sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeMultipleUnitLoco, multipleUnitID);
+				SaveRelations(slaves);
+			});
 	}
 
 	void StorageHandler::Save(const DataModel::Cluster& cluster)
 	{
 		const string serialized = cluster.Serialize();
 		const ClusterID clusterID = cluster.GetID();
-		sqlite.SaveObject(ObjectTypeCluster, clusterID, cluster.GetName(), serialized);
-		sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeClusterTrack, clusterID);
-		SaveRelations(cluster.GetTracks());
+		const string name = cluster.GetName();
+		const vector<SerializedRelation> tracks = SerializeRelations(cluster.GetTracks());
+		Enqueue(ObjectKey(ObjectTypeCluster, clusterID),
+			[this, serialized, clusterID, name, tracks]()
+			{
+				sqlite.SaveObject(ObjectTypeCluster, clusterID, name, serialized);
+				sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeClusterTrack, clusterID);
+				SaveRelations(tracks);
+			});
 	}
 
 	void StorageHandler::Save(const DataModel::Track& track)
 	{
 		const string serialized = track.Serialize();
 		const TrackID trackId = track.GetID();
-		sqlite.SaveObject(ObjectTypeTrack, trackId, track.GetName(), serialized);
-		sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeTrackFeedback, trackId);
-		SaveRelations(track.GetFeedbacks());
-		sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeTrackSignal, trackId);
-		SaveRelations(track.GetSignals());
+		const string name = track.GetName();
+		const vector<SerializedRelation> feedbacks = SerializeRelations(track.GetFeedbacks());
+		const vector<SerializedRelation> signals = SerializeRelations(track.GetSignals());
+		Enqueue(ObjectKey(ObjectTypeTrack, trackId),
+			[this, serialized, trackId, name, feedbacks, signals]()
+			{
+				sqlite.SaveObject(ObjectTypeTrack, trackId, name, serialized);
+				sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeTrackFeedback, trackId);
+				SaveRelations(feedbacks);
+				sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeTrackSignal, trackId);
+				SaveRelations(signals);
+			});
 	}
 
 	void StorageHandler::AllRoutes(std::map<RouteID,DataModel::Route*>& routes)
 	{
-		vector<string> serializedObjects;
-		sqlite.ObjectsOfType(ObjectTypeRoute, serializedObjects);
+		const vector<string> serializedObjects = ObjectsOfType(ObjectTypeRoute);
 		for (auto& serializedObject : serializedObjects)
 		{
 			Route* route = new Route(manager, serializedObject);
@@ -241,15 +468,18 @@ namespace Storage
 
 	void StorageHandler::DeleteRoute(const RouteID routeID)
 	{
-		sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeRouteAtLock, routeID);
-		sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeRouteAtUnlock, routeID);
-		sqlite.DeleteObject(ObjectTypeRoute, routeID);
+		Enqueue(ObjectKey(ObjectTypeRoute, routeID),
+			[this, routeID]()
+			{
+				sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeRouteAtLock, routeID);
+				sqlite.DeleteRelationsFrom(DataModel::Relation::RelationTypeRouteAtUnlock, routeID);
+				sqlite.DeleteObject(ObjectTypeRoute, routeID);
+			});
 	}
 
 	void StorageHandler::AllLayers(std::map<LayerID,DataModel::Layer*>& layers)
 	{
-		vector<string> serializedObjects;
-		sqlite.ObjectsOfType(ObjectTypeLayer, serializedObjects);
+		const vector<string> serializedObjects = ObjectsOfType(ObjectTypeLayer);
 		for (auto& serializedObject : serializedObjects)
 		{
 			Layer* layer = new Layer(serializedObject);
@@ -263,8 +493,7 @@ namespace Storage
 
 	void StorageHandler::AllSignals(std::map<SignalID,DataModel::Signal*>& signals)
 	{
-		vector<string> serializedObjects;
-		sqlite.ObjectsOfType(ObjectTypeSignal, serializedObjects);
+		const vector<string> serializedObjects = ObjectsOfType(ObjectTypeSignal);
 		for (auto& serializedObject : serializedObjects)
 		{
 			Signal* signal = new Signal(manager, serializedObject);
@@ -278,14 +507,17 @@ namespace Storage
 
 	void StorageHandler::DeleteSignal(const SignalID signalID)
 	{
-		sqlite.DeleteRelationsTo(ObjectTypeSignal, signalID);
-		sqlite.DeleteObject(ObjectTypeSignal, signalID);
+		Enqueue(ObjectKey(ObjectTypeSignal, signalID),
+			[this, signalID]()
+			{
+				sqlite.DeleteRelationsTo(ObjectTypeSignal, signalID);
+				sqlite.DeleteObject(ObjectTypeSignal, signalID);
+			});
 	}
 
 	void StorageHandler::AllClusters(std::map<ClusterID,DataModel::Cluster*>& clusters)
 	{
-		vector<string> serializedObjects;
-		sqlite.ObjectsOfType(ObjectTypeCluster, serializedObjects);
+		const vector<string> serializedObjects = ObjectsOfType(ObjectTypeCluster);
 		for (auto& serializedObject : serializedObjects)
 		{
 			Cluster* cluster = new Cluster(manager, serializedObject);
@@ -301,8 +533,7 @@ namespace Storage
 
 	void StorageHandler::AllTexts(std::map<TextID,DataModel::Text*>& texts)
 	{
-		vector<string> serializedObjects;
-		sqlite.ObjectsOfType(ObjectTypeText, serializedObjects);
+		const vector<string> serializedObjects = ObjectsOfType(ObjectTypeText);
 		for (auto& serializedObject : serializedObjects)
 		{
 			Text* text = new Text(serializedObject);
@@ -316,8 +547,7 @@ namespace Storage
 
 	void StorageHandler::AllCounters(std::map<CounterID,DataModel::Counter*>& counters)
 	{
-		vector<string> serializedObjects;
-		sqlite.ObjectsOfType(ObjectTypeCounter, serializedObjects);
+		const vector<string> serializedObjects = ObjectsOfType(ObjectTypeCounter);
 		for (auto& serializedObject : serializedObjects)
 		{
 			Counter* counter = new Counter(serializedObject);
@@ -329,19 +559,80 @@ namespace Storage
 		}
 	}
 
-	void StorageHandler::SaveRelations(const vector<DataModel::Relation*> relations)
+	vector<StorageHandler::SerializedRelation> StorageHandler::SerializeRelations(const vector<DataModel::Relation*>& relations)
 	{
+		vector<SerializedRelation> output;
 		for (auto relation : relations)
 		{
-			string serializedRelation = relation->Serialize();
-			sqlite.SaveRelation(relation->GetType(), relation->ObjectID1(), relation->ObjectType2(), relation->ObjectID2(), relation->GetPriority(), serializedRelation);
+			SerializedRelation serializedRelation;
+			serializedRelation.type = relation->GetType();
+			serializedRelation.objectID1 = relation->ObjectID1();
+			serializedRelation.objectType2 = relation->ObjectType2();
+			serializedRelation.objectID2 = relation->ObjectID2();
+			serializedRelation.priority = relation->GetPriority();
+			serializedRelation.relation = relation->Serialize();
+			output.push_back(serializedRelation);
 		}
+		return output;
+	}
+
+	void StorageHandler::SaveRelations(const vector<SerializedRelation>& relations)
+	{
+		for (auto& relation : relations)
+		{
+			sqlite.SaveRelation(relation.type, relation.objectID1, relation.objectType2, relation.objectID2, relation.priority, relation.relation);
+		}
+	}
+
+	vector<string> StorageHandler::ObjectsOfType(const ObjectType objectType)
+	{
+		vector<string> serializedObjects;
+		{
+			// every type is read once at startup, so the preloaded objects are handed over
+			std::lock_guard<std::mutex> preloadLock(preloadMutex);
+			if (preloaded)
+			{
+				auto objects = preloadedObjects.find(objectType);
+				if (objects != preloadedObjects.end())
+				{
+					serializedObjects.swap(objects->second);
+					preloadedObjects.erase(objects);
+				}
+				return serializedObjects;
+			}
+		}
+
+		Flush();
+		std::lock_guard<std::mutex> sqliteLock(sqliteMutex);
+		sqlite.ObjectsOfType(objectType, serializedObjects);
+		return serializedObjects;
 	}
 
 	vector<Relation*> StorageHandler::RelationsFrom(const DataModel::Relation::RelationType type, const ObjectID objectID)
 	{
 		vector<string> relationStrings;
-		sqlite.RelationsFrom(type, objectID, relationStrings);
+		std::unique_lock<std::mutex> preloadLock(preloadMutex);
+		if (preloaded)
+		{
+			// an object without relations has no entry in the preloaded relations
+			auto relationsOfType = preloadedRelations.find(type);
+			if (relationsOfType != preloadedRelations.end())
+			{
+				auto relations = relationsOfType->second.find(objectID);
+				if (relations != relationsOfType->second.end())
+				{
+					relationStrings.swap(relations->second);
+					relationsOfType->second.erase(relations);
+				}
+			}
+			preloadLock.unlock();
+		}
+		else
+		{
+			preloadLock.unlock();
+			std::lock_guard<std::mutex> sqliteLock(sqliteMutex);
+			sqlite.RelationsFrom(type, objectID, relationStrings);
+		}
 		vector<Relation*> output;
 		for (auto& relationString : relationStrings)
 		{
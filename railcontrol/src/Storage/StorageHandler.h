@@ -20,8 +20,15 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
-#include <vector>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
 #include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "DataModel/DataModel.h"
 #include "DataTypes.h"
@@ -33,29 +40,19 @@ along with RailControl; see the file LICENCE. If not see
 
 namespace Storage
 {
+	// Writes are queued and written behind by a writer thread. Writes of the same object within
+	// WriteDelay are coalesced, and every flush is written in a single transaction. Writes queued
+	// inside a TransactionGuard are never split over two flushes. Reads flush all pending writes first.
 	class StorageHandler
 	{
 		public:
-			inline StorageHandler(Manager* manager, const StorageParams* params)
-			:	manager(manager),
-				sqlite(params)
-			{
-			}
-
-			inline ~StorageHandler()
-			{
-			}
-
-			inline void AllHardwareParams(std::map<ControlID,Hardware::HardwareParams*>& hardwareParams)
-			{
-				sqlite.AllHardwareParams(hardwareParams);
-			}
+			StorageHandler(Manager* manager, const StorageParams* params);
 
-			inline void DeleteHardwareParams(const ControlID controlID)
-			{
-				sqlite.DeleteHardwareParams(controlID);
-			}
+			// writes all pending writes before returning
+			~StorageHandler();
 
+			void AllHardwareParams(std::map<ControlID,Hardware::HardwareParams*>& hardwareParams);
+			void DeleteHardwareParams(const ControlID controlID);
 			void AllLocos(std::map<LocoID,DataModel::Loco*>& locos);
 			void DeleteLoco(LocoID locoID);
 			void AllMultipleUnits(std::map<LocoID,DataModel::MultipleUnit*>& multipleUnits);
@@ -64,14 +61,14 @@ namespace Storage
 
 			inline void DeleteAccessory(AccessoryID accessoryID)
 			{
-				sqlite.DeleteObject(ObjectTypeAccessory, accessoryID);
+				DeleteObject(ObjectTypeAccessory, accessoryID);
 			}
 
 			void AllFeedbacks(std::map<FeedbackID,DataModel::Feedback*>& feedbacks);
 
 			inline void DeleteFeedback(FeedbackID feedbackID)
 			{
-				sqlite.DeleteObject(ObjectTypeFeedback, feedbackID);
+				DeleteObject(ObjectTypeFeedback, feedbackID);
 			}
 
 			void AllTracks(std::map<TrackID,DataModel::Track*>& tracks);
@@ -80,7 +77,7 @@ namespace Storage
 
 			inline void DeleteSwitch(SwitchID switchID)
 			{
-				sqlite.DeleteObject(ObjectTypeSwitch, switchID);
+				DeleteObject(ObjectTypeSwitch, switchID);
 			}
 
 			void AllRoutes(std::map<RouteID,DataModel::Route*>& routes);
@@ -89,7 +86,7 @@ namespace Storage
 
 			inline void DeleteLayer(LayerID layerID)
 			{
-				sqlite.DeleteObject(ObjectTypeLayer, layerID);
+				DeleteObject(ObjectTypeLayer, layerID);
 			}
 
 			void AllSignals(std::map<SignalID,DataModel::Signal*>& signals);
@@ -98,28 +95,24 @@ namespace Storage
 
 			inline void DeleteCluster(ClusterID clusterID)
 			{
-				sqlite.DeleteObject(ObjectTypeCluster, clusterID);
+				DeleteObject(ObjectTypeCluster, clusterID);
 			}
 
 			void AllTexts(std::map<TextID,DataModel::Text*>& texts);
 
 			inline void DeleteText(TextID textID)
 			{
-				sqlite.DeleteObject(ObjectTypeText, textID);
+				DeleteObject(ObjectTypeText, textID);
 			}
 
 			void AllCounters(std::map<CounterID,DataModel::Counter*>& counters);
 
 			inline void DeleteCounter(CounterID counterID)
 			{
-				sqlite.DeleteObject(ObjectTypeCounter, counterID);
-			}
-
-			inline void Save(const Hardware::HardwareParams& hardwareParams)
-			{
-				sqlite.SaveHardwareParams(hardwareParams);
+				DeleteObject(ObjectTypeCounter, counterID);
 			}
 
+			void Save(const Hardware::HardwareParams& hardwareParams);
 			void Save(const DataModel::Route& route);
 			void Save(const DataModel::Loco& loco);
 			void Save(const DataModel::MultipleUnit& multipleUnit);
@@ -128,8 +121,15 @@ namespace Storage
 
 			template<class T> void Save(const T& t)
 			{
+				const ObjectType objectType = t.GetObjectType();
+				const ObjectID objectID = t.GetID();
+				const std::string name = t.GetName();
 				const std::string serialized = t.Serialize();
-				sqlite.SaveObject(t.GetObjectType(), t.GetID(), t.GetName(), serialized);
+				Enqueue(ObjectKey(objectType, objectID),
+					[this, objectType, objectID, name, serialized]()
+					{
+						sqlite.SaveObject(objectType, objectID, name, serialized);
+					});
 			}
 
 			template <class T> static void Save(StorageHandler* storageHandler, const T* t)
@@ -137,36 +137,76 @@ namespace Storage
 				storageHandler->Save(*t);
 			}
 
-			inline void SaveSetting(const std::string& key, const std::string& value)
-			{
-				sqlite.SaveSetting(key, value);
-			}
+			void SaveSetting(const std::string& key, const std::string& value);
 
+			std::string GetSetting(const std::string& key);
 
-			inline std::string GetSetting(const std::string& key)
-			{
-				return sqlite.GetSetting(key);
-			}
+			// reads all objects and relations in a single pass, the All* calls take their objects and
+			// relations from there and may run in parallel until ReleasePreload is called
+			void Preload(size_t& nrOfObjects, size_t& nrOfRelations);
+			void ReleasePreload();
 
 			inline void StartTransaction()
 			{
 				transactionMutex.lock();
-				sqlite.StartTransaction();
 			}
 
 			inline void CommitTransaction()
 			{
-				sqlite.CommitTransaction();
 				transactionMutex.unlock();
+				writerCondition.notify_all();
 			}
 
 		private:
-			void SaveRelations(const std::vector<DataModel::Relation*> relations);
+			struct SerializedRelation
+			{
+				DataModel::Relation::RelationType type;
+				ObjectID objectID1;
+				ObjectType objectType2;
+				ObjectID objectID2;
+				Priority priority;
+				std::string relation;
+			};
+
+			typedef std::function<void()> Write;
+
+			static const std::chrono::milliseconds WriteDelay;
+
+			static inline std::string ObjectKey(const ObjectType objectType, const ObjectID objectID)
+			{
+				return "object " + std::to_string(objectType) + " " + std::to_string(objectID);
+			}
+
+			// an empty key never gets coalesced
+			void Enqueue(const std::string& key, const Write& write);
+
+			void Flush();
+
+			void Writer();
+
+			void DeleteObject(const ObjectType objectType, const ObjectID objectID);
+
+			static std::vector<SerializedRelation> SerializeRelations(const std::vector<DataModel::Relation*>& relations);
+			void SaveRelations(const std::vector<SerializedRelation>& relations);
+			std::vector<std::string> ObjectsOfType(const ObjectType objectType);
 			std::vector<DataModel::Relation*> RelationsFrom(const DataModel::Relation::RelationType type, const ObjectID objectID);
 
 			Manager* manager;
 			Storage::SQLite sqlite;
+			std::mutex sqliteMutex;
 			std::mutex transactionMutex;
+
+			std::list<std::pair<std::string,Write>> writes;
+			std::map<std::string,std::list<std::pair<std::string,Write>>::iterator> writeKeys;
+			std::mutex writeMutex;
+			std::condition_variable writerCondition;
+			volatile bool run;
+			std::thread writerThread;
+
+			bool preloaded;
+			std::map<ObjectType,std::vector<std::string>> preloadedObjects;
+			std::map<DataModel::Relation::RelationType,std::map<ObjectID,std::vector<std::string>>> preloadedRelations;
+			std::mutex preloadMutex;
 	};
 } // namespace Storage
 
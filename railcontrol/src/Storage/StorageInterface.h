@@ -55,6 +55,9 @@ namespace Storage
 			// read datamodelobject
 			virtual void ObjectsOfType(const ObjectType objectType, std::vector<std::string>& objects) = 0;
 
+			// read all datamodelobjects ordered by type
+			virtual void AllObjects(std::map<ObjectType,std::vector<std::string>>& objects) = 0;
+
 			// save datamodelrelation
 			virtual void SaveRelation(const DataModel::Relation::RelationType type, const ObjectID objectID1, const ObjectType objectType2, const ObjectID objectID2, const Priority priority, const std::string& relation) = 0;
 
@@ -70,6 +73,9 @@ namespace Storage
 			// read datamodelrelation
 			virtual void RelationsTo(const ObjectType objectType, const ObjectID objectID, std::vector<std::string>& relations) = 0;
 
+			// read all datamodelrelations ordered by type and object
+			virtual void AllRelations(std::map<DataModel::Relation::RelationType,std::map<ObjectID,std::vector<std::string>>>& relations) = 0;
+
 			// save setting
 			virtual void SaveSetting(const std::string& key, const std::string& value) = 0;
 
@@ -0,0 +1,111 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <iterator>
+
+#include "Utils/CoalescingQueue.h"
+
+using std::chrono::steady_clock;
+
+namespace Utils
+{
+	bool CoalescingQueue::Push(const unsigned long long object,
+		const unsigned int kind,
+		const std::function<void()>& call)
+	{
+		Entry entry;
+		entry.sequence = ++sequence;
+		entry.object = object;
+		entry.kind = kind;
+		entry.call = call;
+		entry.posted = steady_clock::now();
+
+		bool added = true;
+		auto last = lastOfObject.find(object);
+		if (last != lastOfObject.end() && last->second->kind == kind)
+		{
+			// the latency counts from the replaced call on, the value has been waiting since then
+			entry.posted = last->second->posted;
+			queue.erase(last->second);
+			added = false;
+		}
+		queue.push_back(std::move(entry));
+		lastOfObject[object] = std::prev(queue.end());
+		return added;
+	}
+
+	void CoalescingQueue::PushUrgent(const std::function<void()>& call)
+	{
+		Entry entry;
+		entry.sequence = ++sequence;
+		entry.object = 0;
+		entry.kind = 0;
+		entry.call = call;
+		entry.posted = steady_clock::now();
+		urgentQueue.push_back(std::move(entry));
+	}
+
+	void CoalescingQueue::PushUrgent(const unsigned long long object,
+		const unsigned int kind,
+		const std::function<void()>& call)
+	{
+		// urgent calls are rare, so walking through the waiting calls is good enough
+		for (auto& entry : queue)
+		{
+			if (entry.object == object && entry.kind == kind)
+			{
+				entry.call = call;
+			}
+		}
+		PushUrgent(call);
+	}
+
+	bool CoalescingQueue::Pop(Entry& entry)
+	{
+		if (!urgentQueue.empty())
+		{
+			entry = std::move(urgentQueue.front());
+			urgentQueue.pop_front();
+			return true;
+		}
+
+		if (queue.empty())
+		{
+			return false;
+		}
+
+		auto front = queue.begin();
+		auto last = lastOfObject.find(front->object);
+		if (last != lastOfObject.end() && last->second == front)
+		{
+			lastOfObject.erase(last);
+		}
+		entry = std::move(*front);
+		queue.pop_front();
+		return true;
+	}
+
+	bool CoalescingQueue::IsPoppedUpTo(const unsigned long long sequence) const
+	{
+		// both queues are sorted by sequence, a replaced call keeps its earlier position
+		return (queue.empty() || queue.front().sequence > sequence)
+			&& (urgentQueue.empty() || urgentQueue.front().sequence > sequence);
+	}
+} // namespace Utils
@@ -0,0 +1,102 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+
+namespace Utils
+{
+	// Queue of calls in which a waiting call is replaced by a newer one of the same object and kind
+	// as long as no other call of that object has been queued behind it.
+	// The newer call takes the place at the end of the queue, so it never overtakes calls posted before it.
+	// Urgent calls are returned in order before all other calls.
+	// The queue is not thread safe, the owner has to lock it.
+	class CoalescingQueue
+	{
+		public:
+			struct Entry
+			{
+				unsigned long long sequence;
+				unsigned long long object;
+				unsigned int kind;
+				std::function<void()> call;
+				std::chrono::steady_clock::time_point posted;
+			};
+
+			CoalescingQueue(const CoalescingQueue&) = delete;
+			CoalescingQueue& operator=(const CoalescingQueue&) = delete;
+
+			inline CoalescingQueue()
+			:	sequence(0)
+			{
+			}
+
+			// returns false if a waiting call has been replaced instead of only adding a new one
+			bool Push(const unsigned long long object,
+				const unsigned int kind,
+				const std::function<void()>& call);
+
+			void PushUrgent(const std::function<void()>& call);
+
+			// pushes an urgent call and replaces all waiting calls of the same object and kind with it,
+			// so that none of them can undo the urgent one after it has been delivered
+			void PushUrgent(const unsigned long long object,
+				const unsigned int kind,
+				const std::function<void()>& call);
+
+			bool Pop(Entry& entry);
+
+			inline bool IsEmpty() const
+			{
+				return queue.empty() && urgentQueue.empty();
+			}
+
+			inline bool HasUrgent() const
+			{
+				return !urgentQueue.empty();
+			}
+
+			inline size_t GetSize() const
+			{
+				return queue.size() + urgentQueue.size();
+			}
+
+			// sequence number of the last pushed call
+			inline unsigned long long GetSequence() const
+			{
+				return sequence;
+			}
+
+			// true if no call pushed up to sequence is waiting anymore
+			bool IsPoppedUpTo(const unsigned long long sequence) const;
+
+		private:
+			std::list<Entry> queue;
+			std::deque<Entry> urgentQueue;
+			// last waiting call of each object, only this one may be replaced
+			std::map<unsigned long long,std::list<Entry>::iterator> lastOfObject;
+			unsigned long long sequence;
+	};
+} // namespace Utils
@@ -0,0 +1,87 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <string>
+
+#include "Utils/LatencyHistogram.h"
+
+using std::string;
+using std::to_string;
+
+namespace Utils
+{
+	LatencyHistogram::LatencyHistogram()
+	{
+		Reset();
+	}
+
+	void LatencyHistogram::Add(const std::chrono::steady_clock::duration latency)
+	{
+		long long microSeconds = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+		if (microSeconds < 0)
+		{
+			microSeconds = 0;
+		}
+		const unsigned long long value = static_cast<unsigned long long>(microSeconds);
+
+		unsigned char bucket = 0;
+		while (bucket < NumberOfBuckets - 1 && (value >> bucket) != 0)
+		{
+			++bucket;
+		}
+		++buckets[bucket];
+		++count;
+		sum += value;
+
+		unsigned long long oldMax = max;
+		while (value > oldMax && !max.compare_exchange_weak(oldMax, value))
+		{
+		}
+	}
+
+	void LatencyHistogram::Reset()
+	{
+		for (unsigned char bucket = 0; bucket < NumberOfBuckets; ++bucket)
+		{
+			buckets[bucket] = 0;
+		}
+		count = 0;
+		sum = 0;
+		max = 0;
+	}
+
+	string LatencyHistogram::ToCsv(const string& name) const
+	{
+		string out;
+		for (unsigned char bucket = 0; bucket < NumberOfBuckets; ++bucket)
+		{
+			const unsigned long long bucketCount = buckets[bucket];
+			if (bucketCount == 0)
+			{
+				continue;
+			}
+			out += name + ";bucket;";
+			out += (bucket == NumberOfBuckets - 1 ? string("inf") : to_string(1ULL << bucket)) + ";";
+			out += to_string(bucketCount) + "\n";
+		}
+		out += name + ";total;" + to_string(count) + ";" + to_string(sum) + ";" + to_string(max) + "\n";
+		return out;
+	}
+} // namespace Utils
@@ -0,0 +1,65 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+namespace Utils
+{
+	// Thread safe latency histogram with logarithmic buckets in microseconds.
+	// Bucket n counts latencies below 2^n microseconds, the last bucket counts everything above.
+	class LatencyHistogram
+	{
+		public:
+			static const unsigned char NumberOfBuckets = 24;
+
+			LatencyHistogram();
+
+			LatencyHistogram(const LatencyHistogram&) = delete;
+			LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+			void Add(const std::chrono::steady_clock::duration latency);
+
+			inline void Add(const std::chrono::steady_clock::time_point start)
+			{
+				Add(std::chrono::steady_clock::now() - start);
+			}
+
+			inline unsigned long long GetCount() const
+			{
+				return count;
+			}
+
+			void Reset();
+
+			// returns one CSV line per non empty bucket: name;bucket;upper limit in us;count
+			// followed by a summary line: name;total;count;sum in us;max in us
+			std::string ToCsv(const std::string& name) const;
+
+		private:
+			std::atomic<unsigned long long> buckets[NumberOfBuckets];
+			std::atomic<unsigned long long> count;
+			std::atomic<unsigned long long> sum;
+			std::atomic<unsigned long long> max;
+	};
+} // namespace Utils
@@ -0,0 +1,288 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace Utils
+{
+	// Bounded queue for one consumer on a fixed ring of slots, enqueueing and dequeueing do not lock.
+	// With MultipleProducers any number of threads may enqueue, otherwise only one.
+	// The mutex is only used to put a waiting consumer or producer to sleep and to wake it up again.
+	template<class T, size_t Capacity, bool MultipleProducers>
+	class RingQueue
+	{
+		static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+		public:
+			RingQueue(const RingQueue&) = delete;
+			RingQueue& operator=(const RingQueue&) = delete;
+
+			inline RingQueue()
+			:	enqueuePosition(0),
+				dequeuePosition(0),
+				consumerWaiting(false),
+				producersWaiting(0),
+				run(true)
+			{
+				for (size_t i = 0; i < Capacity; ++i)
+				{
+					slots[i].sequence.store(i, std::memory_order_relaxed);
+				}
+			}
+
+			inline ~RingQueue()
+			{
+				Terminate();
+			}
+
+			// returns false if the queue is full, value is only moved away on success
+			bool TryEnqueue(T& value)
+			{
+				size_t position = enqueuePosition.load(std::memory_order_relaxed);
+				Slot* slot;
+				while (true)
+				{
+					slot = &slots[position & Mask];
+					const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+					const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+					if (difference < 0)
+					{
+						return false;
+					}
+					if (difference > 0)
+					{
+						// another producer has taken this slot
+						position = enqueuePosition.load(std::memory_order_relaxed);
+						continue;
+					}
+					if (!MultipleProducers)
+					{
+						enqueuePosition.store(position + 1, std::memory_order_relaxed);
+						break;
+					}
+					if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				slot->value = std::move(value);
+				slot->sequence.store(position + 1, std::memory_order_release);
+				WakeupConsumer();
+				return true;
+			}
+
+			inline bool TryEnqueue(const T& value)
+			{
+				T copy(value);
+				return TryEnqueue(copy);
+			}
+
+			// waits while the queue is full, returns false only if the queue has been terminated
+			bool Enqueue(T value)
+			{
+				while (!TryEnqueue(value))
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					++producersWaiting;
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					if (run && IsFull())
+					{
+						notFullCv.wait_for(lock, std::chrono::milliseconds(100));
+					}
+					--producersWaiting;
+					if (!run)
+					{
+						return false;
+					}
+				}
+				return true;
+			}
+
+			// only to be called by the consumer
+			bool TryDequeue(T& value)
+			{
+				const size_t position = dequeuePosition.load(std::memory_order_relaxed);
+				Slot& slot = slots[position & Mask];
+				if (slot.sequence.load(std::memory_order_acquire) != position + 1)
+				{
+					return false;
+				}
+				value = std::move(slot.value);
+				slot.sequence.store(position + Capacity, std::memory_order_release);
+				dequeuePosition.store(position + 1, std::memory_order_relaxed);
+				WakeupProducers();
+				return true;
+			}
+
+			// waits until an entry is available, returns false if the queue has been terminated
+			inline bool Dequeue(T& value)
+			{
+				return Dequeue(value, std::chrono::steady_clock::time_point::max());
+			}
+
+			// returns false if the deadline has passed or the queue has been terminated
+			bool Dequeue(T& value, const std::chrono::steady_clock::time_point deadline)
+			{
+				while (!TryDequeue(value))
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					consumerWaiting.store(true, std::memory_order_relaxed);
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					if (TryDequeue(value))
+					{
+						consumerWaiting.store(false, std::memory_order_relaxed);
+						return true;
+					}
+					if (!run)
+					{
+						consumerWaiting.store(false, std::memory_order_relaxed);
+						return false;
+					}
+					bool timeout = false;
+					if (deadline == std::chrono::steady_clock::time_point::max())
+					{
+						cv.wait(lock);
+					}
+					else
+					{
+						timeout = (cv.wait_until(lock, deadline) == std::cv_status::timeout);
+					}
+					consumerWaiting.store(false, std::memory_order_relaxed);
+					if (timeout)
+					{
+						return TryDequeue(value);
+					}
+				}
+				return true;
+			}
+
+			// moves all available entries to values without waiting, only to be called by the consumer
+			size_t DequeueAll(std::vector<T>& values)
+			{
+				size_t count = 0;
+				T value;
+				while (TryDequeue(value))
+				{
+					values.push_back(std::move(value));
+					++count;
+				}
+				return count;
+			}
+
+			// the oldest entry or nullptr, stays valid until the consumer removes it
+			inline T* Front()
+			{
+				const size_t position = dequeuePosition.load(std::memory_order_relaxed);
+				Slot& slot = slots[position & Mask];
+				if (slot.sequence.load(std::memory_order_acquire) != position + 1)
+				{
+					return nullptr;
+				}
+				return &slot.value;
+			}
+
+			inline void PopFront()
+			{
+				T value;
+				TryDequeue(value);
+			}
+
+			inline bool IsEmpty() const
+			{
+				return GetSize() == 0;
+			}
+
+			inline size_t GetSize() const
+			{
+				const size_t dequeued = dequeuePosition.load(std::memory_order_acquire);
+				const size_t enqueued = enqueuePosition.load(std::memory_order_acquire);
+				return enqueued > dequeued ? enqueued - dequeued : 0;
+			}
+
+			// wakes up all waiting threads, Dequeue and Enqueue do not wait anymore afterwards
+			void Terminate()
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				run = false;
+				cv.notify_all();
+				notFullCv.notify_all();
+			}
+
+		private:
+			static const size_t Mask = Capacity - 1;
+
+			struct Slot
+			{
+				std::atomic<size_t> sequence;
+				T value;
+			};
+
+			inline bool IsFull() const
+			{
+				return GetSize() >= Capacity;
+			}
+
+			inline void WakeupConsumer()
+			{
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (!consumerWaiting.load(std::memory_order_relaxed))
+				{
+					return;
+				}
+				std::lock_guard<std::mutex> lock(mutex);
+				cv.notify_one();
+			}
+
+			inline void WakeupProducers()
+			{
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				// waiting producers are woken up together once half of the queue is free again
+				if (producersWaiting.load(std::memory_order_relaxed) == 0 || GetSize() > Capacity / 2)
+				{
+					return;
+				}
+				std::lock_guard<std::mutex> lock(mutex);
+				notFullCv.notify_all();
+			}
+
+			Slot slots[Capacity];
+			std::atomic<size_t> enqueuePosition;
+			std::atomic<size_t> dequeuePosition;
+			std::atomic<bool> consumerWaiting;
+			std::atomic<unsigned int> producersWaiting;
+			std::mutex mutex;
+			std::condition_variable cv;
+			std::condition_variable notFullCv;
+			volatile bool run;
+	};
+
+	template<class T, size_t Capacity>
+	using SpscQueue = RingQueue<T, Capacity, false>;
+
+	template<class T, size_t Capacity>
+	using MpscQueue = RingQueue<T, Capacity, true>;
+} // namespace Utils
@@ -46,14 +46,14 @@ namespace Utils
 			{
 				std::unique_lock<std::mutex> lock(mutex);
 				list.push_back(t);
-				cv.notify_all();
+				cv.notify_one();
 			}
 
 			inline void EnqueueFront(T t)
 			{
 				std::unique_lock<std::mutex> lock(mutex);
 				list.push_front(t);
-				cv.notify_all();
+				cv.notify_one();
 			}
 
 			T Dequeue()
@@ -65,13 +65,34 @@ namespace Utils
 					{
 						return T();
 					}
-					cv.wait_for(lock, std::chrono::seconds(1));
+					cv.wait(lock);
 				}
 				T val = list.front();
 				list.pop_front();
 				return val;
 			}
 
+			// copies the first entry without removing it, returns false if the queue is empty
+			inline bool Front(T& t)
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				if (list.empty())
+				{
+					return false;
+				}
+				t = list.front();
+				return true;
+			}
+
+			inline void PopFront()
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				if (!list.empty())
+				{
+					list.pop_front();
+				}
+			}
+
 			inline bool IsEmpty()
 			{
 				std::unique_lock<std::mutex> lock(mutex);
@@ -80,6 +101,7 @@ namespace Utils
 
 			inline void Terminate()
 			{
+				std::unique_lock<std::mutex> lock(mutex);
 				run = false;
 				cv.notify_all();
 			}
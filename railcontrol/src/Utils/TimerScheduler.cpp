@@ -0,0 +1,183 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "Utils/TimerScheduler.h"
+#include "Utils/Utils.h"
+
+using std::chrono::steady_clock;
+
+namespace Utils
+{
+	TimerScheduler::TimerScheduler(const std::string& threadName)
+	:	threadName(threadName),
+		run(true),
+		lastTimerID(TimerNone),
+		runningOwner(nullptr),
+		timerThread(&TimerScheduler::Worker, this)
+	{
+	}
+
+	TimerScheduler::~TimerScheduler()
+	{
+		Terminate();
+	}
+
+	TimerScheduler::TimerID TimerScheduler::ScheduleAt(const steady_clock::time_point deadline,
+		const std::function<void()>& callback,
+		const void* owner)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		++lastTimerID;
+		if (lastTimerID == TimerNone)
+		{
+			++lastTimerID;
+		}
+		Timer& timer = timers[lastTimerID];
+		timer.owner = owner;
+		timer.callback = callback;
+		Deadline entry;
+		entry.time = deadline;
+		entry.id = lastTimerID;
+		deadlines.push(entry);
+		cv.notify_all();
+		return lastTimerID;
+	}
+
+	void TimerScheduler::Cancel(const TimerID timerID)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		timers.erase(timerID);
+		CompactDeadlines();
+	}
+
+	void TimerScheduler::CancelAll(const void* owner, const bool waitForRunning)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		for (auto timer = timers.begin(); timer != timers.end();)
+		{
+			if (timer->second.owner == owner)
+			{
+				timer = timers.erase(timer);
+			}
+			else
+			{
+				++timer;
+			}
+		}
+		CompactDeadlines();
+
+		// a callback of the owner may be running right now, wait for it unless we are called from it
+		if (!waitForRunning || std::this_thread::get_id() == timerThread.get_id())
+		{
+			return;
+		}
+		while (owner && runningOwner == owner)
+		{
+			cv.wait(lock);
+		}
+	}
+
+	void TimerScheduler::Terminate(const bool runPending)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!runPending)
+			{
+				timers.clear();
+				deadlines = std::priority_queue<Deadline,std::vector<Deadline>,std::greater<Deadline>>();
+			}
+			run = false;
+			cv.notify_all();
+		}
+		if (timerThread.joinable())
+		{
+			timerThread.join();
+		}
+	}
+
+	void TimerScheduler::CompactDeadlines()
+	{
+		// timers that are cancelled again and again, like debounce timers, would let the heap grow until their deadlines pass
+		if (deadlines.size() <= 2 * timers.size() + 64)
+		{
+			return;
+		}
+		std::vector<Deadline> pending;
+		pending.reserve(timers.size());
+		while (!deadlines.empty())
+		{
+			if (timers.count(deadlines.top().id))
+			{
+				pending.push_back(deadlines.top());
+			}
+			deadlines.pop();
+		}
+		deadlines = std::priority_queue<Deadline,std::vector<Deadline>,std::greater<Deadline>>(std::greater<Deadline>(), std::move(pending));
+	}
+
+	void TimerScheduler::Worker()
+	{
+		Utils::SetThreadName(threadName);
+		std::unique_lock<std::mutex> lock(mutex);
+		while (true)
+		{
+			if (deadlines.empty())
+			{
+				if (!run)
+				{
+					return;
+				}
+				cv.wait(lock);
+				continue;
+			}
+
+			const Deadline next = deadlines.top();
+			auto timer = timers.find(next.id);
+			if (timer == timers.end())
+			{
+				// cancelled
+				deadlines.pop();
+				continue;
+			}
+
+			if (run && next.time > steady_clock::now())
+			{
+				cv.wait_until(lock, next.time);
+				continue;
+			}
+
+			deadlines.pop();
+			const std::function<void()> callback = std::move(timer->second.callback);
+			runningOwner = timer->second.owner;
+			timers.erase(timer);
+			lock.unlock();
+
+			if (run)
+			{
+				lateness.Add(next.time);
+			}
+			callback();
+
+			lock.lock();
+			runningOwner = nullptr;
+			cv.notify_all();
+		}
+	}
+} // namespace Utils
@@ -0,0 +1,113 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Utils/LatencyHistogram.h"
+
+namespace Utils
+{
+	// Runs delayed callbacks on one shared thread instead of one sleeping thread per delay.
+	// Callbacks must return quickly, they delay all timers that are due after them.
+	class TimerScheduler
+	{
+		public:
+			typedef unsigned int TimerID;
+			static const TimerID TimerNone = 0;
+
+			TimerScheduler(const TimerScheduler&) = delete;
+			TimerScheduler& operator=(const TimerScheduler&) = delete;
+
+			TimerScheduler(const std::string& threadName);
+			~TimerScheduler();
+
+			// owner is used to cancel all timers of an object at once, it is never dereferenced
+			inline TimerID Schedule(const std::chrono::milliseconds delay,
+				const std::function<void()>& callback,
+				const void* owner = nullptr)
+			{
+				return ScheduleAt(std::chrono::steady_clock::now() + delay, callback, owner);
+			}
+
+			TimerID ScheduleAt(const std::chrono::steady_clock::time_point deadline,
+				const std::function<void()>& callback,
+				const void* owner = nullptr);
+
+			void Cancel(const TimerID timerID);
+
+			// after returning no callback of owner will be run anymore,
+			// with waitForRunning it is also guaranteed that none is running
+			void CancelAll(const void* owner, const bool waitForRunning = true);
+
+			// runs all pending callbacks immediately, or drops them if runPending is false, and stops the thread
+			void Terminate(const bool runPending = true);
+
+			inline const LatencyHistogram& GetLateness() const
+			{
+				return lateness;
+			}
+
+		private:
+			struct Timer
+			{
+				const void* owner;
+				std::function<void()> callback;
+			};
+
+			struct Deadline
+			{
+				std::chrono::steady_clock::time_point time;
+				TimerID id;
+
+				// timers with the same deadline run in the order they were scheduled
+				inline bool operator>(const Deadline& other) const
+				{
+					return time > other.time || (time == other.time && id > other.id);
+				}
+			};
+
+			void Worker();
+
+			// mutex has to be locked when calling this
+			void CompactDeadlines();
+
+			const std::string threadName;
+			// min-heap of the deadlines, cancelled timers are only removed from timers and skipped when they come up
+			std::priority_queue<Deadline,std::vector<Deadline>,std::greater<Deadline>> deadlines;
+			std::unordered_map<TimerID,Timer> timers;
+			std::mutex mutex;
+			std::condition_variable cv;
+			volatile bool run;
+			TimerID lastTimerID;
+			const void* runningOwner;
+			LatencyHistogram lateness;
+			std::thread timerThread;
+	};
+} // namespace Utils
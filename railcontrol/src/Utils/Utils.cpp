@@ -136,29 +136,32 @@ namespace Utils
 
 	const std::string& Utils::GetStringMapEntry(const std::map<std::string, std::string>& map, const std::string& key, const std::string& defaultValue)
 	{
-		if (map.count(key) == 0)
+		auto entry = map.find(key);
+		if (entry == map.end())
 		{
 			return defaultValue;
 		}
-		return map.at(key);
+		return entry->second;
 	}
 
 	int Utils::GetIntegerMapEntry(const std::map<std::string, std::string>& map, const std::string& key, const int defaultValue)
 	{
-		if (map.count(key) == 0)
+		auto entry = map.find(key);
+		if (entry == map.end())
 		{
 			return defaultValue;
 		}
-		return Integer::StringToInteger(map.at(key), defaultValue);
+		return Integer::StringToInteger(entry->second, defaultValue);
 	}
 
 	bool Utils::GetBoolMapEntry(const std::map<std::string, std::string>& map, const std::string& key, const bool defaultValue)
 	{
-		if (map.count(key) == 0)
+		auto entry = map.find(key);
+		if (entry == map.end())
 		{
 			return defaultValue;
 		}
-		string value = map.at(key);
+		const string& value = entry->second;
 		return (value.compare("true") == 0 || value.compare("on") == 0 || value.compare("1") == 0 || key.compare(value) == 0);
 	}
 
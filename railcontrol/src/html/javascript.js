@@ -2379,12 +2379,16 @@ function locoSpeedSliderOnChange(locoId)
 	{
 		return false;
 	}
+	updateSliderAllowed = true;
+	if (webSocketSend(WebSocketLocoSpeed, 0, locoId, slider.value))
+	{
+		return false;
+	}
 	var url = '/?cmd=locospeed&loco=';
 	url += locoId;
 	url += '&speed=';
 	url += slider.value;
 	fireRequestAndForget(url);
-	updateSliderAllowed = true;
 	return false;
 }
 
@@ -2412,6 +2416,10 @@ function locoSpeedChange(delta)
 	{
 		newValue = 0;
 	}
+	if (webSocketSend(WebSocketLocoSpeed, 0, locoId, newValue))
+	{
+		return false;
+	}
 	let url = '/?cmd=locospeed&loco=';
 	url += locoId;
 	url += '&speed=';
@@ -2428,6 +2436,10 @@ function locoOrientationChange(orientation)
 		return false;
 	}
 	let locoId = loco.value;
+	if (webSocketSend(WebSocketLocoOrientation, 0, locoId, orientation ? 1 : 0))
+	{
+		return false;
+	}
 	let url = '/?cmd=locoorientation&loco=';
 	url += locoId;
 	url += '&on=';
@@ -2436,6 +2448,157 @@ function locoOrientationChange(orientation)
 	return false;
 }
 
+const WebSocketLocoSpeed = 1;
+const WebSocketLocoOrientation = 2;
+const WebSocketLocoFunction = 3;
+const WebSocketFeedback = 4;
+const WebSocketSwitch = 5;
+const WebSocketSignal = 6;
+
+var webSocket = null;
+var webSocketRevision = -1;
+
+function startUpdater()
+{
+	if (!window.WebSocket)
+	{
+		startEventSource();
+		return;
+	}
+	var protocol = (window.location.protocol == 'https:' ? 'wss://' : 'ws://');
+	var url = protocol + window.location.host + '/?cmd=websocket';
+	var reconnecting = (webSocketRevision >= 0);
+	if (reconnecting)
+	{
+		// the server sends what has changed since then
+		url += '&revision=' + webSocketRevision;
+	}
+	var socket = new WebSocket(url);
+	socket.binaryType = 'arraybuffer';
+	var opened = false;
+	socket.onopen = function()
+	{
+		opened = true;
+		webSocket = socket;
+	};
+	socket.onmessage = function(event)
+	{
+		if (typeof event.data === 'string')
+		{
+			if (event.data.startsWith('command=revision;'))
+			{
+				webSocketRevision = +event.data.split('=')[2];
+				return;
+			}
+			++webSocketRevision;
+			dataUpdate(event);
+			return;
+		}
+		++webSocketRevision;
+		dataUpdate({ data: webSocketDecode(event.data) });
+	};
+	socket.onclose = function()
+	{
+		webSocket = null;
+		if (opened)
+		{
+			startUpdater();
+			return;
+		}
+		if (reconnecting)
+		{
+			dataUpdateError();
+			return;
+		}
+		// a proxy in between may not support WebSockets, the server sent events work there
+		startEventSource();
+	};
+}
+
+function startEventSource()
+{
+	var updater = new EventSource('/?cmd=updater');
+	updater.addEventListener('message', dataUpdate);
+	updater.addEventListener('error', function()
+	{
+		if (updater.readyState !== EventSource.CONNECTING)
+		{
+			dataUpdateError();
+			return;
+		}
+		// the browser reconnects with the ID of the last update and the server sends what has changed since then
+		setTimeout(function()
+		{
+			if (updater.readyState !== EventSource.OPEN)
+			{
+				updater.close();
+				dataUpdateError();
+			}
+		}, 5000);
+	});
+}
+
+function webSocketDecode(buffer)
+{
+	var view = new DataView(buffer);
+	var type = view.getUint8(0);
+	var argument = view.getUint8(1);
+	var id = view.getUint32(2);
+	var value = view.getUint16(6);
+	var status = new TextDecoder().decode(new Uint8Array(buffer, 8));
+	var command;
+	switch (type)
+	{
+		case WebSocketLocoSpeed:
+			command = 'locospeed;loco=' + id + ';speed=' + value;
+			break;
+
+		case WebSocketLocoOrientation:
+			command = 'locoorientation;loco=' + id + ';orientation=' + (value ? 'true' : 'false');
+			break;
+
+		case WebSocketLocoFunction:
+			command = 'locofunction;loco=' + id + ';function=' + argument + ';on=' + (value ? 'true' : 'false');
+			break;
+
+		case WebSocketFeedback:
+			command = 'feedback;feedback=' + id + ';state=' + (value ? 'on' : 'off');
+			break;
+
+		case WebSocketSwitch:
+			var switchStates = ['turnout', 'straight', 'third'];
+			command = 'switch;switch=' + id + ';state=' + (switchStates[value] || 'straight');
+			break;
+
+		case WebSocketSignal:
+			var signalStates = ['stop', 'clear', 'aspect2', 'aspect3', 'aspect4', 'aspect5', 'aspect6', 'aspect7', 'aspect8', 'aspect9', 'aspect10'];
+			var signalState = (value == 0x1F ? 'dark' : (signalStates[value & 0x1F] || 'stop') + (value & 0x20 ? 'expected' : ''));
+			command = 'signal;signal=' + id + ';state=' + signalState;
+			break;
+
+		default:
+			return '';
+	}
+	return 'command=' + command + ';status=' + status;
+}
+
+// returns false if the WebSocket is not open and the request has to be sent over HTTP
+function webSocketSend(type, argument, id, value)
+{
+	if (!webSocket || webSocket.readyState !== WebSocket.OPEN)
+	{
+		return false;
+	}
+	var buffer = new ArrayBuffer(8);
+	var view = new DataView(buffer);
+	view.setUint8(0, type);
+	view.setUint8(1, argument);
+	view.setUint32(2, id);
+	view.setUint16(6, value);
+	webSocket.send(buffer);
+	return true;
+}
+
 function fireRequestAndForget(url)
 {
 	var xmlHttp = new XMLHttpRequest();
@@ -2648,10 +2811,7 @@ const MaxNumberOfLocoControls = 5;
 var noSleep = new NoSleep();
 document.addEventListener('click', enableNoSleep, false);
 
-var updater = new EventSource('/?cmd=updater');
-updater.addEventListener('message', dataUpdate);
-
-updater.addEventListener('error', dataUpdateError);
+startUpdater();
 
 window.addEventListener('resize', updateLocoControls);
 
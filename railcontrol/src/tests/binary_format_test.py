@@ -0,0 +1,116 @@
+import re
+import sqlite3
+from pathlib import Path
+
+import pytest
+
+
+# the key table of the binary records, read from the source so that the test can not drift from it
+SERIALIZABLE = Path(__file__).resolve().parent.parent / 'DataModel' / 'Serializable.cpp'
+KEYS = re.findall(r'"([^"]*)"', re.search(r'const char\* const Keys\[\] =\s*\{(.*?)\};',
+                                         SERIALIZABLE.read_text(), re.S).group(1))
+
+# the config of the service fixture quotes the file name and the quotes are part of it
+DATABASE = "'railcontrol.sqlite'"
+
+# records as written by a RailControl version before the binary format
+OBJECTS = [
+    (1, 1, 'Crocodile', 'objectType=Loco;objectID=1;name=Crocodile;controlID=10;protocol=0;address=3;serveraddress=3;functions=;orientation=1;track=0;length=120;pushpull=0;maxspeed=1023;travelspeed=700;reducedspeed=400;creepingspeed=100;propulsion=128;type=1073741824;matchkey='),
+    (2, 1, 'Station 1', 'objectType=Track;objectID=1;name=Station 1;visible=1;posX=1;posY=2;posZ=0;width=1;height=3;rotation=1;lockstate=0;locobaseid=0;locobasetype=0;selectrouteapproach=0;trackstate=0;trackstatedelayed=0;locoorientation=1;blocked=0;locodelayed=0;locotypedelayed=0;allowlocoturn=0;releasewhenfree=0;showname=1;displayname=;tracktype=0;main=0'),
+    (2, 2, 'Station 2', 'objectType=Track;objectID=2;name=Station 2;visible=1;posX=5;posY=2;posZ=0;width=1;height=2;rotation=1;lockstate=0;locobaseid=0;locobasetype=0;selectrouteapproach=0;trackstate=0;trackstatedelayed=0;locoorientation=1;blocked=0;locodelayed=0;locotypedelayed=0;allowlocoturn=0;releasewhenfree=0;showname=1;displayname=;tracktype=0;main=0'),
+    (3, 1, 'Entry', 'objectType=Feedback;objectID=1;name=Entry;visible=0;posX=0;posY=0;posZ=0;width=1;height=1;rotation=1;controlID=10;pin=1;device=0;bus=0;feedbacktype=0;route=0;inverted=0;ondelay=0;offdelay=2000;state=0;matchkey='),
+    (3, 2, 'Stop', 'objectType=Feedback;objectID=2;name=Stop;visible=0;posX=0;posY=0;posZ=0;width=1;height=1;rotation=1;controlID=10;pin=2;device=0;bus=0;feedbacktype=0;route=0;inverted=0;ondelay=0;offdelay=2000;state=0;matchkey='),
+    (6, 1, 'Station 1 - Station 2', 'objectType=Route;objectID=1;name=Station 1 - Station 2;visible=0;posX=0;posY=0;posZ=0;width=1;height=1;rotation=0;lockstate=0;locobaseid=0;locobasetype=0;delay=0;lastused=0;counter=0;automode=1;fromTrack=1;fromorientation=1;toTrack=2;toorientation=1;speed=2;feedbackIdReduced=0;reduceddelay=0;feedbackIdCreep=0;creepdelay=0;feedbackIdStop=2;stopdelay=0;feedbackIdOver=0;pushpull=2;propulsion=191;traintype=1604302847;mintrainlength=0;maxtrainlength=0;waitafterrelease=0;followuproute=0'),
+    (7, 1, 'Layer 1', 'objectType=Layer;objectID=1;name=Layer 1'),
+    (8, 1, 'Signal 1', 'objectType=Signal;controlID=10;protocol=0;address=20;serveraddress=20;type=0;state=0;duration=250;inverted=0;lastused=0;counter=0;matchkey=;objectID=1;name=Signal 1;visible=1;posX=4;posY=1;posZ=0;width=1;height=1;rotation=1;lockstate=0;locobaseid=0;locobasetype=0'),
+    (11, 1, 'Hello -1', 'objectType=Text;objectID=1;name=Hello -1;visible=1;posX=-1;posY=0;posZ=0;width=4;height=1;rotation=0'),
+]
+
+RELATIONS = [
+    (17, 1, 3, 1, 0, 'lockstate=0;locobaseid=0;locobasetype=0;type=17;objectType1=2;objectID1=1;objectType2=3;objectID2=1;priority=0;data=0'),
+    (17, 1, 3, 2, 0, 'lockstate=0;locobaseid=0;locobasetype=0;type=17;objectType1=2;objectID1=1;objectType2=3;objectID2=2;priority=0;data=0'),
+]
+
+
+def read_varint(data, position):
+    value = 0
+    shift = 0
+    while True:
+        byte = data[position]
+        position += 1
+        value |= (byte & 0x7f) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, position
+
+
+def read_string(data, position):
+    length, position = read_varint(data, position)
+    return data[position:position + length].decode(), position + length
+
+
+def binary_to_text(data):
+    assert data[0] == 1 and data[1] == 1
+    position = 2
+    arguments = []
+    while position < len(data):
+        header, position = read_varint(data, position)
+        if header >> 1 == 0:
+            key, position = read_string(data, position)
+        else:
+            key = KEYS[(header >> 1) - 1]
+        if header & 1:
+            zigzag, position = read_varint(data, position)
+            value = str((zigzag >> 1) ^ -(zigzag & 1))
+        else:
+            value, position = read_string(data, position)
+        arguments.append(f'{key}={value}')
+    return ';'.join(arguments)
+
+
+@pytest.fixture
+def text_database(tmpdir: Path):
+    database = sqlite3.connect(str(tmpdir / DATABASE))
+    database.executescript(
+        'CREATE TABLE hardware (controlid UNSIGNED TINYINT, hardwaretype UNSIGNED TINYINT, name VARCHAR(50), arg1 VARCHAR(255), arg2 VARCHAR(255), arg3 VARCHAR(255), arg4 VARCHAR(255), arg5 VARCHAR(255),PRIMARY KEY (controlid));'
+        'CREATE TABLE objects (objecttype UNSIGNED TINYINT, objectid UNSIGNED SHORTINT, name VARCHAR(50), object SHORTTEXT,PRIMARY KEY (objecttype, objectid));'
+        'CREATE TABLE relations (type UNSIGNED TINYINT, objectid1 UNSIGNED SHORTINT, objecttype2 UNSIGNED TINYINT, objectid2 UNSIGNED SHORTINT, priority UNSIGNED TINYINT, relation SHORTTEXT,PRIMARY KEY (type, objectid1, objecttype2, objectid2, priority));'
+        'CREATE TABLE settings (key TINYTEXT, value SHORTTEXT,PRIMARY KEY (key));')
+    database.execute("INSERT INTO hardware VALUES (10, 1, 'virtual', '', '', '', '', '');")
+    database.executemany('INSERT INTO objects VALUES (?, ?, ?, ?);', OBJECTS)
+    database.executemany('INSERT INTO relations VALUES (?, ?, ?, ?, ?, ?);', RELATIONS)
+    database.commit()
+    database.close()
+    return tmpdir
+
+
+def test_text_database_is_converted_to_binary(text_database, service):
+    assert 'Crocodile' in service.cmd('getlocolist').text
+    assert 'Station 1' in service.cmd('tracklist').text
+    assert 'Stop' in service.cmd('feedbacklist').text
+    assert 'Station 1 - Station 2' in service.cmd('routelist').text
+    assert 'Signal 1' in service.cmd('signallist').text
+    assert 'Hello -1' in service.cmd('textlist').text
+
+    database = sqlite3.connect(str(text_database / DATABASE))
+    assert database.execute("SELECT value FROM settings WHERE key = 'binaryformat';").fetchone() == ('1',)
+
+    objects = database.execute('SELECT objecttype, objectid, name, object FROM objects ORDER BY objecttype, objectid;').fetchall()
+    assert [row[:3] for row in objects] == [row[:3] for row in OBJECTS]
+    for row, original in zip(objects, OBJECTS):
+        assert isinstance(row[3], bytes)
+        assert len(row[3]) < len(original[3])
+        assert binary_to_text(row[3]) == original[3]
+
+    relations = database.execute('SELECT type, objectid1, objecttype2, objectid2, priority, relation FROM relations ORDER BY objectid2;').fetchall()
+    assert [row[:5] for row in relations] == [row[:5] for row in RELATIONS]
+    for row, original in zip(relations, RELATIONS):
+        assert binary_to_text(row[5]) == original[5]
+
+
+def test_text_database_is_backed_up_before_conversion(text_database, service):
+    service.cmd('getlocolist')
+    backup = sqlite3.connect(str(text_database / (DATABASE + '.textformat.bak')))
+    assert backup.execute('SELECT objecttype, objectid, name, object FROM objects ORDER BY objecttype, objectid;').fetchall() == OBJECTS
+    assert backup.execute('SELECT * FROM relations ORDER BY objectid2;').fetchall() == RELATIONS
+    assert backup.execute("SELECT value FROM settings WHERE key = 'binaryformat';").fetchone() is None
@@ -0,0 +1,62 @@
+import os
+import subprocess
+import time
+from pathlib import Path
+
+from conftest import Client
+
+# capture
+
+
+def s88_event(contact, state):
+    return bytes([0x00, 0x23, 0x03, 0x00, 8, 0x00, 0x00, 0x00, contact, 1 - state, state, 0x00, 0x00])
+
+
+def start(tmpdir: Path, config: str, port: int):
+    configfile = tmpdir / 'config.conf'
+    configfile.write_text("dbfilename = 'railcontrol.sqlite'\n"
+                          f"webserverport = {port}\n"
+                          f"numkeepbackups = 0\n{config}", 'UTF-8')
+    proc = subprocess.Popen([os.path.join(os.getcwd(), 'railcontrol'), '--config', str(configfile), '--logfile=railcontrol.log'],
+                            cwd=tmpdir)
+    client = Client(f"http://localhost:{port}")
+    for _ in range(20):
+        if client.ping():
+            return proc, client
+        time.sleep(0.5)
+    proc.kill()
+    raise RuntimeError('Could not connect to service')
+
+
+def test_replay_cs2_tcp(tmpdir: Path, port: int = 8023):
+    proc, client = start(tmpdir, '', port)
+    client.cmd('controlsave', control=0, name='CS2', hardwaretype=10, arg1='127.0.0.1')
+    proc.terminate()
+    proc.wait()
+
+    replaydirectory = tmpdir / 'replay'
+    replaydirectory.mkdir()
+    with open(replaydirectory / 'control10.rccap', 'wb') as capture:
+        capture.write(b'RCCAP\x01')
+        for contact in (1, 2):
+            for state in (1, 0):
+                capture.write(bytes([0xE8, 0x07, 0x01, 13]) + s88_event(contact, state))
+
+    proc, client = start(tmpdir, f'replaydirectory = {replaydirectory}\nreplayspeed = 0\ncapturedirectory = {tmpdir}\n', port)
+    try:
+        log = ''
+        for _ in range(50):
+            log = (tmpdir / 'railcontrol.log').read_text('UTF-8')
+            if 'finished' in log:
+                break
+            time.sleep(0.1)
+        assert 'State of pin 1 on S88 module 0 on bus 0 on device 0 is on' in log
+        assert 'State of pin 2 on S88 module 0 on bus 0 on device 0 is off' in log
+    finally:
+        proc.terminate()
+        proc.wait()
+
+    # the replayed bytes are recorded again
+    recorded = (tmpdir / 'control10.rccap').read_binary()
+    assert recorded.startswith(b'RCCAP\x01')
+    assert recorded.count(s88_event(2, 0)) == 1
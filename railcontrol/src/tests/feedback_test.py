@@ -0,0 +1,37 @@
+import socket
+import time
+from urllib.parse import urlparse
+
+# feedback
+
+
+def receive_until(updater, text):
+    received = b''
+    while text not in received:
+        data = updater.recv(4096)
+        assert data
+        received += data
+    return received
+
+
+def test_cmd_feedbackstate_off_delay(service):
+    service.cmd('feedbacksave', feedback=0, name='delayed', pin=1, ondelay=0, offdelay=300)
+    url = urlparse(service.url)
+    updater = socket.create_connection((url.hostname, url.port), timeout=5)
+    updater.sendall(b'GET /?cmd=updater HTTP/1.1\r\n\r\n')
+
+    service.cmd('feedbackstate', feedback=1, state='occupied')
+    receive_until(updater, b'feedback;feedback=1;state=on')
+
+    # a short interruption is not published
+    service.cmd('feedbackstate', feedback=1, state='free')
+    service.cmd('feedbackstate', feedback=1, state='occupied')
+    time.sleep(0.5)
+
+    start = time.monotonic()
+    service.cmd('feedbackstate', feedback=1, state='free')
+    received = receive_until(updater, b'feedback;feedback=1;state=off')
+    delay = time.monotonic() - start
+    assert 0.25 < delay < 1
+    assert received.count(b'feedback;feedback=1;state=off') == 1
+    updater.close()
@@ -0,0 +1,15 @@
+# stats
+
+def test_cmd_stats(service):
+    response = service.cmd('stats')
+
+    assert response.headers['Content-Type'] == 'text/csv; charset=utf-8'
+    assert 'updatelatency;total;' in response.text
+    assert 'timerlateness;total;' in response.text
+    assert 'logger;dropped;' in response.text
+    assert 'controlqueue;' in response.text
+    assert 'layoutcache;' in response.text
+    assert 'statestore;' in response.text
+
+    response = service.cmd('stats')
+    assert 'webcommand;stats;total;' in response.text
@@ -0,0 +1,80 @@
+import socket
+from urllib.parse import urlparse
+
+# updater
+
+def test_cmd_updater_many_clients(service):
+    url = urlparse(service.url)
+    updaters = []
+    for _ in range(50):
+        updater = socket.create_connection((url.hostname, url.port), timeout=5)
+        updater.sendall(b'GET /?cmd=updater HTTP/1.1\r\nConnection: keep-alive\r\n\r\n')
+        updaters.append(updater)
+
+    for updater in updaters:
+        assert b'text/event-stream' in updater.recv(4096)
+
+    service.cmd('booster', on='false')
+
+    for updater in updaters:
+        received = b''
+        while b'booster;on=false' not in received:
+            data = updater.recv(4096)
+            assert data
+            received += data
+        updater.close()
+
+
+def receive_until(updater, text):
+    received = b''
+    while text not in received:
+        data = updater.recv(4096)
+        assert data
+        received += data
+    return received
+
+
+def test_cmd_updater_reconnect_after_many_updates(service):
+    service.cmd('controlsave', control=0, name='virtual', hardwaretype=1)
+    service.cmd('locosave', loco=0, name='updater', control=10, protocol=0, address=3)
+    url = urlparse(service.url)
+
+    updater = socket.create_connection((url.hostname, url.port), timeout=5)
+    updater.sendall(b'GET /?cmd=updater HTTP/1.1\r\n\r\n')
+    service.cmd('locospeed', loco=1, speed=5)
+    received = receive_until(updater, b'speed=5;')
+    lastEventID = received.split(b'speed=5;')[0].rsplit(b'id: ', 1)[1].split(b'\r\n')[0]
+    updater.close()
+
+    # more updates than the server keeps
+    service.cmd('locospeed', loco=1, speed=42)
+    watcher = socket.create_connection((url.hostname, url.port), timeout=5)
+    watcher.sendall(b'GET /?cmd=updater HTTP/1.1\r\n\r\n')
+    for index in range(12):
+        service.cmd('booster', on=('true' if index % 2 else 'false'))
+    receive_until(watcher, b'booster;on=true')
+    watcher.close()
+
+    updater = socket.create_connection((url.hostname, url.port), timeout=5)
+    updater.sendall(b'GET /?cmd=updater HTTP/1.1\r\nLast-Event-ID: ' + lastEventID + b'\r\n\r\n')
+    received = receive_until(updater, b'booster;on=true')
+    assert b'command=locospeed;loco=1;speed=42\r\n' in received
+    assert b'speed=5' not in received
+    updater.close()
+
+
+def test_stalled_requests_do_not_block_others(service):
+    url = urlparse(service.url)
+    stalled = []
+    # more stalled clients than there are request workers
+    for _ in range(8):
+        client = socket.create_connection((url.hostname, url.port), timeout=5)
+        client.sendall(b'GET /?cmd=booster&on=true HTTP/1.1\r\nConnec')
+        stalled.append(client)
+
+    service.cmd('booster', on='false')
+
+    stalled[0].sendall(b'tion: keep-alive\r\n\r\n')
+    assert b'200 OK' in stalled[0].recv(4096)
+    for client in stalled:
+        client.close()
@@ -0,0 +1,87 @@
+import base64
+import os
+import socket
+import struct
+import time
+from urllib.parse import urlparse
+
+# websocket
+
+MessageLocoSpeed = 1
+
+
+def websocket_connect(url):
+    connection = socket.create_connection((url.hostname, url.port), timeout=5)
+    key = base64.b64encode(os.urandom(16)).decode()
+    connection.sendall(('GET /?cmd=websocket HTTP/1.1\r\n'
+                        'Upgrade: websocket\r\n'
+                        'Connection: Upgrade\r\n'
+                        f'Sec-WebSocket-Key: {key}\r\n'
+                        'Sec-WebSocket-Version: 13\r\n\r\n').encode())
+    response = b''
+    while b'\r\n\r\n' not in response:
+        data = connection.recv(4096)
+        assert data
+        response += data
+    header, _, rest = response.partition(b'\r\n\r\n')
+    assert header.startswith(b'HTTP/1.1 101')
+    return connection, rest
+
+
+def websocket_send(connection, payload):
+    mask = os.urandom(4)
+    masked = bytes(b ^ mask[i % 4] for i, b in enumerate(payload))
+    connection.sendall(bytes([0x82, 0x80 | len(payload)]) + mask + masked)
+
+
+def websocket_receive(connection, buffer):
+    while True:
+        if len(buffer) >= 2:
+            size = buffer[1] & 0x7F
+            position = 2
+            if size == 126 and len(buffer) >= 4:
+                size = struct.unpack('>H', buffer[2:4])[0]
+                position = 4
+            if size < 126 and len(buffer) >= position + size:
+                return buffer[0] & 0x0F, buffer[position:position + size], buffer[position + size:]
+        data = connection.recv(4096)
+        assert data
+        buffer += data
+
+
+def test_cmd_websocket_without_upgrade(service):
+    url = urlparse(service.url)
+    connection = socket.create_connection((url.hostname, url.port), timeout=5)
+    connection.sendall(b'GET /?cmd=websocket HTTP/1.1\r\n\r\n')
+    assert connection.recv(4096).startswith(b'HTTP/1.1 400')
+
+
+def test_cmd_websocket_loco_speed_round_trip_many_clients(service):
+    service.cmd('controlsave', control=0, name='virtual', hardwaretype=1)
+    service.cmd('locosave', loco=0, name='websocket', control=10, protocol=0, address=3)
+    url = urlparse(service.url)
+
+    clients = [websocket_connect(url) for _ in range(20)]
+    latencies = []
+    for index, (connection, buffer) in enumerate(clients):
+        speed = 10 + index
+        start = time.monotonic()
+        websocket_send(connection, struct.pack('>BBIH', MessageLocoSpeed, 0, 1, speed))
+        while True:
+            opcode, payload, buffer = websocket_receive(connection, buffer)
+            if opcode == 2 and struct.unpack('>BBIH', payload[:8]) == (MessageLocoSpeed, 0, 1, speed):
+                break
+        latencies.append(time.monotonic() - start)
+        clients[index] = (connection, buffer)
+
+    latencies.sort()
+    print('throttle round trip with 20 clients: median', latencies[len(latencies) // 2], 'max', latencies[-1])
+    assert latencies[-1] < 1
+
+    # the updates reach the other clients as well
+    for connection, buffer in clients:
+        while True:
+            opcode, payload, buffer = websocket_receive(connection, buffer)
+            if opcode == 2 and struct.unpack('>BBIH', payload[:8]) == (MessageLocoSpeed, 0, 1, 29):
+                break
+        connection.close()
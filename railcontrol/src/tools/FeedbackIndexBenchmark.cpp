@@ -0,0 +1,92 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+// Measures looking up the feedback of a reported contact in the hardware index of
+// the manager, once in a std::map and once in the hashed index the manager uses.
+// The layout has four controls with 512 contacts each, the contacts are reported
+// in a random order as on a busy layout.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "Manager.h"
+
+using std::chrono::steady_clock;
+
+static const unsigned int NumberOfControls = 4;
+static const unsigned int NumberOfPins = 512;
+static const unsigned int NumberOfLookups = 10000000;
+
+static void Print(const char* name, const steady_clock::duration duration)
+{
+	const double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+	std::cout << name << ": " << ns / NumberOfLookups << " ns per lookup" << std::endl;
+}
+
+template<class Index>
+static void Benchmark(const char* name, const std::vector<Manager::FeedbackHardwareKey>& reports)
+{
+	Index index;
+	unsigned long long feedbackID = 0;
+	for (ControlID control = 1; control <= NumberOfControls; ++control)
+	{
+		for (FeedbackPin pin = 1; pin <= NumberOfPins; ++pin)
+		{
+			index[Manager::FeedbackHardwareKey(control, pin, 0, 0)] = ++feedbackID;
+		}
+	}
+
+	unsigned long long sum = 0;
+	const steady_clock::time_point start = steady_clock::now();
+	for (unsigned int i = 0; i < NumberOfLookups; ++i)
+	{
+		auto entry = index.find(reports[i % reports.size()]);
+		if (entry != index.end())
+		{
+			sum += entry->second;
+		}
+	}
+	Print(name, steady_clock::now() - start);
+	if (sum == 0)
+	{
+		std::exit(1);
+	}
+}
+
+int main()
+{
+	std::mt19937 random(4711);
+	std::vector<Manager::FeedbackHardwareKey> reports;
+	for (unsigned int i = 0; i < 65536; ++i)
+	{
+		const ControlID control = static_cast<ControlID>(random() % NumberOfControls + 1);
+		const FeedbackPin pin = static_cast<FeedbackPin>(random() % NumberOfPins + 1);
+		reports.push_back(Manager::FeedbackHardwareKey(control, pin, 0, 0));
+	}
+
+	Benchmark<std::map<Manager::FeedbackHardwareKey,unsigned long long>>("std::map", reports);
+	Benchmark<std::unordered_map<Manager::FeedbackHardwareKey,unsigned long long,Manager::FeedbackHardwareKeyHash>>("Hashed index", reports);
+	return 0;
+}
@@ -0,0 +1,132 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+// Measures parsing a typical locospeed request of the web UI and looking up its
+// arguments, once with the arguments copied into a std::map as the handlers did
+// before and once with the flat lookup the handlers use now.
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+
+#include "Server/Web/HttpRequest.h"
+#include "Utils/Utils.h"
+
+using std::chrono::steady_clock;
+
+static const unsigned int NumberOfRequests = 1000000;
+
+static const char Request[] =
+	"GET /?cmd=locospeed&loco=3&speed=511&rnd=0.4711 HTTP/1.1\r\n"
+	"Host: railcontrol:8082\r\n"
+	"User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:128.0) Gecko/20100101 Firefox/128.0\r\n"
+	"Accept: */*\r\n"
+	"Accept-Language: de,en-US;q=0.7,en;q=0.3\r\n"
+	"Accept-Encoding: gzip, deflate\r\n"
+	"Connection: keep-alive\r\n"
+	"Referer: http://railcontrol:8082/\r\n"
+	"\r\n";
+
+static bool Receive(Server::Web::HttpRequest& request)
+{
+	request.Reset();
+	const size_t length = sizeof(Request) - 1;
+	memcpy(request.FreeSpace(), Request, length);
+	request.Received(length);
+	return request.Parse();
+}
+
+// the copy of the arguments every request got before the handlers used the flat lookup
+static void CopyArguments(const Server::Web::HttpRequest& request, std::map<std::string,std::string>& arguments)
+{
+	const std::string uri = request.GetUri().ToString();
+	size_t start = uri.find('?');
+	while (start != std::string::npos)
+	{
+		++start;
+		const size_t end = uri.find('&', start);
+		const std::string argument = uri.substr(start, end == std::string::npos ? std::string::npos : end - start);
+		const size_t equal = argument.find('=');
+		if (equal != std::string::npos)
+		{
+			arguments[argument.substr(0, equal)] = argument.substr(equal + 1);
+		}
+		start = end;
+	}
+}
+
+static void Print(const char* name, const steady_clock::duration duration)
+{
+	const double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+	std::cout << name << ": " << ns / NumberOfRequests << " ns per request" << std::endl;
+}
+
+static void BenchmarkMap()
+{
+	Server::Web::HttpRequest* request = new Server::Web::HttpRequest();
+	unsigned long long sum = 0;
+	const steady_clock::time_point start = steady_clock::now();
+	for (unsigned int i = 0; i < NumberOfRequests; ++i)
+	{
+		Receive(*request);
+		std::map<std::string,std::string> arguments;
+		CopyArguments(*request, arguments);
+		sum += Utils::Utils::GetStringMapEntry(arguments, "cmd").size();
+		sum += Utils::Utils::GetIntegerMapEntry(arguments, "loco", 0);
+		sum += Utils::Utils::GetIntegerMapEntry(arguments, "speed", 0);
+	}
+	Print("Arguments copied into std::map", steady_clock::now() - start);
+	delete request;
+	if (sum == 0)
+	{
+		std::exit(1);
+	}
+}
+
+static void BenchmarkFlat()
+{
+	Server::Web::HttpRequest* request = new Server::Web::HttpRequest();
+	unsigned long long sum = 0;
+	const steady_clock::time_point start = steady_clock::now();
+	for (unsigned int i = 0; i < NumberOfRequests; ++i)
+	{
+		Receive(*request);
+		const Server::Web::HttpRequest::Arguments arguments = request->GetArguments();
+		sum += request->GetArgument("cmd").length;
+		sum += arguments.GetInteger("loco", 0);
+		sum += arguments.GetInteger("speed", 0);
+	}
+	Print("Flat argument lookup", steady_clock::now() - start);
+	delete request;
+	if (sum == 0)
+	{
+		std::exit(1);
+	}
+}
+
+int main()
+{
+	BenchmarkMap();
+	BenchmarkFlat();
+	return 0;
+}
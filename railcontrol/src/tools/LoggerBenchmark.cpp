@@ -0,0 +1,179 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+// Measures the formatting of log messages.
+// The messages are the most frequent ones of a running layout with their typical arguments.
+// Each message is formatted with the pre-tokenized texts of the logger and, for comparison,
+// with the former find/replace pass per argument.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "Languages.h"
+#include "Logger/Logger.h"
+
+using std::string;
+
+#define MESSAGES(M) \
+	M(TextSettingSpeedWithProtocol, "MM2", 24, 512) \
+	M(TextSettingFunctionWithProtocol, 3, "DCC128", 3, "on") \
+	M(TextSettingDirectionOfTravelWithProtocol, "MFX", 16385, "right") \
+	M(TextSettingAccessoryWithProtocol, "DCC", 101, "green", "on") \
+	M(TextSettingAccessoryOnOff, 101, "green", "off") \
+	M(TextSettingSpeed, 24, 512) \
+	M(TextSettingOrientation, 24, 1) \
+	M(TextSettingFunctions1_8, 24, 5) \
+	M(TextSettingFunctions9_16, 24, 0) \
+	M(TextSettingFunctions17_28, 24, 0, 0) \
+	M(TextSettingFunction, 3, 24, "on") \
+	M(TextSettingDirectionOfTravel, 24) \
+	M(TextSettingAccessory, 101, "red") \
+	M(TextReceivedSpeedCommand, "MM2", 24, 512) \
+	M(TextReceivedFunctionCommand, "MM2", 24, 3, 1) \
+	M(TextReceivedDirectionCommand, "MM2", 24, 1) \
+	M(TextReceivedAccessoryCommand, "DCC", 101, 1) \
+	M(TextLocoSpeedIs, "BR 218 Intercity", 512) \
+	M(TextLocoIsOnTrack, "BR 218 Intercity", "Station track 3") \
+	M(TextIsNotFree, "Station track 3") \
+	M(TextSwitchIsLocked, "Switch 12") \
+	M(TextSignalIsLocked, "Exit signal 3") \
+	M(TextAccessoryIsLocked, "Street light") \
+	M(TextRouteIsLocked, "Track 3 to track 7") \
+	M(TextWaitingUntilHasStopped, "BR 218 Intercity") \
+	M(TextReachedItsDestination) \
+	M(TextIsRunningWaitingUntilDestination) \
+	M(TextBoosterIsTurnedOn) \
+	M(TextBoosterIsTurnedOff) \
+	M(TextTurningBoosterOn) \
+	M(TextShortCircuit) \
+	M(TextInvalidDataReceived) \
+	M(TextCheckSumError) \
+	M(TextControlReturnedUnknownErrorCode, 42) \
+	M(TextControlDoesNotAnswer) \
+	M(TextQueryAffected, "UPDATE objects SET name = ?, layer = ?, object = ? WHERE objecttype = ? AND objectid = ?;", 1) \
+	M(TextRelationTargetNotFound) \
+	M(TextNotImplemented, "Hardware/Protocols/MaerklinCAN.cpp", 312) \
+	M(TextHasAlreadyReservedRoute) \
+	M(TextLookingForDestination, "Station track 3") \
+	M(TextTryingToReserveRoute, "Track 3 to track 7") \
+	M(TextRouteReserved, "Track 3 to track 7") \
+	M(TextUnableToReserveRoute, "Track 3 to track 7") \
+	M(TextExecutingRoute, "Track 3 to track 7") \
+	M(TextHeadingToVia, "Track 7", "Track 3 to track 7") \
+	M(TextHeadingToViaVia, "Track 7", "Track 1 to track 3", "Track 3 to track 7") \
+	M(TextNoValidRouteFound, "BR 218 Intercity") \
+	M(TextTrackIsUsedByLoco, "Station track 3", "BR 218 Intercity") \
+	M(TextFeedbackChangeCS2, 3, 12, 1, 0, "on") \
+	M(TextHitOverrun, "Feedback 17")
+
+// the formatting as it has been done before the texts were tokenized
+static void Replace(string& workString, const unsigned char argument, const string& value)
+{
+	const string needle = "{" + std::to_string(argument) + "}";
+	const size_t pos = workString.find(needle);
+	if (pos == string::npos)
+	{
+		return;
+	}
+	workString.replace(pos, needle.size(), value);
+}
+
+static void Replace(string& workString, const unsigned char argument, const char* value)
+{
+	Replace(workString, argument, string(value));
+}
+
+template<typename T>
+static void Replace(string& workString, const unsigned char argument, T value)
+{
+	Replace(workString, argument, std::to_string(value));
+}
+
+static void FormatInternal(__attribute__((unused)) string& workString, __attribute__((unused)) const unsigned char argument)
+{
+}
+
+template<typename T, typename... Args>
+static void FormatInternal(string& workString, const unsigned char argument, T value, Args... args)
+{
+	Replace(workString, argument, value);
+	FormatInternal(workString, argument + 1, args...);
+}
+
+template<typename... Args>
+static void ReplaceFormat(string& output, const Languages::TextSelector text, Args... args)
+{
+	string workString = Languages::GetText(text);
+	FormatInternal(workString, 0, args...);
+	output += workString;
+}
+
+#define APPEND_TOKENIZED(text, ...) Logger::Logger::Append(output, Languages::text, ##__VA_ARGS__);
+#define APPEND_REPLACED(text, ...) ReplaceFormat(output, Languages::text, ##__VA_ARGS__);
+
+static const unsigned int NumberOfMessages = 50;
+
+static double FormatTokenized(const unsigned int rounds, string& output)
+{
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (unsigned int round = 0; round < rounds; ++round)
+	{
+		output.clear();
+		MESSAGES(APPEND_TOKENIZED)
+	}
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double FormatReplaced(const unsigned int rounds, string& output)
+{
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (unsigned int round = 0; round < rounds; ++round)
+	{
+		output.clear();
+		MESSAGES(APPEND_REPLACED)
+	}
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+	const unsigned int rounds = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+
+	string tokenized;
+	string replaced;
+	// warm up, the texts are tokenized on first use
+	FormatTokenized(1, tokenized);
+	FormatReplaced(1, replaced);
+	if (tokenized != replaced)
+	{
+		std::cout << "Output differs:" << std::endl << tokenized << std::endl << replaced << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const double messages = static_cast<double>(rounds) * NumberOfMessages;
+	const double nanosecondsTokenized = FormatTokenized(rounds, tokenized);
+	const double nanosecondsReplaced = FormatReplaced(rounds, replaced);
+	std::cout << "Messages:  " << static_cast<unsigned long long>(messages) << std::endl;
+	std::cout << "Tokenized: " << nanosecondsTokenized / messages << " ns/message" << std::endl;
+	std::cout << "Replaced:  " << nanosecondsReplaced / messages << " ns/message" << std::endl;
+	return EXIT_SUCCESS;
+}
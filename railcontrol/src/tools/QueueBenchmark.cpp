@@ -0,0 +1,148 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2026 by Teddy / Dominik Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+// Measures the producer/consumer throughput of the list based ThreadSafeQueue
+// and the ring buffer queues with one and with several producers.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "Utils/RingQueue.h"
+#include "Utils/ThreadSafeQueue.h"
+
+using std::chrono::steady_clock;
+
+static const unsigned int NumberOfEntries = 1000000;
+static const unsigned int QueueSize = 1024;
+
+template<class Queue>
+static void ProduceThreadSafeQueue(Queue& queue, const unsigned int count)
+{
+	for (unsigned int i = 1; i <= count; ++i)
+	{
+		queue.EnqueueBack(i);
+	}
+}
+
+template<class Queue>
+static void ProduceRingQueue(Queue& queue, const unsigned int count)
+{
+	for (unsigned int i = 1; i <= count; ++i)
+	{
+		queue.Enqueue(i);
+	}
+}
+
+static void Print(const char* name, const unsigned int producers, const steady_clock::duration duration)
+{
+	const double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+	std::cout << name << " with " << producers << " producer(s): "
+		<< ns / NumberOfEntries << " ns per entry, "
+		<< NumberOfEntries / ns * 1000 << " M entries/s" << std::endl;
+}
+
+static void BenchmarkThreadSafeQueue(const unsigned int producers)
+{
+	Utils::ThreadSafeQueue<unsigned int> queue;
+	const steady_clock::time_point start = steady_clock::now();
+	std::vector<std::thread> threads;
+	for (unsigned int p = 0; p < producers; ++p)
+	{
+		threads.push_back(std::thread(ProduceThreadSafeQueue<Utils::ThreadSafeQueue<unsigned int>>, std::ref(queue), NumberOfEntries / producers));
+	}
+	unsigned long long sum = 0;
+	for (unsigned int i = 0; i < NumberOfEntries / producers * producers; ++i)
+	{
+		sum += queue.Dequeue();
+	}
+	const steady_clock::duration duration = steady_clock::now() - start;
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	Print("ThreadSafeQueue", producers, duration);
+	if (sum == 0)
+	{
+		std::exit(1);
+	}
+}
+
+template<bool MultipleProducers>
+static void BenchmarkRingQueue(const char* name, const unsigned int producers, const bool batch)
+{
+	typedef Utils::RingQueue<unsigned int,QueueSize,MultipleProducers> Queue;
+	Queue* queue = new Queue();
+	const steady_clock::time_point start = steady_clock::now();
+	std::vector<std::thread> threads;
+	for (unsigned int p = 0; p < producers; ++p)
+	{
+		threads.push_back(std::thread(ProduceRingQueue<Queue>, std::ref(*queue), NumberOfEntries / producers));
+	}
+	unsigned long long sum = 0;
+	const unsigned int total = NumberOfEntries / producers * producers;
+	unsigned int received = 0;
+	std::vector<unsigned int> values;
+	values.reserve(QueueSize);
+	while (received < total)
+	{
+		unsigned int value;
+		if (!queue->Dequeue(value))
+		{
+			break;
+		}
+		sum += value;
+		++received;
+		if (!batch)
+		{
+			continue;
+		}
+		values.clear();
+		received += queue->DequeueAll(values);
+		for (unsigned int v : values)
+		{
+			sum += v;
+		}
+	}
+	const steady_clock::duration duration = steady_clock::now() - start;
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	delete queue;
+	Print(name, producers, duration);
+	if (sum == 0)
+	{
+		std::exit(1);
+	}
+}
+
+int main()
+{
+	BenchmarkThreadSafeQueue(1);
+	BenchmarkRingQueue<false>("SpscQueue", 1, false);
+	BenchmarkRingQueue<false>("SpscQueue DequeueAll", 1, true);
+	BenchmarkThreadSafeQueue(4);
+	BenchmarkRingQueue<true>("MpscQueue", 4, false);
+	BenchmarkRingQueue<true>("MpscQueue DequeueAll", 4, true);
+	return 0;
+}
@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+# Prints a capture of the traffic of a control, one line per chunk, to be read or diffed.
+#
+# usage: capture_dump.py [--no-time] capture file
+#
+# Captures are written by RailControl to capturedirectory/control<ID>.rccap when
+# capturedirectory is set in the config file, and replayed from
+# replaydirectory/control<ID>.rccap when replaydirectory is set. Dumping the capture
+# recorded during a replay and the original capture with --no-time shows what a
+# version of RailControl sends differently.
+
+import sys
+
+MAGIC = b'RCCAP\x01'
+DIRECTIONS = ('>', '<')  # sent, received
+
+
+def read_varint(data, position):
+    value = 0
+    shift = 0
+    while True:
+        byte = data[position]
+        position += 1
+        value |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return value, position
+        shift += 7
+
+
+def chunks(data):
+    if not data.startswith(MAGIC):
+        sys.exit('not a capture file')
+    position = len(MAGIC)
+    time = 0
+    while position < len(data):
+        delta, position = read_varint(data, position)
+        channel_and_direction = data[position]
+        length, position = read_varint(data, position + 1)
+        time += delta
+        yield time, channel_and_direction >> 1, channel_and_direction & 1, data[position:position + length]
+        position += length
+
+
+def main():
+    arguments = sys.argv[1:]
+    with_time = '--no-time' not in arguments
+    arguments = [argument for argument in arguments if argument != '--no-time']
+    if len(arguments) != 1:
+        sys.exit('usage: capture_dump.py [--no-time] capture file')
+    with open(arguments[0], 'rb') as file:
+        data = file.read()
+    for time, channel, direction, chunk in chunks(data):
+        prefix = f'{time / 1000000:12.6f} ' if with_time else ''
+        print(f'{prefix}{channel} {DIRECTIONS[direction]} {chunk.hex(" ")}')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+# Measures how fast RailControl parses replayed hardware traffic.
+#
+# usage: replay_benchmark.py [railcontrol binary] [number of frames] [runs]
+#
+# A capture of a Maerklin CS2 TCP control is generated that only receives S88 events,
+# each contact going on and off again. RailControl replays it as fast as possible
+# (replayspeed = 0) and the time between starting the replay and its end is taken
+# from the log. Every run parses exactly the same bytes in the same chunks.
+
+import datetime
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+import urllib.parse
+import urllib.request
+
+PORT = 8097
+CONTROL = 10
+HARDWARE_TYPE_CS2_TCP = 10
+MAGIC = b'RCCAP\x01'
+RECEIVED = 1
+CAN_COMMAND_S88_EVENT = 0x11
+LOG_TIME = re.compile(r'^(\d{4}-\d\d-\d\d \d\d:\d\d:\d\d\.\d{6}): ')
+
+
+def varint(value):
+    out = bytearray()
+    while value >= 0x80:
+        out.append((value & 0x7F) | 0x80)
+        value >>= 7
+    out.append(value)
+    return bytes(out)
+
+
+def s88_event(contact, state):
+    # CAN ID with response bit and hash, length, device, contact, old state, new state, time
+    return bytes([0x00, (CAN_COMMAND_S88_EVENT << 1) | 1, 0x03, 0x00, 8,
+                  0x00, 0x00, contact >> 8, contact & 0xFF, 1 - state, state, 0x00, 0x00])
+
+
+def generate(file_name, frames):
+    with open(file_name, 'wb') as capture:
+        capture.write(MAGIC)
+        for frame in range(frames):
+            contact = (frame // 2) % 1024 + 1
+            data = s88_event(contact, 1 - frame % 2)
+            capture.write(varint(1000) + bytes([(0 << 1) | RECEIVED]) + varint(len(data)) + data)
+
+
+def wait_for_webserver(process):
+    while process.poll() is None:
+        try:
+            urllib.request.urlopen(f'http://localhost:{PORT}/', timeout=1).read()
+            return True
+        except OSError:
+            time.sleep(0.01)
+    return False
+
+
+def start(binary, directory):
+    return subprocess.Popen([binary, '--config', os.path.join(directory, 'config.conf'), '--logfile=railcontrol.log', '-s'],
+                            cwd=directory, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+
+
+def write_config(directory, replay):
+    with open(os.path.join(directory, 'config.conf'), 'w') as config:
+        config.write(f'dbfilename = railcontrol.sqlite\nwebserverport = {PORT}\nnumkeepbackups = 0\n')
+        if replay:
+            config.write(f'replaydirectory = {directory}\nreplayspeed = 0\n')
+
+
+def create_control(binary, directory):
+    write_config(directory, False)
+    process = start(binary, directory)
+    if not wait_for_webserver(process):
+        sys.exit('RailControl did not start')
+    arguments = urllib.parse.urlencode({'cmd': 'controlsave', 'control': 0, 'name': 'CS2',
+                                        'hardwaretype': HARDWARE_TYPE_CS2_TCP, 'arg1': '127.0.0.1'})
+    urllib.request.urlopen(f'http://localhost:{PORT}/?{arguments}', timeout=10).read()
+    process.terminate()
+    process.wait()
+    write_config(directory, True)
+
+
+def log_seconds(directory, first, last):
+    times = {}
+    with open(os.path.join(directory, 'railcontrol.log'), encoding='utf-8', errors='replace') as log:
+        for line in log:
+            match = LOG_TIME.match(line)
+            if not match:
+                continue
+            for text in (first, last):
+                if text in line and text not in times:
+                    times[text] = datetime.datetime.strptime(match.group(1), '%Y-%m-%d %H:%M:%S.%f')
+    if first not in times or last not in times:
+        return float('nan')
+    return (times[last] - times[first]).total_seconds()
+
+
+def measure(binary, directory):
+    for name in os.listdir(directory):
+        if name.startswith('railcontrol.log'):
+            os.remove(os.path.join(directory, name))
+    process = start(binary, directory)
+    if not wait_for_webserver(process):
+        sys.exit('RailControl did not start')
+    deadline = time.monotonic() + 600
+    while time.monotonic() < deadline:
+        with open(os.path.join(directory, 'railcontrol.log'), encoding='utf-8', errors='replace') as log:
+            if 'finished' in log.read():
+                break
+        time.sleep(0.1)
+    process.terminate()
+    process.wait()
+    for name in os.listdir(directory):
+        if name.startswith('railcontrol.log.'):
+            os.rename(os.path.join(directory, name), os.path.join(directory, 'railcontrol.log'))
+    return log_seconds(directory, 'Replaying the traffic', 'Replay of')
+
+
+def main():
+    binary = os.path.abspath(sys.argv[1] if len(sys.argv) > 1 else 'railcontrol')
+    frames = int(sys.argv[2]) if len(sys.argv) > 2 else 100000
+    runs = int(sys.argv[3]) if len(sys.argv) > 3 else 3
+
+    with tempfile.TemporaryDirectory() as directory:
+        create_control(binary, directory)
+        generate(os.path.join(directory, f'control{CONTROL}.rccap'), frames)
+        for run in range(runs):
+            seconds = measure(binary, directory)
+            print(f'Run {run + 1}: {frames} frames in {seconds:.3f} s, {frames / seconds:.0f} frames/s')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+# Drives trains in automode on the layout simulator and reports how RailControl kept up.
+#
+# usage: simulator_benchmark.py [railcontrol binary] [trains] [minutes] [simulation speed]
+#
+# A ring of tracks, three per train and at least five, with varying lengths is created through the web
+# interface. Every track has an entry and a stop feedback and is connected to the next
+# two tracks, so trains compete for the same destinations. The trains are started in
+# automode on the "Virtual Layout Simulator" control, which moves them along their
+# reserved routes and reports the feedbacks. After the given minutes of real time the
+# route selection latency, the route reservation conflicts, the command throughput of
+# the control and the CPU time used per train are reported.
+
+import os
+import subprocess
+import sys
+import tempfile
+import time
+import urllib.parse
+import urllib.request
+
+PORT = 8098
+CONTROL = 10
+HARDWARE_TYPE_SIMULATOR = 25
+TRACKS_PER_TRAIN = 3
+
+
+def command(cmd, **arguments):
+    arguments['cmd'] = cmd
+    url = f'http://localhost:{PORT}/?' + urllib.parse.urlencode(arguments)
+    return urllib.request.urlopen(url, timeout=10).read().decode('utf-8', errors='replace')
+
+
+def wait_for_webserver(process):
+    while process.poll() is None:
+        try:
+            urllib.request.urlopen(f'http://localhost:{PORT}/', timeout=1).read()
+            return True
+        except OSError:
+            time.sleep(0.01)
+    return False
+
+
+def build_layout(trains, speed):
+    command('controlsave', control=0, name='Simulator', hardwaretype=HARDWARE_TYPE_SIMULATOR, arg1=speed)
+    # with less than five tracks a train could return to the track it is just leaving
+    tracks = max(trains * TRACKS_PER_TRAIN, 5)
+    for track in range(tracks):
+        # feedback IDs start at 1 in the order of creation: entry 2 * track + 1, stop 2 * track + 2
+        # without debouncing, the delays would run in real time and not in simulated time
+        command('feedbacksave', feedback=0, name=f'F{track}a', control=CONTROL, pin=2 * track + 1, ondelay=0, offdelay=0)
+        command('feedbacksave', feedback=0, name=f'F{track}b', control=CONTROL, pin=2 * track + 2, ondelay=0, offdelay=0)
+        command('tracksave', track=0, name=f'T{track}', posx=(track % 10) * 5, posy=track // 10,
+                length=2 + track % 3, feedbackcounter=2,
+                feedback_id_1=2 * track + 1, feedback_id_2=2 * track + 2)
+    for track in range(tracks):
+        for step in (1, 2):
+            destination = (track + step) % tracks
+            command('routesave', route=0, name=f'R{track}-{destination}', automode='true', visible='false',
+                    fromtrack=track + 1, totrack=destination + 1,
+                    feedbackreduced=2 * destination + 1, feedbackstop=2 * destination + 2)
+    for train in range(trains):
+        command('locosave', loco=0, name=f'Train {train + 1}', control=CONTROL, protocol=0, address=train + 1,
+                length=40 + 10 * (train % 4), travelspeed=700, reducedspeed=400, creepingspeed=100)
+    command('booster', on='true')
+    for train in range(trains):
+        command('tracksetloco', track=train * TRACKS_PER_TRAIN + 1, loco=train + 1)
+    for train in range(trains):
+        command('trackstartloco', track=train * TRACKS_PER_TRAIN + 1)
+
+
+def cpu_seconds(pid):
+    with open(f'/proc/{pid}/stat') as stat:
+        fields = stat.read().rsplit(')', 1)[1].split()
+    return (int(fields[11]) + int(fields[12])) / os.sysconf('SC_CLK_TCK')
+
+
+def report(statistics, trains, seconds, cpu):
+    lines = [line.split(';') for line in statistics.splitlines()]
+    for line in lines:
+        if line[:2] == ['routeselection', 'total']:
+            count, total, maximum = (int(value) for value in line[2:5])
+            average = total / count if count else 0
+            print(f'Route selections: {count}, average {average:.0f} us, max {maximum} us')
+        elif line[0] == 'routeconflicts':
+            print(f'Route reservation conflicts: {line[1]}')
+        elif line[0] == 'hardwarequeue' and line[1] == str(CONTROL):
+            print(f'Commands posted: {line[4]} ({int(line[4]) / seconds:.1f}/s), dropped {line[5]}, max queue depth {line[3]}')
+        elif line[0] == 'simulator':
+            print(f'Simulator: {line[2]} trains moving, {line[3]} commands, {line[4]} feedbacks, {line[5]} overruns, {int(line[6]) / 1000:.0f} s simulated')
+    print(f'CPU: {cpu:.2f} s in {seconds:.0f} s, {1000 * cpu / seconds / trains:.2f} ms per second per train')
+
+
+def main():
+    binary = os.path.abspath(sys.argv[1] if len(sys.argv) > 1 else 'railcontrol')
+    trains = int(sys.argv[2]) if len(sys.argv) > 2 else 10
+    minutes = float(sys.argv[3]) if len(sys.argv) > 3 else 5
+    speed = int(sys.argv[4]) if len(sys.argv) > 4 else 10
+
+    with tempfile.TemporaryDirectory() as directory:
+        with open(os.path.join(directory, 'config.conf'), 'w') as config:
+            config.write(f'dbfilename = railcontrol.sqlite\nwebserverport = {PORT}\nnumkeepbackups = 0\n')
+        process = subprocess.Popen([binary, '--config', os.path.join(directory, 'config.conf'), '--logfile=railcontrol.log', '-s'],
+                                   cwd=directory, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+        try:
+            if not wait_for_webserver(process):
+                sys.exit('RailControl did not start')
+            build_layout(trains, speed)
+            begin = time.monotonic()
+            cpu_begin = cpu_seconds(process.pid)
+            time.sleep(minutes * 60)
+            statistics = command('stats')
+            report(statistics, trains, time.monotonic() - begin, cpu_seconds(process.pid) - cpu_begin)
+        finally:
+            process.terminate()
+            process.wait()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+# Measures the startup of RailControl with a generated layout database.
+#
+# usage: startup_benchmark.py [railcontrol binary] [number of objects] [runs]
+#
+# The database is created by RailControl itself, then filled with copies of
+# the objects RailControl stores for a track, a feedback, a switch, a signal,
+# an accessory, a route and a loco. The time from start until the web server
+# answers and the time between opening the database and starting the web
+# server from the log are reported, followed by the loading phases of the
+# last run.
+
+import datetime
+import os
+import re
+import sqlite3
+import subprocess
+import sys
+import tempfile
+import time
+import urllib.request
+
+PORT = 8099
+
+OBJECTS = [
+    # objecttype, share, serialized object with {id}, {name}, {x}, {y}
+    (3, 3, 'objectType=Feedback;objectID={id};name={name};visible=1;posX={x};posY={y};posZ=0;width=1;height=1;rotation=1;controlID=0;pin={id};device=0;bus=0;feedbacktype=0;route=0;inverted=0;state=0;matchkey='),
+    (2, 3, 'objectType=Track;objectID={id};name={name};visible=1;posX={x};posY={y};posZ=0;width=1;height=1;rotation=1;lockstate=0;locobaseid=0;locobasetype=0;selectrouteapproach=0;trackstate=0;trackstatedelayed=0;locoorientation=1;blocked=0;locodelayed=0;locotypedelayed=0;allowlocoturn=0;releasewhenfree=0;showname=1;displayname=;tracktype=0;main=0'),
+    (5, 1, 'objectType=Switch;controlID=0;protocol=0;address={id};serveraddress={id};type=0;state=0;duration=250;inverted=0;lastused=0;counter=0;matchkey=;objectID={id};name={name};visible=1;posX={x};posY={y};posZ=0;width=1;height=1;rotation=1;lockstate=0;locobaseid=0;locobasetype=0'),
+    (8, 1, 'objectType=Signal;controlID=0;protocol=0;address={id};serveraddress={id};type=0;state=0;duration=250;inverted=0;lastused=0;counter=0;matchkey=;objectID={id};name={name};visible=1;posX={x};posY={y};posZ=0;width=1;height=1;rotation=1;lockstate=0;locobaseid=0;locobasetype=0'),
+    (4, 1, 'objectType=Accessory;controlID=0;protocol=0;address={id};serveraddress={id};type=0;state=0;duration=250;inverted=0;lastused=0;counter=0;matchkey=;objectID={id};name={name};visible=1;posX={x};posY={y};posZ=0;width=1;height=1;rotation=1;lockstate=0;locobaseid=0;locobasetype=0;port=0'),
+    (6, 1, 'objectType=Route;objectID={id};name={name};visible=0;posX=0;posY=0;posZ=0;width=1;height=1;rotation=0;lockstate=0;locobaseid=0;locobasetype=0;delay=0;lastused=0;counter=0;automode=0'),
+]
+LOCO_SHARE = 1
+LOCO = 'objectType=Loco;objectID={id};name={name};controlID=0;protocol=0;address={id};serveraddress={id};functions=;orientation=1;track=0;length=0;pushpull=0;maxspeed=1023;travelspeed=700;reducedspeed=400;creepingspeed=100;propulsion=128;type=1073741824;matchkey='
+RELATION_TRACK_FEEDBACK = 17
+LOG_TIME = re.compile(r'^(\d{4}-\d\d-\d\d \d\d:\d\d:\d\d\.\d{6}): ')
+LOG_PHASE = re.compile(r'relations from the database in|Startup phase|Loaded all objects in')
+
+
+def start(binary, directory):
+    return subprocess.Popen([binary, '--config', os.path.join(directory, 'config.conf'), '--logfile=', '-s'],
+                            cwd=directory, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+
+
+def wait_for_webserver(process):
+    while process.poll() is None:
+        try:
+            urllib.request.urlopen(f'http://localhost:{PORT}/', timeout=1).read()
+            return True
+        except OSError:
+            time.sleep(0.01)
+    return False
+
+
+def generate(binary, directory, number_of_objects):
+    with open(os.path.join(directory, 'config.conf'), 'w') as config:
+        config.write(f'dbfilename = railcontrol.sqlite\nwebserverport = {PORT}\nnumkeepbackups = 0\n')
+
+    process = start(binary, directory)
+    wait_for_webserver(process)
+    process.terminate()
+    process.wait()
+
+    database = sqlite3.connect(os.path.join(directory, 'railcontrol.sqlite'))
+    shares = sum(share for _, share, _ in OBJECTS) + LOCO_SHARE
+    rows = []
+    relations = []
+    for objecttype, share, template in OBJECTS:
+        count = number_of_objects * share // shares
+        for objectid in range(1, count + 1):
+            name = f'{objecttype}-{objectid}'
+            rows.append((objecttype, objectid, name,
+                         template.format(id=objectid, name=name, x=objectid % 250, y=objectid // 250)))
+            if objecttype == 2:
+                relations.append((RELATION_TRACK_FEEDBACK, objectid, 3, objectid, 0,
+                                  f'lockstate=0;locobaseid=0;locobasetype=0;type={RELATION_TRACK_FEEDBACK};'
+                                  f'objectType1=2;objectID1={objectid};objectType2=3;objectID2={objectid};priority=0;data=0'))
+    for objectid in range(1, number_of_objects * LOCO_SHARE // shares + 1):
+        name = f'Loco {objectid}'
+        rows.append((1, objectid, name, LOCO.format(id=objectid, name=name)))
+
+    database.executemany('INSERT OR REPLACE INTO objects (objecttype, objectid, name, object) VALUES (?, ?, ?, ?)', rows)
+    database.executemany('INSERT OR REPLACE INTO relations (type, objectid1, objecttype2, objectid2, priority, relation) VALUES (?, ?, ?, ?, ?, ?)', relations)
+    database.commit()
+    database.close()
+    return len(rows)
+
+
+def log_seconds(directory, first, last):
+    times = {}
+    with open(os.path.join(directory, 'railcontrol.log'), encoding='utf-8', errors='replace') as log:
+        for line in log:
+            match = LOG_TIME.match(line)
+            if not match:
+                continue
+            for text in (first, last):
+                if text in line and text not in times:
+                    times[text] = datetime.datetime.strptime(match.group(1), '%Y-%m-%d %H:%M:%S.%f')
+    if first not in times or last not in times:
+        return float('nan')
+    return (times[last] - times[first]).total_seconds()
+
+
+def log_phases(directory):
+    phases = []
+    with open(os.path.join(directory, 'railcontrol.log'), encoding='utf-8', errors='replace') as log:
+        for line in log:
+            if LOG_PHASE.search(line):
+                phases.append(line.split(': ', 2)[-1].rstrip())
+    return phases
+
+
+def measure(binary, directory):
+    for name in os.listdir(directory):
+        if name.startswith('railcontrol.log'):
+            os.remove(os.path.join(directory, name))
+    begin = time.monotonic()
+    process = subprocess.Popen([binary, '--config', os.path.join(directory, 'config.conf'), '--logfile=railcontrol.log', '-s'],
+                               cwd=directory, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    if not wait_for_webserver(process):
+        sys.exit('RailControl did not start')
+    ready = time.monotonic() - begin
+    process.terminate()
+    process.wait()
+    for name in os.listdir(directory):
+        if name.startswith('railcontrol.log.'):
+            os.rename(os.path.join(directory, name), os.path.join(directory, 'railcontrol.log'))
+    return ready, log_seconds(directory, 'Opening SQLite', 'Webserver started')
+
+
+def main():
+    binary = os.path.abspath(sys.argv[1] if len(sys.argv) > 1 else 'railcontrol')
+    number_of_objects = int(sys.argv[2]) if len(sys.argv) > 2 else 10000
+    runs = int(sys.argv[3]) if len(sys.argv) > 3 else 3
+
+    with tempfile.TemporaryDirectory() as directory:
+        generated = generate(binary, directory, number_of_objects)
+        print(f'Objects: {generated}')
+        for run in range(runs):
+            ready, loading = measure(binary, directory)
+            print(f'Run {run + 1}: web server answers after {ready:.3f} s, loading took {loading:.3f} s')
+        for phase in log_phases(directory):
+            print(phase)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+# Measures how many concurrent web clients RailControl sustains on one core.
+#
+# usage: web_load_benchmark.py [railcontrol binary] [updater clients] [updates] [slow clients]
+#
+# RailControl is pinned to one core. The given number of updater (server sent
+# events) clients is connected, together with slow clients that send only a
+# part of their request header and then stall. Then updates are triggered by
+# toggling the booster and the time until every updater has received each
+# update is measured. Finally one keep-alive client sends as many requests as
+# it can for two seconds. The number of threads of RailControl is reported.
+
+import os
+import select
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+import urllib.request
+
+PORT = 8097
+
+
+def wait_for_webserver(process):
+    while process.poll() is None:
+        try:
+            urllib.request.urlopen(f'http://localhost:{PORT}/', timeout=1).read()
+            return True
+        except OSError:
+            time.sleep(0.01)
+    return False
+
+
+def connect_updater():
+    updater = socket.create_connection(('localhost', PORT), timeout=10)
+    updater.sendall(b'GET /?cmd=updater HTTP/1.1\r\nConnection: keep-alive\r\n\r\n')
+    return updater
+
+
+def receive_all(updaters, text):
+    pending = {updater: b'' for updater in updaters}
+    while pending:
+        readable, _, _ = select.select(list(pending), [], [], 10)
+        if not readable:
+            sys.exit('Updaters did not receive ' + text.decode())
+        for updater in readable:
+            data = updater.recv(65536)
+            if not data:
+                sys.exit('Updater has been closed')
+            received = pending[updater] + data
+            if text in received:
+                del pending[updater]
+            else:
+                # keep enough to find the text split over two receives
+                pending[updater] = received[-len(text):]
+
+
+def booster(connection, on):
+    connection.sendall(f'GET /?cmd=booster&on={on} HTTP/1.1\r\nConnection: keep-alive\r\n\r\n'.encode())
+    response = b''
+    while b'\r\n\r\n' not in response:
+        response += connection.recv(65536)
+    header, body = response.split(b'\r\n\r\n', 1)
+    length = 0
+    for line in header.split(b'\r\n'):
+        if line.lower().startswith(b'content-length:'):
+            length = int(line.split(b':')[1])
+    while len(body) < length:
+        body += connection.recv(65536)
+
+
+def main():
+    binary = os.path.abspath(sys.argv[1] if len(sys.argv) > 1 else 'railcontrol')
+    number_of_updaters = int(sys.argv[2]) if len(sys.argv) > 2 else 300
+    number_of_updates = int(sys.argv[3]) if len(sys.argv) > 3 else 100
+    number_of_slow_clients = int(sys.argv[4]) if len(sys.argv) > 4 else 8
+
+    with tempfile.TemporaryDirectory() as directory:
+        with open(os.path.join(directory, 'config.conf'), 'w') as config:
+            config.write(f'dbfilename = railcontrol.sqlite\nwebserverport = {PORT}\nnumkeepbackups = 0\n')
+        process = subprocess.Popen([binary, '--config', os.path.join(directory, 'config.conf'), '--logfile=', '-s'],
+                                   cwd=directory, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+        try:
+            if not wait_for_webserver(process):
+                sys.exit('RailControl did not start')
+            os.sched_setaffinity(process.pid, {min(os.sched_getaffinity(0))})
+
+            slow_clients = []
+            for _ in range(number_of_slow_clients):
+                slow = socket.create_connection(('localhost', PORT), timeout=10)
+                slow.sendall(b'GET /?cmd=booster&on=true HTTP/1.1\r\nConnec')
+                slow_clients.append(slow)
+
+            updaters = [connect_updater() for _ in range(number_of_updaters)]
+            receive_all(updaters, b'text/event-stream')
+
+            control = socket.create_connection(('localhost', PORT), timeout=10)
+            latencies = []
+            for update in range(number_of_updates):
+                on = 'true' if update % 2 else 'false'
+                start = time.monotonic()
+                booster(control, on)
+                receive_all(updaters, f'booster;on={on}'.encode())
+                latencies.append(time.monotonic() - start)
+
+            requests = 0
+            end = time.monotonic() + 2
+            while time.monotonic() < end:
+                booster(control, 'false')
+                requests += 1
+                # the updaters have to be drained, otherwise they get disconnected
+                if requests % 50 == 0:
+                    receive_all(updaters, b'booster;on=false')
+
+            threads = len(os.listdir(f'/proc/{process.pid}/task'))
+            latencies.sort()
+            print(f'Updaters: {number_of_updaters}, slow clients: {number_of_slow_clients}, threads: {threads}')
+            print(f'Update reaches all updaters: median {latencies[len(latencies) // 2] * 1000:.1f} ms, '
+                  f'max {latencies[-1] * 1000:.1f} ms')
+            print(f'Keep-alive requests: {requests / 2:.0f} per second')
+
+            control.close()
+            for client in updaters + slow_clients:
+                client.close()
+        finally:
+            process.terminate()
+            process.wait()
+
+
+if __name__ == '__main__':
+    main()